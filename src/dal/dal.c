@@ -70,6 +70,36 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include "dal.h"
 
 #include <ctype.h>
+#include <stdlib.h>
+#include <limits.h>
+
+/**
+ * Identify the NUMA node local to the device behind a network interface
+ * @param const char* ifname : Name of the network interface
+ * @return int : NUMA node of the interface ( -1 if the device reports no locality ),
+ *               or -2 if the interface could not be identified
+ */
+static int numa_node_of_interface(const char *ifname)
+{
+   char path[PATH_MAX];
+   if (strchr(ifname, '/') != NULL ||
+       snprintf(path, PATH_MAX, "/sys/class/net/%s/device/numa_node", ifname) >= PATH_MAX)
+   {
+      return -2;
+   }
+   FILE *nodefile = fopen(path, "r");
+   if (nodefile == NULL)
+   {
+      return -2;
+   }
+   int node = -2;
+   if (fscanf(nodefile, "%d", &node) != 1 || node < -1)
+   {
+      node = -2;
+   }
+   fclose(nodefile);
+   return node;
+}
 
 // Function to provide specific DAL initialization calls based on name
 DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
@@ -85,12 +115,123 @@ DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
    // make sure we have a valid 'type' attribute
    xmlAttr *type = dal_conf_root->properties;
    xmlNode *typetxt = NULL;
+   int io_depth = -1; // not specified
+   int compress = -1;  // no compression
+   char compress_set = 0;
+   int checksum = CSUM_CRC32;
+   char checksum_set = 0;
+   int numa_node = -1; // no placement
+   char numa_set = 0;
    for (; type; type = type->next)
    {
       if (typetxt == NULL && type->type == XML_ATTRIBUTE_NODE && strncmp((char *)type->name, "type", 5) == 0)
       {
          typetxt = type->children;
       }
+      else if (io_depth < 0 && type->type == XML_ATTRIBUTE_NODE && strncmp((char *)type->name, "iodepth", 8) == 0)
+      {
+         char *endptr = NULL;
+         long parsedval = -1;
+         if (type->children != NULL && type->children->type == XML_TEXT_NODE && type->children->content != NULL)
+         {
+            parsedval = strtol((char *)type->children->content, &endptr, 10);
+         }
+         if (endptr == NULL || *endptr != '\0' || parsedval < 1 || parsedval > INT_MAX)
+         {
+            LOG(LOG_ERR, "invalid DAL 'iodepth' attribute value\n");
+            errno = EINVAL;
+            return NULL;
+         }
+         io_depth = (int)parsedval;
+      }
+      else if (!(compress_set) && type->type == XML_ATTRIBUTE_NODE && strncmp((char *)type->name, "compress", 9) == 0)
+      {
+         char *endptr = NULL;
+         long parsedval = -2;
+         if (type->children != NULL && type->children->type == XML_TEXT_NODE && type->children->content != NULL)
+         {
+            if (strncasecmp((char *)type->children->content, "none", 5) == 0)
+            {
+               parsedval = -1;
+               endptr = "";
+            }
+            else
+            {
+               parsedval = strtol((char *)type->children->content, &endptr, 10);
+            }
+         }
+         // accept any isa-l igzip compression level
+         if (endptr == NULL || *endptr != '\0' || parsedval < -1 || parsedval > 3)
+         {
+            LOG(LOG_ERR, "invalid DAL 'compress' attribute value ( expected 'none' or a level of 0 to 3 )\n");
+            errno = EINVAL;
+            return NULL;
+         }
+         compress = (int)parsedval;
+         compress_set = 1;
+      }
+      else if (!(checksum_set) && type->type == XML_ATTRIBUTE_NODE && strncmp((char *)type->name, "checksum", 9) == 0)
+      {
+         const char *algname = NULL;
+         if (type->children != NULL && type->children->type == XML_TEXT_NODE)
+         {
+            algname = (const char *)type->children->content;
+         }
+         if (algname != NULL && strncasecmp(algname, "crc32", 6) == 0)
+         {
+            checksum = CSUM_CRC32;
+         }
+         else if (algname != NULL && strncasecmp(algname, "crc32c", 7) == 0)
+         {
+            checksum = CSUM_CRC32C;
+         }
+         else
+         {
+            LOG(LOG_ERR, "invalid DAL 'checksum' attribute value ( expected 'crc32' or 'crc32c' )\n");
+            errno = EINVAL;
+            return NULL;
+         }
+         checksum_set = 1;
+      }
+      else if (!(numa_set) && type->type == XML_ATTRIBUTE_NODE && strncmp((char *)type->name, "numa", 5) == 0)
+      {
+         const char *nodename = NULL;
+         if (type->children != NULL && type->children->type == XML_TEXT_NODE)
+         {
+            nodename = (const char *)type->children->content;
+         }
+         char *endptr = NULL;
+         long parsedval = -2;
+         if (nodename != NULL && strncasecmp(nodename, "none", 5) == 0)
+         {
+            parsedval = -1;
+         }
+         else if (nodename != NULL && isdigit(*nodename))
+         {
+            parsedval = strtol(nodename, &endptr, 10);
+            if (*endptr != '\0' || parsedval > INT_MAX)
+            {
+               parsedval = -2;
+            }
+         }
+         else if (nodename != NULL && *nodename != '\0')
+         {
+            // place blocks alongside the device of the named network interface
+            parsedval = numa_node_of_interface(nodename);
+            if (parsedval == -1)
+            {
+               LOG(LOG_WARNING, "network interface \"%s\" reports no NUMA locality, so no placement will be applied\n", nodename);
+            }
+         }
+         if (parsedval < -1)
+         {
+            LOG(LOG_ERR, "invalid DAL 'numa' attribute value ( expected 'none', a NUMA node number, or a network interface name )\n");
+            errno = EINVAL;
+            return NULL;
+         }
+         numa_node = (int)parsedval;
+         numa_set = 1;
+      }
       else
       {
          LOG(LOG_WARNING, "encountered unrecognized or redundant DAL attribute: \"%s\"\n", (char *)type->name);
@@ -112,37 +253,62 @@ DAL init_dal(xmlNode *dal_conf_root, DAL_location max_loc)
    }
 
    // name comparison for each DAL type
+   DAL dal = NULL;
    if (strncasecmp((char *)typetxt->content, "posix", 6) == 0)
    {
-      return posix_dal_init(dal_conf_root->children, max_loc);
+      dal = posix_dal_init(dal_conf_root->children, max_loc);
+   }
+   else if (strncasecmp((char *)typetxt->content, "posix_uring", 12) == 0)
+   {
+      dal = posix_uring_dal_init(dal_conf_root->children, max_loc);
    }
    else if (strncasecmp((char *)typetxt->content, "fuzzing", 8) == 0)
    {
-      return fuzzing_dal_init(dal_conf_root->children, max_loc);
+      dal = fuzzing_dal_init(dal_conf_root->children, max_loc);
    }
 #ifdef S3DAL
    else if (strncasecmp((char *)typetxt->content, "s3", 3) == 0)
    {
-      return s3_dal_init(dal_conf_root->children, max_loc);
+      dal = s3_dal_init(dal_conf_root->children, max_loc);
    }
 #endif
    else if (strncasecmp((char *)typetxt->content, "timer", 6) == 0)
    {
-      return timer_dal_init(dal_conf_root->children, max_loc);
+      dal = timer_dal_init(dal_conf_root->children, max_loc);
    }
    else if (strncasecmp((char *)typetxt->content, "noop", 5) == 0)
    {
-      return noop_dal_init(dal_conf_root->children, max_loc);
+      dal = noop_dal_init(dal_conf_root->children, max_loc);
+   }
+   else if (strncasecmp((char *)typetxt->content, "sim", 4) == 0)
+   {
+      dal = sim_dal_init(dal_conf_root->children, max_loc);
    }
 #ifdef RECURSION
    else if (strncasecmp((char *)typetxt->content, "recursive", 10) == 0)
    {
-      return rec_dal_init(dal_conf_root->children, max_loc);
+      dal = rec_dal_init(dal_conf_root->children, max_loc);
    }
 #endif
+   else
+   {
+      // if no DAL found, return NULL
+      LOG(LOG_ERR, "failed to identify a DAL of type: \"%s\"\n", typetxt->content);
+      errno = ENODEV;
+      return NULL;
+   }
 
-   // if no DAL found, return NULL
-   LOG(LOG_ERR, "failed to identify a DAL of type: \"%s\"\n", typetxt->content);
-   errno = ENODEV;
-   return NULL;
+   // apply any explicit IO depth, overriding the DAL's own preference
+   if (dal != NULL && io_depth > 0)
+   {
+      dal->io_depth = io_depth;
+   }
+   // compression, checksums, and NUMA placement are applied only by libne, and so are never inherited from an underlying DAL
+   if (dal != NULL)
+   {
+      dal->compress = compress;
+      dal->checksum = checksum;
+      dal->numa_node = numa_node;
+   }
+   return dal;
 }
@@ -66,6 +66,7 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <strings.h>
 #include <string.h>
 #include <errno.h>
+#include <sys/uio.h>
 
 #ifndef LIBXML_TREE_ENABLED
 #error "Included Libxml2 does not support tree functionality!"
@@ -104,17 +105,25 @@ typedef struct meta_info_struct
    ssize_t blocksz;
    long long crcsum;
    ssize_t totsz;
+   ssize_t compsz; // stored size of the compressed block data, which is followed by an index of
+                   //  its IO units ( zero if the block data is uncompressed; specific to each block )
+   int csum;       // checksum algorithm protecting each IO unit ( CSUM_* value; specific to each block )
 } meta_info;
 
+// IO unit checksum algorithms ( see meta_info 'csum' )
+#define CSUM_CRC32  0 // isa-l crc32_ieee ( the original algorithm, assumed for any block lacking a 'csum' value )
+#define CSUM_CRC32C 1 // isa-l crc32_iscsi ( Castagnoli polynomial, accelerated by SSE4.2 / ARMv8 CRC instructions )
+#define CSUM_MAX    CSUM_CRC32C
+
 /**
- * Duplicates info from one meta_info struct to another (excluding CRCSUM!)
+ * Duplicates info from one meta_info struct to another (excluding CRCSUM, COMPSZ, and CSUM!)
  * @param meta_info* target : Target struct reference
  * @param meta_info* source : Source struct reference
  */
 void cpy_minfo( meta_info* target, meta_info* source );
 
 /**
- * Compares the values of two meta_info structs (excluding CRCSUM!)
+ * Compares the values of two meta_info structs (excluding CRCSUM, COMPSZ, and CSUM!)
  * @param meta_info* minfo1 : First struct reference
  * @param meta_info* minfo2 : Second struct reference
  * @return int : A zero value if the structures match, non-zero otherwise
@@ -144,6 +153,23 @@ typedef struct DAL_struct
    // Preferred I/O Size
    size_t io_size;
 
+   // Preferred number of I/O buffers in flight per block ( zero for the IOQueue default )
+   //  NOTE -- this is set from an optional 'iodepth' attribute of the DAL node, and should
+   //          otherwise be inherited from any underlying DAL
+   int io_depth;
+
+   // isa-l igzip level at which libne compresses written block data ( negative for no compression )
+   //  NOTE -- this is set from an optional 'compress' attribute of the outermost DAL node
+   int compress;
+
+   // Checksum algorithm with which libne protects written IO units ( CSUM_* value )
+   //  NOTE -- this is set from an optional 'checksum' attribute of the outermost DAL node
+   int checksum;
+
+   // NUMA node on which libne places the IO threads and buffers of each block ( negative for no placement )
+   //  NOTE -- this is set from an optional 'numa' attribute of the outermost DAL node
+   int numa_node;
+
    // DAL Functions --
    int (*verify)(DAL_CTXT ctxt, int flags);
    // Description:
@@ -203,11 +229,27 @@ typedef struct DAL_struct
    //  Store data to the object associated with the given WRITE/REBUILD BLOCK_CTXT.
    // Return Values:
    //  Zero on success, Non-zero if the operation could not be completed
+   int (*putv)(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt);
+   // Description:
+   //  Store data from a list of buffers to the object associated with the given WRITE/REBUILD BLOCK_CTXT.
+   //  The result must be identical to a single put() of the concatenated buffers.
+   //  Note - this function is OPTIONAL.  A NULL value indicates that the DAL does not support vectored puts,
+   //  in which case callers must fall back to put().
+   // Return Values:
+   //  Zero on success, Non-zero if the operation could not be completed
    ssize_t (*get)(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
    // Description:
    //  Retrieve data from the object associated with the given READ BLOCK_CTXT.
    // Return Values:
    //  Byte count on success, Non-zero if the operation could not be completed
+   ssize_t (*getv)(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset);
+   // Description:
+   //  Retrieve data from the object associated with the given READ BLOCK_CTXT, scattering it across a list
+   //  of buffers.  The result must be identical to a single get() of the total size, split among those buffers.
+   //  Note - this function is OPTIONAL.  A NULL value indicates that the DAL does not support vectored gets,
+   //  in which case callers must fall back to get().
+   // Return Values:
+   //  Byte count on success, Non-zero if the operation could not be completed
    int (*abort)(BLOCK_CTXT ctxt);
    // Description:
    //  Abandon a given WRITE/REBUILD BLOCK_CTXT.  This is roughly equivalent to calling close() on the
@@ -224,10 +266,14 @@ typedef struct DAL_struct
 
 // Forward decls of specific DAL initializations
 DAL posix_dal_init(xmlNode *posix_dal_conf_root, DAL_location max_loc);
+DAL posix_uring_dal_init(xmlNode *posix_dal_conf_root, DAL_location max_loc);
 DAL fuzzing_dal_init(xmlNode *fuzzing_dal_conf_root, DAL_location max_loc);
 DAL s3_dal_init(xmlNode *s3_dal_conf_root, DAL_location max_loc);
 DAL timer_dal_init(xmlNode *timer_dal_conf_root, DAL_location max_loc);
 DAL noop_dal_init(xmlNode *noop_dal_conf_root, DAL_location max_loc);
+DAL sim_dal_init(xmlNode *sim_dal_conf_root, DAL_location max_loc);
+// Release all Sim DAL reads held by a 'stall' timing definition
+void sim_dal_release(void);
 #ifdef RECURSION
 DAL rec_dal_init(xmlNode *rec_dal_conf_root, DAL_location max_loc);
 #endif
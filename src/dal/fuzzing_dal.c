@@ -409,6 +409,26 @@ int fuzzing_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
    return bctxt->global_ctxt->under_dal->put(bctxt->bctxt, buf, size);
 }
 
+int fuzzing_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+
+   FUZZING_BLOCK_CTXT bctxt = (FUZZING_BLOCK_CTXT)ctxt;
+
+   // vectored puts are fuzzed identically to standard puts
+   if (check_fuzz(bctxt->global_ctxt->put, bctxt->loc.block))
+   {
+      LOG(LOG_ERR, "Fuzzing DAL: fuzzing putv block %d\n", bctxt->loc.block);
+      return -2;
+   }
+
+   return bctxt->global_ctxt->under_dal->putv(bctxt->bctxt, iov, iovcnt);
+}
+
 ssize_t fuzzing_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
 {
    if (ctxt == NULL)
@@ -428,6 +448,26 @@ ssize_t fuzzing_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
    return bctxt->global_ctxt->under_dal->get(bctxt->bctxt, buf, size, offset);
 }
 
+ssize_t fuzzing_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+
+   FUZZING_BLOCK_CTXT bctxt = (FUZZING_BLOCK_CTXT)ctxt;
+
+   // vectored gets are fuzzed identically to standard gets
+   if (check_fuzz(bctxt->global_ctxt->get, bctxt->loc.block))
+   {
+      LOG(LOG_ERR, "Fuzzing DAL: fuzzing getv block %d\n", bctxt->loc.block);
+      return -2;
+   }
+
+   return bctxt->global_ctxt->under_dal->getv(bctxt->bctxt, iov, iovcnt, offset);
+}
+
 int fuzzing_abort(BLOCK_CTXT ctxt)
 {
    if (ctxt == NULL)
@@ -688,13 +728,16 @@ DAL fuzzing_dal_init(xmlNode *root, DAL_location max_loc)
    fdal->name = dctxt->under_dal->name;
    fdal->ctxt = (DAL_CTXT)dctxt;
    fdal->io_size = dctxt->under_dal->io_size;
+   fdal->io_depth = dctxt->under_dal->io_depth;
    fdal->verify = fuzzing_verify;
    fdal->migrate = fuzzing_migrate;
    fdal->open = fuzzing_open;
    fdal->set_meta = fuzzing_set_meta;
    fdal->get_meta = fuzzing_get_meta;
    fdal->put = fuzzing_put;
+   fdal->putv = (dctxt->under_dal->putv) ? fuzzing_putv : NULL;
    fdal->get = fuzzing_get;
+   fdal->getv = (dctxt->under_dal->getv) ? fuzzing_getv : NULL;
    fdal->abort = fuzzing_abort;
    fdal->close = fuzzing_close;
    fdal->del = fuzzing_del;
@@ -83,7 +83,8 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <stdlib.h>
 
 
-#define MINFO_VER 1
+#define MINFO_VER 3 // version 2 appends 'compsz', version 3 also appends 'csum'
+                    //  NOTE -- versioned formats are only written for blocks which depend upon those values
 
 
 /* ------------------------------   INTERNAL HELPER FUNCTIONS   ------------------------------ */
@@ -132,6 +133,8 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    minfo->blocksz = -1;
    minfo->crcsum  = -1;
    minfo->totsz   = -1;
+   minfo->compsz  = -1;
+   minfo->csum    = -1;
    // get the meta info for the given object
    ssize_t dstrbytes;
    if ( (dstrbytes = meta_filler( handle, str, strmax )) <= 0 ) {
@@ -151,7 +154,7 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    // make SURE this string is null-terminated
    str[dstrbytes-1] = '\0';
 
-   int status = 8; // initialize to the number of values we expect to parse
+   int status = 8; // initialize to the number of values we expect to parse ( adjusted below for later versions )
    // Parse the string into appropriate meta_info fields
    // declared here so that the compiler can hopefully free up this memory outside of the 'else' block
    char metaN[5];        /* char array to get n parts from the meta string */
@@ -162,6 +165,8 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    char metablocksz[20]; /* char array to get complete block size from the meta string */
    char metacrcsum[20];  /* char array to get crc sum from the meta string */
    char metatotsize[20]; /* char array to get object totsz from the meta string */
+   char metacompsz[20];  /* char array to get compressed block size from the meta string */
+   char metacsum[5];     /* char array to get checksum algorithm from the meta string */
 
    LOG( LOG_INFO, "Parsing meta string: %s", str );
 
@@ -184,7 +189,34 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    }
    
    int ret = 0;
-   if ( vertag ) {
+   if ( vertag >= 3 ) {
+      status = 10;
+      ret = sscanf(parse,"%4s %4s %4s %19s %19s %19s %19s %19s %19s %4s",
+                           metaN,
+                           metaE,
+                           metaO,
+                           metapartsz,
+                           metaversz,
+                           metablocksz,
+                           metacrcsum,
+                           metatotsize,
+                           metacompsz,
+                           metacsum);
+   }
+   else if ( vertag == 2 ) {
+      status = 9;
+      ret = sscanf(parse,"%4s %4s %4s %19s %19s %19s %19s %19s %19s",
+                           metaN,
+                           metaE,
+                           metaO,
+                           metapartsz,
+                           metaversz,
+                           metablocksz,
+                           metacrcsum,
+                           metatotsize,
+                           metacompsz);
+   }
+   else if ( vertag ) {
       // only process the meta string if we successfully retreived it
       ret = sscanf(parse,"%4s %4s %4s %19s %19s %19s %19s %19s",
                            metaN,
@@ -214,7 +246,8 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
       free( str );
       return -1;
    }
-   if (ret != 8) {
+   int expected = status;
+   if (ret != expected) {
       LOG( LOG_WARNING, "sscanf parsed only %d values from meta info: \"%s\"\n", ret, str);
       status = ret;
    }  
@@ -243,11 +276,22 @@ int dal_get_meta_helper( ssize_t (*meta_filler)(BLOCK_CTXT handle, char *meta_bu
    PARSE_VALUE( minfo->blocksz, metablocksz, 5,  strtol, ssize_t )
    PARSE_VALUE(  minfo->crcsum,  metacrcsum, 6, strtoll, long long )
    PARSE_VALUE(   minfo->totsz, metatotsize, 7, strtoll, ssize_t )
+   PARSE_VALUE(  minfo->compsz,  metacompsz, 8, strtoll, ssize_t )
+   PARSE_VALUE(    minfo->csum,    metacsum, 9,  strtol, int )
+
+   // earlier versions lack these values entirely, as such blocks are never compressed and always use crc32
+   if ( vertag < 2 ) { minfo->compsz = 0; }
+   if ( vertag < 3 ) { minfo->csum = CSUM_CRC32; }
+   else if ( minfo->csum > CSUM_MAX ) {
+      LOG( LOG_ERR, "unrecognized checksum algorithm: %d\n", minfo->csum );
+      minfo->csum = -1;
+      status -= 1;
+   }
 
-   LOG( LOG_INFO, "Got values (N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd)\n",
-                  minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz );
+   LOG( LOG_INFO, "Got values (N=%d,E=%d,O=%d,partsz=%zd,versz=%zd,blocksz=%zd,totsz=%zd,compsz=%zd,csum=%d)\n",
+                  minfo->N, minfo->E, minfo->O, minfo->partsz, minfo->versz, minfo->blocksz, minfo->totsz, minfo->compsz, minfo->csum );
 
-   return ( valid_suffix  &&  status == 8 ) ? 0 : status;
+   return ( valid_suffix  &&  status == expected ) ? 0 : status;
 }
 
 
@@ -276,11 +320,24 @@ int dal_set_meta_helper( int (*meta_writer)(BLOCK_CTXT handle, const char *meta_
    LOG( LOG_INFO, "crcsum %zd\n", minfo->crcsum );
 
 	// fill the string allocation with meta_info values
-   if ( snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd\n",
-                  MINFO_VER, minfo->N, minfo->E, minfo->O,
-                  minfo->partsz, minfo->versz,
-                  minfo->blocksz, minfo->crcsum,
-                  minfo->totsz) < 0 ) {
+   // NOTE -- uncompressed, crc32 blocks retain the version 1 format, so that they remain readable by older code
+   int ret;
+   if ( minfo->compsz > 0  ||  minfo->csum != CSUM_CRC32 ) {
+      ret = snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd %zd %d\n",
+                     MINFO_VER, minfo->N, minfo->E, minfo->O,
+                     minfo->partsz, minfo->versz,
+                     minfo->blocksz, minfo->crcsum,
+                     minfo->totsz, ( minfo->compsz > 0 ) ? minfo->compsz : 0,
+                     minfo->csum);
+   }
+   else {
+      ret = snprintf(str,strmax, "v%d %d %d %d %zd %zd %zd %llu %zd\n",
+                     1, minfo->N, minfo->E, minfo->O,
+                     minfo->partsz, minfo->versz,
+                     minfo->blocksz, minfo->crcsum,
+                     minfo->totsz);
+   }
+   if ( ret < 0 ) {
       LOG( LOG_ERR, "failed to convert meta_info to string format!\n" );
       free( str );
       return -1;
@@ -302,7 +359,7 @@ int dal_set_meta_helper( int (*meta_writer)(BLOCK_CTXT handle, const char *meta_
 
 
 /**
- * Duplicates info from one meta_info struct to another (excluding CRCSUM!)
+ * Duplicates info from one meta_info struct to another (excluding CRCSUM and COMPSZ!)
  * @param meta_info* target : Target struct reference
  * @param meta_info* source : Source struct reference
  */
@@ -317,7 +374,7 @@ void cpy_minfo( meta_info* target, meta_info* source ) {
 }
 
 /**
- * Compares the values of two meta_info structs (excluding CRCSUM!)
+ * Compares the values of two meta_info structs (excluding CRCSUM and COMPSZ!)
  * @param meta_info* minfo1 : First struct reference
  * @param meta_info* minfo2 : Second struct reference
  * @return int : A zero value if the structures match, non-zero otherwise
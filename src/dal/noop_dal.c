@@ -304,6 +304,8 @@ int noop_get_meta(BLOCK_CTXT ctxt, meta_info* dest )
    // Return cached metadata
    cpy_minfo(dest, &(bctxt->dctxt->minfo));
    dest->crcsum = bctxt->dctxt->minfo.crcsum; // manually copy crcsum, as it is excluded from the above call
+   dest->compsz = 0; // cached data is never compressed
+   dest->csum = CSUM_CRC32; // cached data is always protected by crc32_ieee
    return 0;
 }
 
@@ -325,6 +327,12 @@ int noop_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
    return 0;
 }
 
+int noop_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   // no data is stored, so this is identical to a single put
+   return noop_put(ctxt, NULL, 0);
+}
+
 ssize_t noop_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
 {
    if (ctxt == NULL)
@@ -462,13 +470,16 @@ DAL noop_dal_init(xmlNode *root, DAL_location max_loc)
    ndal->name = "noop";
    ndal->ctxt = (DAL_CTXT)dctxt;
    ndal->io_size = IO_SIZE;
+   ndal->io_depth = 0;
    ndal->verify = noop_verify;
    ndal->migrate = noop_migrate;
    ndal->open = noop_open;
    ndal->set_meta = noop_set_meta;
    ndal->get_meta = noop_get_meta;
    ndal->put = noop_put;
+   ndal->putv = noop_putv;
    ndal->get = noop_get;
+   ndal->getv = NULL; // each get() is served from a single cached buffer
    ndal->abort = noop_abort;
    ndal->close = noop_close;
    ndal->del = noop_del;
@@ -71,8 +71,15 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 
 #include "dal.h"
 #include "metainfo.h"
+#include "posix_uring.h"
 
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/xattr.h>
+#include <sys/ioctl.h>
+#ifdef HAVE_LINUX_FS_H
+#include <linux/fs.h> // for FICLONE
+#endif
 #include <fcntl.h>
 #include <errno.h>
 #include <pwd.h>
@@ -87,9 +94,19 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #define WRITE_SFX ".partial"   // 8 characters
 #define REBUILD_SFX ".rebuild" // 8 characters
 #define META_SFX ".meta"       // 5 characters (in ADDITION to other suffixes!)
+#define META_XATTR "user.ne.meta" // Name of the data file xattr holding meta info ( 'xattr' meta layout only )
 
 #define IO_SIZE 1048576 // Preferred I/O Size
 
+#define DIRECT_ALIGN 4096     // Alignment of buffers, offsets, and sizes of all O_DIRECT data IO
+#define DIRECT_BUFSZ 1048576  // Size of the staging buffer for unaligned O_DIRECT writes
+
+#define MIGRATE_CHUNK 1073741824 // Maximum bytes per copy_file_range() call during manual migration
+#define MIGRATE_BUFSZ 16777216   // Size of the user-space buffer for manual migrations which cannot be offloaded
+
+#define URING_ENTRIES 256 // Default io_uring queue depth ( 'posix_uring' DAL only )
+#define URING_FILES 1024  // Default number of io_uring fixed file slots ( 'posix_uring' DAL only )
+
 #define MAX_LOC_BUF 1048576 // Default Location Buffer Size
 
 #define REB_DIR "rebuild-" // For emergency rebuild
@@ -105,6 +122,14 @@ typedef struct posix_block_context_struct
    char *filepath; // File Path (if open)
    int filelen;    // Length of filepath string
    DAL_MODE mode;  // Mode in which this block was opened
+   POSIX_URING uring; // Shared io_uring instance for data IO (if any)
+   int fslot;         // Fixed file slot of our data FD within that io_uring (if any)
+   off_t woff;        // Offset of the next io_uring or O_DIRECT write
+   char direct;       // Data FD was opened with O_DIRECT, requiring aligned data IO
+   char *dbuf;        // Aligned staging buffer for unaligned O_DIRECT IO (if allocated)
+   size_t dbufsz;     // Allocated size of that buffer
+   size_t dfill;      // Bytes of write data staged in that buffer, but not yet written
+   char xattrmeta;    // Meta info is held by an xattr of the data file, unless a meta file is open
 } * POSIX_BLOCK_CTXT;
 
 typedef struct posix_dal_context_struct
@@ -116,6 +141,8 @@ typedef struct posix_dal_context_struct
    int sec_root;         // Handle of secure root directory
    int dataflags;        // Any additional flag values to be passed to open() of data files
    int metaflags;        // Any additional flag values to be passed to open() of meta files
+   char xattrmeta;       // Store meta info as an xattr of each data file, rather than as a separate meta file
+   POSIX_URING uring;    // Shared io_uring instance for data IO ( 'posix_uring' DAL only )
 } * POSIX_DAL_CTXT;
 
 /* For emergency rebuild. This indicates all the combinations of locations that either need to be rebuilt,
@@ -245,6 +272,364 @@ static int parse_open_flags( const char* flagstr, int* oflags ) {
    return 0;
 }
 
+/** (INTERNAL HELPER FUNCTION)
+ * Perform a single positioned data IO op for the given block, via io_uring if the block has one
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to perform IO for
+ * @param char write : Non-zero to write, zero to read
+ * @param const struct iovec* iov : Buffers to be written from / read into
+ * @param int iovcnt : Number of iovec entries
+ * @param off_t offset : Data file offset of the op
+ * @return ssize_t : Number of bytes transferred, or -1 on failure
+ */
+static ssize_t data_io(POSIX_BLOCK_CTXT bctxt, char write, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (bctxt->uring)
+   {
+      return posix_uring_io(bctxt->uring, write, bctxt->fd, bctxt->fslot, iov, iovcnt, offset);
+   }
+   if (write)
+   {
+      return pwritev(bctxt->fd, iov, iovcnt, offset);
+   }
+   return preadv(bctxt->fd, iov, iovcnt, offset);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Ensure that the O_DIRECT staging buffer of the given block is at least the given size
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to be updated
+ * @param size_t size : Minimum buffer size ( a multiple of DIRECT_ALIGN )
+ * @return int : Zero on success, or -1 on failure
+ */
+static int direct_buffer(POSIX_BLOCK_CTXT bctxt, size_t size)
+{
+   if (bctxt->dbufsz >= size)
+   {
+      return 0;
+   }
+   char *newbuf = NULL;
+   if (posix_memalign((void **)&newbuf, DIRECT_ALIGN, size))
+   {
+      LOG(LOG_ERR, "failed to allocate a %zu byte O_DIRECT staging buffer\n", size);
+      errno = ENOMEM;
+      return -1;
+   }
+   // preserve any staged write data
+   if (bctxt->dfill)
+   {
+      memcpy(newbuf, bctxt->dbuf, bctxt->dfill);
+   }
+   free(bctxt->dbuf);
+   bctxt->dbuf = newbuf;
+   bctxt->dbufsz = size;
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Write the given aligned buffer at the current O_DIRECT write offset of the given block
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to write to
+ * @param const char* buf : Buffer to be written ( aligned to DIRECT_ALIGN )
+ * @param size_t size : Number of bytes to be written ( a multiple of DIRECT_ALIGN )
+ * @return int : Zero on success, or -1 on failure
+ */
+static int direct_write(POSIX_BLOCK_CTXT bctxt, const char *buf, size_t size)
+{
+   while (size)
+   {
+      struct iovec iov = { .iov_base = (void *)buf, .iov_len = size };
+      ssize_t res = data_io(bctxt, 1, &iov, 1, bctxt->woff);
+      if (res <= 0)
+      {
+         LOG(LOG_ERR, "O_DIRECT write to offset %zd of \"%s\" failed (%s)\n", bctxt->woff, bctxt->filepath, (res) ? strerror(errno) : "no progress");
+         if (res == 0)
+         {
+            errno = EIO;
+         }
+         return -1;
+      }
+      // NOTE -- any short write will still have been of a multiple of the device block size
+      buf += res;
+      size -= res;
+      bctxt->woff += res;
+   }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Append the given buffers to a block opened with O_DIRECT.  Aligned spans of the caller's buffers are written
+ * directly, while any remainder is staged in an aligned buffer until a full DIRECT_BUFSZ span is available.
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to write to
+ * @param const struct iovec* iov : Buffers to be written
+ * @param int iovcnt : Number of iovec entries
+ * @return int : Zero on success, or -1 on failure
+ */
+static int direct_putv(POSIX_BLOCK_CTXT bctxt, const struct iovec *iov, int iovcnt)
+{
+   if (direct_buffer(bctxt, DIRECT_BUFSZ))
+   {
+      return -1;
+   }
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      const char *src = (const char *)iov[i].iov_base;
+      size_t len = iov[i].iov_len;
+      while (len)
+      {
+         // write aligned spans of caller data directly, so long as all staged data can be written ahead of them
+         if ((bctxt->dfill % DIRECT_ALIGN) == 0 && ((uintptr_t)src % DIRECT_ALIGN) == 0 && len >= DIRECT_ALIGN)
+         {
+            if (bctxt->dfill)
+            {
+               if (direct_write(bctxt, bctxt->dbuf, bctxt->dfill))
+               {
+                  return -1;
+               }
+               bctxt->dfill = 0;
+            }
+            size_t span = len - (len % DIRECT_ALIGN);
+            if (direct_write(bctxt, src, span))
+            {
+               return -1;
+            }
+            src += span;
+            len -= span;
+            continue;
+         }
+         // otherwise, stage data until we have a full buffer
+         size_t copy = DIRECT_BUFSZ - bctxt->dfill;
+         if (copy > len)
+         {
+            copy = len;
+         }
+         memcpy(bctxt->dbuf + bctxt->dfill, src, copy);
+         bctxt->dfill += copy;
+         src += copy;
+         len -= copy;
+         if (bctxt->dfill == DIRECT_BUFSZ)
+         {
+            if (direct_write(bctxt, bctxt->dbuf, DIRECT_BUFSZ))
+            {
+               return -1;
+            }
+            bctxt->dfill = 0;
+         }
+      }
+   }
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Write out all data staged for a block opened with O_DIRECT.  Any unaligned tail is written as a
+ * zero-padded, aligned span, and the data file is then truncated back to its true length.
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to flush
+ * @return int : Zero on success, or -1 on failure
+ */
+static int direct_flush(POSIX_BLOCK_CTXT bctxt)
+{
+   if (bctxt->dfill == 0)
+   {
+      return 0;
+   }
+   off_t datalen = bctxt->woff + bctxt->dfill;
+   size_t padlen = (DIRECT_ALIGN - (bctxt->dfill % DIRECT_ALIGN)) % DIRECT_ALIGN;
+   memset(bctxt->dbuf + bctxt->dfill, 0, padlen);
+   if (direct_write(bctxt, bctxt->dbuf, bctxt->dfill + padlen))
+   {
+      return -1;
+   }
+   bctxt->dfill = 0;
+   if (padlen && ftruncate(bctxt->fd, datalen))
+   {
+      LOG(LOG_ERR, "failed to truncate \"%s\" to its data length of %zd (%s)\n", bctxt->filepath, datalen, strerror(errno));
+      return -1;
+   }
+   bctxt->woff = datalen;
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Read from a block opened with O_DIRECT, landing data directly in the caller's memory.  This handles requests
+ * which begin at an aligned offset and an aligned buffer, where some buffers continue that first buffer in memory
+ * ( 'inline' ) while the rest lie entirely outside of the request's extent from it ( 'detached' ).  This is the
+ * layout of IO unit reads, which scatter the data of consecutive units contiguously while placing each of their
+ * CRCs aside.  All but the unaligned tail of the request is read straight into the inline region, with the tail
+ * staged separately.  Detached bytes are then copied out and inline bytes shifted back down into place.
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to read from
+ * @param const struct iovec* iov : Buffers to be read into
+ * @param int iovcnt : Number of iovec entries
+ * @param off_t offset : Data file offset to read from
+ * @param size_t size : Total length of all buffers
+ * @return ssize_t : Number of bytes read, -1 on failure, or -2 if the request does not suit this approach
+ */
+static ssize_t direct_getv_inplace(POSIX_BLOCK_CTXT bctxt, const struct iovec *iov, int iovcnt, off_t offset, size_t size)
+{
+   if ((offset % DIRECT_ALIGN) || ((uintptr_t)iov[0].iov_base % DIRECT_ALIGN))
+   {
+      return -2;
+   }
+   char *region = (char *)iov[0].iov_base;
+   size_t inlinelen = 0; // length of the contiguous region formed by all inline buffers
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      char *base = (char *)iov[i].iov_base;
+      if (base == region + inlinelen)
+      {
+         inlinelen += iov[i].iov_len;
+      }
+      else if (base < region + size && base + iov[i].iov_len > region)
+      {
+         return -2; // a detached buffer overlapping our read target would be clobbered
+      }
+   }
+   // read as much as we can into the inline region, staging only the remaining tail
+   size_t direct = inlinelen - (inlinelen % DIRECT_ALIGN);
+   if (direct == 0 || size - direct > DIRECT_BUFSZ)
+   {
+      return -2;
+   }
+   size_t staged = size - direct;
+   staged += (DIRECT_ALIGN - (staged % DIRECT_ALIGN)) % DIRECT_ALIGN;
+   if (staged && direct_buffer(bctxt, staged))
+   {
+      return -1;
+   }
+   struct iovec span[2] = {
+      { .iov_base = region, .iov_len = direct },
+      { .iov_base = bctxt->dbuf, .iov_len = staged }
+   };
+   ssize_t res = data_io(bctxt, 0, span, (staged) ? 2 : 1, offset);
+   if (res < 0)
+   {
+      return -1;
+   }
+   size_t avail = ((size_t)res > size) ? size : (size_t)res;
+   // move each buffer's bytes into place, in order
+   //  NOTE -- Inline buffers only ever shift toward the start of the region, by the total length of any detached
+   //          buffers preceding them, so no byte is overwritten before it has been moved.
+   size_t pos = 0;
+   for (i = 0; i < iovcnt && pos < avail; i++)
+   {
+      char *dest = (char *)iov[i].iov_base;
+      size_t len = iov[i].iov_len;
+      if (len > avail - pos)
+      {
+         len = avail - pos;
+      }
+      if (pos < direct)
+      {
+         size_t part = (len > direct - pos) ? direct - pos : len;
+         if (dest != region + pos)
+         {
+            memmove(dest, region + pos, part);
+         }
+         dest += part;
+         pos += part;
+         len -= part;
+      }
+      if (len)
+      {
+         memcpy(dest, bctxt->dbuf + (pos - direct), len);
+         pos += len;
+      }
+   }
+   return avail;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Read from a block opened with O_DIRECT.  Requests that do not meet O_DIRECT alignment requirements are
+ * read, where possible, directly into the contiguous memory region formed by their leading buffers and then
+ * rearranged in place ( see direct_getv_inplace() ).  Otherwise, the enclosing aligned span is read into a
+ * staging buffer and copied out.
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to read from
+ * @param const struct iovec* iov : Buffers to be read into
+ * @param int iovcnt : Number of iovec entries
+ * @param off_t offset : Data file offset to read from
+ * @return ssize_t : Number of bytes read, or -1 on failure
+ */
+static ssize_t direct_getv(POSIX_BLOCK_CTXT bctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   size_t size = 0;
+   char aligned = ((offset % DIRECT_ALIGN) == 0);
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      size += iov[i].iov_len;
+      if (((uintptr_t)iov[i].iov_base % DIRECT_ALIGN) || (iov[i].iov_len % DIRECT_ALIGN))
+      {
+         aligned = 0;
+      }
+   }
+   // read directly into caller buffers, whenever they allow it
+   if (aligned)
+   {
+      return data_io(bctxt, 0, iov, iovcnt, offset);
+   }
+   ssize_t res = direct_getv_inplace(bctxt, iov, iovcnt, offset, size);
+   if (res != -2)
+   {
+      return res;
+   }
+   off_t spanstart = offset - (offset % DIRECT_ALIGN);
+   size_t lead = offset - spanstart;
+   size_t spanlen = lead + size;
+   spanlen += (DIRECT_ALIGN - (spanlen % DIRECT_ALIGN)) % DIRECT_ALIGN;
+   if (direct_buffer(bctxt, spanlen))
+   {
+      return -1;
+   }
+   struct iovec span = { .iov_base = bctxt->dbuf, .iov_len = spanlen };
+   res = data_io(bctxt, 0, &span, 1, spanstart);
+   if (res < 0)
+   {
+      return -1;
+   }
+   // copy out whatever portion of the request was read
+   size_t avail = (res > lead) ? (res - lead) : 0;
+   if (avail > size)
+   {
+      avail = size;
+   }
+   size_t copied = 0;
+   for (i = 0; i < iovcnt && copied < avail; i++)
+   {
+      size_t copy = avail - copied;
+      if (copy > iov[i].iov_len)
+      {
+         copy = iov[i].iov_len;
+      }
+      memcpy(iov[i].iov_base, bctxt->dbuf + lead + copied, copy);
+      copied += copy;
+   }
+   return avail;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Open the separate meta file of a block for reading, as written by the original ( 'file' ) meta layout
+ * @param POSIX_BLOCK_CTXT bctxt : Block context to open the meta file of
+ * @param int oflags : Any additional open() flags for the meta file
+ * @return int : Zero on success, or -1 on failure
+ */
+static int open_meta_file(POSIX_BLOCK_CTXT bctxt, int oflags)
+{
+   // append the meta suffix and check for success
+   char *res = strncat(bctxt->filepath + bctxt->filelen, META_SFX, SFX_PADDING);
+   if (res != (bctxt->filepath + bctxt->filelen))
+   {
+      LOG(LOG_ERR, "failed to append meta suffix \"%s\" to file path!\n", META_SFX);
+      errno = EBADF;
+      return -1;
+   }
+   bctxt->mfd = openat(bctxt->sfd, bctxt->filepath, O_RDONLY | oflags);
+   if (bctxt->mfd < 0)
+   {
+      LOG(LOG_ERR, "failed to open meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+   }
+   // remove the suffix in the simplest possible manner
+   *(bctxt->filepath + bctxt->filelen) = '\0';
+   return (bctxt->mfd < 0) ? -1 : 0;
+}
+
 static char *expand_path(const char *parse, char *fill, DAL_location loc, DAL_location *loc_flags, int dir)
 {
    char escp = 0;
@@ -857,6 +1242,17 @@ int posix_set_meta_internal(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
+   // attach the provided buffer to the data file itself, if using that layout
+   if (bctxt->xattrmeta)
+   {
+      if (fsetxattr(bctxt->fd, META_XATTR, meta_buf, size, 0))
+      {
+         LOG(LOG_ERR, "failed to set meta xattr of data file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+         return -1;
+      }
+      return 0;
+   }
+
    // reseek to the start of the sidecar file
    if ( lseek( bctxt->mfd, 0, SEEK_SET ) ) {
       LOG( LOG_ERR, "failed to reseek to start of meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno) );
@@ -888,6 +1284,32 @@ ssize_t posix_get_meta_internal(BLOCK_CTXT ctxt, char *meta_buf, size_t size)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
+   // check for meta info attached to the data file itself, if using that layout
+   if (bctxt->xattrmeta && bctxt->mfd < 0)
+   {
+      ssize_t result = fgetxattr(bctxt->fd, META_XATTR, meta_buf, size);
+      if (result < 0 && errno == ERANGE)
+      {
+         // indicate the total meta info size
+         result = fgetxattr(bctxt->fd, META_XATTR, NULL, 0);
+      }
+      if (result >= 0)
+      {
+         return result;
+      }
+      if (errno != ENODATA && errno != ENOTSUP)
+      {
+         LOG(LOG_ERR, "failed to get meta xattr of data file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+         return -1;
+      }
+      // blocks written with the original layout keep their meta info in a separate file
+      LOG(LOG_INFO, "data file \"%s\" lacks a meta xattr, falling back to its meta file\n", bctxt->filepath);
+      if (open_meta_file(bctxt, 0))
+      {
+         return -1;
+      }
+   }
+
    // reseek to the start of the sidecar file
    if ( lseek( bctxt->mfd, 0, SEEK_SET ) ) {
       LOG( LOG_ERR, "failed to reseek to start of meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno) );
@@ -918,10 +1340,61 @@ int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size);
 
 ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset);
 
+ssize_t posix_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset);
+
 int posix_abort(BLOCK_CTXT ctxt);
 
 int posix_close(BLOCK_CTXT ctxt);
 
+/** (INTERNAL HELPER FUNCTION)
+ * Copy the data file of one open block to another without transiting user space, first via copy_file_range()
+ * ( which the filesystem may itself offload to its servers ), and then via a FICLONE reflink
+ * @param POSIX_BLOCK_CTXT src_ctxt : Block context to copy from ( opened for DAL_READ )
+ * @param POSIX_BLOCK_CTXT dest_ctxt : Block context to copy to ( freshly opened for DAL_WRITE )
+ * @return int : Zero on success, 1 if neither method is supported for these files ( the destination is left
+ *               empty ), or -1 on failure
+ */
+static int offload_copy(POSIX_BLOCK_CTXT src_ctxt, POSIX_BLOCK_CTXT dest_ctxt)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+   loff_t inoff = 0;
+   loff_t outoff = 0;
+   ssize_t res;
+   while ((res = copy_file_range(src_ctxt->fd, &inoff, dest_ctxt->fd, &outoff, MIGRATE_CHUNK, 0)) > 0) {}
+   if (res == 0)
+   {
+      LOG(LOG_INFO, "Copied %zd bytes from \"%s\" via copy_file_range()\n", outoff, src_ctxt->filepath);
+      return 0;
+   }
+   if (errno != EXDEV && errno != ENOSYS && errno != EOPNOTSUPP && errno != EINVAL)
+   {
+      LOG(LOG_ERR, "copy_file_range() from \"%s\" failed (%s)\n", src_ctxt->filepath, strerror(errno));
+      return -1;
+   }
+   LOG(LOG_INFO, "copy_file_range() is unsupported for \"%s\" (%s)\n", src_ctxt->filepath, strerror(errno));
+   // discard any partial copy
+   if (outoff && ftruncate(dest_ctxt->fd, 0))
+   {
+      LOG(LOG_ERR, "failed to truncate partial copy of \"%s\" (%s)\n", src_ctxt->filepath, strerror(errno));
+      return -1;
+   }
+#endif
+#ifdef FICLONE
+   if (ioctl(dest_ctxt->fd, FICLONE, src_ctxt->fd) == 0)
+   {
+      LOG(LOG_INFO, "Reflinked \"%s\" via FICLONE\n", src_ctxt->filepath);
+      return 0;
+   }
+   if (errno != EXDEV && errno != EOPNOTSUPP && errno != EINVAL && errno != ENOTTY)
+   {
+      LOG(LOG_ERR, "FICLONE of \"%s\" failed (%s)\n", src_ctxt->filepath, strerror(errno));
+      return -1;
+   }
+   LOG(LOG_INFO, "FICLONE is unsupported for \"%s\" (%s)\n", src_ctxt->filepath, strerror(errno));
+#endif
+   return 1;
+}
+
 /** (INTERNAL HELPER FUNCTION)
  * Attempt to manually migrate an object from one location to another using put/get/set_meta/get_meta dal functions..
  * @param POSIX_DAL_CTXT dctxt : Context reference of the current POSIX DAL
@@ -933,16 +1406,11 @@ int posix_close(BLOCK_CTXT ctxt);
  */
 int manual_migrate(POSIX_DAL_CTXT dctxt, const char *objID, DAL_location src, DAL_location dest)
 {
-   // allocate buffers to transfer between locations
-   void *data_buf = malloc(IO_SIZE);
-   if (data_buf == NULL)
-   {
-      return -1;
-   }
+   // allocate a buffer to transfer meta info between locations ( data is only buffered if it must be )
+   void *data_buf = NULL;
    char *meta_buf = malloc(IO_SIZE);
    if (meta_buf == NULL)
    {
-      free(data_buf);
       return -1;
    }
 
@@ -963,12 +1431,32 @@ int manual_migrate(POSIX_DAL_CTXT dctxt, const char *objID, DAL_location src, DA
       return -1;
    }
 
-   // move data file from source location to destination location
-   ssize_t res;
+   // move data file from source location to destination location, preferably without passing through this host
+   int offload = offload_copy(src_ctxt, dest_ctxt);
+   if (offload < 0)
+   {
+      posix_abort((BLOCK_CTXT)src_ctxt);
+      block_delete(dest_ctxt, 0);  // delete any in-progress output
+      posix_abort((BLOCK_CTXT)dest_ctxt);
+      free(meta_buf);
+      return -1;
+   }
+   // otherwise, fall back to a large, aligned ( and so O_DIRECT friendly ) buffered copy
+   if (offload > 0 && posix_memalign(&data_buf, DIRECT_ALIGN, MIGRATE_BUFSZ))
+   {
+      LOG(LOG_ERR, "failed to allocate a %d byte migration buffer\n", MIGRATE_BUFSZ);
+      posix_abort((BLOCK_CTXT)src_ctxt);
+      block_delete(dest_ctxt, 0);  // delete any in-progress output
+      posix_abort((BLOCK_CTXT)dest_ctxt);
+      free(meta_buf);
+      errno = ENOMEM;
+      return -1;
+   }
+   ssize_t res = 0;
    off_t off = 0;
-   do
+   while (offload > 0)
    {
-      res = posix_get((BLOCK_CTXT)src_ctxt, data_buf, IO_SIZE, off);
+      res = posix_get((BLOCK_CTXT)src_ctxt, data_buf, MIGRATE_BUFSZ, off);
       if (res < 0)
       {
          posix_abort((BLOCK_CTXT)src_ctxt);
@@ -988,7 +1476,11 @@ int manual_migrate(POSIX_DAL_CTXT dctxt, const char *objID, DAL_location src, DA
          free(meta_buf);
          return -1;
       }
-   } while (res > 0);
+      if (res == 0)
+      {
+         break;
+      }
+   }
 
    // move meta file from source location to destination location
    res = posix_get_meta_internal((BLOCK_CTXT)src_ctxt, meta_buf, IO_SIZE);
@@ -1373,7 +1865,9 @@ int posix_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_locati
 
       int ret = 0;
       // attempt to link meta and check for success
-      if (linkat(dctxt->sec_root, src_meta_path, dctxt->sec_root, dest_meta_path, 0))
+      //  NOTE -- with the 'xattr' meta layout, the data file link will have carried the meta info along
+      if (linkat(dctxt->sec_root, src_meta_path, dctxt->sec_root, dest_meta_path, 0)  &&
+          !(dctxt->xattrmeta  &&  errno == ENOENT))
       {
          LOG(LOG_ERR, "failed to link meta file \"%s\" to \"%s\" (%s)\n", src_meta_path, dest_meta_path, strerror(errno));
          if (unlinkat(dctxt->sec_root, destctxt->filepath, 0))
@@ -1401,7 +1895,7 @@ int posix_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_locati
       }
 
       // attempt to unlink meta and check for success
-      if (unlinkat(dctxt->sec_root, src_meta_path, 0))
+      if (unlinkat(dctxt->sec_root, src_meta_path, 0)  &&  !(dctxt->xattrmeta  &&  errno == ENOENT))
       {
          LOG(LOG_ERR, "failed to unlink source meta file \"%s\" to (%s)\n", src_meta_path, strerror(errno));
          ret = 1;
@@ -1579,6 +2073,7 @@ int posix_cleanup(DAL dal)
    POSIX_DAL_CTXT dctxt = (POSIX_DAL_CTXT)dal->ctxt; // should have been passed a posix context
 
    // free DAL context state
+   if ( dctxt->uring ) { posix_uring_destroy( dctxt->uring ); }
    if ( dctxt->sec_root > 0 ) { close( dctxt->sec_root ); }
    free(dctxt->dirtmp);
    free(dctxt);
@@ -1603,6 +2098,8 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
       LOG( LOG_ERR, "Failed to allocate a new block ctxt struct\n" );
       return NULL;
    } // calloc will set errno
+   bctxt->fslot = -1;
+   bctxt->xattrmeta = dctxt->xattrmeta;
 
    // popultate the full file path for this object
    if (expand_dir_template(dctxt, bctxt, location, objID) != 0)
@@ -1664,21 +2161,29 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
 
    // open the meta file and check for success
    mode_t mask = umask(0);
-   bctxt->mfd = openat(dctxt->sec_root, bctxt->filepath, oflags | dctxt->metaflags, S_IRWXU | S_IRWXG | S_IRWXO); // mode arg should be harmlessly ignored if reading
-   if (bctxt->mfd < 0  &&  errno == EEXIST  &&  mode != DAL_READ  &&  mode != DAL_METAREAD ) {
-      // specifically for a write EEXIST error, unlink the dest path and retry once
-      unlinkat( dctxt->sec_root, bctxt->filepath, 0 ); // don't bother checking for this failure, only the open result matters
-      bctxt->mfd = openat(dctxt->sec_root, bctxt->filepath, oflags | dctxt->metaflags, S_IRWXU | S_IRWXG | S_IRWXO);
+   if (bctxt->xattrmeta)
+   {
+      // meta info is held by the data file itself
+      bctxt->mfd = -1;
    }
-   if (bctxt->mfd < 0)
+   else
    {
-      LOG(LOG_ERR, "failed to open meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
-      if (mode == DAL_METAREAD)
+      bctxt->mfd = openat(dctxt->sec_root, bctxt->filepath, oflags | dctxt->metaflags, S_IRWXU | S_IRWXG | S_IRWXO); // mode arg should be harmlessly ignored if reading
+      if (bctxt->mfd < 0  &&  errno == EEXIST  &&  mode != DAL_READ  &&  mode != DAL_METAREAD ) {
+         // specifically for a write EEXIST error, unlink the dest path and retry once
+         unlinkat( dctxt->sec_root, bctxt->filepath, 0 ); // don't bother checking for this failure, only the open result matters
+         bctxt->mfd = openat(dctxt->sec_root, bctxt->filepath, oflags | dctxt->metaflags, S_IRWXU | S_IRWXG | S_IRWXO);
+      }
+      if (bctxt->mfd < 0)
       {
-         umask(mask);
-         free(bctxt->filepath);
-         free(bctxt);
-         return NULL;
+         LOG(LOG_ERR, "failed to open meta file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
+         if (mode == DAL_METAREAD)
+         {
+            umask(mask);
+            free(bctxt->filepath);
+            free(bctxt);
+            return NULL;
+         }
       }
    }
    // remove any suffix in the simplest possible manner
@@ -1717,12 +2222,36 @@ BLOCK_CTXT posix_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
       if (bctxt->fd < 0  &&  errno == EEXIST  &&  mode != DAL_READ ) {
          // specifically for a write EEXIST error, unlink the dest path and retry once
          unlinkat( dctxt->sec_root, bctxt->filepath, 0 ); // don't bother checking for this failure, only the open result matters
-         bctxt->fd = openat(dctxt->sec_root, bctxt->filepath, oflags | dctxt->metaflags, S_IRWXU | S_IRWXG | S_IRWXO);
+         bctxt->fd = openat(dctxt->sec_root, bctxt->filepath, oflags | dctxt->dataflags, S_IRWXU | S_IRWXG | S_IRWXO);
       }
       if (bctxt->fd < 0)
       {
          LOG(LOG_ERR, "failed to open file: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
-         close(bctxt->mfd);
+         if (bctxt->mfd >= 0) { close(bctxt->mfd); }
+         umask(mask);
+         free(bctxt->filepath);
+         free(bctxt);
+         return NULL;
+      }
+      // issue all data IO through our shared io_uring, if we have one
+      if (dctxt->uring)
+      {
+         bctxt->uring = dctxt->uring;
+         bctxt->fslot = posix_uring_register(dctxt->uring, bctxt->fd);
+      }
+      // O_DIRECT data IO must be aligned, so track our own write offset for staged writes
+      if (dctxt->dataflags & O_DIRECT)
+      {
+         bctxt->direct = 1;
+      }
+   }
+   else if (bctxt->xattrmeta)
+   {
+      // meta info is held by the data file, unless this block was written with the original layout
+      bctxt->fd = openat(dctxt->sec_root, bctxt->filepath, O_RDONLY | dctxt->metaflags);
+      if (bctxt->fd < 0  &&  (errno != ENOENT  ||  open_meta_file(bctxt, dctxt->metaflags)))
+      {
+         LOG(LOG_ERR, "failed to open file for meta access: \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
          umask(mask);
          free(bctxt->filepath);
          free(bctxt);
@@ -1758,6 +2287,12 @@ int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
+   if (bctxt->direct)
+   {
+      struct iovec iov = { .iov_base = (void *)buf, .iov_len = size };
+      return direct_putv(bctxt, &iov, 1);
+   }
+
    // just a write to our pre-opened FD
    if (write(bctxt->fd, buf, size) != size)
    {
@@ -1768,6 +2303,38 @@ int posix_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
    return 0;
 }
 
+int posix_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   if (bctxt->direct)
+   {
+      return direct_putv(bctxt, iov, iovcnt);
+   }
+
+   // calculate the total size of this write
+   size_t size = 0;
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      size += iov[i].iov_len;
+   }
+
+   // just a writev to our pre-opened FD
+   if (writev(bctxt->fd, iov, iovcnt) != size)
+   {
+      LOG(LOG_ERR, "writev to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+
+   return 0;
+}
+
 ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
 {
    if (ctxt == NULL)
@@ -1784,22 +2351,122 @@ ssize_t posix_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
       return -1;
    }
 
-   // always reseek ( minimal performance impact and a bit more explicitly safe )
-   LOG(LOG_INFO, "Performing seek to offset of %zd\n", offset);
-   off_t newoff = lseek(bctxt->fd, offset, SEEK_SET);
-   // make sure our new offset makes sense
-   if (newoff != offset)
+   ssize_t res;
+   if (bctxt->direct)
+   {
+      struct iovec iov = { .iov_base = buf, .iov_len = size };
+      res = direct_getv(bctxt, &iov, 1, offset);
+   }
+   else
+   {
+      // positioned read from our pre-opened FD ( no need for a separate seek )
+      res = pread(bctxt->fd, buf, size, offset);
+   }
+   if (res < 0)
+   {
+      LOG(LOG_ERR, "failed to read from offset %zd of file \"%s\" (%s)\n", offset, bctxt->filepath, strerror(errno));
+   }
+
+   return res;
+}
+
+ssize_t posix_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // abort, unless we're reading
+   if (bctxt->mode != DAL_READ)
+   {
+      LOG(LOG_ERR, "Can only perform get ops on a DAL_READ block handle!\n");
+      return -1;
+   }
+
+   // positioned, vectored read from our pre-opened FD
+   ssize_t res = (bctxt->direct) ? direct_getv(bctxt, iov, iovcnt, offset) : preadv(bctxt->fd, iov, iovcnt, offset);
+   if (res < 0)
+   {
+      LOG(LOG_ERR, "failed to read from offset %zd of file \"%s\" (%s)\n", offset, bctxt->filepath, strerror(errno));
+   }
+
+   return res;
+}
+
+int posix_uring_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   if (bctxt->direct)
+   {
+      return direct_putv(bctxt, iov, iovcnt);
+   }
+
+   // calculate the total size of this write
+   size_t size = 0;
+   int i;
+   for (i = 0; i < iovcnt; i++)
+   {
+      size += iov[i].iov_len;
+   }
+
+   // submit via our io_uring, at our own tracked offset
+   if (posix_uring_io(bctxt->uring, 1, bctxt->fd, bctxt->fslot, iov, iovcnt, bctxt->woff) != size)
+   {
+      LOG(LOG_ERR, "io_uring write to \"%s\" failed (%s)\n", bctxt->filepath, strerror(errno));
+      return -1;
+   }
+   bctxt->woff += size;
+
+   return 0;
+}
+
+int posix_uring_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
+{
+   struct iovec iov = { .iov_base = (void*)buf, .iov_len = size };
+   return posix_uring_putv(ctxt, &iov, 1);
+}
+
+ssize_t posix_uring_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      return -1;
+   }
+   POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
+
+   // abort, unless we're reading
+   if (bctxt->mode != DAL_READ)
    {
-      LOG(LOG_ERR, "failed to seek to offset %zd of file \"%s\" (%s)\n", offset, bctxt->filepath, strerror(errno));
+      LOG(LOG_ERR, "Can only perform get ops on a DAL_READ block handle!\n");
       return -1;
    }
 
-   // just a read from our pre-opened FD
-   ssize_t res = read(bctxt->fd, buf, size);
+   // submit via our io_uring
+   ssize_t res = (bctxt->direct) ? direct_getv(bctxt, iov, iovcnt, offset) : posix_uring_io(bctxt->uring, 0, bctxt->fd, bctxt->fslot, iov, iovcnt, offset);
+   if (res < 0)
+   {
+      LOG(LOG_ERR, "io_uring read from offset %zd of file \"%s\" failed (%s)\n", offset, bctxt->filepath, strerror(errno));
+   }
 
    return res;
 }
 
+ssize_t posix_uring_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
+{
+   struct iovec iov = { .iov_base = buf, .iov_len = size };
+   return posix_uring_getv(ctxt, &iov, 1, offset);
+}
+
 int posix_abort(BLOCK_CTXT ctxt)
 {
    if (ctxt == NULL)
@@ -1810,17 +2477,22 @@ int posix_abort(BLOCK_CTXT ctxt)
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
    int retval = 0;
+   if (bctxt->uring)
+   {
+      posix_uring_unregister(bctxt->uring, bctxt->fslot);
+   }
    // close the file descriptor, note but bypass failure
-   if (close(bctxt->fd) != 0)
+   if (bctxt->fd >= 0 && close(bctxt->fd) != 0)
    {
       LOG(LOG_WARNING, "failed to close data file \"%s\" during abort (%s)\n", bctxt->filepath, strerror(errno));
    }
-   if (close(bctxt->mfd) != 0)
+   if (bctxt->mfd >= 0 && close(bctxt->mfd) != 0)
    {
       LOG(LOG_WARNING, "failed to close meta file \"%s%s\" during abort (%s)\n", bctxt->filepath, META_SFX, strerror(errno));
    }
 
    // free state
+   free(bctxt->dbuf);
    free(bctxt->filepath);
    free(bctxt);
    return retval;
@@ -1835,15 +2507,25 @@ int posix_close(BLOCK_CTXT ctxt)
    }
    POSIX_BLOCK_CTXT bctxt = (POSIX_BLOCK_CTXT)ctxt; // should have been passed a posix context
 
-   // if this is not a meta-only reference, attempt to close our FD and check for success
-   if ((bctxt->mode != DAL_METAREAD) && (close(bctxt->fd) != 0))
+   // write out any data still staged for O_DIRECT
+   if (bctxt->direct && direct_flush(bctxt))
+   {
+      LOG(LOG_ERR, "failed to write out staged data of \"%s\"\n", bctxt->filepath);
+      return -1;
+   }
+   if (bctxt->uring)
+   {
+      posix_uring_unregister(bctxt->uring, bctxt->fslot);
+   }
+   // if we hold a data FD ( not true of most meta-only references ), attempt to close it and check for success
+   if ((bctxt->fd >= 0) && (close(bctxt->fd) != 0))
    {
       LOG(LOG_ERR, "failed to close data file \"%s\" (%s)\n", bctxt->filepath, strerror(errno));
       return -1;
    }
 
-   // attempt to close our meta FD and check for success
-   if (close(bctxt->mfd))
+   // attempt to close any meta FD and check for success
+   if ((bctxt->mfd >= 0) && close(bctxt->mfd))
    {
       LOG(LOG_ERR, "failed to close meta file \"%s%s\" (%s)\n", bctxt->filepath, META_SFX, strerror(errno));
       return -1;
@@ -1884,49 +2566,54 @@ int posix_close(BLOCK_CTXT ctxt)
       }
       free(write_path);
 
-      // append the meta suffix and check for success
-      res = strncat(bctxt->filepath + bctxt->filelen, META_SFX, SFX_PADDING);
-      if (res != (bctxt->filepath + bctxt->filelen))
+      // with the 'xattr' meta layout, renaming the data file has also published our meta info
+      if (!(bctxt->xattrmeta))
       {
-         LOG(LOG_ERR, "failed to append meta suffix \"%s\" to file path!\n", META_SFX);
-         errno = EBADF;
-         return -1;
-      }
+         // append the meta suffix and check for success
+         res = strncat(bctxt->filepath + bctxt->filelen, META_SFX, SFX_PADDING);
+         if (res != (bctxt->filepath + bctxt->filelen))
+         {
+            LOG(LOG_ERR, "failed to append meta suffix \"%s\" to file path!\n", META_SFX);
+            errno = EBADF;
+            return -1;
+         }
 
-      int metalen = strlen(META_SFX);
+         int metalen = strlen(META_SFX);
 
-      // append the proper suffix and check for success
-      if (bctxt->mode == DAL_WRITE)
-      {
-         res = strncat(bctxt->filepath + bctxt->filelen + metalen, WRITE_SFX, SFX_PADDING - metalen);
-      }
-      if (bctxt->mode == DAL_REBUILD)
-      {
-         res = strncat(bctxt->filepath + bctxt->filelen + metalen, REBUILD_SFX, SFX_PADDING - metalen);
-      }
-      if (res != (bctxt->filepath + bctxt->filelen + metalen))
-      {
-         LOG(LOG_ERR, "failed to append write suffix \"%s\" to file path!\n", WRITE_SFX);
-         errno = EBADF;
-         *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
-         return -1;
-      }
+         // append the proper suffix and check for success
+         if (bctxt->mode == DAL_WRITE)
+         {
+            res = strncat(bctxt->filepath + bctxt->filelen + metalen, WRITE_SFX, SFX_PADDING - metalen);
+         }
+         if (bctxt->mode == DAL_REBUILD)
+         {
+            res = strncat(bctxt->filepath + bctxt->filelen + metalen, REBUILD_SFX, SFX_PADDING - metalen);
+         }
+         if (res != (bctxt->filepath + bctxt->filelen + metalen))
+         {
+            LOG(LOG_ERR, "failed to append write suffix \"%s\" to file path!\n", WRITE_SFX);
+            errno = EBADF;
+            *(bctxt->filepath + bctxt->filelen) = '\0'; // make sure no suffix remains
+            return -1;
+         }
 
-      // duplicate the path and check for success
-      char *meta_path = strdup(bctxt->filepath);
-      *(bctxt->filepath + bctxt->filelen + metalen) = '\0'; // make sure no suffix remains
+         // duplicate the path and check for success
+         char *meta_path = strdup(bctxt->filepath);
+         *(bctxt->filepath + bctxt->filelen + metalen) = '\0'; // make sure no suffix remains
 
-      // attempt to rename and check for success
-      if (renameat(bctxt->sfd, meta_path, bctxt->sfd, bctxt->filepath) != 0)
-      {
-         LOG(LOG_ERR, "failed to rename meta file \"%s\" to \"%s\" (%s)\n", meta_path, bctxt->filepath, strerror(errno));
+         // attempt to rename and check for success
+         if (renameat(bctxt->sfd, meta_path, bctxt->sfd, bctxt->filepath) != 0)
+         {
+            LOG(LOG_ERR, "failed to rename meta file \"%s\" to \"%s\" (%s)\n", meta_path, bctxt->filepath, strerror(errno));
+            free(meta_path);
+            return -1;
+         }
          free(meta_path);
-         return -1;
       }
-      free(meta_path);
    }
 
    // free state
+   free(bctxt->dbuf);
    free(bctxt->filepath);
    free(bctxt);
    return 0;
@@ -1934,7 +2621,15 @@ int posix_close(BLOCK_CTXT ctxt)
 
 //   -------------    POSIX INITIALIZATION    -------------
 
-DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
+/** (INTERNAL HELPER FUNCTION)
+ * Initialize a POSIX DAL from the given config
+ * @param xmlNode* root : First child node of the DAL config
+ * @param DAL_location max_loc : Maximum pod/cap/block/scatter values
+ * @param xmlNode** uring_conf : Reference to be populated with any 'uring' config element
+ *                               ( NULL if such an element should be rejected )
+ * @return DAL : The new DAL, or NULL on failure
+ */
+static DAL posix_dal_setup(xmlNode *root, DAL_location max_loc, xmlNode **uring_conf)
 {
    // first, calculate the number of digits required for pod/cap/block/scatter
    int d_pod = num_digits(max_loc.pod);
@@ -1978,6 +2673,8 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
    dctxt->sec_root = AT_FDCWD;
    dctxt->dataflags = 0;
    dctxt->metaflags = 0;
+   dctxt->xattrmeta = 0;
+   dctxt->uring = NULL;
    size_t io_size = IO_SIZE;
 
    int origerrno = errno;
@@ -2091,6 +2788,24 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
             }
             else if ( strncasecmp( (char*)attr->name, "metaflags", 10 ) == 0 ) {
                if ( parse_open_flags( (const char*)attr->children->content, &(dctxt->metaflags) ) ) { break; }
+               // meta files are small and unaligned, so only data files support O_DIRECT
+               if ( dctxt->metaflags & O_DIRECT ) {
+                  LOG( LOG_ERR, "POSIX DAL 'io' metaflags may not include O_DIRECT\n" );
+                  break;
+               }
+            }
+            else if ( strncasecmp( (char*)attr->name, "meta", 5 ) == 0 ) {
+               // select the layout of newly written meta info ( meta files of the original layout remain readable )
+               if ( strncasecmp( (char*)attr->children->content, "xattr", 6 ) == 0 ) {
+                  dctxt->xattrmeta = 1;
+               }
+               else if ( strncasecmp( (char*)attr->children->content, "file", 5 ) == 0 ) {
+                  dctxt->xattrmeta = 0;
+               }
+               else {
+                  LOG( LOG_ERR, "Invalid POSIX DAL 'io' meta value ( expected 'file' or 'xattr' ): \"%s\"\n", (char*)attr->children->content );
+                  break;
+               }
             }
             else {
                LOG( LOG_ERR, "Encountered an unrecognized \"%s\" property of POSIX DAL 'io' definition\n", (char*)attr->name );
@@ -2104,6 +2819,10 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
             return NULL;
          }
       }
+      else if ( uring_conf  &&  root->type == XML_ELEMENT_NODE  &&  strncmp((char *)root->name, "uring", 6) == 0 ) {
+         // leave parsing of io_uring settings to our caller
+         *uring_conf = root;
+      }
       else {
          LOG( LOG_ERR, "Encountered unrecognized config element: \"%s\"\n", (char *)root->name );
          if ( dctxt->sec_root > 0 ) { close( dctxt->sec_root ); }
@@ -2144,13 +2863,16 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
    pdal->name = "posix";
    pdal->ctxt = (DAL_CTXT)dctxt;
    pdal->io_size = io_size;
+   pdal->io_depth = 0;
    pdal->verify = posix_verify;
    pdal->migrate = posix_migrate;
    pdal->open = posix_open;
    pdal->set_meta = posix_set_meta;
    pdal->get_meta = posix_get_meta;
    pdal->put = posix_put;
+   pdal->putv = posix_putv;
    pdal->get = posix_get;
+   pdal->getv = posix_getv;
    pdal->abort = posix_abort;
    pdal->close = posix_close;
    pdal->del = posix_del;
@@ -2158,6 +2880,90 @@ DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
    pdal->cleanup = posix_cleanup;
    errno = origerrno; // cleanup errno
    return pdal;
+}
+
+DAL posix_dal_init(xmlNode *root, DAL_location max_loc)
+{
+   return posix_dal_setup(root, max_loc, NULL);
+}
+
+DAL posix_uring_dal_init(xmlNode *root, DAL_location max_loc)
+{
+   xmlNode *uring_conf = NULL;
+   DAL pdal = posix_dal_setup(root, max_loc, &uring_conf);
+   if (pdal == NULL)
+   {
+      return NULL;
+   }
 
+   // parse any io_uring settings
+   unsigned int entries = URING_ENTRIES;
+   unsigned int files = URING_FILES;
+   char sqpoll = 0;
+   xmlAttr *attr = (uring_conf) ? uring_conf->properties : NULL;
+   for ( ; attr; attr = attr->next)
+   {
+      if (attr->type != XML_ATTRIBUTE_NODE || attr->children == NULL || attr->children->type != XML_TEXT_NODE || attr->children->content == NULL)
+      {
+         LOG(LOG_ERR, "Encountered an unrecognized property of POSIX DAL 'uring' definition\n");
+         break;
+      }
+      char *content = (char *)attr->children->content;
+      char *endptr = NULL;
+      if (strncasecmp((char *)attr->name, "entries", 8) == 0)
+      {
+         unsigned long parseval = strtoul(content, &endptr, 10);
+         if (*endptr != '\0' || parseval == 0 || parseval > 32768)
+         {
+            LOG(LOG_ERR, "Invalid POSIX DAL 'uring' entries value: \"%s\"\n", content);
+            break;
+         }
+         entries = (unsigned int)parseval;
+      }
+      else if (strncasecmp((char *)attr->name, "files", 6) == 0)
+      {
+         unsigned long parseval = strtoul(content, &endptr, 10);
+         if (*endptr != '\0' || parseval > 65536)
+         {
+            LOG(LOG_ERR, "Invalid POSIX DAL 'uring' files value: \"%s\"\n", content);
+            break;
+         }
+         files = (unsigned int)parseval;
+      }
+      else if (strncasecmp((char *)attr->name, "sqpoll", 7) == 0)
+      {
+         if (strncasecmp(content, "yes", 4) == 0) { sqpoll = 1; }
+         else if (strncasecmp(content, "no", 3) != 0)
+         {
+            LOG(LOG_ERR, "Invalid POSIX DAL 'uring' sqpoll value: \"%s\"\n", content);
+            break;
+         }
+      }
+      else
+      {
+         LOG(LOG_ERR, "Encountered an unrecognized \"%s\" property of POSIX DAL 'uring' definition\n", (char *)attr->name);
+         break;
+      }
+   }
+   if (attr) // indicates a 'break' from the above loop
+   {
+      posix_cleanup(pdal);
+      errno = EINVAL;
+      return NULL;
+   }
 
+   // set up our io_uring, falling back to standard POSIX IO if we cannot
+   POSIX_DAL_CTXT dctxt = (POSIX_DAL_CTXT)pdal->ctxt;
+   dctxt->uring = posix_uring_create(entries, files, sqpoll);
+   if (dctxt->uring == NULL)
+   {
+      LOG(LOG_WARNING, "Failed to initialize io_uring (%s), falling back to standard POSIX IO\n", strerror(errno));
+      return pdal;
+   }
+   pdal->name = "posix_uring";
+   pdal->put = posix_uring_put;
+   pdal->putv = posix_uring_putv;
+   pdal->get = posix_uring_get;
+   pdal->getv = posix_uring_getv;
+   return pdal;
 }
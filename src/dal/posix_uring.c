@@ -0,0 +1,554 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include "marfs_auto_config.h"
+#ifdef DEBUG_DAL
+#define DEBUG DEBUG_DAL
+#elif (defined DEBUG_ALL)
+#define DEBUG DEBUG_ALL
+#endif
+#define LOG_PREFIX "posix_uring"
+#include "logging/logging.h"
+
+#include "posix_uring.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef HAVE_LINUX_IO_URING_H
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define URING_SUBMIT_RETRIES 1000 // Maximum attempts at a submission refused for lack of kernel resources
+
+//   -------------    URING CONTEXT    -------------
+
+// A single outstanding request, owned by the submitting thread
+typedef struct uring_request_struct
+{
+   pthread_cond_t complete; // signaled once the request has completed, or once its owner must reap for itself
+   char done;               // flag indicating that the request has completed
+   int res;                 // result of the request
+   struct uring_request_struct *next; // next request awaiting completion by another thread's reaping
+} uring_request;
+
+// NOTE -- There is no dedicated completion thread.  Whichever submitter first finds no other thread reaping
+//         becomes the reaper, waiting in the kernel and collecting completions for every request of the ring.
+//         Other submitters sleep until either their request completes or the reaper's own request completes,
+//         at which point one of them takes over reaping.  A lone submitter thus reaps its own completions,
+//         with no additional thread or wakeup involved.
+struct posix_uring_struct
+{
+   int fd;                    // io_uring file descriptor
+   char sqpoll;               // flag indicating use of a kernel submission polling thread
+   pthread_mutex_t lock;      // lock for queue manipulation
+   pthread_cond_t space;      // signaled as requests complete, freeing queue space
+   pthread_rwlock_t enter;    // held shared while submitting to the kernel, exclusive while undoing a failed submission
+   unsigned int inflight;     // number of requests submitted, but not yet reaped
+   unsigned int maxinflight;  // maximum number of concurrent requests
+   char reaping;              // flag indicating that some submitter is currently reaping completions
+   uring_request *waiters;    // list of submitters waiting on another to reap their completions
+   // submission queue
+   void *sqmap;
+   size_t sqmapsz;
+   unsigned int *sqhead;
+   unsigned int *sqtail;
+   unsigned int *sqmask;
+   unsigned int *sqflags;
+   unsigned int *sqarray;
+   struct io_uring_sqe *sqes;
+   size_t sqesz;
+   // completion queue
+   void *cqmap;
+   size_t cqmapsz;
+   unsigned int *cqhead;
+   unsigned int *cqtail;
+   unsigned int *cqmask;
+   struct io_uring_cqe *cqes;
+   // fixed files
+   int *files;                // fixed file table ( -1 for unused slots )
+   unsigned int filecnt;      // number of fixed file slots ( zero if fixed files are unavailable )
+};
+
+//   -------------    URING INTERNAL FUNCTIONS    -------------
+
+static int sys_io_uring_setup( unsigned int entries, struct io_uring_params *p )
+{
+   return (int)syscall( __NR_io_uring_setup, entries, p );
+}
+
+static int sys_io_uring_enter( int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags )
+{
+   return (int)syscall( __NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0 );
+}
+
+static int sys_io_uring_register( int fd, unsigned int opcode, void *arg, unsigned int nr_args )
+{
+   return (int)syscall( __NR_io_uring_register, fd, opcode, arg, nr_args );
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Queue a new submission and notify the kernel of it
+ * NOTE -- the caller must NOT hold the ring lock
+ * @param POSIX_URING ring : Instance to submit through
+ * @param uint8_t opcode : Operation to be performed
+ * @param int fd : File descriptor ( or fixed file slot ) to perform the operation against
+ * @param char fixed : Flag indicating that 'fd' is a fixed file slot
+ * @param const struct iovec* iov : List of buffers for the operation
+ * @param int iovcnt : Number of buffers in the list
+ * @param off_t offset : Offset of the operation
+ * @param uring_request* req : Request to be updated on completion
+ * @return int : Zero on success, -1 on failure ( with errno set, and the request never to be performed )
+ */
+static int uring_submit( POSIX_URING ring, uint8_t opcode, int fd, char fixed, const struct iovec *iov, int iovcnt, off_t offset, uring_request *req )
+{
+   pthread_mutex_lock( &ring->lock );
+   // never exceed the capacity of our queues
+   while ( ring->inflight >= ring->maxinflight )
+   {
+      pthread_cond_wait( &ring->space, &ring->lock );
+   }
+   unsigned int tail = *(ring->sqtail);
+   unsigned int index = tail & *(ring->sqmask);
+   struct io_uring_sqe *sqe = &(ring->sqes[index]);
+   memset( sqe, 0, sizeof(struct io_uring_sqe) );
+   sqe->opcode = opcode;
+   sqe->fd = fd;
+   if ( fixed ) { sqe->flags = IOSQE_FIXED_FILE; }
+   sqe->addr = (uint64_t)(uintptr_t)iov;
+   sqe->len = (uint32_t)iovcnt;
+   sqe->off = (uint64_t)offset;
+   sqe->user_data = (uint64_t)(uintptr_t)req;
+   ring->sqarray[index] = index;
+   __atomic_store_n( ring->sqtail, tail + 1, __ATOMIC_RELEASE );
+   ring->inflight++;
+   pthread_mutex_unlock( &ring->lock );
+
+   // let the kernel know of our new submission
+   if ( ring->sqpoll )
+   {
+      __atomic_thread_fence( __ATOMIC_SEQ_CST ); // tail update must be visible prior to checking the flags
+      if ( __atomic_load_n( ring->sqflags, __ATOMIC_ACQUIRE ) & IORING_SQ_NEED_WAKEUP )
+      {
+         sys_io_uring_enter( ring->fd, 0, 0, IORING_ENTER_SQ_WAKEUP );
+      }
+      return 0;
+   }
+   int res;
+   int tries = 0;
+   pthread_rwlock_rdlock( &ring->enter );
+   while ( (res = sys_io_uring_enter( ring->fd, 1, 0, 0 )) < 0 )
+   {
+      if ( errno == EINTR ) { continue; }
+      // the kernel may temporarily lack resources, or completions may be backlogged, so give it a moment
+      if ( ( errno != EAGAIN  &&  errno != EBUSY )  ||  ++tries >= URING_SUBMIT_RETRIES ) { break; }
+      struct timespec pause = { .tv_sec = 0, .tv_nsec = 1000000 };
+      nanosleep( &pause, NULL );
+   }
+   pthread_rwlock_unlock( &ring->enter );
+   // NOTE -- a zero return only indicates that a concurrent caller has submitted our request for us
+   if ( res >= 0 ) { return 0; }
+   int err = errno;
+
+   // with no concurrent submission underway, the kernel cannot be reading our entry
+   pthread_rwlock_wrlock( &ring->enter );
+   pthread_mutex_lock( &ring->lock );
+   if ( (int)( __atomic_load_n( ring->sqhead, __ATOMIC_ACQUIRE ) - tail ) > 0 )
+   {
+      // a concurrent caller did submit our request, so it will complete as normal
+      pthread_mutex_unlock( &ring->lock );
+      pthread_rwlock_unlock( &ring->enter );
+      return 0;
+   }
+   if ( *(ring->sqtail) == tail + 1 )
+   {
+      // ours is the most recent entry, so simply withdraw it
+      __atomic_store_n( ring->sqtail, tail, __ATOMIC_RELEASE );
+      ring->inflight--;
+      pthread_cond_broadcast( &ring->space );
+   }
+   else
+   {
+      // later entries follow ours, so convert it to a no-op, whose completion will be discarded
+      memset( sqe, 0, sizeof(struct io_uring_sqe) );
+      sqe->opcode = IORING_OP_NOP;
+   }
+   pthread_mutex_unlock( &ring->lock );
+   pthread_rwlock_unlock( &ring->enter );
+   LOG( LOG_ERR, "Failed to submit io_uring request (%s)\n", strerror(err) );
+   errno = err;
+   return -1;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Collect all available completions of the given io_uring instance
+ * NOTE -- the caller must hold the ring lock
+ * @param POSIX_URING ring : Instance to reap completions for
+ */
+static void uring_reap( POSIX_URING ring )
+{
+   unsigned int head = *(ring->cqhead);
+   unsigned int tail = __atomic_load_n( ring->cqtail, __ATOMIC_ACQUIRE );
+   if ( head == tail ) { return; }
+   while ( head != tail )
+   {
+      struct io_uring_cqe *cqe = &(ring->cqes[head & *(ring->cqmask)]);
+      uring_request *req = (uring_request*)(uintptr_t)cqe->user_data;
+      if ( req ) // a request with no associated struct was abandoned after a failed submission
+      {
+         req->res = cqe->res;
+         req->done = 1;
+         pthread_cond_signal( &req->complete );
+      }
+      ring->inflight--;
+      head++;
+   }
+   __atomic_store_n( ring->cqhead, head, __ATOMIC_RELEASE );
+   pthread_cond_broadcast( &ring->space );
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Wait for completion of the given request, reaping completions for the entire ring if no other thread is doing so
+ * @param POSIX_URING ring : Instance the request was submitted through
+ * @param uring_request* req : Request to wait on
+ */
+static void uring_wait( POSIX_URING ring, uring_request *req )
+{
+   pthread_mutex_lock( &ring->lock );
+   while ( !(req->done) )
+   {
+      if ( ring->reaping )
+      {
+         // another thread will wake us, either upon our completion or upon its own
+         req->next = ring->waiters;
+         ring->waiters = req;
+         pthread_cond_wait( &req->complete, &ring->lock );
+         uring_request **prev = &(ring->waiters);
+         while ( *prev != req ) { prev = &((*prev)->next); }
+         *prev = req->next;
+         continue;
+      }
+      // take over reaping, until our own request completes
+      ring->reaping = 1;
+      pthread_mutex_unlock( &ring->lock );
+      if ( sys_io_uring_enter( ring->fd, 0, 1, IORING_ENTER_GETEVENTS ) < 0  &&  errno != EINTR )
+      {
+         LOG( LOG_ERR, "Failed to wait for io_uring completions (%s)\n", strerror(errno) );
+         // keep trying, as our request ( and possibly others ) depend on us
+      }
+      pthread_mutex_lock( &ring->lock );
+      uring_reap( ring );
+      ring->reaping = 0;
+   }
+   // if we were reaping, hand that responsibility to a thread still awaiting completion
+   if ( !(ring->reaping) )
+   {
+      uring_request *waiter = ring->waiters;
+      while ( waiter  &&  waiter->done ) { waiter = waiter->next; }
+      if ( waiter ) { pthread_cond_signal( &waiter->complete ); }
+   }
+   pthread_mutex_unlock( &ring->lock );
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Release all mappings and handles of a partially or fully initialized io_uring instance
+ * @param POSIX_URING ring : Instance to be released
+ */
+static void uring_release( POSIX_URING ring )
+{
+   if ( ring->sqes && ring->sqes != MAP_FAILED ) { munmap( ring->sqes, ring->sqesz ); }
+   if ( ring->cqmap && ring->cqmap != MAP_FAILED && ring->cqmap != ring->sqmap ) { munmap( ring->cqmap, ring->cqmapsz ); }
+   if ( ring->sqmap && ring->sqmap != MAP_FAILED ) { munmap( ring->sqmap, ring->sqmapsz ); }
+   if ( ring->fd >= 0 ) { close( ring->fd ); }
+   if ( ring->files ) { free( ring->files ); }
+   pthread_rwlock_destroy( &ring->enter );
+   pthread_cond_destroy( &ring->space );
+   pthread_mutex_destroy( &ring->lock );
+   free( ring );
+}
+
+//   -------------    URING FUNCTIONS    -------------
+
+POSIX_URING posix_uring_create( unsigned int entries, unsigned int files, char sqpoll )
+{
+   POSIX_URING ring = calloc( 1, sizeof(struct posix_uring_struct) );
+   if ( ring == NULL )
+   {
+      LOG( LOG_ERR, "Failed to allocate an io_uring struct\n" );
+      return NULL;
+   }
+   ring->fd = -1;
+   pthread_mutex_init( &ring->lock, NULL );
+   pthread_cond_init( &ring->space, NULL );
+   pthread_rwlock_init( &ring->enter, NULL );
+
+   struct io_uring_params params;
+   memset( &params, 0, sizeof(params) );
+   if ( sqpoll )
+   {
+      params.flags = IORING_SETUP_SQPOLL;
+      params.sq_thread_idle = 1000; // milliseconds
+      ring->fd = sys_io_uring_setup( entries, &params );
+      if ( ring->fd < 0 )
+      {
+         LOG( LOG_WARNING, "Failed to setup io_uring with SQPOLL (%s), proceeding without it\n", strerror(errno) );
+         memset( &params, 0, sizeof(params) );
+      }
+      else { ring->sqpoll = 1; }
+   }
+   if ( ring->fd < 0 )
+   {
+      ring->fd = sys_io_uring_setup( entries, &params );
+      if ( ring->fd < 0 )
+      {
+         LOG( LOG_ERR, "Failed to setup io_uring (%s)\n", strerror(errno) );
+         int err = errno;
+         uring_release( ring );
+         errno = err;
+         return NULL;
+      }
+   }
+
+   // map in the submission and completion rings
+   ring->sqmapsz = params.sq_off.array + (params.sq_entries * sizeof(unsigned int));
+   ring->cqmapsz = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+   if ( params.features & IORING_FEAT_SINGLE_MMAP )
+   {
+      if ( ring->cqmapsz > ring->sqmapsz ) { ring->sqmapsz = ring->cqmapsz; }
+      ring->cqmapsz = ring->sqmapsz;
+   }
+   ring->sqmap = mmap( NULL, ring->sqmapsz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING );
+   if ( ring->sqmap == MAP_FAILED )
+   {
+      LOG( LOG_ERR, "Failed to map io_uring submission queue (%s)\n", strerror(errno) );
+      int err = errno;
+      uring_release( ring );
+      errno = err;
+      return NULL;
+   }
+   if ( params.features & IORING_FEAT_SINGLE_MMAP ) { ring->cqmap = ring->sqmap; }
+   else
+   {
+      ring->cqmap = mmap( NULL, ring->cqmapsz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING );
+      if ( ring->cqmap == MAP_FAILED )
+      {
+         LOG( LOG_ERR, "Failed to map io_uring completion queue (%s)\n", strerror(errno) );
+         int err = errno;
+         uring_release( ring );
+         errno = err;
+         return NULL;
+      }
+   }
+   ring->sqesz = params.sq_entries * sizeof(struct io_uring_sqe);
+   ring->sqes = mmap( NULL, ring->sqesz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES );
+   if ( ring->sqes == MAP_FAILED )
+   {
+      LOG( LOG_ERR, "Failed to map io_uring submission entries (%s)\n", strerror(errno) );
+      int err = errno;
+      uring_release( ring );
+      errno = err;
+      return NULL;
+   }
+   ring->sqhead  = (unsigned int*)(ring->sqmap + params.sq_off.head);
+   ring->sqtail  = (unsigned int*)(ring->sqmap + params.sq_off.tail);
+   ring->sqmask  = (unsigned int*)(ring->sqmap + params.sq_off.ring_mask);
+   ring->sqflags = (unsigned int*)(ring->sqmap + params.sq_off.flags);
+   ring->sqarray = (unsigned int*)(ring->sqmap + params.sq_off.array);
+   ring->cqhead  = (unsigned int*)(ring->cqmap + params.cq_off.head);
+   ring->cqtail  = (unsigned int*)(ring->cqmap + params.cq_off.tail);
+   ring->cqmask  = (unsigned int*)(ring->cqmap + params.cq_off.ring_mask);
+   ring->cqes    = (struct io_uring_cqe*)(ring->cqmap + params.cq_off.cqes);
+   // every in-flight request must always have room for its completion
+   ring->maxinflight = ( params.sq_entries < params.cq_entries ) ? params.sq_entries : params.cq_entries;
+
+   // register a sparse table of fixed files
+   if ( files )
+   {
+      ring->files = malloc( sizeof(int) * files );
+      if ( ring->files == NULL )
+      {
+         LOG( LOG_ERR, "Failed to allocate a fixed file table\n" );
+         uring_release( ring );
+         return NULL;
+      }
+      unsigned int i;
+      for ( i = 0; i < files; i++ ) { ring->files[i] = -1; }
+      if ( sys_io_uring_register( ring->fd, IORING_REGISTER_FILES, ring->files, files ) )
+      {
+         LOG( LOG_WARNING, "Failed to register io_uring fixed files (%s), proceeding without them\n", strerror(errno) );
+         free( ring->files );
+         ring->files = NULL;
+      }
+      else { ring->filecnt = files; }
+   }
+
+   LOG( LOG_INFO, "Created io_uring with %u entries ( %u fixed files, sqpoll=%d )\n", ring->maxinflight, ring->filecnt, (int)ring->sqpoll );
+   return ring;
+}
+
+void posix_uring_destroy( POSIX_URING ring )
+{
+   if ( ring == NULL ) { return; }
+   if ( ring->filecnt ) { sys_io_uring_register( ring->fd, IORING_UNREGISTER_FILES, NULL, 0 ); }
+   uring_release( ring );
+}
+
+int posix_uring_register( POSIX_URING ring, int fd )
+{
+   if ( ring->filecnt == 0 ) { return -1; }
+   pthread_mutex_lock( &ring->lock );
+   unsigned int slot;
+   for ( slot = 0; slot < ring->filecnt; slot++ )
+   {
+      if ( ring->files[slot] < 0 ) { break; }
+   }
+   if ( slot == ring->filecnt )
+   {
+      pthread_mutex_unlock( &ring->lock );
+      LOG( LOG_INFO, "All %u fixed file slots are in use\n", ring->filecnt );
+      return -1;
+   }
+   struct io_uring_files_update update;
+   memset( &update, 0, sizeof(update) );
+   update.offset = slot;
+   update.fds = (uint64_t)(uintptr_t)&fd;
+   if ( sys_io_uring_register( ring->fd, IORING_REGISTER_FILES_UPDATE, &update, 1 ) != 1 )
+   {
+      pthread_mutex_unlock( &ring->lock );
+      LOG( LOG_WARNING, "Failed to update fixed file slot %u (%s)\n", slot, strerror(errno) );
+      return -1;
+   }
+   ring->files[slot] = fd;
+   pthread_mutex_unlock( &ring->lock );
+   return (int)slot;
+}
+
+void posix_uring_unregister( POSIX_URING ring, int slot )
+{
+   if ( slot < 0  ||  (unsigned int)slot >= ring->filecnt ) { return; }
+   pthread_mutex_lock( &ring->lock );
+   int fd = -1;
+   struct io_uring_files_update update;
+   memset( &update, 0, sizeof(update) );
+   update.offset = (unsigned int)slot;
+   update.fds = (uint64_t)(uintptr_t)&fd;
+   if ( sys_io_uring_register( ring->fd, IORING_REGISTER_FILES_UPDATE, &update, 1 ) != 1 )
+   {
+      // leave the slot marked as in use, as the kernel may still reference the old file
+      LOG( LOG_WARNING, "Failed to clear fixed file slot %d (%s)\n", slot, strerror(errno) );
+   }
+   else { ring->files[slot] = -1; }
+   pthread_mutex_unlock( &ring->lock );
+}
+
+ssize_t posix_uring_io( POSIX_URING ring, char write, int fd, int slot, const struct iovec* iov, int iovcnt, off_t offset )
+{
+   uring_request req;
+   req.done = 0;
+   req.res = 0;
+   req.next = NULL;
+   pthread_cond_init( &req.complete, NULL );
+   char fixed = ( slot >= 0 ) ? 1 : 0;
+   if ( uring_submit( ring, write ? IORING_OP_WRITEV : IORING_OP_READV, fixed ? slot : fd, fixed, iov, iovcnt, offset, &req ) )
+   {
+      int err = errno;
+      pthread_cond_destroy( &req.complete );
+      errno = err;
+      return -1;
+   }
+   uring_wait( ring, &req );
+   pthread_cond_destroy( &req.complete );
+   if ( req.res < 0 )
+   {
+      errno = -(req.res);
+      return -1;
+   }
+   return (ssize_t)req.res;
+}
+
+#else
+
+POSIX_URING posix_uring_create( unsigned int entries, unsigned int files, char sqpoll )
+{
+   LOG( LOG_ERR, "io_uring support was not available at build time\n" );
+   errno = ENOSYS;
+   return NULL;
+}
+
+void posix_uring_destroy( POSIX_URING ring ) {}
+
+int posix_uring_register( POSIX_URING ring, int fd ) { return -1; }
+
+void posix_uring_unregister( POSIX_URING ring, int slot ) {}
+
+ssize_t posix_uring_io( POSIX_URING ring, char write, int fd, int slot, const struct iovec* iov, int iovcnt, off_t offset )
+{
+   errno = ENOSYS;
+   return -1;
+}
+
+#endif
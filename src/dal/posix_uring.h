@@ -0,0 +1,126 @@
+#ifndef __POSIX_URING_H__
+#define __POSIX_URING_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+
+// Shared io_uring instance, through which all block IO of a 'posix_uring' DAL is issued
+typedef struct posix_uring_struct* POSIX_URING;
+
+/**
+ * Create a new io_uring instance
+ * NOTE -- completions are reaped by the submitting threads themselves, with no dedicated completion thread
+ * @param unsigned int entries : Number of submission queue entries ( max concurrent requests )
+ * @param unsigned int files : Number of fixed file slots to register ( zero to skip fixed files )
+ * @param char sqpoll : If non-zero, attempt to use a kernel submission polling thread
+ * @return POSIX_URING : Reference to the new instance, or NULL on failure ( such as if io_uring is unsupported )
+ */
+POSIX_URING posix_uring_create( unsigned int entries, unsigned int files, char sqpoll );
+
+/**
+ * Destroy the given io_uring instance
+ * NOTE -- all requests must have completed and all files must have been unregistered
+ * @param POSIX_URING ring : Instance to be destroyed
+ */
+void posix_uring_destroy( POSIX_URING ring );
+
+/**
+ * Register the given file descriptor in a fixed file slot of the given io_uring instance
+ * @param POSIX_URING ring : Instance to register with
+ * @param int fd : File descriptor to be registered
+ * @return int : Index of the fixed file slot, or -1 if no slot could be used ( the plain FD should be used instead )
+ */
+int posix_uring_register( POSIX_URING ring, int fd );
+
+/**
+ * Release a fixed file slot of the given io_uring instance
+ * @param POSIX_URING ring : Instance to unregister from
+ * @param int slot : Fixed file slot to be released
+ */
+void posix_uring_unregister( POSIX_URING ring, int slot );
+
+/**
+ * Perform a vectored read or write via the given io_uring instance, waiting for its completion
+ * @param POSIX_URING ring : Instance to submit through
+ * @param char write : Non-zero for a write, zero for a read
+ * @param int fd : File descriptor to perform IO against
+ * @param int slot : Fixed file slot of that file descriptor ( -1 if none )
+ * @param const struct iovec* iov : List of buffers to read into / write from
+ * @param int iovcnt : Number of buffers in the list
+ * @param off_t offset : Offset of the IO within the file
+ * @return ssize_t : Number of bytes transferred, or -1 on failure ( with errno set )
+ */
+ssize_t posix_uring_io( POSIX_URING ring, char write, int fd, int slot, const struct iovec* iov, int iovcnt, off_t offset );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
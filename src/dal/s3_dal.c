@@ -68,32 +68,49 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include "logging/logging.h"
 
 #include "dal.h"
+#include "metainfo.h"
 
 #include <sys/stat.h>
+#include <sys/select.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <stdint.h>
+#include <time.h>
 #include <libs3.h>
 
 //   -------------    S3 DEFINITIONS    -------------
 
-#define TIMEOUT 0            // S3 request timeout
-#define TRIES 5              // Number of times to retry a request
-#define IO_SIZE (5 << 20)    // Preferred I/O Size: 5M
-#define NO_OBJID "noneGiven" // Substitute ID when one is provided
+#define TIMEOUT 0                  // S3 request timeout
+#define TRIES 5                    // Number of times to retry a request
+#define BACKOFF_USEC 100000        // Delay before the first retry of a request: 100ms ( doubled for each subsequent retry )
+#define BACKOFF_MAX_USEC 5000000   // Maximum delay between retries of a request: 5s
+#define POLL_MSEC 100              // Maximum time to wait for progress on concurrent requests
+#define IO_SIZE (5 << 20)          // Preferred I/O Size: 5M
+#define INFLIGHT 4                 // Default number of concurrent part uploads / ranged gets per block
+#define MAX_INFLIGHT 64            // Maximum number of concurrent part uploads / ranged gets per block
+#define GET_RANGE (1 << 20)        // Minimum size of each ranged get issued by a single get(): 1M
+#define PART_MIN (5 << 20)         // Minimum size of any but the last part of a multipart upload: 5M
+#define PART_XML_SIZE 256          // Maximum length of a single part entry in a multipart commit
+#define NO_OBJID "noneGiven"       // Substitute ID when one is provided
 
 //   -------------    S3 CONTEXT    -------------
 
-// Growbuffer from https://github.com/bji/libs3/blob/master/src/s3.c
-typedef struct growbuffer
+// State of a single libs3 request, passed to every callback as its callbackData
+typedef struct s3_request_struct
 {
-   // The total number of bytes, and the start byte
-   int size;
-   // The start byte
-   int start;
-   // The blocks
-   char data[64 * 1024];
-   struct growbuffer *prev, *next;
-} growbuffer;
+   S3Status status; // Completion status of the request
+   char active;     // Flag indicating that the request is still in flight
+   int tries;       // Number of times the request has been retried
+   void *ref;       // Request specific target ( block context, metadata buffer, etc. )
+
+   char *data;      // Caller buffer to be sent from / received into by the request (if any)
+   size_t size;     // Number of bytes to be sent / received by the request
+   size_t done;     // Number of bytes sent / received so far
+   off_t offset;    // Object offset of a ranged get (if any)
+
+   int seq;         // Part number of a part upload (if any)
+   char *etag;      // ETag returned for an uploaded part (if any)
+} s3_request;
 
 typedef struct s3_block_context_struct
 {
@@ -102,15 +119,16 @@ typedef struct s3_block_context_struct
    char *key;                      // Object key
    DAL_MODE mode;                  // Mode in which this block was opened
 
-   growbuffer *data_gb; // Buffer for data
-   int data_size;       // Size of data buffer
+   S3RequestContext *rctxt;        // Context driving this block's concurrent requests
+   int inflight;                   // Maximum number of concurrent requests for this block
 
    char *meta; // Metadata buffer to be written on close (if any)
 
    char *upload_id;     // Upload ID for multipart upload (if write enabled)
    int seq;             // Part number for multipart upload (if write enabled)
-   growbuffer *part_gb; // Buffer to hold list of parts (if write enable)
-   int part_size;       // Size of part buffer (if write enable)
+   s3_request **parts;  // Part uploads, indexed by part number - 1 (if write enabled)
+   int parts_len;       // Allocated length of the parts list (if write enabled)
+   int reaped;          // Number of leading parts known to be uploaded (if write enabled)
 } * S3_BLOCK_CTXT;
 
 typedef struct s3_dal_context_struct
@@ -119,9 +137,12 @@ typedef struct s3_dal_context_struct
    char *accessKey;      // AWS Access Key ID
    char *secretKey;      // AWS Secret Access Key
    char *region;         // AWS Region Name
+   int inflight;         // Maximum number of concurrent requests per block
 } * S3_DAL_CTXT;
 
-static S3Status statusG;
+// libs3 does not hand any callbackData to multipart abort callbacks, so the status of
+// those requests is tracked per-thread instead
+static __thread S3Status abortStatus;
 
 //   -------------    S3 INTERNAL FUNCTIONS    -------------
 
@@ -160,117 +181,6 @@ static int num_digits(int value)
    return -1;
 }
 
-/** (INTERNAL HELPER FUNCTION)
- * Add data to the given growbuffer. From
- * https://github.com/bji/libs3/blob/master/src/s3.c
- * @param growbuffer** gb : Buffer to add data to
- * @param const char* data : Data to be added
- * @param int dataLen : Number of chars to be added
- * @return int : Number of chars added, or 0 on an error
- */
-static int growbuffer_append(growbuffer **gb, const char *data, int dataLen)
-{
-   int origDataLen = dataLen;
-   while (dataLen)
-   {
-      growbuffer *buf = *gb ? (*gb)->prev : 0;
-      if (!buf || (buf->size == sizeof(buf->data)))
-      {
-         buf = (growbuffer *)malloc(sizeof(growbuffer));
-         if (!buf)
-         {
-            return 0;
-         }
-         buf->size = 0;
-         buf->start = 0;
-         if (*gb && (*gb)->prev)
-         {
-            buf->prev = (*gb)->prev;
-            buf->next = *gb;
-            (*gb)->prev->next = buf;
-            (*gb)->prev = buf;
-         }
-         else
-         {
-            buf->prev = buf->next = buf;
-            *gb = buf;
-         }
-      }
-
-      int toCopy = (sizeof(buf->data) - buf->size);
-      if (toCopy > dataLen)
-      {
-         toCopy = dataLen;
-      }
-
-      memcpy(&(buf->data[buf->size]), data, toCopy);
-
-      buf->size += toCopy, data += toCopy, dataLen -= toCopy;
-   }
-
-   return origDataLen;
-}
-
-/** (INTERNAL HELPER FUNCTION)
- * Read data from the given growbuffer. From
- * https://github.com/bji/libs3/blob/master/src/s3.c
- * @param growbuffer** gb : Buffer to add data to
- * @param int amt : Number of chars requested to be read
- * @param int* amtReturn : Number of chars actually read
- * @param char* buffer : Buffer to read data into
- */
-static void growbuffer_read(growbuffer **gb, int amt, int *amtReturn,
-                            char *buffer)
-{
-   *amtReturn = 0;
-
-   growbuffer *buf = *gb;
-
-   if (!buf)
-   {
-      return;
-   }
-
-   *amtReturn = (buf->size > amt) ? amt : buf->size;
-
-   memcpy(buffer, &(buf->data[buf->start]), *amtReturn);
-
-   buf->start += *amtReturn, buf->size -= *amtReturn;
-
-   if (buf->size == 0)
-   {
-      if (buf->next == buf)
-      {
-         *gb = 0;
-      }
-      else
-      {
-         *gb = buf->next;
-         buf->prev->next = buf->next;
-         buf->next->prev = buf->prev;
-      }
-      free(buf);
-      buf = NULL;
-   }
-}
-
-/** (INTERNAL HELPER FUNCTION)
- * Free all data in the given growbuffer. From
- * https://github.com/bji/libs3/blob/master/src/s3.c
- * @param growbuffer** gb : Buffer to add data to
- */
-static void growbuffer_destroy(growbuffer *gb)
-{
-   growbuffer *start = gb;
-
-   while (gb)
-   {
-      growbuffer *next = gb->next;
-      free(gb);
-      gb = (next == start) ? 0 : next;
-   }
-}
-
 /** (INTERNAL HELPER FUNCTION)
  * This callback is made after initiation of a multipart upload operation.  It
  * indicates that the multi part upload has been created and provides the
@@ -289,7 +199,8 @@ static void growbuffer_destroy(growbuffer *gb)
  */
 static S3Status initialMultipartCallback(const char *upload_id, void *callbackData)
 {
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
+   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)((s3_request *)callbackData)->ref;
+   free(bctxt->upload_id);
    bctxt->upload_id = strdup(upload_id);
    return S3StatusOK;
 }
@@ -313,27 +224,23 @@ static S3Status initialMultipartCallback(const char *upload_id, void *callbackDa
  **/
 static int putObjectDataCallback(int bufferSize, char *buffer, void *callbackData)
 {
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
+   s3_request *req = (s3_request *)callbackData;
 
-   int ret = 0;
-
-   if (bctxt->data_size)
+   if (req->data == NULL)
    {
-      int toRead = ((bctxt->data_size > (unsigned)bufferSize) ? (unsigned)bufferSize : bctxt->data_size);
-      if (bctxt->data_gb)
-      {
-         growbuffer_read(&(bctxt->data_gb), toRead, &ret, buffer);
-      }
-      else
-      {
-         LOG(LOG_ERR, "missing data growbuffer!\n");
-         return -1;
-      }
+      LOG(LOG_ERR, "missing request data!\n");
+      return -1;
    }
 
-   bctxt->data_size -= ret;
+   size_t toCopy = req->size - req->done;
+   if (toCopy > (size_t)bufferSize)
+   {
+      toCopy = bufferSize;
+   }
+   memcpy(buffer, req->data + req->done, toCopy);
+   req->done += toCopy;
 
-   return ret;
+   return (int)toCopy;
 }
 
 /** (INTERNAL HELPER FUNCTION)
@@ -355,14 +262,15 @@ static int putObjectDataCallback(int bufferSize, char *buffer, void *callbackDat
  **/
 static S3Status getObjectDataCallback(int bufferSize, const char *buffer, void *callbackData)
 {
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
+   s3_request *req = (s3_request *)callbackData;
 
-   if (!growbuffer_append(&(bctxt->data_gb), buffer, bufferSize))
+   if (req->done + bufferSize > req->size)
    {
-      LOG(LOG_ERR, "data not appended to growbuffer\n");
+      LOG(LOG_ERR, "received %zu bytes for a %zu byte request\n", req->done + bufferSize, req->size);
       return S3StatusAbortedByCallback;
    }
-   bctxt->data_size += bufferSize;
+   memcpy(req->data + req->done, buffer, bufferSize);
+   req->done += bufferSize;
 
    return S3StatusOK;
 }
@@ -385,15 +293,8 @@ static S3Status getObjectDataCallback(int bufferSize, const char *buffer, void *
 static int commitObjectCallback(int bufferSize, char *buffer,
                                 void *callbackData)
 {
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
-   int ret = 0;
-   if (bctxt->part_size)
-   {
-      int toRead = ((bctxt->part_size > bufferSize) ? bufferSize : bctxt->part_size);
-      growbuffer_read(&(bctxt->part_gb), toRead, &ret, buffer);
-   }
-   bctxt->part_size -= ret;
-   return ret;
+   // the part list is sent just like any other request data
+   return putObjectDataCallback(bufferSize, buffer, callbackData);
 }
 
 /** (INTERNAL HELPER FUNCTION)
@@ -428,8 +329,14 @@ static S3Status responsePropertiesCallback(const S3ResponseProperties *propertie
 static S3Status getMetaResponsePropertiesCallback(const S3ResponseProperties *properties, void *callbackData)
 {
    responsePropertiesCallback(properties, callbackData);
-   char *buf = (char *)callbackData;
-   strcpy(buf, properties->metaData->value);
+   s3_request *req = (s3_request *)callbackData;
+   if (properties->metaDataCount < 1)
+   {
+      LOG(LOG_ERR, "object has no metadata\n");
+      return S3StatusAbortedByCallback;
+   }
+   char *buf = (char *)req->ref;
+   snprintf(buf, req->size, "%s", properties->metaData->value);
    return S3StatusOK;
 }
 
@@ -448,10 +355,12 @@ static S3Status getMetaResponsePropertiesCallback(const S3ResponseProperties *pr
 static S3Status putResponseProperiesCallback(const S3ResponseProperties *properties, void *callbackData)
 {
    responsePropertiesCallback(properties, callbackData);
-   S3_BLOCK_CTXT bctxt = (S3_BLOCK_CTXT)callbackData;
-   char buf[256];
-   int n = snprintf(buf, sizeof(buf), "<Part><ETag>%s</ETag><PartNumber>%d</PartNumber></Part>", properties->eTag, bctxt->seq);
-   bctxt->part_size += growbuffer_append(&(bctxt->part_gb), buf, n);
+   s3_request *req = (s3_request *)callbackData;
+   if (properties->eTag)
+   {
+      free(req->etag);
+      req->etag = strdup(properties->eTag);
+   }
    return S3StatusOK;
 }
 
@@ -479,24 +388,12 @@ static S3Status listCallback(const char *ownerId, const char *ownerDisplayName,
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * This callback is made when the response has been completely received, or an
- * error has occurred which has prematurely aborted the request, or one of the
- * other user-supplied callbacks returned a value intended to abort the
- * request.  This callback is always made for every request, as the very last
- * callback made for that request.
- * @param status gives the overall status of the response, indicating success
- *        or failure; use S3_status_is_retryable() as a simple way to detect
- *        whether or not the status indicates that the request failed but may
- *        be retried.
+ * Log the details of a failed request
  * @param errorDetails if non-NULL, gives details as returned by the S3
  *        service, describing the error
- * @param callbackData is the callback data as specified when the request
- *        was issued.
  **/
-static void responseCompleteCallback(S3Status status, const S3ErrorDetails *error, void *callbackData)
+static void logErrorDetails(const S3ErrorDetails *error)
 {
-   statusG = status;
-
    if (error && error->message)
    {
       LOG(LOG_ERR, "  Message: %s\n", error->message);
@@ -520,6 +417,46 @@ static void responseCompleteCallback(S3Status status, const S3ErrorDetails *erro
    }
 }
 
+/** (INTERNAL HELPER FUNCTION)
+ * This callback is made when the response has been completely received, or an
+ * error has occurred which has prematurely aborted the request, or one of the
+ * other user-supplied callbacks returned a value intended to abort the
+ * request.  This callback is always made for every request, as the very last
+ * callback made for that request.
+ * @param status gives the overall status of the response, indicating success
+ *        or failure; use S3_status_is_retryable() as a simple way to detect
+ *        whether or not the status indicates that the request failed but may
+ *        be retried.
+ * @param errorDetails if non-NULL, gives details as returned by the S3
+ *        service, describing the error
+ * @param callbackData is the callback data as specified when the request
+ *        was issued.
+ **/
+static void responseCompleteCallback(S3Status status, const S3ErrorDetails *error, void *callbackData)
+{
+   s3_request *req = (s3_request *)callbackData;
+   req->status = status;
+   req->active = 0;
+
+   logErrorDetails(error);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * This callback is made when a multipart abort request has completed.  As
+ * libs3 provides no callbackData for these requests, the status is recorded
+ * for the calling thread.
+ * @param status gives the overall status of the response
+ * @param errorDetails if non-NULL, gives details as returned by the S3
+ *        service, describing the error
+ * @param callbackData is always NULL
+ **/
+static void abortCompleteCallback(S3Status status, const S3ErrorDetails *error, void *callbackData)
+{
+   abortStatus = status;
+
+   logErrorDetails(error);
+}
+
 //   -------------    S3 HANDLERS    -------------
 
 // Callbacks for verify() operations
@@ -591,7 +528,7 @@ static S3GetObjectHandler getHandler = {
 // Callbacks for multipart abort operations
 static S3AbortMultipartUploadHandler abortHandler = {
     {&responsePropertiesCallback,
-     &responseCompleteCallback},
+     &abortCompleteCallback},
 
 };
 
@@ -612,6 +549,186 @@ static S3ListServiceHandler listHandler = {
 
 };
 
+//   -------------    S3 REQUEST MANAGEMENT    -------------
+
+/** (INTERNAL HELPER FUNCTION)
+ * Determine whether a completed request should be reissued and, if so, sleep for a
+ * randomized, exponentially increasing delay and reset the request's transfer state.
+ * This replaces tight retry loops, which tend to hammer an already struggling server
+ * with every thread at once.
+ * @param s3_request* req : Request which has completed
+ * @return int : 1 if the request should be reissued, 0 if it succeeded or should not be retried
+ */
+static int retry_request(s3_request *req)
+{
+   if (req->status == S3StatusOK || !S3_status_is_retryable(req->status) || req->tries >= TRIES)
+   {
+      return 0;
+   }
+
+   // delay for somewhere between half and all of the current backoff interval
+   useconds_t delay = BACKOFF_USEC << req->tries;
+   if (delay > BACKOFF_MAX_USEC)
+   {
+      delay = BACKOFF_MAX_USEC;
+   }
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   unsigned int seed = (unsigned int)now.tv_nsec ^ (unsigned int)(uintptr_t)req;
+   delay = (delay / 2) + (rand_r(&seed) % ((delay / 2) + 1));
+
+   req->tries++;
+   LOG(LOG_WARNING, "retrying request (%s) in %u usec ( retry %d of %d )\n", S3_get_status_name(req->status), delay, req->tries, TRIES);
+   usleep(delay);
+
+   // discard any partial transfer
+   req->done = 0;
+   return 1;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Terminate all outstanding requests of the given block ( completing each ), and replace
+ * its request context with a fresh one
+ * @param S3_BLOCK_CTXT bctxt : Block context whose requests should be terminated
+ */
+static void reset_requests(S3_BLOCK_CTXT bctxt)
+{
+   if (bctxt->rctxt)
+   {
+      S3_destroy_request_context(bctxt->rctxt);
+      bctxt->rctxt = NULL;
+   }
+   S3Status status = S3_create_request_context(&(bctxt->rctxt));
+   if (status != S3StatusOK)
+   {
+      LOG(LOG_ERR, "failed to recreate request context (%s)\n", S3_get_status_name(status));
+      bctxt->rctxt = NULL;
+   }
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Drive the concurrent requests of the given block until no more than the given number
+ * remain in flight. On failure, all outstanding requests of the block are terminated.
+ * @param S3_BLOCK_CTXT bctxt : Block context whose requests should be processed
+ * @param int limit : Maximum number of requests which may remain in flight
+ * @return int : 0 on success, or -1 on failure
+ */
+static int run_requests(S3_BLOCK_CTXT bctxt, int limit)
+{
+   if (bctxt->rctxt == NULL)
+   {
+      LOG(LOG_ERR, "no request context available for \"%s/%s\"\n", bctxt->bucketContext->bucketName, bctxt->key);
+      errno = EIO;
+      return -1;
+   }
+   while (1)
+   {
+      int remaining = 0;
+      S3Status status = S3_runonce_request_context(bctxt->rctxt, &remaining);
+      if (status != S3StatusOK)
+      {
+         LOG(LOG_ERR, "failed to process requests for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(status));
+         // tear down all outstanding requests and start fresh
+         reset_requests(bctxt);
+         errno = EIO;
+         return -1;
+      }
+      if (remaining <= limit)
+      {
+         return 0;
+      }
+
+      // wait for any of our connections to make progress
+      fd_set readfds, writefds, exceptfds;
+      FD_ZERO(&readfds);
+      FD_ZERO(&writefds);
+      FD_ZERO(&exceptfds);
+      int maxfd = -1;
+      S3_get_request_context_fdsets(bctxt->rctxt, &readfds, &writefds, &exceptfds, &maxfd);
+      int64_t timeout = S3_get_request_context_timeout(bctxt->rctxt);
+      if (timeout < 0 || timeout > POLL_MSEC)
+      {
+         timeout = POLL_MSEC;
+      }
+      struct timeval tv = {timeout / 1000, (timeout % 1000) * 1000};
+      select(maxfd + 1, &readfds, &writefds, &exceptfds, &tv);
+   }
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Issue an upload of the given part, via the request context of the given block
+ * @param S3_BLOCK_CTXT bctxt : Block context of the multipart upload
+ * @param s3_request* part : Part to be uploaded
+ */
+static void submit_part(S3_BLOCK_CTXT bctxt, s3_request *part)
+{
+   part->active = 1;
+   S3_upload_part(bctxt->bucketContext, bctxt->key, NULL, &putHandler, part->seq, bctxt->upload_id, part->size, bctxt->rctxt, TIMEOUT, part);
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Wait until no more than the given number of part uploads remain in flight, reissuing
+ * any parts which failed along the way
+ * @param S3_BLOCK_CTXT bctxt : Block context of the multipart upload
+ * @param int limit : Maximum number of parts which may remain in flight
+ * @return int : 0 on success, or -1 if any part has failed permanently
+ */
+static int reap_parts(S3_BLOCK_CTXT bctxt, int limit)
+{
+   int resubmitted;
+   do
+   {
+      if (run_requests(bctxt, limit))
+      {
+         return -1;
+      }
+      resubmitted = 0;
+      int p;
+      for (p = bctxt->reaped; p < bctxt->seq - 1; p++)
+      {
+         s3_request *part = bctxt->parts[p];
+         if (part->active)
+         {
+            continue;
+         }
+         if (part->status == S3StatusOK)
+         {
+            part->data = NULL; // the caller's buffer is no longer needed
+            if (p == bctxt->reaped)
+            {
+               bctxt->reaped++;
+            }
+            continue;
+         }
+         if (!retry_request(part))
+         {
+            LOG(LOG_ERR, "failed to upload part %d of \"%s/%s\" (%s)\n", part->seq, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(part->status));
+            errno = EIO;
+            return -1;
+         }
+         submit_part(bctxt, part);
+         resubmitted = 1;
+      }
+   } while (resubmitted);
+   return 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Free all part upload state of the given block
+ * @param S3_BLOCK_CTXT bctxt : Block context of the multipart upload
+ */
+static void free_parts(S3_BLOCK_CTXT bctxt)
+{
+   int p;
+   for (p = 0; p < bctxt->seq - 1; p++)
+   {
+      free(bctxt->parts[p]->etag);
+      free(bctxt->parts[p]);
+   }
+   free(bctxt->parts);
+   bctxt->parts = NULL;
+}
+
 
 int s3_set_meta_internal(BLOCK_CTXT ctxt, const char *meta_buf, size_t size)
 {
@@ -658,22 +775,21 @@ ssize_t s3_get_meta_internal(BLOCK_CTXT ctxt, char *meta_buf, size_t size)
    }
 
    // Give several tries to retrieve metadata
-   int i = TRIES;
+   s3_request req = {.ref = meta_buf, .size = size};
    do
    {
-      S3_head_object(bctxt->bucketContext, bctxt->key, NULL, TIMEOUT, &getMetaHandler, meta_buf);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      S3_head_object(bctxt->bucketContext, bctxt->key, NULL, TIMEOUT, &getMetaHandler, &req);
+   } while (retry_request(&req));
 
-   if (statusG != S3StatusOK)
+   if (req.status != S3StatusOK)
    {
-      LOG(LOG_ERR, "failed to retrieve metadata from \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+      LOG(LOG_ERR, "failed to retrieve metadata from \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(req.status));
       errno = EIO;
       return -1;
    }
 
    // Add a newline to the end of the metadata if we have room
-   if (strlen(meta_buf) < size)
+   if (strlen(meta_buf) + 1 < size)
    {
       strcat(meta_buf, "\n\0");
    }
@@ -710,28 +826,26 @@ int s3_verify(DAL_CTXT ctxt, int flags)
          for (s = 0; s <= dctxt->max_loc.scatter; s++)
          {
             sprintf(bucket, "b%d.%d.%d", b, c, s);
-            int i = TRIES;
+            s3_request req = {0};
             do
             {
-               S3_test_bucket(S3ProtocolHTTP, S3UriStylePath, dctxt->accessKey, dctxt->secretKey, NULL, NULL, bucket, dctxt->region, 0, NULL, NULL, TIMEOUT, &verifyHandler, NULL);
-               i--;
-            } while (S3_status_is_retryable(statusG) && i >= 0);
+               S3_test_bucket(S3ProtocolHTTP, S3UriStylePath, dctxt->accessKey, dctxt->secretKey, NULL, NULL, bucket, dctxt->region, 0, NULL, NULL, TIMEOUT, &verifyHandler, &req);
+            } while (retry_request(&req));
 
-            if (statusG != S3StatusOK)
+            if (req.status != S3StatusOK)
             {
-               LOG(LOG_ERR, "failed to verify bucket \"%s\" (%s)\n", bucket, S3_get_status_name(statusG));
+               LOG(LOG_ERR, "failed to verify bucket \"%s\" (%s)\n", bucket, S3_get_status_name(req.status));
                if (fix)
                {
-                  int i = TRIES;
+                  s3_request creq = {0};
                   do
                   {
-                     S3_create_bucket(S3ProtocolHTTP, dctxt->accessKey, dctxt->secretKey, NULL, NULL, bucket, dctxt->region, S3CannedAclPrivate, NULL, NULL, TIMEOUT, &verifyHandler, NULL);
-                     i--;
-                  } while (S3_status_is_retryable(statusG) && i >= 0);
+                     S3_create_bucket(S3ProtocolHTTP, dctxt->accessKey, dctxt->secretKey, NULL, NULL, bucket, dctxt->region, S3CannedAclPrivate, NULL, NULL, TIMEOUT, &verifyHandler, &creq);
+                  } while (retry_request(&creq));
 
-                  if (statusG != S3StatusOK)
+                  if (creq.status != S3StatusOK)
                   {
-                     LOG(LOG_ERR, "failed to create bucket \"%s\" (%s)\n", bucket, S3_get_status_name(statusG));
+                     LOG(LOG_ERR, "failed to create bucket \"%s\" (%s)\n", bucket, S3_get_status_name(creq.status));
                      num_err++;
                   }
                   else
@@ -799,16 +913,15 @@ int s3_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_location
    snprintf(destBucket, destSize, "b%d.%d.%d", dest.block, dest.cap, dest.scatter);
 
    // Give several tries to copy object
-   int i = TRIES;
+   s3_request req = {0};
    do
    {
-      S3_copy_object(&srcBucketContext, objID, destBucket, NULL, NULL, NULL, 0, NULL, NULL, TIMEOUT, &migrateHandler, NULL);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      S3_copy_object(&srcBucketContext, objID, destBucket, NULL, NULL, NULL, 0, NULL, NULL, TIMEOUT, &migrateHandler, &req);
+   } while (retry_request(&req));
 
-   if (statusG != S3StatusOK)
+   if (req.status != S3StatusOK)
    {
-      LOG(LOG_ERR, "failed to migrate %s from bucket %s to bucket %s (%s)\n", objID, srcBucketContext.bucketName, destBucket, S3_get_status_name(statusG));
+      LOG(LOG_ERR, "failed to migrate %s from bucket %s to bucket %s (%s)\n", objID, srcBucketContext.bucketName, destBucket, S3_get_status_name(req.status));
       free(srcBucket);
       free(destBucket);
       errno = EIO;
@@ -819,16 +932,15 @@ int s3_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_location
    if (offline)
    {
       // Give several tries to delete object
-      i = TRIES;
+      s3_request dreq = {0};
       do
       {
-         S3_delete_object(&srcBucketContext, objID, NULL, TIMEOUT, &delHandler, NULL);
-         i--;
-      } while (S3_status_is_retryable(statusG) && i >= 0);
+         S3_delete_object(&srcBucketContext, objID, NULL, TIMEOUT, &delHandler, &dreq);
+      } while (retry_request(&dreq));
 
-      if (statusG != S3StatusOK)
+      if (dreq.status != S3StatusOK)
       {
-         LOG(LOG_ERR, "failed to delete \"%s/%s\" (%s)\n", srcBucketContext.bucketName, objID, S3_get_status_name(statusG));
+         LOG(LOG_ERR, "failed to delete \"%s/%s\" (%s)\n", srcBucketContext.bucketName, objID, S3_get_status_name(dreq.status));
          free(srcBucket);
          free(destBucket);
          errno = EIO;
@@ -873,16 +985,15 @@ int s3_del(DAL_CTXT ctxt, DAL_location location, const char *objID)
    };
 
    // Give several tries to delete object
-   int i = TRIES;
+   s3_request req = {0};
    do
    {
-      S3_delete_object(&bucketContext, objID, NULL, TIMEOUT, &delHandler, NULL);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      S3_delete_object(&bucketContext, objID, NULL, TIMEOUT, &delHandler, &req);
+   } while (retry_request(&req));
 
-   if (statusG != S3StatusOK)
+   if (req.status != S3StatusOK)
    {
-      LOG(LOG_ERR, "failed to delete \"%s/%s\" (%s)\n", bucketContext.bucketName, objID, S3_get_status_name(statusG));
+      LOG(LOG_ERR, "failed to delete \"%s/%s\" (%s)\n", bucketContext.bucketName, objID, S3_get_status_name(req.status));
       free(bucket);
       errno = EIO;
       return -1;
@@ -924,16 +1035,15 @@ int s3_stat(DAL_CTXT ctxt, DAL_location location, const char *objID)
    };
 
    // Give several tries to detect object
-   int i = TRIES;
+   s3_request req = {0};
    do
    {
-      S3_head_object(&bucketContext, objID, NULL, TIMEOUT, &statHandler, NULL);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      S3_head_object(&bucketContext, objID, NULL, TIMEOUT, &statHandler, &req);
+   } while (retry_request(&req));
 
-   if (statusG != S3StatusOK)
+   if (req.status != S3StatusOK)
    {
-      LOG(LOG_ERR, "failed to stat \"%s/%s\" (%s)\n", bucketContext.bucketName, objID, S3_get_status_name(statusG));
+      LOG(LOG_ERR, "failed to stat \"%s/%s\" (%s)\n", bucketContext.bucketName, objID, S3_get_status_name(req.status));
       free(bucket);
       errno = EIO;
       return -1;
@@ -982,6 +1092,11 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
 
    bctxt->mode = mode;
    bctxt->seq = 1;
+   bctxt->parts = NULL;
+   bctxt->parts_len = 0;
+   bctxt->reaped = 0;
+   bctxt->upload_id = NULL;
+   bctxt->inflight = dctxt->inflight;
 
    if (strlen(objID) == 0)
    {
@@ -990,8 +1105,16 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
    bctxt->key = strdup(objID);
    bctxt->meta = NULL;
 
-   bctxt->data_gb = 0;
-   bctxt->data_size = 0;
+   // Each block handle drives its own concurrent requests, allowing handles to be used from separate threads
+   S3Status status;
+   if ((status = S3_create_request_context(&(bctxt->rctxt))) != S3StatusOK)
+   {
+      LOG(LOG_ERR, "failed to create a request context for \"%s\" (%s)\n", bctxt->key, S3_get_status_name(status));
+      free(bctxt->key);
+      free(bctxt);
+      errno = ENOMEM;
+      return NULL;
+   }
 
    // Form bucket from location
    int size = sizeof(char) * (4 + num_digits(location.block) + num_digits(location.cap) + num_digits(location.scatter));
@@ -1028,16 +1151,16 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
       }
 
       // Give several tries to initiate a multipart upload
-      int i = TRIES;
+      s3_request req = {.ref = bctxt};
       do
       {
-         S3_initiate_multipart(bctxt->bucketContext, bctxt->key, NULL, &initHandler, NULL, TIMEOUT, bctxt);
-         i--;
-      } while (S3_status_is_retryable(statusG) && i >= 0);
+         S3_initiate_multipart(bctxt->bucketContext, bctxt->key, NULL, &initHandler, NULL, TIMEOUT, &req);
+      } while (retry_request(&req));
 
-      if (statusG != S3StatusOK)
+      if (req.status != S3StatusOK)
       {
-         LOG(LOG_ERR, "failed to initiate multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+         LOG(LOG_ERR, "failed to initiate multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(req.status));
+         S3_destroy_request_context(bctxt->rctxt);
          free(bctxt->bucket);
          free(bctxt->bucketContext);
          free(bctxt->key);
@@ -1046,9 +1169,6 @@ BLOCK_CTXT s3_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const ch
          errno = EIO;
          return NULL;
       }
-
-      bctxt->part_gb = 0;
-      bctxt->part_size = growbuffer_append(&(bctxt->part_gb), "<CompleteMultipartUpload>", strlen("<CompleteMultipartUpload>"));
    }
 
    return bctxt;
@@ -1080,35 +1200,74 @@ int s3_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
       return -1;
    }
 
-   // Add data to growbuffer to be handed to libs3
-   bctxt->data_size = size;
-   if (!growbuffer_append(&(bctxt->data_gb), buf, size))
+   // Split the data into as many concurrent parts as the minimum part size allows
+   int nparts = size / PART_MIN;
+   if (nparts > bctxt->inflight)
    {
-      LOG(LOG_ERR, "data not appended to growbuffer\n");
-      growbuffer_destroy(bctxt->data_gb);
-      bctxt->data_size = 0;
-      return -1;
+      nparts = bctxt->inflight;
    }
+   if (nparts < 1)
+   {
+      nparts = 1;
+   }
+   size_t partsz = size / nparts;
 
-   // Give several tries to add data to the object's multipart upload
-   int i = TRIES;
-   do
+   // Extend the part list, if necessary
+   if (bctxt->seq - 1 + nparts > bctxt->parts_len)
    {
-      S3_upload_part(bctxt->bucketContext, bctxt->key, NULL, &putHandler, bctxt->seq, bctxt->upload_id, size, NULL, TIMEOUT, bctxt);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      int len = (bctxt->parts_len) ? bctxt->parts_len * 2 : 16;
+      while (bctxt->seq - 1 + nparts > len)
+      {
+         len *= 2;
+      }
+      s3_request **parts = realloc(bctxt->parts, sizeof(s3_request *) * len);
+      if (parts == NULL)
+      {
+         LOG(LOG_ERR, "failed to extend the part list to %d entries\n", len);
+         return -1;
+      } // realloc will set errno
+      bctxt->parts = parts;
+      bctxt->parts_len = len;
+   }
 
-   if (statusG != S3StatusOK)
+   // Each part is uploaded straight out of the caller's buffer
+   int p;
+   for (p = 0; p < nparts; p++)
    {
-      LOG(LOG_ERR, "failed to upload part %d of \"%s/%s\" (%s)\n", bctxt->seq, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
-      errno = EIO;
-      growbuffer_destroy(bctxt->data_gb);
-      bctxt->data_size = 0;
+      s3_request *part = calloc(1, sizeof(s3_request));
+      if (part == NULL)
+      {
+         LOG(LOG_ERR, "failed to allocate state for part %d\n", bctxt->seq + p);
+         while (p > 0)
+         {
+            p--;
+            free(bctxt->parts[bctxt->seq - 1 + p]);
+         }
+         return -1;
+      } // calloc will set errno
+      part->data = (char *)buf + (p * partsz);
+      part->size = (p == nparts - 1) ? size - (p * partsz) : partsz;
+      part->seq = bctxt->seq + p;
+      part->ref = bctxt;
+      bctxt->parts[bctxt->seq - 1 + p] = part;
+   }
+   for (p = 0; p < nparts; p++)
+   {
+      submit_part(bctxt, bctxt->parts[bctxt->seq - 1]);
+      bctxt->seq++;
+   }
+
+   // Wait for every part, as the caller may reuse its buffer once we return
+   if (reap_parts(bctxt, 0))
+   {
+      // a part which failed permanently may leave its siblings in flight, still referencing the buffer
+      reset_requests(bctxt);
+      for (p = 1; p <= nparts; p++)
+      {
+         bctxt->parts[bctxt->seq - 1 - p]->data = NULL;
+      }
       return -1;
    }
-   bctxt->seq++;
-   growbuffer_destroy(bctxt->data_gb);
-   bctxt->data_size = 0;
    return 0;
 }
 
@@ -1128,36 +1287,80 @@ ssize_t s3_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
       return -1;
    }
 
-   bctxt->data_size = 0;
+   // Split the request into concurrent ranged gets
+   int nranges = (size + GET_RANGE - 1) / GET_RANGE;
+   if (nranges > bctxt->inflight)
+   {
+      nranges = bctxt->inflight;
+   }
+   if (nranges < 1)
+   {
+      nranges = 1;
+   }
+   size_t rangesz = size / nranges;
+   s3_request ranges[MAX_INFLIGHT];
+   memset(ranges, 0, sizeof(s3_request) * nranges);
+   int r;
+   for (r = 0; r < nranges; r++)
+   {
+      ranges[r].data = (char *)buf + (r * rangesz);
+      ranges[r].offset = offset + (r * rangesz);
+      ranges[r].size = (r == nranges - 1) ? size - (r * rangesz) : rangesz;
+      ranges[r].active = 1;
+      S3_get_object(bctxt->bucketContext, bctxt->key, NULL, ranges[r].offset, ranges[r].size, bctxt->rctxt, TIMEOUT, &getHandler, &(ranges[r]));
+   }
 
-   // Give several tries to retrieve data from specified location
-   int i = TRIES;
+   // Wait for all ranges to complete, giving several tries to retrieve each
+   int resubmitted;
+   ssize_t retval = 0;
    do
    {
-      S3_get_object(bctxt->bucketContext, bctxt->key, NULL, offset, size, NULL, TIMEOUT, &getHandler, bctxt);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      if (run_requests(bctxt, 0))
+      {
+         retval = -1;
+         break;
+      }
+      resubmitted = 0;
+      for (r = 0; r < nranges; r++)
+      {
+         if (ranges[r].status == S3StatusErrorInvalidRange && r > 0)
+         {
+            // this range begins beyond the end of the object
+            ranges[r].status = S3StatusOK;
+         }
+         if (ranges[r].status == S3StatusOK)
+         {
+            continue;
+         }
+         if (!retry_request(&(ranges[r])))
+         {
+            LOG(LOG_ERR, "failed to read %zu bytes at offset %zd from \"%s/%s\" (%s)\n", ranges[r].size, (ssize_t)ranges[r].offset, bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(ranges[r].status));
+            errno = EIO;
+            retval = -1;
+            continue;
+         }
+         ranges[r].active = 1;
+         S3_get_object(bctxt->bucketContext, bctxt->key, NULL, ranges[r].offset, ranges[r].size, bctxt->rctxt, TIMEOUT, &getHandler, &(ranges[r]));
+         resubmitted = 1;
+      }
+   } while (resubmitted);
 
-   if (statusG != S3StatusOK)
+   if (retval)
    {
-      LOG(LOG_ERR, "failed to read from \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
-      errno = EIO;
-      growbuffer_destroy(bctxt->data_gb);
-      return -1;
+      return retval;
    }
 
-   // Add data in growbuffer to buf
-   int ret = 0;
-   size = 0;
-   do
+   // Each range was received straight into the caller's buffer; count up to the first short one
+   for (r = 0; r < nranges; r++)
    {
-      growbuffer_read(&(bctxt->data_gb), bctxt->data_size, &ret, buf);
-      buf += ret;
-      size += ret;
-   } while (ret > 0);
-   growbuffer_destroy(bctxt->data_gb);
+      retval += ranges[r].done;
+      if (ranges[r].done < ranges[r].size)
+      {
+         break;
+      }
+   }
 
-   return size;
+   return retval;
 }
 
 int s3_abort(BLOCK_CTXT ctxt)
@@ -1178,17 +1381,23 @@ int s3_abort(BLOCK_CTXT ctxt)
 
    int retval = 0;
 
+   // terminate any part uploads still in flight
+   if (bctxt->rctxt)
+   {
+      S3_destroy_request_context(bctxt->rctxt);
+   }
+
    // abort the multipart upload
-   int i = TRIES;
+   s3_request req = {0};
    do
    {
       S3_abort_multipart_upload(bctxt->bucketContext, bctxt->key, bctxt->upload_id, TIMEOUT, &abortHandler);
-      i--;
-   } while (S3_status_is_retryable(statusG) && i >= 0);
+      req.status = abortStatus;
+   } while (retry_request(&req));
 
-   if (statusG != S3StatusOK)
+   if (req.status != S3StatusOK)
    {
-      LOG(LOG_ERR, "failed to abort multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+      LOG(LOG_ERR, "failed to abort multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(req.status));
       errno = EIO;
       retval = -1;
    }
@@ -1198,10 +1407,7 @@ int s3_abort(BLOCK_CTXT ctxt)
    {
       free(bctxt->meta);
    }
-   if (bctxt->part_gb)
-   {
-      growbuffer_destroy(bctxt->part_gb);
-   }
+   free_parts(bctxt);
    free(bctxt->upload_id);
    free(bctxt->bucket);
    free(bctxt->bucketContext);
@@ -1222,20 +1428,40 @@ int s3_close(BLOCK_CTXT ctxt)
    // Commit any data written
    if (bctxt->mode == DAL_WRITE || bctxt->mode == DAL_REBUILD)
    {
+      // Wait for every part to be uploaded
+      if (reap_parts(bctxt, 0))
+      {
+         return -1;
+      }
 
-      bctxt->part_size += growbuffer_append(&(bctxt->part_gb), "</CompleteMultipartUpload>", strlen("</CompleteMultipartUpload>"));
+      // Assemble the part list, which must be in part number order
+      size_t len = strlen("<CompleteMultipartUpload></CompleteMultipartUpload>") + (PART_XML_SIZE * (bctxt->seq - 1)) + 1;
+      char *partlist = malloc(len);
+      if (partlist == NULL)
+      {
+         LOG(LOG_ERR, "failed to allocate a part list for \"%s/%s\"\n", bctxt->bucketContext->bucketName, bctxt->key);
+         return -1;
+      } // malloc will set errno
+      size_t off = snprintf(partlist, len, "<CompleteMultipartUpload>");
+      int p;
+      for (p = 0; p < bctxt->seq - 1; p++)
+      {
+         off += snprintf(partlist + off, len - off, "<Part><ETag>%.*s</ETag><PartNumber>%d</PartNumber></Part>",
+                         PART_XML_SIZE - 64, (bctxt->parts[p]->etag) ? bctxt->parts[p]->etag : "", bctxt->parts[p]->seq);
+      }
+      off += snprintf(partlist + off, len - off, "</CompleteMultipartUpload>");
 
       // Give several tries to complete the multipart upload
-      int i = TRIES;
+      s3_request req = {.ref = bctxt, .data = partlist, .size = off};
       do
       {
-         S3_complete_multipart_upload(bctxt->bucketContext, bctxt->key, &commitHandler, bctxt->upload_id, bctxt->part_size, NULL, TIMEOUT, bctxt);
-         i--;
-      } while (S3_status_is_retryable(statusG) && i >= 0);
+         S3_complete_multipart_upload(bctxt->bucketContext, bctxt->key, &commitHandler, bctxt->upload_id, req.size, NULL, TIMEOUT, &req);
+      } while (retry_request(&req));
+      free(partlist);
 
-      if (statusG != S3StatusOK)
+      if (req.status != S3StatusOK)
       {
-         LOG(LOG_ERR, "failed to complete multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+         LOG(LOG_ERR, "failed to complete multipart upload for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(req.status));
          errno = EIO;
          return -1;
       }
@@ -1264,30 +1490,30 @@ int s3_close(BLOCK_CTXT ctxt)
          };
 
          // Give several tries to write metadata
-         i = TRIES;
+         s3_request mreq = {0};
          do
          {
-            S3_copy_object(bctxt->bucketContext, bctxt->key, NULL, NULL, &setMetaProperties, NULL, 0, NULL, NULL, TIMEOUT, &setMetaHandler, NULL);
-            i--;
-         } while (S3_status_is_retryable(statusG) && i >= 0);
+            S3_copy_object(bctxt->bucketContext, bctxt->key, NULL, NULL, &setMetaProperties, NULL, 0, NULL, NULL, TIMEOUT, &setMetaHandler, &mreq);
+         } while (retry_request(&mreq));
 
-         if (statusG != S3StatusOK)
+         if (mreq.status != S3StatusOK)
          {
-            LOG(LOG_ERR, "failed to upload metadata for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(statusG));
+            LOG(LOG_ERR, "failed to upload metadata for \"%s/%s\" (%s)\n", bctxt->bucketContext->bucketName, bctxt->key, S3_get_status_name(mreq.status));
             errno = EIO;
             return -1;
          }
          free(bctxt->meta);
       }
 
-      if (bctxt->part_gb)
-      {
-         growbuffer_destroy(bctxt->part_gb);
-      }
+      free_parts(bctxt);
       free(bctxt->upload_id);
    }
 
    // free state
+   if (bctxt->rctxt)
+   {
+      S3_destroy_request_context(bctxt->rctxt);
+   }
    free(bctxt->bucket);
    free(bctxt->bucketContext);
    free(bctxt->key);
@@ -1349,6 +1575,7 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
          dctxt->max_loc = max_loc;
 
          size_t io_size = IO_SIZE;
+         dctxt->inflight = INFLIGHT;
 
          // find the access key, secret key, and region. Fail if any are missing
          while (root != NULL)
@@ -1372,10 +1599,18 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
                   io_size = atol((char *)root->children->content);
                }
             }
+            else if (root->type == XML_ELEMENT_NODE && strncmp((char *)root->name, "inflight", 9) == 0)
+            {
+               dctxt->inflight = atoi((char *)root->children->content);
+            }
             root = root->next;
          }
 
-         if (dctxt->accessKey == NULL || dctxt->secretKey == NULL || dctxt->region == NULL)
+         if (dctxt->inflight < 1 || dctxt->inflight > MAX_INFLIGHT)
+         {
+            LOG(LOG_ERR, "the \"inflight\" value of %d is outside the allowable range of 1 to %d\n", dctxt->inflight, MAX_INFLIGHT);
+         }
+         if (dctxt->accessKey == NULL || dctxt->secretKey == NULL || dctxt->region == NULL || dctxt->inflight < 1 || dctxt->inflight > MAX_INFLIGHT)
          {
             if (dctxt->accessKey != NULL)
             {
@@ -1407,14 +1642,13 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
          }
 
          // test for a connection to the S3 server
-         int i = TRIES;
+         s3_request req = {0};
          do
          {
-            S3_list_service(S3ProtocolHTTP, dctxt->accessKey, dctxt->secretKey, NULL, hostname, dctxt->region, NULL, TIMEOUT, &listHandler, NULL);
-            i--;
-         } while (S3_status_is_retryable(statusG) && i >= 0);
+            S3_list_service(S3ProtocolHTTP, dctxt->accessKey, dctxt->secretKey, NULL, hostname, dctxt->region, NULL, TIMEOUT, &listHandler, &req);
+         } while (retry_request(&req));
 
-         if (statusG != S3StatusOK)
+         if (req.status != S3StatusOK)
          {
             LOG(LOG_ERR, "failed to verify connection to S3 server\n");
             free(dctxt->accessKey);
@@ -1439,13 +1673,16 @@ DAL s3_dal_init(xmlNode *root, DAL_location max_loc)
          s3dal->name = "s3";
          s3dal->ctxt = (DAL_CTXT)dctxt;
          s3dal->io_size = io_size;
+         s3dal->io_depth = 0;
          s3dal->verify = s3_verify;
          s3dal->migrate = s3_migrate;
          s3dal->open = s3_open;
          s3dal->set_meta = s3_set_meta;
          s3dal->get_meta = s3_get_meta;
          s3dal->put = s3_put;
+         s3dal->putv = NULL; // parts of a multipart upload must each be at least PART_MIN bytes
          s3dal->get = s3_get;
+         s3dal->getv = NULL;
          s3dal->abort = s3_abort;
          s3dal->close = s3_close;
          s3dal->del = s3_del;
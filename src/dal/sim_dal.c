@@ -0,0 +1,1191 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include "marfs_auto_config.h"
+#ifdef DEBUG_DAL
+#define DEBUG DEBUG_DAL
+#elif (defined DEBUG_ALL)
+#define DEBUG DEBUG_ALL
+#endif
+#define LOG_PREFIX "sim_dal"
+#include "logging/logging.h"
+
+#include "dal.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//   -------------    SIM DEFINITIONS    -------------
+
+#define IO_SIZE 1048576 // Preferred I/O Size
+#define STORE_BUCKETS 4096 // Number of hash chains in the object store
+#define NSEC_PER_SEC 1000000000ULL
+#define DEFAULT_SEED 1 // RNG seed used in the absence of a 'seed' definition
+
+// latency distributions
+#define DIST_FIXED       0 // every operation takes exactly 'latency'
+#define DIST_UNIFORM     1 // uniform over [ latency - spread, latency + spread ]
+#define DIST_NORMAL      2 // normal, with mean 'latency' and standard deviation 'spread'
+#define DIST_EXPONENTIAL 3 // 'latency', plus an exponential tail with mean 'spread'
+
+// flags indicating which values a 'timing' definition set explicitly
+#define SET_LATENCY   0x1
+#define SET_SPREAD    0x2
+#define SET_DIST      0x4
+#define SET_BANDWIDTH 0x8
+#define SET_STRAGGLE  0x10
+#define SET_SLOWDOWN  0x20
+#define SET_STALL     0x40
+
+//   -------------    SIM CONTEXT    -------------
+
+typedef struct sim_profile_struct
+{
+   int pod;          // location values this profile applies to ( -1 matches any value )
+   int cap;
+   int block;
+   int scatter;
+   int set;          // SET_* flags of values defined by this profile
+   int dist;         // DIST_* distribution of per-operation latency
+   uint64_t latency; // nanoseconds
+   uint64_t spread;  // nanoseconds
+   double bandwidth; // bytes per second ( zero for unlimited )
+   double straggle;  // probability that a block handle is a straggler
+   double slowdown;  // factor by which all operations of a straggler are slowed
+   char stall;       // flag indicating that data reads are held until sim_dal_release() is called
+} SIM_PROFILE;
+
+typedef struct sim_link_struct
+{
+   pthread_mutex_t lock;
+   uint64_t busy; // time at which all transfers reserved on this link will have completed
+} * SIM_LINK;
+
+typedef struct sim_object_struct
+{
+   void*      data;
+   size_t     size;
+   meta_info minfo;
+   char     hasmeta;
+   int         refs; // store entry + open READ handles ( protected by the store lock )
+} * SIM_OBJECT;
+
+typedef struct sim_entry_struct
+{
+   char*                     key;
+   SIM_OBJECT                obj;
+   struct sim_entry_struct* next;
+} * SIM_ENTRY;
+
+typedef struct sim_dal_context_struct
+{
+   char        storeref;     // flag indicating that this DAL holds a reference to the object store
+   SIM_LINK   links;         // one transfer link per pod/cap/block
+   DAL_location   max_loc;
+   SIM_PROFILE     defprof;  // timing of any location not matched by a more specific profile
+   SIM_PROFILE*   profiles;  // location specific timing profiles
+   int             profcnt;
+   uint64_t           seed;
+} * SIM_DAL_CTXT;
+
+typedef struct sim_block_context_struct
+{
+   SIM_DAL_CTXT       dctxt; // Global DAL context
+   DAL_MODE            mode; // Mode of this block ctxt
+   char*                key; // Store key of the target object
+   const SIM_PROFILE*  prof; // Timing profile of the target location
+   SIM_LINK            link; // Transfer link of the target location
+   uint64_t             rng; // RNG state, seeded from the target location and object
+   char           straggler; // Flag indicating that all operations on this handle are slowed
+   SIM_OBJECT           obj; // Referenced object ( READ ) or unpublished object ( WRITE )
+   size_t             alloc; // Allocated size of an unpublished object's data buffer
+} * SIM_BLOCK_CTXT;
+
+// all Sim DALs of a process share a single object store, so that objects written through one
+//  DAL instance ( or libne context ) may be read through another, as with a real backend
+static pthread_mutex_t sim_store_lock = PTHREAD_MUTEX_INITIALIZER;
+static SIM_ENTRY* sim_store_chains = NULL; // hash chains of stored objects
+static int sim_store_users = 0; // count of DAL instances referencing the store
+
+// reads of any 'stall' location are held until the process calls sim_dal_release(), allowing tests to
+//  produce an unresponsive block without depending upon the relative speed of any other operations
+static pthread_mutex_t sim_stall_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_stall_cond = PTHREAD_COND_INITIALIZER;
+static char sim_stall_released = 0;
+
+//   -------------    SIM INTERNAL FUNCTIONS    -------------
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Produce the next value of a splitmix64 sequence
+ * @param uint64_t* state : Reference to the RNG state
+ * @return uint64_t : Pseudo-random value
+ */
+static uint64_t sim_rand( uint64_t* state ) {
+   uint64_t z = ( *state += 0x9E3779B97F4A7C15ULL );
+   z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+   z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+   return z ^ ( z >> 31 );
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Produce a pseudo-random value in the range [0,1)
+ * @param uint64_t* state : Reference to the RNG state
+ * @return double : Pseudo-random value
+ */
+static double sim_uniform( uint64_t* state ) {
+   return (double)( sim_rand( state ) >> 11 ) / (double)( 1ULL << 53 );
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Seed an RNG from the DAL seed and the given location and object, so that a benchmark replays
+ *  the same sequence of timings for each block, regardless of thread scheduling
+ * @param SIM_DAL_CTXT dctxt : DAL context
+ * @param const char* key : Store key of the target object
+ * @param DAL_MODE mode : Mode of the operation(s) being timed
+ * @return uint64_t : Initial RNG state
+ */
+static uint64_t sim_seed( SIM_DAL_CTXT dctxt, const char* key, DAL_MODE mode ) {
+   uint64_t hash = 14695981039346656037ULL; // FNV-1a
+   for ( ; *key != '\0'; key++ ) {
+      hash ^= (unsigned char)*key;
+      hash *= 1099511628211ULL;
+   }
+   uint64_t state = dctxt->seed ^ hash ^ ( (uint64_t)mode << 56 );
+   sim_rand( &state ); // discard the first value, which is poorly mixed across similar keys
+   return state;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Sample the latency of a single operation from the given profile
+ * @param const SIM_PROFILE* prof : Timing profile
+ * @param uint64_t* rng : Reference to the RNG state
+ * @return double : Latency in nanoseconds
+ */
+static double sim_latency( const SIM_PROFILE* prof, uint64_t* rng ) {
+   double latency = (double)prof->latency;
+   double spread = (double)prof->spread;
+   switch ( prof->dist ) {
+      case DIST_UNIFORM:
+         latency += spread * ( ( 2.0 * sim_uniform( rng ) ) - 1.0 );
+         break;
+      case DIST_NORMAL: {
+         // Box-Muller transform ( 1 - u avoids log(0) )
+         double u1 = 1.0 - sim_uniform( rng );
+         double u2 = sim_uniform( rng );
+         latency += spread * sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+         break;
+      }
+      case DIST_EXPONENTIAL:
+         latency -= spread * log( 1.0 - sim_uniform( rng ) );
+         break;
+   }
+   return ( latency > 0.0 ) ? latency : 0.0;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Get the current time
+ * @return uint64_t : Nanoseconds on the monotonic clock
+ */
+static uint64_t sim_now( void ) {
+   struct timespec ts;
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+   return ( (uint64_t)ts.tv_sec * NSEC_PER_SEC ) + ts.tv_nsec;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Emulate the timing of a single operation, sleeping until it would have completed
+ * @param const SIM_PROFILE* prof : Timing profile of the target location
+ * @param SIM_LINK link : Transfer link of the target location ( may be NULL, if 'bytes' is zero )
+ * @param uint64_t* rng : Reference to the RNG state
+ * @param char straggler : Flag indicating that the operation should be slowed
+ * @param size_t bytes : Volume of data transferred by the operation
+ */
+static void sim_delay( const SIM_PROFILE* prof, SIM_LINK link, uint64_t* rng, char straggler, size_t bytes ) {
+   double slowdown = ( straggler ) ? prof->slowdown : 1.0;
+   uint64_t finish = sim_now() + (uint64_t)( sim_latency( prof, rng ) * slowdown );
+   if ( bytes  &&  prof->bandwidth > 0.0 ) {
+      // transfers to a single location are serialized, each beginning once its latency has
+      //  elapsed and all previously reserved transfers have completed
+      uint64_t transfer = (uint64_t)( ( (double)bytes * NSEC_PER_SEC / prof->bandwidth ) * slowdown );
+      pthread_mutex_lock( &(link->lock) );
+      if ( link->busy > finish ) { finish = link->busy; }
+      finish += transfer;
+      link->busy = finish;
+      pthread_mutex_unlock( &(link->lock) );
+   }
+   struct timespec deadline = { .tv_sec = finish / NSEC_PER_SEC, .tv_nsec = finish % NSEC_PER_SEC };
+   while ( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL ) == EINTR ) {}
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Identify the timing profile applicable to the given location
+ * @param SIM_DAL_CTXT dctxt : DAL context
+ * @param DAL_location location : Target location
+ * @return const SIM_PROFILE* : The last defined profile matching the location, or the default profile
+ */
+static const SIM_PROFILE* sim_profile( SIM_DAL_CTXT dctxt, DAL_location location ) {
+   int index = dctxt->profcnt - 1;
+   for ( ; index >= 0; index-- ) {
+      const SIM_PROFILE* prof = dctxt->profiles + index;
+      if ( ( prof->pod == -1  ||  prof->pod == location.pod )  &&
+           ( prof->cap == -1  ||  prof->cap == location.cap )  &&
+           ( prof->block == -1  ||  prof->block == location.block )  &&
+           ( prof->scatter == -1  ||  prof->scatter == location.scatter ) ) {
+         return prof;
+      }
+   }
+   return &(dctxt->defprof);
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Identify the transfer link of the given location
+ * NOTE -- locations beyond the DAL's max_loc wrap around, sharing a link with some lower location
+ * @param SIM_DAL_CTXT dctxt : DAL context
+ * @param DAL_location location : Target location
+ * @return SIM_LINK : Transfer link shared by all scatters of the location's pod/cap/block
+ */
+static SIM_LINK sim_link( SIM_DAL_CTXT dctxt, DAL_location location ) {
+   size_t pods = dctxt->max_loc.pod + 1;
+   size_t caps = dctxt->max_loc.cap + 1;
+   size_t blocks = dctxt->max_loc.block + 1;
+   size_t index = ( ( ( (size_t)abs(location.pod) % pods ) * caps ) + ( (size_t)abs(location.cap) % caps ) ) * blocks
+                  + ( (size_t)abs(location.block) % blocks );
+   return dctxt->links + index;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Generate the store key of the given object
+ * @param DAL_location location : Object location
+ * @param const char* objID : Object ID
+ * @return char* : Allocated key string, or NULL on failure
+ */
+static char* sim_key( DAL_location location, const char* objID ) {
+   size_t keylen = snprintf( NULL, 0, "%d.%d.%d.%d/%s", location.pod, location.cap, location.block, location.scatter, objID );
+   char* key = malloc( keylen + 1 );
+   if ( key == NULL ) {
+      LOG( LOG_ERR, "failed to allocate an object key\n" );
+      return NULL;
+   }
+   snprintf( key, keylen + 1, "%d.%d.%d.%d/%s", location.pod, location.cap, location.block, location.scatter, objID );
+   return key;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Locate the store entry reference associated with the given key ( store lock must be held )
+ * @param const char* key : Store key
+ * @return SIM_ENTRY* : Reference to the matching entry pointer, or to the terminating NULL
+ *                      pointer of the key's hash chain
+ */
+static SIM_ENTRY* sim_find( const char* key ) {
+   uint64_t hash = 14695981039346656037ULL; // FNV-1a
+   const char* parse = key;
+   for ( ; *parse != '\0'; parse++ ) {
+      hash ^= (unsigned char)*parse;
+      hash *= 1099511628211ULL;
+   }
+   SIM_ENTRY* ref = sim_store_chains + ( hash % STORE_BUCKETS );
+   while ( *ref  &&  strcmp( (*ref)->key, key ) ) { ref = &((*ref)->next); }
+   return ref;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Drop a reference to the given object, freeing it once no references remain ( store lock must be held )
+ * @param SIM_OBJECT obj : Object to release
+ */
+static void sim_release( SIM_OBJECT obj ) {
+   obj->refs--;
+   if ( obj->refs <= 0 ) {
+      free( obj->data );
+      free( obj );
+   }
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Associate the given object with the given key, replacing any existing object ( store lock must be held )
+ * NOTE -- this consumes one reference to the object, even on failure
+ * @param const char* key : Store key
+ * @param SIM_OBJECT obj : Object to be stored
+ * @return int : Zero on success, -1 on failure
+ */
+static int sim_store( const char* key, SIM_OBJECT obj ) {
+   SIM_ENTRY* ref = sim_find( key );
+   if ( *ref ) {
+      sim_release( (*ref)->obj );
+      (*ref)->obj = obj;
+      return 0;
+   }
+   SIM_ENTRY entry = malloc( sizeof( struct sim_entry_struct ) );
+   if ( entry == NULL ) {
+      LOG( LOG_ERR, "failed to allocate a store entry\n" );
+      sim_release( obj );
+      return -1;
+   }
+   entry->key = strdup( key );
+   if ( entry->key == NULL ) {
+      LOG( LOG_ERR, "failed to duplicate a store key\n" );
+      free( entry );
+      sim_release( obj );
+      return -1;
+   }
+   entry->obj = obj;
+   entry->next = NULL;
+   *ref = entry;
+   return 0;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Remove the given store entry ( store lock must be held )
+ * @param SIM_ENTRY* ref : Reference to the entry pointer
+ */
+static void sim_unstore( SIM_ENTRY* ref ) {
+   SIM_ENTRY entry = *ref;
+   *ref = entry->next;
+   sim_release( entry->obj );
+   free( entry->key );
+   free( entry );
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Parse a time value, in nanoseconds
+ * @param const char* valuestr : Value string, with an optional "ns"/"us"/"ms"/"s" unit ( microseconds, by default )
+ * @param uint64_t* target : Reference to the value to populate
+ * @return int : Zero on success, -1 on error
+ */
+static int sim_parse_time( const char* valuestr, uint64_t* target ) {
+   char* endptr = NULL;
+   double value = strtod( valuestr, &(endptr) );
+   double unitmult = 1000.0;
+   if ( endptr == valuestr  ||  value < 0.0 ) {
+      LOG( LOG_ERR, "invalid time value: \"%s\"\n", valuestr );
+      return -1;
+   }
+   if ( strcmp( endptr, "ns" ) == 0 ) { unitmult = 1.0; }
+   else if ( strcmp( endptr, "us" ) == 0 ) { unitmult = 1000.0; }
+   else if ( strcmp( endptr, "ms" ) == 0 ) { unitmult = 1000000.0; }
+   else if ( strcmp( endptr, "s" ) == 0 ) { unitmult = 1000000000.0; }
+   else if ( *endptr != '\0' ) {
+      LOG( LOG_ERR, "encountered unrecognized unit in time value: \"%s\"\n", valuestr );
+      return -1;
+   }
+   *target = (uint64_t)( value * unitmult );
+   return 0;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Parse a size value
+ * @param const char* valuestr : Value string, with an optional "K"/"M"/"G"/"T" unit
+ * @param double* target : Reference to the value to populate
+ * @return int : Zero on success, -1 on error
+ */
+static int sim_parse_size( const char* valuestr, double* target ) {
+   char* endptr = NULL;
+   double value = strtod( valuestr, &(endptr) );
+   double unitmult = 1.0;
+   if ( endptr == valuestr  ||  value < 0.0 ) {
+      LOG( LOG_ERR, "invalid size value: \"%s\"\n", valuestr );
+      return -1;
+   }
+   if ( *endptr != '\0' ) {
+      if ( *endptr == 'K' ) { unitmult = 1024.0; }
+      else if ( *endptr == 'M' ) { unitmult = 1048576.0; }
+      else if ( *endptr == 'G' ) { unitmult = 1073741824.0; }
+      else if ( *endptr == 'T' ) { unitmult = 1099511627776.0; }
+      else {
+         LOG( LOG_ERR, "encountered unrecognized unit in size value: \"%s\"\n", valuestr );
+         return -1;
+      }
+      if ( *(endptr + 1) != '\0' ) {
+         LOG( LOG_ERR, "encountered unrecognized trailing character in size value: \"%s\"\n", valuestr );
+         return -1;
+      }
+   }
+   *target = value * unitmult;
+   return 0;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Parse the attributes of a 'timing' node
+ * @param xmlNode* node : Node to be parsed
+ * @param SIM_PROFILE* prof : Reference to the profile to populate
+ * @return int : Zero on success, -1 on error
+ */
+static int sim_parse_timing( xmlNode* node, SIM_PROFILE* prof ) {
+   prof->pod = -1;
+   prof->cap = -1;
+   prof->block = -1;
+   prof->scatter = -1;
+   xmlAttr* attr = node->properties;
+   for ( ; attr; attr = attr->next ) {
+      if ( attr->type != XML_ATTRIBUTE_NODE ) {
+         LOG( LOG_ERR, "Encountered unrecognized property type of Sim DAL 'timing' definition\n" );
+         return -1;
+      }
+      if ( attr->children == NULL  ||  attr->children->type != XML_TEXT_NODE  ||  attr->children->content == NULL ) {
+         LOG( LOG_ERR, "Encountered a \"%s\" property of Sim DAL 'timing' definition with no associated value\n", (char*)attr->name );
+         return -1;
+      }
+      const char* value = (char*)attr->children->content;
+      int* selector = NULL;
+      if ( strcasecmp( (char*)attr->name, "pod" ) == 0 ) { selector = &(prof->pod); }
+      else if ( strcasecmp( (char*)attr->name, "cap" ) == 0 ) { selector = &(prof->cap); }
+      else if ( strcasecmp( (char*)attr->name, "block" ) == 0 ) { selector = &(prof->block); }
+      else if ( strcasecmp( (char*)attr->name, "scatter" ) == 0 ) { selector = &(prof->scatter); }
+      else if ( strcasecmp( (char*)attr->name, "latency" ) == 0 ) {
+         if ( sim_parse_time( value, &(prof->latency) ) ) { return -1; }
+         prof->set |= SET_LATENCY;
+      }
+      else if ( strcasecmp( (char*)attr->name, "spread" ) == 0 ) {
+         if ( sim_parse_time( value, &(prof->spread) ) ) { return -1; }
+         prof->set |= SET_SPREAD;
+      }
+      else if ( strcasecmp( (char*)attr->name, "dist" ) == 0 ) {
+         if ( strcasecmp( value, "fixed" ) == 0 ) { prof->dist = DIST_FIXED; }
+         else if ( strcasecmp( value, "uniform" ) == 0 ) { prof->dist = DIST_UNIFORM; }
+         else if ( strcasecmp( value, "normal" ) == 0 ) { prof->dist = DIST_NORMAL; }
+         else if ( strcasecmp( value, "exponential" ) == 0 ) { prof->dist = DIST_EXPONENTIAL; }
+         else {
+            LOG( LOG_ERR, "Invalid Sim DAL 'timing' dist value ( expected 'fixed', 'uniform', 'normal', or 'exponential' ): \"%s\"\n", value );
+            return -1;
+         }
+         prof->set |= SET_DIST;
+      }
+      else if ( strcasecmp( (char*)attr->name, "bandwidth" ) == 0 ) {
+         if ( sim_parse_size( value, &(prof->bandwidth) ) ) { return -1; }
+         prof->set |= SET_BANDWIDTH;
+      }
+      else if ( strcasecmp( (char*)attr->name, "straggle" ) == 0 ) {
+         char* endptr = NULL;
+         prof->straggle = strtod( value, &(endptr) );
+         if ( endptr == value  ||  *endptr != '\0'  ||  prof->straggle < 0.0  ||  prof->straggle > 1.0 ) {
+            LOG( LOG_ERR, "Invalid Sim DAL 'timing' straggle probability: \"%s\"\n", value );
+            return -1;
+         }
+         prof->set |= SET_STRAGGLE;
+      }
+      else if ( strcasecmp( (char*)attr->name, "stall" ) == 0 ) {
+         if ( strcmp( value, "0" ) == 0 ) { prof->stall = 0; }
+         else if ( strcmp( value, "1" ) == 0 ) { prof->stall = 1; }
+         else {
+            LOG( LOG_ERR, "Invalid Sim DAL 'timing' stall value ( expected '0' or '1' ): \"%s\"\n", value );
+            return -1;
+         }
+         prof->set |= SET_STALL;
+      }
+      else if ( strcasecmp( (char*)attr->name, "slowdown" ) == 0 ) {
+         char* endptr = NULL;
+         prof->slowdown = strtod( value, &(endptr) );
+         if ( endptr == value  ||  *endptr != '\0'  ||  prof->slowdown < 1.0 ) {
+            LOG( LOG_ERR, "Invalid Sim DAL 'timing' slowdown factor: \"%s\"\n", value );
+            return -1;
+         }
+         prof->set |= SET_SLOWDOWN;
+      }
+      else {
+         LOG( LOG_ERR, "Encountered an unrecognized \"%s\" property of Sim DAL 'timing' definition\n", (char*)attr->name );
+         return -1;
+      }
+      if ( selector ) {
+         char* endptr = NULL;
+         long parsevalue = strtol( value, &(endptr), 10 );
+         if ( endptr == value  ||  *endptr != '\0'  ||  parsevalue < 0  ||  parsevalue > INT_MAX ) {
+            LOG( LOG_ERR, "Invalid Sim DAL 'timing' %s value: \"%s\"\n", (char*)attr->name, value );
+            return -1;
+         }
+         *selector = (int)parsevalue;
+      }
+   }
+   return 0;
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Populate any values not explicitly set by a profile from another profile
+ * @param SIM_PROFILE* prof : Profile to be populated
+ * @param const SIM_PROFILE* source : Profile to inherit values from
+ */
+static void sim_inherit( SIM_PROFILE* prof, const SIM_PROFILE* source ) {
+   if ( !(prof->set & SET_LATENCY) ) { prof->latency = source->latency; }
+   if ( !(prof->set & SET_SPREAD) ) { prof->spread = source->spread; }
+   if ( !(prof->set & SET_DIST) ) { prof->dist = source->dist; }
+   if ( !(prof->set & SET_BANDWIDTH) ) { prof->bandwidth = source->bandwidth; }
+   if ( !(prof->set & SET_STRAGGLE) ) { prof->straggle = source->straggle; }
+   if ( !(prof->set & SET_SLOWDOWN) ) { prof->slowdown = source->slowdown; }
+   if ( !(prof->set & SET_STALL) ) { prof->stall = source->stall; }
+   prof->set |= source->set;
+}
+
+
+//   -------------    SIM IMPLEMENTATION    -------------
+
+/**
+ * Release all reads held by a 'stall' timing definition, both those currently waiting and any future ones
+ * NOTE -- this applies to every Sim DAL instance of the process
+ */
+void sim_dal_release( void )
+{
+   pthread_mutex_lock( &sim_stall_lock );
+   sim_stall_released = 1;
+   pthread_cond_broadcast( &sim_stall_cond );
+   pthread_mutex_unlock( &sim_stall_lock );
+}
+
+int sim_verify(DAL_CTXT ctxt, int flags)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal context!\n");
+      return -1;
+   }
+   // nothing to verify for an in-memory store
+   return 0;
+}
+
+int sim_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_location dest, char offline)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal context!\n");
+      return -1;
+   }
+   SIM_DAL_CTXT dctxt = (SIM_DAL_CTXT)ctxt; // Should have been passed a DAL context
+   // a migration that changes only the block value is never permitted
+   if ( src.pod == dest.pod  &&  src.cap == dest.cap  &&  src.scatter == dest.scatter )
+   {
+      LOG(LOG_ERR, "cannot migrate an object to a location differing only by block\n");
+      errno = EINVAL;
+      return -1;
+   }
+   char* srckey = sim_key( src, objID );
+   if ( srckey == NULL ) { return -1; }
+   char* destkey = sim_key( dest, objID );
+   if ( destkey == NULL ) { free( srckey ); return -1; }
+   uint64_t rng = sim_seed( dctxt, srckey, DAL_WRITE );
+   const SIM_PROFILE* prof = sim_profile( dctxt, dest );
+   char straggler = ( sim_uniform( &rng ) < prof->straggle );
+
+   pthread_mutex_lock( &sim_store_lock );
+   SIM_ENTRY* ref = sim_find( srckey );
+   if ( *ref == NULL )
+   {
+      pthread_mutex_unlock( &sim_store_lock );
+      LOG(LOG_ERR, "failed to locate source object \"%s\"\n", srckey );
+      free( srckey );
+      free( destkey );
+      errno = ENOENT;
+      return -1;
+   }
+   SIM_OBJECT obj = (*ref)->obj;
+   size_t size = obj->size;
+   obj->refs++; // objects are never modified once stored, so both locations may share one
+   if ( sim_store( destkey, obj ) )
+   {
+      pthread_mutex_unlock( &sim_store_lock );
+      free( srckey );
+      free( destkey );
+      return -1;
+   }
+   if ( offline )
+   {
+      // the store may have been modified, so locate the source entry again
+      sim_unstore( sim_find( srckey ) );
+   }
+   pthread_mutex_unlock( &sim_store_lock );
+   free( srckey );
+   free( destkey );
+
+   // an offline migration is a rename, while an online migration copies all data to the destination
+   sim_delay( prof, sim_link( dctxt, dest ), &rng, straggler, ( offline ) ? 0 : size );
+   return 0;
+}
+
+int sim_del(DAL_CTXT ctxt, DAL_location location, const char *objID)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal context!\n");
+      return -1;
+   }
+   SIM_DAL_CTXT dctxt = (SIM_DAL_CTXT)ctxt; // Should have been passed a DAL context
+   char* key = sim_key( location, objID );
+   if ( key == NULL ) { return -1; }
+   uint64_t rng = sim_seed( dctxt, key, DAL_WRITE );
+   const SIM_PROFILE* prof = sim_profile( dctxt, location );
+   char straggler = ( sim_uniform( &rng ) < prof->straggle );
+
+   pthread_mutex_lock( &sim_store_lock );
+   SIM_ENTRY* ref = sim_find( key );
+   if ( *ref ) { sim_unstore( ref ); }
+   pthread_mutex_unlock( &sim_store_lock );
+   free( key );
+
+   // deleting a non-existent object is not an error
+   sim_delay( prof, NULL, &rng, straggler, 0 );
+   return 0;
+}
+
+int sim_stat(DAL_CTXT ctxt, DAL_location location, const char *objID)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal context!\n");
+      return -1;
+   }
+   SIM_DAL_CTXT dctxt = (SIM_DAL_CTXT)ctxt; // Should have been passed a DAL context
+   char* key = sim_key( location, objID );
+   if ( key == NULL ) { return -1; }
+   uint64_t rng = sim_seed( dctxt, key, DAL_METAREAD );
+   const SIM_PROFILE* prof = sim_profile( dctxt, location );
+   char straggler = ( sim_uniform( &rng ) < prof->straggle );
+
+   pthread_mutex_lock( &sim_store_lock );
+   char found = ( *(sim_find( key )) != NULL );
+   pthread_mutex_unlock( &sim_store_lock );
+   free( key );
+
+   sim_delay( prof, NULL, &rng, straggler, 0 );
+   if ( !found )
+   {
+      errno = ENOENT;
+      return -1;
+   }
+   return 0;
+}
+
+int sim_cleanup(DAL dal)
+{
+   if (dal == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal!\n");
+      return -1;
+   }
+   SIM_DAL_CTXT dctxt = (SIM_DAL_CTXT)dal->ctxt; // Should have been passed a DAL context
+   // Free all stored objects, once no other DAL references them
+   if ( dctxt->storeref )
+   {
+      pthread_mutex_lock( &sim_store_lock );
+      sim_store_users--;
+      if ( sim_store_users == 0 )
+      {
+         int bucket = 0;
+         for ( ; bucket < STORE_BUCKETS; bucket++ )
+         {
+            while ( sim_store_chains[bucket] ) { sim_unstore( sim_store_chains + bucket ); }
+         }
+         free( sim_store_chains );
+         sim_store_chains = NULL;
+      }
+      pthread_mutex_unlock( &sim_store_lock );
+   }
+   // Free all links
+   if ( dctxt->links )
+   {
+      size_t linkcnt = (size_t)( dctxt->max_loc.pod + 1 ) * ( dctxt->max_loc.cap + 1 ) * ( dctxt->max_loc.block + 1 );
+      size_t index = 0;
+      for ( ; index < linkcnt; index++ ) { pthread_mutex_destroy( &(dctxt->links[index].lock) ); }
+      free( dctxt->links );
+   }
+   // Free DAL and its context state
+   free( dctxt->profiles );
+   free(dctxt);
+   free(dal);
+   return 0;
+}
+
+BLOCK_CTXT sim_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const char *objID)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL dal context!\n");
+      return NULL;
+   }
+   SIM_DAL_CTXT dctxt = (SIM_DAL_CTXT)ctxt; // Should have been passed a DAL context
+   SIM_BLOCK_CTXT bctxt = calloc( 1, sizeof(struct sim_block_context_struct) );
+   if (bctxt == NULL)
+   {
+      LOG( LOG_ERR, "failed to allocate a new block ctxt\n" );
+      return NULL;
+   }
+   bctxt->key = sim_key( location, objID );
+   if ( bctxt->key == NULL )
+   {
+      free( bctxt );
+      return NULL;
+   }
+   // populate values and global ctxt reference
+   bctxt->dctxt = dctxt;
+   bctxt->mode = mode;
+   bctxt->prof = sim_profile( dctxt, location );
+   bctxt->link = sim_link( dctxt, location );
+   bctxt->rng = sim_seed( dctxt, bctxt->key, mode );
+   bctxt->straggler = ( sim_uniform( &(bctxt->rng) ) < bctxt->prof->straggle );
+   if ( bctxt->straggler ) { LOG( LOG_INFO, "handle for \"%s\" is a straggler\n", bctxt->key ); }
+
+   if ( mode == DAL_READ  ||  mode == DAL_METAREAD )
+   {
+      // reference the current object, which will remain readable through this handle even if replaced
+      pthread_mutex_lock( &sim_store_lock );
+      SIM_ENTRY entry = *(sim_find( bctxt->key ));
+      if ( entry )
+      {
+         bctxt->obj = entry->obj;
+         bctxt->obj->refs++;
+      }
+      pthread_mutex_unlock( &sim_store_lock );
+      if ( bctxt->obj == NULL )
+      {
+         LOG( LOG_ERR, "failed to locate object \"%s\"\n", bctxt->key );
+         free( bctxt->key );
+         free( bctxt );
+         errno = ENOENT;
+         return NULL;
+      }
+   }
+   else if ( mode == DAL_WRITE  ||  mode == DAL_REBUILD )
+   {
+      // written data remains invisible until the handle is closed
+      bctxt->obj = calloc( 1, sizeof(struct sim_object_struct) );
+      if ( bctxt->obj == NULL )
+      {
+         LOG( LOG_ERR, "failed to allocate a new object\n" );
+         free( bctxt->key );
+         free( bctxt );
+         return NULL;
+      }
+      bctxt->obj->refs = 1;
+   }
+   else
+   {
+      LOG( LOG_ERR, "received an unrecognized mode value: %d\n", (int)mode );
+      free( bctxt->key );
+      free( bctxt );
+      errno = EINVAL;
+      return NULL;
+   }
+
+   sim_delay( bctxt->prof, NULL, &(bctxt->rng), bctxt->straggler, 0 );
+   return bctxt;
+}
+
+int sim_set_meta(BLOCK_CTXT ctxt, const meta_info* source)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_BLOCK_CTXT bctxt = (SIM_BLOCK_CTXT)ctxt; // Should have been passed a block context
+   // validate mode
+   if ( bctxt->mode != DAL_WRITE  &&  bctxt->mode != DAL_REBUILD ) {
+      LOG( LOG_ERR, "received block handle has inappropriate mode\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   bctxt->obj->minfo = *source;
+   bctxt->obj->hasmeta = 1;
+   sim_delay( bctxt->prof, NULL, &(bctxt->rng), bctxt->straggler, 0 );
+   return 0;
+}
+
+int sim_get_meta(BLOCK_CTXT ctxt, meta_info* dest )
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_BLOCK_CTXT bctxt = (SIM_BLOCK_CTXT)ctxt; // Should have been passed a block context
+   // validate mode
+   if ( bctxt->mode != DAL_READ  &&  bctxt->mode != DAL_METAREAD ) {
+      LOG( LOG_ERR, "received block handle has inappropriate mode\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   sim_delay( bctxt->prof, NULL, &(bctxt->rng), bctxt->straggler, 0 );
+   if ( !(bctxt->obj->hasmeta) ) {
+      LOG( LOG_ERR, "object \"%s\" has no meta info\n", bctxt->key );
+      errno = ENOENT;
+      return -1;
+   }
+   *dest = bctxt->obj->minfo;
+   return 0;
+}
+
+int sim_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_BLOCK_CTXT bctxt = (SIM_BLOCK_CTXT)ctxt; // Should have been passed a block context
+   // validate mode
+   if ( bctxt->mode != DAL_WRITE  &&  bctxt->mode != DAL_REBUILD ) {
+      LOG( LOG_ERR, "received block handle has inappropriate mode\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_OBJECT obj = bctxt->obj;
+   size_t total = 0;
+   int index = 0;
+   for ( ; index < iovcnt; index++ ) { total += iov[index].iov_len; }
+   // grow the data buffer geometrically, so that many small puts remain cheap
+   if ( obj->size + total > bctxt->alloc ) {
+      size_t alloc = ( bctxt->alloc ) ? bctxt->alloc : IO_SIZE;
+      while ( alloc < obj->size + total ) { alloc *= 2; }
+      void* data = realloc( obj->data, alloc );
+      if ( data == NULL ) {
+         LOG( LOG_ERR, "failed to expand object data buffer to %zu bytes\n", alloc );
+         return -1;
+      }
+      obj->data = data;
+      bctxt->alloc = alloc;
+   }
+   for ( index = 0; index < iovcnt; index++ ) {
+      memcpy( obj->data + obj->size, iov[index].iov_base, iov[index].iov_len );
+      obj->size += iov[index].iov_len;
+   }
+   sim_delay( bctxt->prof, bctxt->link, &(bctxt->rng), bctxt->straggler, total );
+   return 0;
+}
+
+int sim_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
+{
+   struct iovec iov = { .iov_base = (void*)buf, .iov_len = size };
+   return sim_putv( ctxt, &iov, 1 );
+}
+
+ssize_t sim_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_BLOCK_CTXT bctxt = (SIM_BLOCK_CTXT)ctxt; // Should have been passed a block context
+   // validate mode
+   if ( bctxt->mode != DAL_READ ) {
+      LOG( LOG_ERR, "received block handle has inappropriate mode\n" );
+      errno = EINVAL;
+      return -1;
+   }
+   if ( offset < 0 ) {
+      LOG( LOG_ERR, "received a negative offset: %zd\n", offset );
+      errno = EINVAL;
+      return -1;
+   }
+   if ( bctxt->prof->stall ) {
+      LOG( LOG_INFO, "holding read of stalled object \"%s\"\n", bctxt->key );
+      pthread_mutex_lock( &sim_stall_lock );
+      while ( !(sim_stall_released) ) { pthread_cond_wait( &sim_stall_cond, &sim_stall_lock ); }
+      pthread_mutex_unlock( &sim_stall_lock );
+   }
+   // reads at or beyond EOF return zero bytes
+   size_t copysize = 0;
+   if ( (size_t)offset < bctxt->obj->size ) {
+      copysize = bctxt->obj->size - offset;
+      if ( copysize > size ) { copysize = size; }
+      memcpy( buf, bctxt->obj->data + offset, copysize );
+   }
+   sim_delay( bctxt->prof, bctxt->link, &(bctxt->rng), bctxt->straggler, copysize );
+   return copysize;
+}
+
+int sim_abort(BLOCK_CTXT ctxt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_BLOCK_CTXT bctxt = (SIM_BLOCK_CTXT)ctxt; // Should have been passed a block context
+   // discard any unpublished object, or our reference to a read object
+   pthread_mutex_lock( &sim_store_lock );
+   sim_release( bctxt->obj );
+   pthread_mutex_unlock( &sim_store_lock );
+   // Free block context
+   free( bctxt->key );
+   free( bctxt );
+   return 0;
+}
+
+int sim_close(BLOCK_CTXT ctxt)
+{
+   if (ctxt == NULL)
+   {
+      LOG(LOG_ERR, "received a NULL block context!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   SIM_BLOCK_CTXT bctxt = (SIM_BLOCK_CTXT)ctxt; // Should have been passed a block context
+   if ( bctxt->mode != DAL_WRITE  &&  bctxt->mode != DAL_REBUILD ) {
+      return sim_abort( ctxt ); // nothing to publish for a read handle
+   }
+   // trim any excess buffer space before the object becomes visible
+   SIM_OBJECT obj = bctxt->obj;
+   if ( obj->size  &&  obj->size < bctxt->alloc ) {
+      void* data = realloc( obj->data, obj->size );
+      if ( data ) { obj->data = data; }
+   }
+   sim_delay( bctxt->prof, NULL, &(bctxt->rng), bctxt->straggler, 0 );
+   // publish the object, replacing any existing one
+   pthread_mutex_lock( &sim_store_lock );
+   int retval = sim_store( bctxt->key, obj );
+   pthread_mutex_unlock( &sim_store_lock );
+   // Free block context
+   free( bctxt->key );
+   free( bctxt );
+   return retval;
+}
+
+//   -------------    SIM INITIALIZATION    -------------
+
+DAL sim_dal_init(xmlNode *root, DAL_location max_loc)
+{
+   // allocate space for our context struct ( initialized to zero vals, by calloc )
+   SIM_DAL_CTXT dctxt = calloc( 1, sizeof(struct sim_dal_context_struct) );
+   if (dctxt == NULL)
+   {
+      LOG( LOG_ERR, "failed to allocate a new DAL ctxt\n" );
+      return NULL;
+   }
+   dctxt->max_loc = max_loc;
+   dctxt->seed = DEFAULT_SEED;
+   // by default, operations complete immediately
+   dctxt->defprof.pod = -1;
+   dctxt->defprof.cap = -1;
+   dctxt->defprof.block = -1;
+   dctxt->defprof.scatter = -1;
+   dctxt->defprof.slowdown = 1.0;
+
+   // allocate and populate a new DAL structure
+   DAL sdal = calloc( 1, sizeof(struct DAL_struct) );
+   if (sdal == NULL)
+   {
+      LOG(LOG_ERR, "failed to allocate space for a DAL_struct\n");
+      free(dctxt);
+      return NULL;
+   }
+   sdal->name = "sim";
+   sdal->ctxt = (DAL_CTXT)dctxt;
+   sdal->io_size = IO_SIZE;
+   sdal->io_depth = 0;
+   sdal->verify = sim_verify;
+   sdal->migrate = sim_migrate;
+   sdal->open = sim_open;
+   sdal->set_meta = sim_set_meta;
+   sdal->get_meta = sim_get_meta;
+   sdal->put = sim_put;
+   sdal->putv = sim_putv;
+   sdal->get = sim_get;
+   sdal->getv = NULL; // each get() is served from a single in-memory buffer
+   sdal->abort = sim_abort;
+   sdal->close = sim_close;
+   sdal->del = sim_del;
+   sdal->stat = sim_stat;
+   sdal->cleanup = sim_cleanup;
+
+   if ( max_loc.pod < 0  ||  max_loc.cap < 0  ||  max_loc.block < 0 ) {
+      LOG( LOG_ERR, "received an invalid max location\n" );
+      sim_cleanup(sdal);
+      errno = EINVAL;
+      return NULL;
+   }
+
+   // loop over XML elements, parsing timing definitions
+   for ( ; root != NULL; root = root->next ) {
+      // validate + parse this node
+      if ( root->type != XML_ELEMENT_NODE ) {
+         // skip comment nodes
+         if ( root->type == XML_COMMENT_NODE ) { continue; }
+         // skip text nodes ( could occur if we are passed an empty DAL tag body )
+         if ( root->type == XML_TEXT_NODE ) { continue; }
+         LOG( LOG_ERR, "encountered unknown node within a Sim DAL definition\n" );
+         break;
+      }
+      if ( strncmp( (char*)root->name, "io", 3 ) == 0 ) {
+         xmlAttr* attr = root->properties;
+         for ( ; attr; attr = attr->next ) {
+            if ( attr->type != XML_ATTRIBUTE_NODE  ||  attr->children == NULL  ||
+                 attr->children->type != XML_TEXT_NODE  ||  attr->children->content == NULL ) {
+               LOG( LOG_ERR, "Encountered an invalid \"%s\" property of Sim DAL 'io' definition\n", (char*)attr->name );
+               break;
+            }
+            if ( strncasecmp( (char*)attr->name, "size", 5 ) == 0 ) {
+               double io_size = 0.0;
+               if ( sim_parse_size( (char*)attr->children->content, &(io_size) )  ||  io_size < 1.0 ) {
+                  LOG( LOG_ERR, "Failed to parse Sim DAL 'io' size value: \"%s\"\n", (char*)attr->children->content );
+                  break;
+               }
+               sdal->io_size = (size_t)io_size;
+            }
+            else {
+               LOG( LOG_ERR, "Encountered an unrecognized \"%s\" property of Sim DAL 'io' definition\n", (char*)attr->name );
+               break;
+            }
+         }
+         if ( attr ) { break; } // indicates a 'break' from the above loop
+      }
+      else if ( strncmp( (char*)root->name, "seed", 5 ) == 0 ) {
+         char* endptr = NULL;
+         if ( root->children == NULL  ||  root->children->type != XML_TEXT_NODE  ||  root->children->content == NULL ) {
+            LOG( LOG_ERR, "failed to identify a value string within the 'seed' definition\n" );
+            break;
+         }
+         dctxt->seed = strtoull( (char*)root->children->content, &(endptr), 10 );
+         if ( *endptr != '\0' ) {
+            LOG( LOG_ERR, "encountered unrecognized trailing character in 'seed' value: \"%c\"\n", *endptr );
+            break;
+         }
+      }
+      else if ( strncmp( (char*)root->name, "timing", 7 ) == 0 ) {
+         SIM_PROFILE prof;
+         memset( &prof, 0, sizeof(SIM_PROFILE) );
+         if ( sim_parse_timing( root, &prof ) ) {
+            LOG( LOG_ERR, "failed to parse 'timing' definition\n" );
+            break;
+         }
+         if ( prof.pod == -1  &&  prof.cap == -1  &&  prof.block == -1  &&  prof.scatter == -1 ) {
+            // a definition without location values alters the default profile
+            sim_inherit( &prof, &(dctxt->defprof) );
+            dctxt->defprof = prof;
+         }
+         else {
+            SIM_PROFILE* profiles = realloc( dctxt->profiles, sizeof(SIM_PROFILE) * ( dctxt->profcnt + 1 ) );
+            if ( profiles == NULL ) {
+               LOG( LOG_ERR, "failed to allocate space for a new timing profile\n" );
+               break;
+            }
+            profiles[dctxt->profcnt] = prof;
+            dctxt->profiles = profiles;
+            dctxt->profcnt++;
+         }
+      }
+      else {
+         LOG( LOG_ERR, "encountered an unrecognized \"%s\" node within a Sim DAL definition\n", (char*)root->name );
+         break;
+      }
+   }
+   // check for fatal error
+   if ( root ) {
+      sim_cleanup(sdal);
+      errno = EINVAL;
+      return NULL;
+   }
+   // location specific profiles inherit any unset values from the default, regardless of definition order
+   int index = 0;
+   for ( ; index < dctxt->profcnt; index++ ) { sim_inherit( dctxt->profiles + index, &(dctxt->defprof) ); }
+
+   // allocate our transfer links
+   size_t linkcnt = (size_t)( max_loc.pod + 1 ) * ( max_loc.cap + 1 ) * ( max_loc.block + 1 );
+   dctxt->links = calloc( linkcnt, sizeof(struct sim_link_struct) );
+   if ( dctxt->links == NULL ) {
+      LOG( LOG_ERR, "failed to allocate transfer links\n" );
+      sim_cleanup(sdal);
+      return NULL;
+   }
+   size_t linkindex = 0;
+   for ( ; linkindex < linkcnt; linkindex++ ) { pthread_mutex_init( &(dctxt->links[linkindex].lock), NULL ); }
+
+   // reference the shared object store, allocating it if this is the first Sim DAL
+   pthread_mutex_lock( &sim_store_lock );
+   if ( sim_store_chains == NULL ) {
+      sim_store_chains = calloc( STORE_BUCKETS, sizeof(SIM_ENTRY) );
+      if ( sim_store_chains == NULL ) {
+         pthread_mutex_unlock( &sim_store_lock );
+         LOG( LOG_ERR, "failed to allocate object store\n" );
+         sim_cleanup(sdal);
+         return NULL;
+      }
+   }
+   sim_store_users++;
+   dctxt->storeref = 1;
+   pthread_mutex_unlock( &sim_store_lock );
+
+   return sdal;
+}
+
@@ -112,25 +112,57 @@ int main(int argc, char **argv)
       return -1;
    }
 
+   // generate reference data, which the DAL must store despite O_DIRECT alignment requirements
+   size_t datalen = (4 * 1024) + 5000 + (8 * 1024) + 3;
+   char *databuffer = malloc(datalen);
+   if (databuffer == NULL)
+   {
+      printf("error: failed to allocate data buffer\n");
+      return -1;
+   }
+   size_t i;
+   for (i = 0; i < datalen; i++)
+   {
+      databuffer[i] = (char)((i * 7) + (i >> 9));
+   }
+
    // Open, write to, and set meta info for a specific block
-   void *writebuffer = aligned_alloc(4 * 1024, 4 * 1024);
+   char *writebuffer = aligned_alloc(4 * 1024, 16 * 1024);
    if (writebuffer == NULL)
    {
       printf("error: failed to allocate write buffer\n");
       return -1;
    }
-   bzero( writebuffer, 4 * 1024 );
    BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, maxloc, "");
    if (block == NULL)
    {
       printf("error: failed to open block context for write: %s\n", strerror(errno));
       return -1;
    }
+   // an aligned buffer and size
+   memcpy(writebuffer, databuffer, (4 * 1024));
    if (dal->put(block, writebuffer, (4 * 1024)))
    {
       printf("error: put did not return expected value\n");
       return -1;
    }
+   // an unaligned buffer and size
+   memcpy(writebuffer + 1, databuffer + (4 * 1024), 5000);
+   if (dal->put(block, writebuffer + 1, 5000))
+   {
+      printf("error: unaligned put did not return expected value\n");
+      return -1;
+   }
+   // aligned buffers, following unaligned data, and leaving an unaligned tail
+   memcpy(writebuffer, databuffer + (4 * 1024) + 5000, (8 * 1024));
+   memcpy(writebuffer + (12 * 1024), databuffer + (12 * 1024) + 5000, 3);
+   struct iovec iov[2] = { { .iov_base = writebuffer, .iov_len = (8 * 1024) },
+                           { .iov_base = writebuffer + (12 * 1024), .iov_len = 3 } };
+   if (dal->putv(block, iov, 2))
+   {
+      printf("error: putv did not return expected value\n");
+      return -1;
+   }
    meta_info meta_val = { .N = 3, .E = 1, .O = 3, .partsz = 4096, .versz = 1048576, .blocksz = 10485760, .crcsum = 1234567, .totsz = 7654321 };
    if (dal->set_meta(block, &meta_val))
    {
@@ -144,29 +176,85 @@ int main(int argc, char **argv)
    }
 
    // Open the same block for read and verify all values
-   void *readbuffer = aligned_alloc(4 * 1024, 4 * 1024);
+   char *readbuffer = aligned_alloc(4 * 1024, 20 * 1024);
    if (readbuffer == NULL)
    {
       printf("error: failed to allocate read buffer\n");
       return -1;
    }
-   bzero( readbuffer, 4 * 1024 );
+   bzero( readbuffer, 20 * 1024 );
    block = dal->open(dal->ctxt, DAL_READ, maxloc, "");
    if (block == NULL)
    {
       printf("error: failed to open block context for read: %s\n", strerror(errno));
       return -1;
    }
-   if (dal->get(block, readbuffer, (4 * 1024), 0) != (4 * 1024))
+   // an aligned read, extending beyond the end of the data
+   if (dal->get(block, readbuffer, (20 * 1024), 0) != datalen)
    {
       printf("error: get did not return expected value\n");
       return -1;
    }
-   if (memcmp(writebuffer, readbuffer, (4 * 1024)))
+   if (memcmp(databuffer, readbuffer, datalen))
    {
       printf("error: retrieved data does not match written!\n");
       return -1;
    }
+   // an unaligned buffer, offset, and size
+   if (dal->get(block, readbuffer + 1, 100, (4 * 1024) + 1) != 100)
+   {
+      printf("error: unaligned get did not return expected value\n");
+      return -1;
+   }
+   if (memcmp(databuffer + (4 * 1024) + 1, readbuffer + 1, 100))
+   {
+      printf("error: unaligned retrieved data does not match written!\n");
+      return -1;
+   }
+   // an aligned read, entirely within the data
+   if (dal->get(block, readbuffer, (8 * 1024), (8 * 1024)) != (8 * 1024))
+   {
+      printf("error: aligned get did not return expected value\n");
+      return -1;
+   }
+   if (memcmp(databuffer + (8 * 1024), readbuffer, (8 * 1024)))
+   {
+      printf("error: aligned retrieved data does not match written!\n");
+      return -1;
+   }
+   // vectored reads laid out as IO units, with each unit's data packed contiguously and its trailing 4 bytes set aside
+   int units;
+   for (units = 4; units <= 5; units++)
+   {
+      struct iovec uiov[10];
+      uint32_t trailers[5];
+      int u;
+      for (u = 0; u < units; u++)
+      {
+         uiov[(u * 2)].iov_base = readbuffer + (u * 4092);
+         uiov[(u * 2)].iov_len = 4092;
+         uiov[(u * 2) + 1].iov_base = &(trailers[u]);
+         uiov[(u * 2) + 1].iov_len = 4;
+      }
+      bzero( readbuffer, 20 * 1024 );
+      // the final unit extends beyond the end of the data, producing a short read
+      ssize_t expected = (units * 4096 > datalen) ? datalen : (units * 4096);
+      if (dal->getv == NULL || dal->getv(block, uiov, units * 2, 0) != expected)
+      {
+         printf("error: getv of %d IO units did not return expected value\n", units);
+         return -1;
+      }
+      for (u = 0; u < units; u++)
+      {
+         size_t ulen = ((u + 1) * 4096 > datalen) ? datalen - (u * 4096) : 4096;
+         size_t dlen = (ulen > 4092) ? 4092 : ulen;
+         if (memcmp(databuffer + (u * 4096), readbuffer + (u * 4092), dlen) || (ulen > 4092 && memcmp(databuffer + (u * 4096) + 4092, &(trailers[u]), 4)))
+         {
+            printf("error: retrieved data of IO unit %d of %d does not match written!\n", u, units);
+            return -1;
+         }
+      }
+   }
    meta_info readmeta;
    if (dal->get_meta(block, &readmeta))
    {
@@ -199,6 +287,7 @@ int main(int argc, char **argv)
    }
 
    /*free the document */
+   free(databuffer);
    free(writebuffer);
    free(readbuffer);
 
@@ -0,0 +1,340 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include "dal/dal.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <time.h>
+
+// elapsed time since the given start, in milliseconds
+double elapsed_ms( struct timespec* start )
+{
+   struct timespec now;
+   clock_gettime( CLOCK_MONOTONIC, &now );
+   return ( ( now.tv_sec - start->tv_sec ) * 1000.0 ) + ( ( now.tv_nsec - start->tv_nsec ) / 1000000.0 );
+}
+
+int main(int argc, char **argv)
+{
+
+   DAL_location maxloc = {.pod = 1, .block = 12, .cap = 2, .scatter = 124};
+   DAL_location curloc = {.pod = 0, .block = 0, .cap = 1, .scatter = 123};
+
+   xmlDoc *doc = NULL;
+   xmlNode *root_element = NULL;
+
+   /*
+    * this initialize the library and check potential ABI mismatches
+    * between the version it was compiled for and the actual shared
+    * library used.
+    */
+   LIBXML_TEST_VERSION
+
+      /*parse the file and get the DOM */
+      doc = xmlReadFile("./testing/sim_config.xml", NULL, XML_PARSE_NOBLANKS);
+
+   if (doc == NULL)
+   {
+      printf("error: could not parse file %s\n", "./dal/testing/sim_config.xml");
+      return -1;
+   }
+
+   /*Get the root element node */
+   root_element = xmlDocGetRootElement(doc);
+
+   // initialize our sim dal
+   DAL dal = init_dal( root_element, maxloc );
+
+   /* Free the xml Doc */
+   xmlFreeDoc(doc);
+   /*
+    *Free the global variables that may
+    *have been allocated by the parser.
+    */
+   xmlCleanupParser();
+
+   // check that initialization succeeded
+   if (dal == NULL)
+   {
+      printf("error: failed to initialize Sim DAL: %s\n", strerror(errno));
+      return -1;
+   }
+
+   // allocate some buffers
+   char* writebuffer = malloc(1024 * 1024);
+   char* readbuffer = malloc(1024 * 1024);
+   if (writebuffer == NULL || readbuffer == NULL)
+   {
+      printf("error: failed to allocate buffers\n");
+      return -1;
+   }
+   int i;
+   for ( i = 0; i < 1024 * 1024; i++ ) { writebuffer[i] = (char)(i % 251); }
+
+   // Open, write to, and set meta info for a specific block
+   BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, curloc, "sim-object");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for write: %s\n", strerror(errno));
+      return -1;
+   }
+   if (dal->put(block, writebuffer, (4 * 1024)) || dal->put(block, writebuffer + (4 * 1024), (6 * 1024)))
+   {
+      printf("error: put did not return expected value\n");
+      return -1;
+   }
+   meta_info meta_val = { .N = 3, .E = 1, .O = 3, .partsz = 4096, .versz = 1048576, .blocksz = 10240, .crcsum = 1234567, .totsz = 7654321 };
+   if (dal->set_meta(block, &meta_val))
+   {
+      printf("error: set_meta did not return expected value\n");
+      return -1;
+   }
+   // written data should not be visible until close
+   if (dal->stat(dal->ctxt, curloc, "sim-object") == 0)
+   {
+      printf("error: stat located an unclosed object\n");
+      return -1;
+   }
+   if (dal->close(block))
+   {
+      printf("error: failed to close block write context: %s\n", strerror(errno));
+      return -1;
+   }
+   if (dal->stat(dal->ctxt, curloc, "sim-object"))
+   {
+      printf("error: stat failed to locate a written object\n");
+      return -1;
+   }
+
+   // Open the same block for read and verify all values
+   BLOCK_CTXT rblock = dal->open(dal->ctxt, DAL_READ, curloc, "sim-object");
+   if (rblock == NULL)
+   {
+      printf("error: failed to open block context for read: %s\n", strerror(errno));
+      return -1;
+   }
+   if (dal->get(rblock, readbuffer, (1024 * 1024), 0) != (10 * 1024))
+   {
+      printf("error: get did not return expected value\n");
+      return -1;
+   }
+   if (memcmp(writebuffer, readbuffer, (10 * 1024)))
+   {
+      printf("error: retrieved data does not match written!\n");
+      return -1;
+   }
+   if (dal->get(rblock, readbuffer, (10 * 1024), (5 * 1024)) != (5 * 1024) || memcmp(writebuffer + (5 * 1024), readbuffer, (5 * 1024)))
+   {
+      printf("error: offset get did not return expected data\n");
+      return -1;
+   }
+   if (dal->get(rblock, readbuffer, (10 * 1024), (10 * 1024)) != 0)
+   {
+      printf("error: get at EOF did not return zero\n");
+      return -1;
+   }
+   meta_info readmeta;
+   if (dal->get_meta(rblock, &readmeta))
+   {
+      printf("error: get_meta returned an unexpected value\n");
+      return -1;
+   }
+   if (cmp_minfo(&meta_val, &readmeta) || meta_val.crcsum != readmeta.crcsum)
+   {
+      printf("error: retrieved meta value does not match written!\n");
+      return -1;
+   }
+
+   // Rebuild the same block, while the read handle remains open
+   block = dal->open(dal->ctxt, DAL_REBUILD, curloc, "sim-object");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for rebuild: %s\n", strerror(errno));
+      return -1;
+   }
+   if (dal->put(block, writebuffer + 1, (8 * 1024)) || dal->set_meta(block, &meta_val) || dal->close(block))
+   {
+      printf("error: failed to rebuild block\n");
+      return -1;
+   }
+   // the existing read handle should still reference the original data
+   if (dal->get(rblock, readbuffer, (1024 * 1024), 0) != (10 * 1024) || memcmp(writebuffer, readbuffer, (10 * 1024)))
+   {
+      printf("error: rebuild altered the data of an open read handle\n");
+      return -1;
+   }
+   if (dal->close(rblock))
+   {
+      printf("error: failed to close block read context: %s\n", strerror(errno));
+      return -1;
+   }
+   rblock = dal->open(dal->ctxt, DAL_READ, curloc, "sim-object");
+   if (rblock == NULL || dal->get(rblock, readbuffer, (1024 * 1024), 0) != (8 * 1024) ||
+       memcmp(writebuffer + 1, readbuffer, (8 * 1024)) || dal->close(rblock))
+   {
+      printf("error: failed to read rebuilt block\n");
+      return -1;
+   }
+
+   // An aborted write should leave no object behind
+   block = dal->open(dal->ctxt, DAL_WRITE, curloc, "aborted-object");
+   if (block == NULL || dal->put(block, writebuffer, 1024) || dal->abort(block))
+   {
+      printf("error: failed to write and abort an object\n");
+      return -1;
+   }
+   if (dal->stat(dal->ctxt, curloc, "aborted-object") == 0 || dal->open(dal->ctxt, DAL_READ, curloc, "aborted-object") != NULL)
+   {
+      printf("error: located an aborted object\n");
+      return -1;
+   }
+
+   // Migration should refuse to alter only the block value
+   DAL_location destloc = curloc;
+   destloc.block = 1;
+   if (dal->migrate(dal->ctxt, "sim-object", curloc, destloc, 1) == 0)
+   {
+      printf("error: migrate permitted a block-only relocation\n");
+      return -1;
+   }
+   // Migrate offline to another pod
+   destloc = curloc;
+   destloc.pod = 1;
+   if (dal->migrate(dal->ctxt, "sim-object", curloc, destloc, 1))
+   {
+      printf("error: failed to migrate object\n");
+      return -1;
+   }
+   if (dal->stat(dal->ctxt, curloc, "sim-object") == 0 || dal->stat(dal->ctxt, destloc, "sim-object"))
+   {
+      printf("error: offline migration did not relocate the object\n");
+      return -1;
+   }
+   rblock = dal->open(dal->ctxt, DAL_READ, destloc, "sim-object");
+   if (rblock == NULL || dal->get(rblock, readbuffer, (1024 * 1024), 0) != (8 * 1024) ||
+       memcmp(writebuffer + 1, readbuffer, (8 * 1024)) || dal->close(rblock))
+   {
+      printf("error: failed to read migrated block\n");
+      return -1;
+   }
+
+   // Pod 1 transfers are capped at 16MiB/s, so a 1MiB write should take at least 62.5ms
+   struct timespec start;
+   clock_gettime( CLOCK_MONOTONIC, &start );
+   block = dal->open(dal->ctxt, DAL_WRITE, destloc, "bandwidth-object");
+   if (block == NULL || dal->put(block, writebuffer, (1024 * 1024)) || dal->close(block))
+   {
+      printf("error: failed to write bandwidth-limited object\n");
+      return -1;
+   }
+   double elapsed = elapsed_ms( &start );
+   if (elapsed < 62.0)
+   {
+      printf("error: 1MiB write at 16MiB/s completed in only %.3fms\n", elapsed);
+      return -1;
+   }
+
+   // Block 3 operations have a latency of 20ms (+/-1ms)
+   curloc.block = 3;
+   clock_gettime( CLOCK_MONOTONIC, &start );
+   dal->stat(dal->ctxt, curloc, "sim-object");
+   elapsed = elapsed_ms( &start );
+   if (elapsed < 19.0)
+   {
+      printf("error: block 3 stat completed in only %.3fms\n", elapsed);
+      return -1;
+   }
+
+   // Block 4 handles always straggle, slowing each operation by a factor of 400
+   curloc.block = 4;
+   clock_gettime( CLOCK_MONOTONIC, &start );
+   dal->stat(dal->ctxt, curloc, "sim-object");
+   elapsed = elapsed_ms( &start );
+   if (elapsed < 1.0)
+   {
+      printf("error: straggling block 4 stat completed in only %.3fms\n", elapsed);
+      return -1;
+   }
+
+   // Delete the objects we created
+   if (dal->del(dal->ctxt, destloc, "sim-object") || dal->del(dal->ctxt, destloc, "bandwidth-object"))
+   {
+      printf("error: del failed!\n");
+      return -1;
+   }
+   if (dal->stat(dal->ctxt, destloc, "sim-object") == 0)
+   {
+      printf("error: located a deleted object\n");
+      return -1;
+   }
+
+   // Free the DAL
+   if (dal->cleanup(dal))
+   {
+      printf("error: failed to cleanup DAL\n");
+      return -1;
+   }
+
+   /*free buffers */
+   free(writebuffer);
+   free(readbuffer);
+
+   return 0;
+}
@@ -248,6 +248,66 @@ int main(int argc, char **argv)
   free(writebuffer);
   free(readbuffer);
 
+  // Check that the put histogram accounts for every put
+  FILE *hist = fopen("./timing_test_data_TMP/put", "r");
+  if (hist == NULL)
+  {
+    printf("error: failed to open put timing data\n");
+    return -1;
+  }
+  double lower, upper;
+  unsigned long long count, total = 0;
+  while (fscanf(hist, "%lf %lf %llu", &lower, &upper, &count) == 3)
+  {
+    if (lower > upper)
+    {
+      printf("error: put timing data has an invalid bucket range\n");
+      return -1;
+    }
+    total += count;
+  }
+  fclose(hist);
+  if (total != 1024)
+  {
+    printf("error: put timing data records %llu calls, rather than 1024\n", total);
+    return -1;
+  }
+
+  // Check that the final snapshot includes the puts
+  FILE *snap = fopen("./timing_test_data_TMP/snapshots", "r");
+  if (snap == NULL)
+  {
+    printf("error: failed to open timing snapshots\n");
+    return -1;
+  }
+  char line[256];
+  total = 0;
+  while (fgets(line, sizeof(line), snap))
+  {
+    char func[32];
+    double p50, p99, p999, max;
+    if (sscanf(line, "%*d %31s count=%llu p50=%lf p99=%lf p999=%lf max=%lf", func, &count, &p50, &p99, &p999, &max) != 6)
+    {
+      printf("error: unexpected timing snapshot format: \"%s\"\n", line);
+      return -1;
+    }
+    if (strcmp(func, "put") == 0)
+    {
+      if (p50 > p99 || p99 > p999 || p999 > max)
+      {
+        printf("error: put percentiles are out of order: \"%s\"\n", line);
+        return -1;
+      }
+      total += count;
+    }
+  }
+  fclose(snap);
+  if (total != 1024)
+  {
+    printf("error: timing snapshots record %llu puts, rather than 1024\n", total);
+    return -1;
+  }
+
   // Delete the timing data output
   if ( deletefstree( "./timing_test_data_TMP" ) ) {
     printf( "Failed to delete timing output data: \"./timing_test_data_TMP\"\n" );
@@ -0,0 +1,349 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include "dal/dal.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#define CONC_BLOCKS 8    // number of blocks written and read concurrently through the shared ring
+#define CONC_IOCNT 64    // number of IOs per block
+#define CONC_IOSZ 4096   // size of each IO
+
+typedef struct conc_arg_struct
+{
+   DAL dal;
+   DAL_location loc;
+   int result;
+} conc_arg;
+
+// write, then read back and verify, a single block via many small IOs
+void *conc_block_io(void *arg)
+{
+   conc_arg *carg = (conc_arg *)arg;
+   DAL dal = carg->dal;
+   carg->result = -1;
+   char *buffer = malloc(CONC_IOSZ);
+   if (buffer == NULL)
+   {
+      printf("error: failed to allocate buffer for block %d\n", carg->loc.block);
+      return NULL;
+   }
+   BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, carg->loc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block %d for write: %s\n", carg->loc.block, strerror(errno));
+      free(buffer);
+      return NULL;
+   }
+   int i;
+   int j;
+   for (i = 0; i < CONC_IOCNT; i++)
+   {
+      for (j = 0; j < CONC_IOSZ; j++)
+      {
+         buffer[j] = (char)(carg->loc.block + i + j);
+      }
+      if (dal->put(block, buffer, CONC_IOSZ))
+      {
+         printf("error: put %d of block %d failed\n", i, carg->loc.block);
+         dal->abort(block);
+         free(buffer);
+         return NULL;
+      }
+   }
+   meta_info meta_val = { .N = CONC_BLOCKS, .E = 0, .O = 0, .partsz = CONC_IOSZ, .versz = CONC_IOSZ, .blocksz = CONC_IOSZ * CONC_IOCNT, .crcsum = 0, .totsz = CONC_IOSZ * CONC_IOCNT * CONC_BLOCKS };
+   if (dal->set_meta(block, &meta_val) || dal->close(block))
+   {
+      printf("error: failed to finalize block %d: %s\n", carg->loc.block, strerror(errno));
+      free(buffer);
+      return NULL;
+   }
+   block = dal->open(dal->ctxt, DAL_READ, carg->loc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block %d for read: %s\n", carg->loc.block, strerror(errno));
+      free(buffer);
+      return NULL;
+   }
+   for (i = 0; i < CONC_IOCNT; i++)
+   {
+      if (dal->get(block, buffer, CONC_IOSZ, (off_t)i * CONC_IOSZ) != CONC_IOSZ)
+      {
+         printf("error: get %d of block %d failed\n", i, carg->loc.block);
+         dal->abort(block);
+         free(buffer);
+         return NULL;
+      }
+      for (j = 0; j < CONC_IOSZ; j++)
+      {
+         if (buffer[j] != (char)(carg->loc.block + i + j))
+         {
+            printf("error: data mismatch at byte %d of IO %d of block %d\n", j, i, carg->loc.block);
+            dal->abort(block);
+            free(buffer);
+            return NULL;
+         }
+      }
+   }
+   if (dal->close(block) || dal->del(dal->ctxt, carg->loc, ""))
+   {
+      printf("error: failed to close and delete block %d: %s\n", carg->loc.block, strerror(errno));
+      free(buffer);
+      return NULL;
+   }
+   free(buffer);
+   carg->result = 0;
+   return NULL;
+}
+
+int main(int argc, char **argv)
+{
+
+   xmlDoc *doc = NULL;
+   xmlNode *root_element = NULL;
+
+   /*
+   * this initialize the library and check potential ABI mismatches
+   * between the version it was compiled for and the actual shared
+   * library used.
+   */
+   LIBXML_TEST_VERSION
+
+   /*parse the file and get the DOM */
+   doc = xmlReadFile("./testing/uring_config.xml", NULL, XML_PARSE_NOBLANKS);
+
+   if (doc == NULL)
+   {
+      printf("error: could not parse file %s\n", "./dal/testing/uring_config.xml");
+      return -1;
+   }
+
+   /*Get the root element node */
+   root_element = xmlDocGetRootElement(doc);
+
+   // Initialize a posix_uring dal instance
+   DAL_location maxloc = {.pod = 1, .block = CONC_BLOCKS, .cap = 1, .scatter = 1};
+   DAL dal = init_dal(root_element, maxloc);
+
+   /* Free the xml Doc */
+   xmlFreeDoc(doc);
+   /*
+   *Free the global variables that may
+   *have been allocated by the parser.
+   */
+   xmlCleanupParser();
+
+   // check that initialization succeeded
+   if (dal == NULL)
+   {
+      printf("error: failed to initialize DAL: %s\n", strerror(errno));
+      return -1;
+   }
+   if (strcmp(dal->name, "posix_uring"))
+   {
+      // the kernel may not permit io_uring, in which case we should still have a working posix DAL
+      printf("warning: io_uring is unavailable, testing fallback \"%s\" DAL\n", dal->name);
+   }
+
+   // Open, write to, and set meta info for a specific block
+   char *writebuffer = malloc(20 * 1024);
+   if (writebuffer == NULL)
+   {
+      printf("error: failed to allocate write buffer\n");
+      return -1;
+   }
+   int i;
+   for (i = 0; i < (20 * 1024); i++)
+   {
+      writebuffer[i] = (char)(i % 251);
+   }
+   BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, maxloc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for write: %s\n", strerror(errno));
+      return -1;
+   }
+   // a simple put, followed by a vectored put, to verify write offset tracking
+   if (dal->put(block, writebuffer, (4 * 1024)))
+   {
+      printf("error: put did not return expected value\n");
+      return -1;
+   }
+   struct iovec wiov[3] = {
+      { .iov_base = writebuffer + (4 * 1024), .iov_len = (8 * 1024) },
+      { .iov_base = writebuffer + (12 * 1024), .iov_len = 1000 },
+      { .iov_base = writebuffer + (12 * 1024) + 1000, .iov_len = (8 * 1024) - 1000 }
+   };
+   if (dal->putv(block, wiov, 3))
+   {
+      printf("error: putv did not return expected value\n");
+      return -1;
+   }
+   meta_info meta_val = { .N = 3, .E = 1, .O = 3, .partsz = 4096, .versz = 1048576, .blocksz = 10485760, .crcsum = 1234567, .totsz = 7654321 };
+   if (dal->set_meta(block, &meta_val))
+   {
+      printf("error: set_meta did not return expected value\n");
+      return -1;
+   }
+   if (dal->close(block))
+   {
+      printf("error: failed to close block write context: %s\n", strerror(errno));
+      return -1;
+   }
+
+   // Open the same block for read and verify all values
+   char *readbuffer = calloc(20, 1024);
+   if (readbuffer == NULL)
+   {
+      printf("error: failed to allocate read buffer\n");
+      return -1;
+   }
+   block = dal->open(dal->ctxt, DAL_READ, maxloc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for read: %s\n", strerror(errno));
+      return -1;
+   }
+   // read the tail via get, and the rest via a vectored get
+   if (dal->get(block, readbuffer + (16 * 1024), (8 * 1024), (16 * 1024)) != (4 * 1024))
+   {
+      printf("error: get did not return expected value\n");
+      return -1;
+   }
+   struct iovec riov[2] = {
+      { .iov_base = readbuffer, .iov_len = 5000 },
+      { .iov_base = readbuffer + 5000, .iov_len = (16 * 1024) - 5000 }
+   };
+   if (dal->getv == NULL || dal->getv(block, riov, 2, 0) != (16 * 1024))
+   {
+      printf("error: getv did not return expected value\n");
+      return -1;
+   }
+   if (memcmp(writebuffer, readbuffer, (20 * 1024)))
+   {
+      printf("error: retrieved data does not match written!\n");
+      return -1;
+   }
+   meta_info readmeta;
+   if (dal->get_meta(block, &readmeta))
+   {
+      printf("error: get_meta returned an unexpected value\n");
+      return -1;
+   }
+   if (cmp_minfo(&meta_val, &readmeta))
+   {
+      printf("error: retrieved meta value does not match written!\n");
+      return -1;
+   }
+   if (dal->close(block))
+   {
+      printf("error: failed to close block read context: %s\n", strerror(errno));
+      return -1;
+   }
+
+   // Delete the block we created
+   if (dal->del(dal->ctxt, maxloc, ""))
+   {
+      printf("error: del failed!\n");
+      return -1;
+   }
+
+   // Drive many blocks concurrently, so that threads must hand off reaping of completions
+   pthread_t threads[CONC_BLOCKS];
+   conc_arg cargs[CONC_BLOCKS];
+   for (i = 0; i < CONC_BLOCKS; i++)
+   {
+      cargs[i].dal = dal;
+      cargs[i].loc = maxloc;
+      cargs[i].loc.block = i;
+      if (pthread_create(&(threads[i]), NULL, conc_block_io, &(cargs[i])))
+      {
+         printf("error: failed to create thread for block %d\n", i);
+         return -1;
+      }
+   }
+   int failed = 0;
+   for (i = 0; i < CONC_BLOCKS; i++)
+   {
+      pthread_join(threads[i], NULL);
+      if (cargs[i].result)
+      {
+         failed = 1;
+      }
+   }
+   if (failed)
+   {
+      printf("error: concurrent block IO failed\n");
+      return -1;
+   }
+
+   // Free the DAL
+   if (dal->cleanup(dal))
+   {
+      printf("error: failed to cleanup DAL\n");
+      return -1;
+   }
+
+   free(writebuffer);
+   free(readbuffer);
+
+   return 0;
+}
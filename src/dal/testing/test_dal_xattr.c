@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include "dal/dal.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+DAL init_config_dal(const char *config, DAL_location maxloc)
+{
+   xmlDoc *doc = xmlReadFile(config, NULL, XML_PARSE_NOBLANKS);
+   if (doc == NULL)
+   {
+      printf("error: could not parse file %s\n", config);
+      return NULL;
+   }
+   DAL dal = init_dal(xmlDocGetRootElement(doc), maxloc);
+   xmlFreeDoc(doc);
+   if (dal == NULL)
+   {
+      printf("error: failed to initialize DAL from %s: %s\n", config, strerror(errno));
+   }
+   return dal;
+}
+
+int write_block(DAL dal, DAL_location loc, const char *buffer, size_t size, meta_info *minfo)
+{
+   BLOCK_CTXT block = dal->open(dal->ctxt, DAL_WRITE, loc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for write: %s\n", strerror(errno));
+      return -1;
+   }
+   if (dal->put(block, buffer, size))
+   {
+      printf("error: put did not return expected value\n");
+      return -1;
+   }
+   if (dal->set_meta(block, minfo))
+   {
+      printf("error: set_meta did not return expected value\n");
+      return -1;
+   }
+   if (dal->close(block))
+   {
+      printf("error: failed to close block write context: %s\n", strerror(errno));
+      return -1;
+   }
+   return 0;
+}
+
+int verify_meta(DAL dal, DAL_MODE mode, DAL_location loc, meta_info *minfo)
+{
+   BLOCK_CTXT block = dal->open(dal->ctxt, mode, loc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for %s: %s\n", (mode == DAL_READ) ? "read" : "meta read", strerror(errno));
+      return -1;
+   }
+   meta_info readmeta;
+   if (dal->get_meta(block, &readmeta))
+   {
+      printf("error: get_meta returned an unexpected value\n");
+      return -1;
+   }
+   if (cmp_minfo(minfo, &readmeta))
+   {
+      printf("error: retrieved meta value does not match written!\n");
+      return -1;
+   }
+   if (dal->close(block))
+   {
+      printf("error: failed to close block context: %s\n", strerror(errno));
+      return -1;
+   }
+   return 0;
+}
+
+int main(int argc, char **argv)
+{
+   LIBXML_TEST_VERSION
+
+   // Initialize a posix dal instance using each meta layout
+   DAL_location maxloc = {.pod = 1, .block = 1, .cap = 1, .scatter = 1};
+   DAL xdal = init_config_dal("./testing/xattr_config.xml", maxloc);
+   DAL fdal = init_config_dal("./testing/config.xml", maxloc);
+   xmlCleanupParser();
+   if (xdal == NULL || fdal == NULL)
+   {
+      return -1;
+   }
+
+   char *writebuffer = malloc(10 * 1024);
+   char *readbuffer = calloc(10, 1024);
+   if (writebuffer == NULL || readbuffer == NULL)
+   {
+      printf("error: failed to allocate buffers\n");
+      return -1;
+   }
+   int i;
+   for (i = 0; i < (10 * 1024); i++)
+   {
+      writebuffer[i] = (char)(i % 241);
+   }
+   meta_info meta_val = { .N = 3, .E = 1, .O = 3, .partsz = 4096, .versz = 1048576, .blocksz = 10485760, .crcsum = 1234567, .totsz = 7654321 };
+
+   // write a block with meta info attached to its data file
+   if (write_block(xdal, maxloc, writebuffer, (10 * 1024), &meta_val))
+   {
+      return -1;
+   }
+   struct stat stval;
+   if (stat("./stripefile.1.meta", &stval) == 0 || errno != ENOENT)
+   {
+      printf("error: meta xattr layout produced a meta file\n");
+      return -1;
+   }
+   BLOCK_CTXT block = xdal->open(xdal->ctxt, DAL_READ, maxloc, "");
+   if (block == NULL)
+   {
+      printf("error: failed to open block context for read: %s\n", strerror(errno));
+      return -1;
+   }
+   if (xdal->get(block, readbuffer, (10 * 1024), 0) != (10 * 1024))
+   {
+      printf("error: get did not return expected value\n");
+      return -1;
+   }
+   if (memcmp(writebuffer, readbuffer, (10 * 1024)))
+   {
+      printf("error: retrieved data does not match written!\n");
+      return -1;
+   }
+   if (xdal->close(block))
+   {
+      printf("error: failed to close block read context: %s\n", strerror(errno));
+      return -1;
+   }
+   if (verify_meta(xdal, DAL_READ, maxloc, &meta_val) || verify_meta(xdal, DAL_METAREAD, maxloc, &meta_val))
+   {
+      return -1;
+   }
+
+   // write a block with a separate meta file, which must remain readable
+   DAL_location oldloc = {.pod = 0, .block = 0, .cap = 0, .scatter = 0};
+   meta_val.totsz = 1234;
+   if (write_block(fdal, oldloc, writebuffer, (10 * 1024), &meta_val))
+   {
+      return -1;
+   }
+   if (verify_meta(xdal, DAL_READ, oldloc, &meta_val) || verify_meta(xdal, DAL_METAREAD, oldloc, &meta_val))
+   {
+      return -1;
+   }
+
+   // Delete the blocks we created
+   if (xdal->del(xdal->ctxt, maxloc, "") || xdal->del(xdal->ctxt, oldloc, ""))
+   {
+      printf("error: del failed!\n");
+      return -1;
+   }
+   if (stat("./stripefile.0.meta", &stval) == 0 || stat("./stripefile.1", &stval) == 0)
+   {
+      printf("error: deleted block files remain\n");
+      return -1;
+   }
+
+   // Free the DALs
+   if (xdal->cleanup(xdal) || fdal->cleanup(fdal))
+   {
+      printf("error: failed to cleanup DAL\n");
+      return -1;
+   }
+
+   free(writebuffer);
+   free(readbuffer);
+
+   return 0;
+}
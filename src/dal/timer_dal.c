@@ -72,341 +72,437 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
-#include <sys/time.h>
+#include <time.h>
 #include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
-#define NODE_SIZE 1024 * 1024 // Buffer size for each timing data node
+// Timing data is kept in log-linear histograms of call durations, in nanoseconds.  Durations below
+// HIST_SUB each have their own bucket, while each larger power of two is split into HIST_SUB linear
+// sub-buckets ( bounding the relative error of any recorded value to 1/HIST_SUB ).  Durations of
+// 2^HIST_MAX_BITS nanoseconds ( ~18 minutes ) or more are recorded in the final bucket.
+#define HIST_SUB_BITS 4
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_MAX_BITS 40
+#define HIST_BUCKETS ((HIST_MAX_BITS - HIST_SUB_BITS + 1) * HIST_SUB)
 
 //   -------------    TIMER CONTEXT    -------------
 
-// Linked list node containing timing data (Nodes should never be directly
-// accessed)
-typedef struct time_node
+// DAL functions for which timing data is recorded
+enum
 {
-  char *data;
-  int remaining;
-  struct time_node *next;
-} * node;
-
-// Linked list containing timing data
-typedef struct time_list
+  TIMER_VERIFY = 0,
+  TIMER_MIGRATE,
+  TIMER_DEL,
+  TIMER_STAT,
+  TIMER_CLEANUP,
+  TIMER_OPEN,
+  TIMER_SET_META,
+  TIMER_GET_META,
+  TIMER_PUT, // includes putv
+  TIMER_GET, // includes getv
+  TIMER_ABORT,
+  TIMER_CLOSE,
+  TIMER_FUNC_COUNT
+};
+
+// Names of each DAL function, which also name their timing data files
+static const char *timer_func_names[TIMER_FUNC_COUNT] = {
+    "verify", "migrate", "del", "stat", "cleanup", "open",
+    "set_meta", "get_meta", "put", "get", "abort", "close"};
+
+// Timing data recorded by a single thread
+//  NOTE -- only the owning thread modifies these counts, so recording a sample requires no lock.  When
+//          a thread exits, its stats are released for adoption by a later thread, so memory use is
+//          bounded by the peak number of concurrent threads, rather than by the number of samples.
+typedef struct timer_thread_stats_struct
 {
-  node start;
-  node end;
-  pthread_mutex_t mtx;
-} * list;
+  uint64_t counts[TIMER_FUNC_COUNT][HIST_BUCKETS];
+  char inuse; // Flag indicating that these stats are owned by a live thread
+  struct timer_thread_stats_struct *next;
+} * THREAD_STATS;
 
 typedef struct timer_dal_context_struct
 {
-  DAL under_dal; // Underlying DAL
-  int dump_fd;   // Directory to export timing data to upon close
-  list verify;   // Linked lists containing the timing data of each DAL function
-  list migrate;
-  list del;
-  list stat;
-  list cleanup;
-  list open;
-  list set_meta;
-  list get_meta;
-  list put;
-  list get;
-  list abort;
-  list close;
+  DAL under_dal;         // Underlying DAL
+  int dump_fd;           // Directory to export timing data to upon close
+  pthread_key_t key;     // Key referencing the THREAD_STATS of the calling thread
+  char keyinit;          // Flag indicating that the above key has been created
+  pthread_mutex_t mtx;   // Lock protecting the list of thread stats
+  THREAD_STATS stats;    // Timing data of every thread that has called into this DAL
+  int interval;          // Seconds between percentile snapshots ( zero if snapshots are disabled )
+  pthread_t snapthread;  // Thread producing percentile snapshots
+  char snapactive;       // Flag indicating that the snapshot thread is running
+  char snapstop;         // Flag indicating that the snapshot thread should exit
+  pthread_mutex_t snapmtx;
+  pthread_cond_t snapcond;
+  uint64_t *snapprev;    // Merged timing data as of the previous snapshot
 } * TIMER_DAL_CTXT;
 
 typedef struct timer_block_context_struct
 {
   TIMER_DAL_CTXT global_ctxt; // Global context
   BLOCK_CTXT bctxt;           // Block context to be passed to underlying DAL
-  list set_meta;              // List containing timing data of each DAL data
-  list get_meta;              // access function performed since the handle was
-  list put;                   // opened.
-  list get;
 } * TIMER_BLOCK_CTXT;
 
 //   -------------    TIMER INTERNAL FUNCTIONS    -------------
 
 /** (INTERNAL HELPER FUNCTION)
- * Initializes and returns a timing data list
- * @return list : An empty list if it could be successfully initialized,
- * otherwise NULL.
+ * Get the current time
+ * @return uint64_t : Nanoseconds on the monotonic clock
  */
-list list_init()
+static uint64_t timer_now()
 {
-  // allocate space for a new list
-  list lst = malloc(sizeof(struct time_list));
-  if (lst == NULL)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Identify the histogram bucket of a duration
+ * @param uint64_t value : Duration in nanoseconds
+ * @return int : Index of the bucket counting the given duration
+ */
+static int hist_index(uint64_t value)
+{
+  if (value < HIST_SUB)
   {
-    return NULL;
+    return (int)value;
   }
-
-  // ensure that the list is empty
-  lst->start = NULL;
-  lst->end = NULL;
-
-  // intitialize the list's lock
-  if (pthread_mutex_init(&lst->mtx, NULL))
+  int msb = 63 - __builtin_clzll(value);
+  if (msb >= HIST_MAX_BITS)
   {
-    free(lst);
-    return NULL;
+    return HIST_BUCKETS - 1;
   }
-  return lst;
+  int shift = msb - HIST_SUB_BITS;
+  return ((shift + 1) << HIST_SUB_BITS) + (int)((value >> shift) - HIST_SUB);
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Append data to the end of a timing data list
- * @param list lst : List to add data to
- * @param char *str : Data to be added
- * @return int : Zero if the data is added successfully, -1 otherwise
+ * Identify the range of durations counted by a histogram bucket
+ * @param int index : Index of the bucket
+ * @param uint64_t *lower : Reference to be populated with the smallest duration of the bucket
+ * @param uint64_t *upper : Reference to be populated with the largest duration of the bucket
  */
-int list_add(list lst, char *str)
+static void hist_range(int index, uint64_t *lower, uint64_t *upper)
 {
-  pthread_mutex_lock(&lst->mtx);
-
-  // Allocate a first node if the list is empty before beginning
-  if (lst->start == NULL)
+  if (index < HIST_SUB)
   {
-    lst->start = malloc(sizeof(struct time_node));
-    if (lst->start == NULL)
-    {
-      pthread_mutex_unlock(&lst->mtx);
-      return -1;
-    }
-    lst->start->data = malloc(sizeof(char) * NODE_SIZE);
-    *lst->start->data = '\0';
-    if (lst->start->data == NULL)
-    {
-      free(lst->start);
-      pthread_mutex_unlock(&lst->mtx);
-      return -1;
-    }
-    lst->start->remaining = NODE_SIZE;
-    lst->start->next = NULL;
-    lst->end = lst->start;
+    *lower = *upper = index;
+    return;
   }
+  int shift = (index >> HIST_SUB_BITS) - 1;
+  *lower = (uint64_t)(HIST_SUB + (index & (HIST_SUB - 1))) << shift;
+  *upper = *lower + ((1ULL << shift) - 1);
+}
 
-  // Allocate a new node if the last node cannot fit the new data
-  if (strlen(str) > lst->end->remaining)
+/** (INTERNAL HELPER FUNCTION)
+ * Estimate a percentile of a histogram
+ * @param const uint64_t *hist : Histogram to be examined
+ * @param uint64_t total : Total count of the histogram
+ * @param double fraction : Target percentile, as a fraction
+ * @return double : Midpoint of the bucket containing the percentile, in seconds
+ */
+static double hist_percentile(const uint64_t *hist, uint64_t total, double fraction)
+{
+  uint64_t rank = (uint64_t)(fraction * total);
+  if (rank < fraction * total || rank == 0)
   {
-    lst->end->next = malloc(sizeof(struct time_node));
-    if (lst->end->next == NULL)
-    {
-      pthread_mutex_unlock(&lst->mtx);
-      return -1;
-    }
-    lst->end->next->data = malloc(sizeof(char) * NODE_SIZE);
-    *lst->end->next->data = '\0';
-    if (lst->end->next->data == NULL)
+    rank++;
+  }
+  uint64_t seen = 0;
+  int index;
+  for (index = 0; index < HIST_BUCKETS - 1; index++)
+  {
+    seen += hist[index];
+    if (seen >= rank)
     {
-      free(lst->end->next);
-      pthread_mutex_unlock(&lst->mtx);
-      return -1;
+      break;
     }
-    lst->end->next->remaining = NODE_SIZE;
-    lst->end->next->next = NULL;
-    lst->end = lst->end->next;
   }
-
-  // Add new data to last node in list
-  strcat(lst->end->data, str);
-  lst->end->remaining -= strlen(str);
-  pthread_mutex_unlock(&lst->mtx);
-
-  return 0;
+  uint64_t lower, upper;
+  hist_range(index, &lower, &upper);
+  return ((lower + upper) / 2) * 1e-9;
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Move the timing data from one list onto another, removing the data from the
- * source list
- * @param list dest : List to move the data to
- * @param list src : List to move the data from (NOTE: This list should
- * only every be accessed from one thread, as this function does not perform
- * locking on it)
- * @return int Zero if the data is migrated successfully, -1 otherwise
+ * Release the stats of an exiting thread ( pthread_key destructor )
+ * @param void *arg : THREAD_STATS of the exiting thread
  */
-int list_migrate(list dest, list src)
+static void release_thread_stats(void *arg)
 {
+  THREAD_STATS stats = (THREAD_STATS)arg;
+  __atomic_store_n(&stats->inuse, 0, __ATOMIC_RELEASE);
+}
 
-  // If there's nothing to migrate, return
-  if (src->start == NULL)
+/** (INTERNAL HELPER FUNCTION)
+ * Retrieve the stats of the calling thread, associating a new set if necessary
+ * @param TIMER_DAL_CTXT dctxt : Context containing timing data
+ * @return THREAD_STATS : Stats of the calling thread, or NULL on failure
+ */
+static THREAD_STATS get_thread_stats(TIMER_DAL_CTXT dctxt)
+{
+  THREAD_STATS stats = (THREAD_STATS)pthread_getspecific(dctxt->key);
+  if (stats)
   {
-    return 0;
+    return stats;
   }
 
-  // Only acquire destination lock (source should be from a block and only
-  // accessed by one thread)
-  pthread_mutex_lock(&dest->mtx);
+  pthread_mutex_lock(&dctxt->mtx);
 
-  // Append the source list to the end of the destination list
-  if (dest->start == NULL)
+  // adopt the stats of an exited thread, if any ( counts are only ever summed, so their origin is irrelevant )
+  for (stats = dctxt->stats; stats != NULL; stats = stats->next)
   {
-    dest->start = src->start;
+    if (!__atomic_load_n(&stats->inuse, __ATOMIC_ACQUIRE))
+    {
+      break;
+    }
   }
-  else
+  if (stats == NULL)
   {
-    dest->end->next = src->start;
+    stats = calloc(1, sizeof(struct timer_thread_stats_struct));
+    if (stats == NULL)
+    {
+      pthread_mutex_unlock(&dctxt->mtx);
+      LOG(LOG_ERR, "failed to allocate timing data for a new thread\n");
+      return NULL;
+    }
+    stats->next = dctxt->stats;
+    dctxt->stats = stats;
   }
-  dest->end = src->end;
+  stats->inuse = 1;
 
-  // Remove all nodes from source list
-  src->start = NULL;
-  src->end = NULL;
+  pthread_mutex_unlock(&dctxt->mtx);
 
-  pthread_mutex_unlock(&dest->mtx);
-  return 0;
+  pthread_setspecific(dctxt->key, stats);
+  return stats;
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Write the timing data from a list into a file, removing the data from the
- * list as it is written
- * @param list lst : List to export data from
- * @param int dir_fd : Directory that contains file where data will be written
- * @param char *fname : Path of file relative to dir_fd to write data to
- * @return int : Zero if the data is exported successfully, -1 otherwise
+ * Record the duration of a DAL function call
+ * @param TIMER_DAL_CTXT dctxt : Context containing timing data
+ * @param int func : TIMER_* value of the called function
+ * @param uint64_t beg : Start time of the call, as returned by timer_now()
  */
-int list_export(list lst, int dir_fd, char *fname)
+static void timer_record(TIMER_DAL_CTXT dctxt, int func, uint64_t beg)
 {
-  // Open the file we will be writing to
-  int fd = openat(dir_fd, fname, O_CREAT | O_WRONLY | O_APPEND, 0666);
-  if (fd < 0)
+  uint64_t elapsed = timer_now() - beg;
+  THREAD_STATS stats = get_thread_stats(dctxt);
+  if (stats == NULL)
   {
-    return -1;
+    return; // drop the sample, rather than failing the DAL call itself
   }
+  // only this thread writes the count, but a concurrent merge may read it, so avoid tearing
+  uint64_t *count = &stats->counts[func][hist_index(elapsed)];
+  __atomic_store_n(count, *count + 1, __ATOMIC_RELAXED);
+}
 
-  pthread_mutex_lock(&lst->mtx);
+/** (INTERNAL HELPER FUNCTION)
+ * Sum the timing data of all threads
+ * @param TIMER_DAL_CTXT dctxt : Context containing timing data
+ * @param uint64_t *merged : Buffer of TIMER_FUNC_COUNT * HIST_BUCKETS counts to be populated
+ */
+static void merge_stats(TIMER_DAL_CTXT dctxt, uint64_t *merged)
+{
+  memset(merged, 0, sizeof(uint64_t) * TIMER_FUNC_COUNT * HIST_BUCKETS);
+  pthread_mutex_lock(&dctxt->mtx);
+  THREAD_STATS stats;
+  for (stats = dctxt->stats; stats != NULL; stats = stats->next)
+  {
+    uint64_t *counts = &stats->counts[0][0];
+    int index;
+    for (index = 0; index < TIMER_FUNC_COUNT * HIST_BUCKETS; index++)
+    {
+      merged[index] += __atomic_load_n(counts + index, __ATOMIC_RELAXED);
+    }
+  }
+  pthread_mutex_unlock(&dctxt->mtx);
+}
 
-  // If the list is empty, we have nothing to export
-  if (lst->start == NULL)
+/** (INTERNAL HELPER FUNCTION)
+ * Append a percentile snapshot of all calls completed since the previous snapshot to the 'snapshots'
+ * file of the dump directory.  Each function called during the interval produces a single line:
+ *  <epoch seconds> <function> count=<calls> p50=<seconds> p99=<seconds> p999=<seconds> max=<seconds>
+ * @param TIMER_DAL_CTXT dctxt : Context containing timing data and export location
+ * @param uint64_t *merged : Current merged timing data ( overwritten with the interval's data )
+ * @return int : Zero on success, -1 otherwise
+ */
+static int write_snapshot(TIMER_DAL_CTXT dctxt, uint64_t *merged)
+{
+  // convert the merged data to that of the interval, retaining the totals for the next snapshot
+  int index;
+  for (index = 0; index < TIMER_FUNC_COUNT * HIST_BUCKETS; index++)
   {
-    pthread_mutex_unlock(&lst->mtx);
-    return close(fd);
+    uint64_t total = merged[index];
+    merged[index] -= dctxt->snapprev[index];
+    dctxt->snapprev[index] = total;
   }
 
-  // Write out all data to the file, node by node
-  int ret;
-  do
+  int fd = openat(dctxt->dump_fd, "snapshots", O_CREAT | O_WRONLY | O_APPEND, 0666);
+  if (fd < 0)
   {
-    ret = write(fd, lst->start->data, strlen(lst->start->data));
-    if (ret < 0)
+    LOG(LOG_ERR, "failed to open timing snapshot file (%s)\n", strerror(errno));
+    return -1;
+  }
+
+  time_t now = time(NULL);
+  int ret = 0;
+  int func;
+  for (func = 0; func < TIMER_FUNC_COUNT && ret >= 0; func++)
+  {
+    uint64_t *hist = merged + (func * HIST_BUCKETS);
+    uint64_t count = 0;
+    int maxindex = 0;
+    for (index = 0; index < HIST_BUCKETS; index++)
     {
-      LOG(LOG_ERR, "failed to write timing data to %s (%s)\n", fname, strerror(errno));
-      break;
+      count += hist[index];
+      if (hist[index])
+      {
+        maxindex = index;
+      }
     }
+    if (count == 0)
+    {
+      continue;
+    }
+    uint64_t lower, upper;
+    hist_range(maxindex, &lower, &upper);
+    ret = dprintf(fd, "%lld %s count=%llu p50=%.6f p99=%.6f p999=%.6f max=%.6f\n",
+                  (long long)now, timer_func_names[func], (unsigned long long)count,
+                  hist_percentile(hist, count, 0.5), hist_percentile(hist, count, 0.99),
+                  hist_percentile(hist, count, 0.999), upper * 1e-9);
+  }
+  if (ret < 0)
+  {
+    LOG(LOG_ERR, "failed to write timing snapshot (%s)\n", strerror(errno));
+  }
 
-    node next = lst->start->next;
-    free(lst->start->data);
-    free(lst->start);
-    lst->start = next;
-  } while (lst->start != NULL);
-
-  pthread_mutex_unlock(&lst->mtx);
-
-  if (close(fd))
+  if (close(fd) || ret < 0)
   {
     return -1;
   }
-
-  return ret;
+  return 0;
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Release all resorces associated with a list
- * @param list lst : List to be destroyed
- * @return int : Zero if list is successfully destroyed, -1 otherwise
+ * Body of the snapshot thread, which periodically writes percentile snapshots until signaled to stop
+ * @param void *arg : TIMER_DAL_CTXT to be snapshotted
+ * @return void* : NULL
  */
-int list_destroy(list lst)
+static void *snapshot_thread(void *arg)
 {
-  pthread_mutex_lock(&lst->mtx);
+  TIMER_DAL_CTXT dctxt = (TIMER_DAL_CTXT)arg;
+  uint64_t *merged = malloc(sizeof(uint64_t) * TIMER_FUNC_COUNT * HIST_BUCKETS);
+  if (merged == NULL)
+  {
+    LOG(LOG_ERR, "failed to allocate snapshot buffer; live timing snapshots are disabled\n");
+    return NULL;
+  }
 
-  // Release every node, one at a time
-  node n = lst->start;
-  while (n)
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  pthread_mutex_lock(&dctxt->snapmtx);
+  while (!dctxt->snapstop)
   {
-    node next = n->next;
-    free(n->data);
-    free(n);
-    n = next;
+    deadline.tv_sec += dctxt->interval;
+    while (!dctxt->snapstop &&
+           pthread_cond_timedwait(&dctxt->snapcond, &dctxt->snapmtx, &deadline) != ETIMEDOUT)
+    {
+    }
+    if (dctxt->snapstop)
+    {
+      break;
+    }
+    pthread_mutex_unlock(&dctxt->snapmtx);
+    merge_stats(dctxt, merged);
+    write_snapshot(dctxt, merged);
+    pthread_mutex_lock(&dctxt->snapmtx);
   }
+  pthread_mutex_unlock(&dctxt->snapmtx);
 
-  // Release general resources associated with the list
-  pthread_mutex_unlock(&lst->mtx);
-  pthread_mutex_destroy(&lst->mtx);
-  free(lst);
-  return 0;
+  free(merged);
+  return NULL;
 }
 
 /** (INTERNAL HELPER FUNCTION)
- * Write out all timing data
+ * Stop the snapshot thread, if it is running
+ * @param TIMER_DAL_CTXT dctxt : Context of the snapshot thread
+ */
+static void stop_snapshots(TIMER_DAL_CTXT dctxt)
+{
+  if (!dctxt->snapactive)
+  {
+    return;
+  }
+  pthread_mutex_lock(&dctxt->snapmtx);
+  dctxt->snapstop = 1;
+  pthread_cond_signal(&dctxt->snapcond);
+  pthread_mutex_unlock(&dctxt->snapmtx);
+  pthread_join(dctxt->snapthread, NULL);
+  dctxt->snapactive = 0;
+}
+
+/** (INTERNAL HELPER FUNCTION)
+ * Write out all timing data, as the merged histogram of each DAL function.  Each function's data is
+ * appended to a file of the same name, as one line per non-empty histogram bucket:
+ *  <smallest duration in seconds> <largest duration in seconds> <count>
+ * A final percentile snapshot is also written, if snapshots are enabled.
  * @param TIMER_DAL_CTXT dctxt : Context containing timing data and export
  * location
- * @return int : Zero on success, the number of lists that could failed to be
+ * @return int : Zero on success, the number of files that failed to be
  * written otherwise
  */
 int dump_times(TIMER_DAL_CTXT dctxt)
 {
-  // Export every list, counting how many fail
-  int ret = 0;
-  if (list_export(dctxt->verify, dctxt->dump_fd, "verify") < 0)
-  {
-    LOG(LOG_ERR, "failed to export verify timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->migrate, dctxt->dump_fd, "migrate") < 0)
-  {
-    LOG(LOG_ERR, "failed to export migrate timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->del, dctxt->dump_fd, "del") < 0)
-  {
-    LOG(LOG_ERR, "failed to export del timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->stat, dctxt->dump_fd, "stat") < 0)
-  {
-    LOG(LOG_ERR, "failed to export stat timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->cleanup, dctxt->dump_fd, "cleanup") < 0)
-  {
-    LOG(LOG_ERR, "failed to export cleanup timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->open, dctxt->dump_fd, "open") < 0)
-  {
-    LOG(LOG_ERR, "failed to export open timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->set_meta, dctxt->dump_fd, "set_meta") < 0)
-  {
-    LOG(LOG_ERR, "failed to export set_meta timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->get_meta, dctxt->dump_fd, "get_meta") < 0)
+  uint64_t *merged = malloc(sizeof(uint64_t) * TIMER_FUNC_COUNT * HIST_BUCKETS);
+  if (merged == NULL)
   {
-    LOG(LOG_ERR, "failed to export get_meta timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->put, dctxt->dump_fd, "put") < 0)
-  {
-    LOG(LOG_ERR, "failed to export put timing data (%s)\n", strerror(errno));
-    ret++;
+    LOG(LOG_ERR, "failed to allocate space for merged timing data\n");
+    return TIMER_FUNC_COUNT;
   }
-  if (list_export(dctxt->get, dctxt->dump_fd, "get") < 0)
-  {
-    LOG(LOG_ERR, "failed to export get timing data (%s)\n", strerror(errno));
-    ret++;
-  }
-  if (list_export(dctxt->abort, dctxt->dump_fd, "abort") < 0)
+  merge_stats(dctxt, merged);
+
+  // Export every histogram, counting how many fail
+  int ret = 0;
+  int func;
+  for (func = 0; func < TIMER_FUNC_COUNT; func++)
   {
-    LOG(LOG_ERR, "failed to export abort timing data (%s)\n", strerror(errno));
-    ret++;
+    int fd = openat(dctxt->dump_fd, timer_func_names[func], O_CREAT | O_WRONLY | O_APPEND, 0666);
+    if (fd < 0)
+    {
+      LOG(LOG_ERR, "failed to open %s timing data file (%s)\n", timer_func_names[func], strerror(errno));
+      ret++;
+      continue;
+    }
+    uint64_t *hist = merged + (func * HIST_BUCKETS);
+    int wret = 0;
+    int index;
+    for (index = 0; index < HIST_BUCKETS && wret >= 0; index++)
+    {
+      if (hist[index])
+      {
+        uint64_t lower, upper;
+        hist_range(index, &lower, &upper);
+        wret = dprintf(fd, "%.9f %.9f %llu\n", lower * 1e-9, upper * 1e-9, (unsigned long long)hist[index]);
+      }
+    }
+    if (wret < 0)
+    {
+      LOG(LOG_ERR, "failed to export %s timing data (%s)\n", timer_func_names[func], strerror(errno));
+    }
+    if (close(fd) || wret < 0)
+    {
+      ret++;
+    }
   }
-  if (list_export(dctxt->close, dctxt->dump_fd, "close") < 0)
+
+  if (dctxt->snapprev && write_snapshot(dctxt, merged))
   {
-    LOG(LOG_ERR, "failed to export close timing data (%s)\n", strerror(errno));
     ret++;
   }
+
+  free(merged);
   return ret;
 }
 
@@ -416,86 +512,31 @@ int dump_times(TIMER_DAL_CTXT dctxt)
  */
 void try_free_dctxt(TIMER_DAL_CTXT dctxt)
 {
-  // Free any lists that have already been initialized
-  if (dctxt->verify)
-  {
-    list_destroy(dctxt->verify);
-  }
-  if (dctxt->migrate)
-  {
-    list_destroy(dctxt->migrate);
-  }
-  if (dctxt->del)
-  {
-    list_destroy(dctxt->del);
-  }
-  if (dctxt->stat)
-  {
-    list_destroy(dctxt->stat);
-  }
-  if (dctxt->cleanup)
+  stop_snapshots(dctxt);
+  if (dctxt->keyinit)
   {
-    list_destroy(dctxt->cleanup);
+    pthread_key_delete(dctxt->key);
   }
-  if (dctxt->open)
+  while (dctxt->stats)
   {
-    list_destroy(dctxt->open);
+    THREAD_STATS next = dctxt->stats->next;
+    free(dctxt->stats);
+    dctxt->stats = next;
   }
-  if (dctxt->set_meta)
-  {
-    list_destroy(dctxt->set_meta);
-  }
-  if (dctxt->get_meta)
-  {
-    list_destroy(dctxt->get_meta);
-  }
-  if (dctxt->put)
-  {
-    list_destroy(dctxt->put);
-  }
-  if (dctxt->get)
-  {
-    list_destroy(dctxt->get);
-  }
-  if (dctxt->abort)
-  {
-    list_destroy(dctxt->abort);
-  }
-  if (dctxt->close)
-  {
-    list_destroy(dctxt->close);
-  }
-
-  close(dctxt->dump_fd);
-  dctxt->under_dal->cleanup(dctxt->under_dal);
-  free(dctxt);
-}
+  free(dctxt->snapprev);
+  pthread_mutex_destroy(&dctxt->mtx);
+  pthread_mutex_destroy(&dctxt->snapmtx);
+  pthread_cond_destroy(&dctxt->snapcond);
 
-/** (INTERNAL HELPER FUNCTION)
- * Free a block context and any allocated resources asssociated with it.
- * @param TIMER_BLOCK_CTXT dctxt : Context to be freed
- */
-void try_free_bctxt(TIMER_BLOCK_CTXT bctxt)
-{
-  // Free any lists that have already been initialized
-  if (bctxt->set_meta)
-  {
-    list_destroy(bctxt->set_meta);
-  }
-  if (bctxt->get_meta)
-  {
-    list_destroy(bctxt->get_meta);
-  }
-  if (bctxt->put)
+  if (dctxt->dump_fd != -1)
   {
-    list_destroy(bctxt->put);
+    close(dctxt->dump_fd);
   }
-  if (bctxt->get)
+  if (dctxt->under_dal)
   {
-    list_destroy(bctxt->get);
+    dctxt->under_dal->cleanup(dctxt->under_dal);
   }
-
-  free(bctxt);
+  free(dctxt);
 }
 
 //   -------------    TIMER IMPLEMENTATION    -------------
@@ -511,20 +552,12 @@ int timer_verify(DAL_CTXT ctxt, int flags)
   TIMER_DAL_CTXT dctxt = (TIMER_DAL_CTXT)ctxt; // Should have been passed a timer context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = dctxt->under_dal->verify(dctxt->under_dal->ctxt, flags);
 
-  // get end time
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(dctxt->verify, tmp);
+  // add interval to histogram
+  timer_record(dctxt, TIMER_VERIFY, beg);
 
   return ret;
 }
@@ -540,19 +573,12 @@ int timer_migrate(DAL_CTXT ctxt, const char *objID, DAL_location src, DAL_locati
   TIMER_DAL_CTXT dctxt = (TIMER_DAL_CTXT)ctxt; // Should have been passed a timer context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = dctxt->under_dal->migrate(dctxt->under_dal->ctxt, objID, src, dest, offline);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(dctxt->migrate, tmp);
+  // add interval to histogram
+  timer_record(dctxt, TIMER_MIGRATE, beg);
 
   return ret;
 }
@@ -568,19 +594,12 @@ int timer_del(DAL_CTXT ctxt, DAL_location location, const char *objID)
   TIMER_DAL_CTXT dctxt = (TIMER_DAL_CTXT)ctxt; // Should have been passed a timer context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = dctxt->under_dal->del(dctxt->under_dal->ctxt, location, objID);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(dctxt->del, tmp);
+  // add interval to histogram
+  timer_record(dctxt, TIMER_DEL, beg);
 
   return ret;
 }
@@ -596,19 +615,12 @@ int timer_stat(DAL_CTXT ctxt, DAL_location location, const char *objID)
   TIMER_DAL_CTXT dctxt = (TIMER_DAL_CTXT)ctxt; // Should have been passed a timer context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = dctxt->under_dal->stat(dctxt->under_dal->ctxt, location, objID);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(dctxt->stat, tmp);
+  // add interval to histogram
+  timer_record(dctxt, TIMER_STAT, beg);
 
   return ret;
 }
@@ -624,42 +636,24 @@ int timer_cleanup(DAL dal)
   TIMER_DAL_CTXT dctxt = (TIMER_DAL_CTXT)dal->ctxt; // Should have been passed a DAL
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = dctxt->under_dal->cleanup(dctxt->under_dal);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(dctxt->cleanup, tmp);
+  // add interval to histogram
+  timer_record(dctxt, TIMER_CLEANUP, beg);
 
   if (ret)
   {
     return ret;
   }
 
+  stop_snapshots(dctxt);
   dump_times(dctxt);
 
-  list_destroy(dctxt->verify);
-  list_destroy(dctxt->migrate);
-  list_destroy(dctxt->del);
-  list_destroy(dctxt->stat);
-  list_destroy(dctxt->cleanup);
-  list_destroy(dctxt->open);
-  list_destroy(dctxt->set_meta);
-  list_destroy(dctxt->get_meta);
-  list_destroy(dctxt->put);
-  list_destroy(dctxt->get);
-  list_destroy(dctxt->abort);
-  list_destroy(dctxt->close);
-
-  close(dctxt->dump_fd);
-  free(dctxt);
+  // the underlying DAL has already been cleaned up
+  dctxt->under_dal = NULL;
+  try_free_dctxt(dctxt);
   free(dal);
   return 0;
 }
@@ -683,46 +677,13 @@ BLOCK_CTXT timer_open(DAL_CTXT ctxt, DAL_MODE mode, DAL_location location, const
 
   bctxt->global_ctxt = dctxt;
 
-  // Initialize timing data lists
-  if ((bctxt->set_meta = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize set_meta timing data list(%s)\n", strerror(errno));
-    try_free_bctxt(bctxt);
-    return NULL;
-  }
-  if ((bctxt->get_meta = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize get_meta timing data list(%s)\n", strerror(errno));
-    try_free_bctxt(bctxt);
-    return NULL;
-  }
-  if ((bctxt->put = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize put timing data list(%s)\n", strerror(errno));
-    try_free_bctxt(bctxt);
-    return NULL;
-  }
-  if ((bctxt->get = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize get timing data list(%s)\n", strerror(errno));
-    try_free_bctxt(bctxt);
-    return NULL;
-  }
-
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   bctxt->bctxt = dctxt->under_dal->open(dctxt->under_dal->ctxt, mode, location, objID);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(dctxt->open, tmp);
+  // add interval to histogram
+  timer_record(dctxt, TIMER_OPEN, beg);
 
   if (bctxt->bctxt == NULL)
   {
@@ -744,19 +705,12 @@ int timer_set_meta(BLOCK_CTXT ctxt, const meta_info* source)
   TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a timer context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = bctxt->global_ctxt->under_dal->set_meta(bctxt->bctxt, source);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(bctxt->set_meta, tmp);
+  // add interval to histogram
+  timer_record(bctxt->global_ctxt, TIMER_SET_META, beg);
 
   return ret;
 }
@@ -772,19 +726,12 @@ int timer_get_meta(BLOCK_CTXT ctxt, meta_info* target)
   TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   ssize_t ret = bctxt->global_ctxt->under_dal->get_meta(bctxt->bctxt, target);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(bctxt->get_meta, tmp);
+  // add interval to histogram
+  timer_record(bctxt->global_ctxt, TIMER_GET_META, beg);
 
   return ret;
 }
@@ -800,19 +747,33 @@ int timer_put(BLOCK_CTXT ctxt, const void *buf, size_t size)
   TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = bctxt->global_ctxt->under_dal->put(bctxt->bctxt, buf, size);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
+  // add interval to histogram
+  timer_record(bctxt->global_ctxt, TIMER_PUT, beg);
 
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(bctxt->put, tmp);
+  return ret;
+}
+
+int timer_putv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt)
+{
+  if (ctxt == NULL)
+  {
+    LOG(LOG_ERR, "received a NULL block context!\n");
+    return -1;
+  }
+
+  TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
+
+  // get start time
+  uint64_t beg = timer_now();
+
+  int ret = bctxt->global_ctxt->under_dal->putv(bctxt->bctxt, iov, iovcnt);
+
+  // vectored puts are recorded alongside standard puts
+  timer_record(bctxt->global_ctxt, TIMER_PUT, beg);
 
   return ret;
 }
@@ -828,19 +789,33 @@ ssize_t timer_get(BLOCK_CTXT ctxt, void *buf, size_t size, off_t offset)
   TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   ssize_t ret = bctxt->global_ctxt->under_dal->get(bctxt->bctxt, buf, size, offset);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
+  // add interval to histogram
+  timer_record(bctxt->global_ctxt, TIMER_GET, beg);
 
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(bctxt->get, tmp);
+  return ret;
+}
+
+ssize_t timer_getv(BLOCK_CTXT ctxt, const struct iovec *iov, int iovcnt, off_t offset)
+{
+  if (ctxt == NULL)
+  {
+    LOG(LOG_ERR, "received a NULL block context!\n");
+    return -1;
+  }
+
+  TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
+
+  // get start time
+  uint64_t beg = timer_now();
+
+  ssize_t ret = bctxt->global_ctxt->under_dal->getv(bctxt->bctxt, iov, iovcnt, offset);
+
+  // vectored gets are recorded alongside standard gets
+  timer_record(bctxt->global_ctxt, TIMER_GET, beg);
 
   return ret;
 }
@@ -856,31 +831,19 @@ int timer_abort(BLOCK_CTXT ctxt)
   TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = bctxt->global_ctxt->under_dal->abort(bctxt->bctxt);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(bctxt->global_ctxt->abort, tmp);
+  // add interval to histogram
+  timer_record(bctxt->global_ctxt, TIMER_ABORT, beg);
 
   if (ret)
   {
     return ret;
   }
 
-  list_migrate(bctxt->global_ctxt->set_meta, bctxt->set_meta);
-  list_migrate(bctxt->global_ctxt->get_meta, bctxt->get_meta);
-  list_migrate(bctxt->global_ctxt->put, bctxt->put);
-  list_migrate(bctxt->global_ctxt->get, bctxt->get);
-
-  try_free_bctxt(bctxt);
+  free(bctxt);
   return 0;
 }
 
@@ -895,31 +858,19 @@ int timer_close(BLOCK_CTXT ctxt)
   TIMER_BLOCK_CTXT bctxt = (TIMER_BLOCK_CTXT)ctxt; // Should have been passed a block context
 
   // get start time
-  struct timeval beg;
-  gettimeofday(&beg, NULL);
+  uint64_t beg = timer_now();
 
   int ret = bctxt->global_ctxt->under_dal->close(bctxt->bctxt);
 
-  // get end time
-  struct timeval end;
-  gettimeofday(&end, NULL);
-
-  // add interval to list
-  char tmp[20];
-  sprintf(tmp, "%.6f\n", (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6);
-  list_add(bctxt->global_ctxt->close, tmp);
+  // add interval to histogram
+  timer_record(bctxt->global_ctxt, TIMER_CLOSE, beg);
 
   if (ret)
   {
     return ret;
   }
 
-  list_migrate(bctxt->global_ctxt->set_meta, bctxt->set_meta);
-  list_migrate(bctxt->global_ctxt->get_meta, bctxt->get_meta);
-  list_migrate(bctxt->global_ctxt->put, bctxt->put);
-  list_migrate(bctxt->global_ctxt->get, bctxt->get);
-
-  try_free_bctxt(bctxt);
+  free(bctxt);
   return 0;
 }
 
@@ -928,7 +879,7 @@ int timer_close(BLOCK_CTXT ctxt)
 DAL timer_dal_init(xmlNode *root, DAL_location max_loc)
 {
   // allocate space for our context struct
-  TIMER_DAL_CTXT dctxt = malloc(sizeof(struct timer_dal_context_struct));
+  TIMER_DAL_CTXT dctxt = calloc(1, sizeof(struct timer_dal_context_struct));
   if (dctxt == NULL)
   {
     return NULL;
@@ -936,6 +887,7 @@ DAL timer_dal_init(xmlNode *root, DAL_location max_loc)
 
   dctxt->under_dal = NULL;
   dctxt->dump_fd = -1;
+  dctxt->interval = 0;
 
   // parse configuration items from XML tree
   while (root != NULL)
@@ -949,6 +901,25 @@ DAL timer_dal_init(xmlNode *root, DAL_location max_loc)
       mkdir((char *)root->children->content, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
       dctxt->dump_fd = open((char *)root->children->content, O_DIRECTORY);
     }
+    else if (root->type == XML_ELEMENT_NODE && strncmp((char *)root->name, "snapshot_interval", 18) == 0)
+    {
+      char *endptr = NULL;
+      if (root->children == NULL || root->children->type != XML_TEXT_NODE || root->children->content == NULL ||
+          (dctxt->interval = strtol((char *)root->children->content, &endptr, 10)) <= 0 || *endptr != '\0')
+      {
+        LOG(LOG_ERR, "invalid snapshot_interval value ( expected a positive number of seconds )\n");
+        if (dctxt->under_dal)
+        {
+          dctxt->under_dal->cleanup(dctxt->under_dal);
+        }
+        if (dctxt->dump_fd != -1)
+        {
+          close(dctxt->dump_fd);
+        }
+        free(dctxt);
+        return NULL;
+      }
+    }
     root = root->next;
   }
 
@@ -965,78 +936,37 @@ DAL timer_dal_init(xmlNode *root, DAL_location max_loc)
     return NULL;
   }
 
-  // Initialize timing data lists
-  if ((dctxt->verify = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize verify timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->migrate = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize migrate timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->del = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize dal timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->stat = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize stat timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->cleanup = list_init()) == NULL)
+  // Initialize timing data, and any periodic snapshots of it
+  pthread_mutex_init(&dctxt->mtx, NULL);
+  pthread_mutex_init(&dctxt->snapmtx, NULL);
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&dctxt->snapcond, &attr);
+  pthread_condattr_destroy(&attr);
+  if ((errno = pthread_key_create(&dctxt->key, release_thread_stats)))
   {
-    LOG(LOG_ERR, "failed to initialize cleanup timing data list(%s)\n", strerror(errno));
+    LOG(LOG_ERR, "failed to create timing data key (%s)\n", strerror(errno));
     try_free_dctxt(dctxt);
     return NULL;
   }
-  if ((dctxt->open = list_init()) == NULL)
+  dctxt->keyinit = 1;
+  if (dctxt->interval > 0)
   {
-    LOG(LOG_ERR, "failed to initialize open timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->set_meta = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize set_meta timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->get_meta = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize get_meta timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->put = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize put timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->get = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize get timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->abort = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize abort timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
-  }
-  if ((dctxt->close = list_init()) == NULL)
-  {
-    LOG(LOG_ERR, "failed to initialize close timing data list(%s)\n", strerror(errno));
-    try_free_dctxt(dctxt);
-    return NULL;
+    dctxt->snapprev = calloc(TIMER_FUNC_COUNT * HIST_BUCKETS, sizeof(uint64_t));
+    if (dctxt->snapprev == NULL)
+    {
+      LOG(LOG_ERR, "failed to allocate timing snapshot data\n");
+      try_free_dctxt(dctxt);
+      return NULL;
+    }
+    if ((errno = pthread_create(&dctxt->snapthread, NULL, snapshot_thread, dctxt)))
+    {
+      LOG(LOG_ERR, "failed to start timing snapshot thread (%s)\n", strerror(errno));
+      try_free_dctxt(dctxt);
+      return NULL;
+    }
+    dctxt->snapactive = 1;
   }
 
   // allocate and populate a new DAL structure
@@ -1050,13 +980,16 @@ DAL timer_dal_init(xmlNode *root, DAL_location max_loc)
   tdal->name = "timer";
   tdal->ctxt = (DAL_CTXT)dctxt;
   tdal->io_size = dctxt->under_dal->io_size;
+  tdal->io_depth = dctxt->under_dal->io_depth;
   tdal->verify = timer_verify;
   tdal->migrate = timer_migrate;
   tdal->open = timer_open;
   tdal->set_meta = timer_set_meta;
   tdal->get_meta = timer_get_meta;
   tdal->put = timer_put;
+  tdal->putv = (dctxt->under_dal->putv) ? timer_putv : NULL;
   tdal->get = timer_get;
+  tdal->getv = (dctxt->under_dal->getv) ? timer_getv : NULL;
   tdal->abort = timer_abort;
   tdal->close = timer_close;
   tdal->del = timer_del;
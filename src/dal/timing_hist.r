@@ -1,12 +1,17 @@
 #! /usr/bin/env Rscript
-getmode <- function(d){
-  uniqd <- unique(d)
-  uniqd[which.max(tabulate(match(d, uniqd)))]
+# Plots a timer DAL histogram file, in which each line is "<lower(s)> <upper(s)> <count>"
+weightedquantile <- function(v, w, p){
+  v[which(cumsum(w) >= p * sum(w))[1]]
 }
 
 args <- commandArgs(trailingOnly = TRUE)
 filename <- args[1]
-d<-scan(filename, quiet=TRUE)
+d <- read.table(filename, col.names = c("lower", "upper", "count"))
+d <- aggregate(count ~ lower + upper, data = d, FUN = sum) # merge the histograms of any appended dumps
+d <- d[order(d$lower), ]
+mid <- (d$lower + d$upper) / 2
+total <- sum(d$count)
+mean <- sum(mid * d$count) / total
 
 png(paste(basename(args[1]), ".png", sep=""), width = 960, height = 480)
-h <- hist(d, plot=TRUE, main = paste("total:", round(length(d), digits=6), ", min:", round(min(d), digits=6), "s, max:", round(max(d), digits=6), "s, median:", round(median(d), digits=6), "s, mode:", round(getmode(d), digits=6), "s, mean:", round(mean(d), digits=6), "s, variance:", round(var(d), digits=6), "s\n", sep=""), xlab = paste(basename(args[1]), "(s)"))
+plot(pmax(mid, 1e-9), d$count, type = "h", log = "x", lwd = 3, main = paste("total:", total, ", min:", round(min(d$lower), digits=6), "s, max:", round(max(d$upper), digits=6), "s, median:", round(weightedquantile(mid, d$count, 0.5), digits=6), "s, p99:", round(weightedquantile(mid, d$count, 0.99), digits=6), "s, mean:", round(mean, digits=6), "s, variance:", round(sum(d$count * (mid - mean)^2) / total, digits=6), "s\n", sep=""), xlab = paste(basename(args[1]), "(s)"), ylab = "Frequency")
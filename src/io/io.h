@@ -71,9 +71,21 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include "thread_queue/thread_queue.h"
 #include <pthread.h>
 #include <stdint.h>
+#include <time.h>
 
-#define SUPER_BLOCK_CNT 4
+#define SUPER_BLOCK_CNT 4 // default number of ioblocks per IOQueue ( see the DAL 'iodepth' attribute )
+#define IOQUEUE_MAX_DEPTH 64 // maximum number of ioblocks per IOQueue
+#define IOQUEUE_SPIN_MIN 16 // minimum number of polls for an ioblock before sleeping
+#define IOQUEUE_SPIN_MAX 4096 // maximum number of polls for an ioblock before sleeping
+#define IOBUFFER_POOL_MAX_BYTES (256UL * 1024 * 1024) // maximum bytes of idle ioblock buffers retained for reuse
 #define CRC_BYTES 4 // DO NOT decrease without adjusting CRC gen and block creation code!
+#define IOTHREAD_POOL_MAX_IDLE 256 // maximum number of parked threads retained by the shared IO thread pool
+#define IOTHREAD_POOL_MAX_ACTIVE 1024 // default limit on IO thread pool slots reserved by open handles ( see iothread_pool_set_limit() )
+#define IO_VECTOR_MAX 256 // maximum number of buffer references passed to a single vectored DAL call
+#define IOBLOCK_BATCH_MAX 8 // maximum number of queued ioblocks combined into a single vectored DAL put
+#define SCOREBOARD_BUCKETS 1024 // number of hash buckets of each location scoreboard
+#define SCOREBOARD_WEIGHT 0.125 // weight of each new sample within scoreboard moving averages
+#define UNIT_INDEX_GROWTH 1024 // number of IO unit index entries allocated at once for compressed blocks
 
 /* ------------------------------   IO QUEUE   ------------------------------ */
 
@@ -83,16 +95,33 @@ typedef struct ioblock_struct
                      //  off_t  error_start;  // offset in buffer at which data errors begin
    off_t error_end;  // offset in buffer at which data errors end
    void *buff;       // buffer for data transfer
+   // External data references ( zero-copy writes, see ioblock_add_external() )
+   size_t ext_offset; // offset in buffer at which external data begins ( buffered data precedes it )
+   int ext_cnt;       // number of external data references
+   int ext_max;       // maximum number of external data references
+   struct iovec *iov; // iov[0] is reserved for buffered data, iov[1..ext_cnt] are external data references,
+                      //  and one additional entry is reserved for a trailing CRC
+   // Producer-generated CRC coverage ( see ioblock_update_crc() )
+   size_t crc_len;     // length of leading data covered by 'crc'
+   uint32_t crc;       // running CRC of the first crc_len bytes of data
+   size_t spill_len;   // length of data, beyond the split threshold, covered by 'spill_crc'
+   uint32_t spill_crc; // running CRC of data to be passed to the next ioblock
 } ioblock;
 
 // Queue of IOBlocks for thread communication
+//  NOTE -- ioblocks are reserved by a single producer and released, in the same order, by their consumer.
+//          The queue is therefore a lock-free ring, tracked by free-running counts of reserved and released
+//          ioblocks.  A producer awaiting a free ioblock polls briefly before sleeping on a futex.
 typedef struct ioqueue_struct
 {
-   pthread_mutex_t qlock;               // lock for queue manipulation
-   pthread_cond_t avail_block;          // condition for awaiting an available block
-   int head;                            // integer indicating location of the next available block
-   int depth;                           // current depth of the queue
-   ioblock block_list[SUPER_BLOCK_CNT]; // list of ioblocks
+   uint32_t reserved;                   // count of ioblocks ever reserved ( only altered by the producer )
+   int head;                            // integer indicating location of the next available block ( producer only )
+   int spin;                            // current number of polls for a free ioblock before sleeping ( producer only )
+   char pad[64];                        // keeps producer and consumer values on distinct cache lines
+   uint32_t released;                   // count of ioblocks ever released ( futex word for any waiters )
+   int waiters;                         // number of threads sleeping until ioblocks are released
+   int block_cnt;                       // total number of ioblocks
+   ioblock *block_list;                 // list of ioblocks
 
    //size_t          fill_threshold;
    size_t split_threshold;
@@ -101,15 +130,21 @@ typedef struct ioqueue_struct
    size_t iosz;    // size of each IO
    int partcnt;    // number of erasure parts each buffer can hold
    size_t blocksz; // size of each ioblock buffer
+   int csum;       // checksum algorithm of written ioblocks ( CSUM_* value, CSUM_CRC32 by default )
+   int numa_node;  // NUMA node on which ioblock buffers reside ( negative if simply local to their creator )
 } ioqueue;
 
 /**
  * Creates a new IOQueue
+ *  Ioblock buffers are drawn from a process-wide pool, and returned there by destroy_ioqueue()
  * @param size_t iosz : Byte size of each IO to be performed
  * @param size_t partsz : Byte size of each erasure part
+ * @param DAL_MODE mode : Mode of the IO to be performed
+ * @param int depth : Number of ioblocks in the queue ( zero for SUPER_BLOCK_CNT, at least 2 otherwise )
+ * @param int numa_node : NUMA node on which to place ioblock buffers ( negative for that of the calling thread )
  * @return ioqueue* : Reference to the newly created IOQueue
  */
-ioqueue *create_ioqueue(size_t iosz, size_t partsz, DAL_MODE mode);
+ioqueue *create_ioqueue(size_t iosz, size_t partsz, DAL_MODE mode, int depth, int numa_node);
 
 /**
  * Destroys an existing IOQueue
@@ -153,11 +188,29 @@ int reserve_ioblock(ioblock **cur_block, ioblock **push_block, ioqueue *ioq);
 
 /**
  * Retrieve a buffer target reference for writing into the given ioblock
+ * NOTE -- any external data referenced by the ioblock will be copied in prior to returning
  * @param ioblock* block : Reference to the ioblock to retrieve a target for
  * @return void* : Buffer reference to write to
  */
 void *ioblock_write_target(ioblock *block);
 
+/**
+ * Record a reference to external data as the next contents of the given ioblock, rather than copying that data
+ * NOTE -- the referenced memory must remain unaltered until the ioblock has either been released by its consumer
+ *         or had its external data copied in via ioblock_copy_external().
+ *         If the ioblock cannot track additional references, the data will simply be copied instead.
+ * @param ioblock* block : Reference to the ioblock to update
+ * @param const void* data : External data to be referenced
+ * @param size_t bytes : Size of the external data
+ */
+void ioblock_add_external(ioblock *block, const void *data, size_t bytes);
+
+/**
+ * Copy all external data referenced by the given ioblock into its own buffer, dropping those references
+ * @param ioblock* block : Reference to the ioblock to update
+ */
+void ioblock_copy_external(ioblock *block);
+
 /**
  * Retrieve a buffer target reference for reading data from the given ioblock
  * @param ioblock* block : Reference to the ioblock to retrieve a target for
@@ -176,6 +229,37 @@ void *ioblock_read_target(ioblock *block, size_t *bytes, off_t *error_end);
  */
 void ioblock_update_fill(ioblock *block, size_t bytes, char bad_data);
 
+/**
+ * Checksum the given data via the given algorithm
+ * @param int alg : Checksum algorithm to use ( CSUM_* value )
+ * @param uint32_t crc : Seed value, or the running checksum of all preceding data
+ * @param const void* data : Reference to the data
+ * @param size_t bytes : Size of the data
+ * @return uint32_t : Checksum of all data, including that preceding this call
+ */
+uint32_t block_csum(int alg, uint32_t crc, const void *data, size_t bytes);
+
+/**
+ * Fold data, just written to the given ioblock, into the CRC maintained for that ioblock
+ * NOTE -- this allows the producer to checksum data while it is still cache-resident.  Data is only
+ *         included if it directly follows that which has already been covered; any remainder will
+ *         simply be checksummed by ioblock_get_crc().
+ * @param ioblock* block : Reference to the ioblock to update
+ * @param size_t offset : Offset of the data within the ioblock
+ * @param const void* data : Reference to the data
+ * @param size_t bytes : Size of the data
+ * @param ioqueue* ioq : Reference to the ioqueue struct from which the ioblock was gathered
+ */
+void ioblock_update_crc(ioblock *block, size_t offset, const void *data, size_t bytes, ioqueue *ioq);
+
+/**
+ * Get the CRC of all data contained in the given ioblock
+ * @param ioblock* block : Reference to the ioblock to checksum
+ * @param ioqueue* ioq : Reference to the ioqueue struct from which the ioblock was gathered
+ * @return uint32_t : CRC of the ioblock data
+ */
+uint32_t ioblock_get_crc(ioblock *block, ioqueue *ioq);
+
 /**
  * Get the current data size written to the ioblock
  * @param ioblock* block : Reference to the ioblock to update
@@ -184,12 +268,92 @@ void ioblock_update_fill(ioblock *block, size_t bytes, char bad_data);
 size_t ioblock_get_fill(ioblock *block);
 
 /**
- * Simply makes an ioblock available for use again by increasing ioqueue depth (works due to single producer & consumer assumption)
- * @param ioqueue* ioq : Reference to the ioqueue struct to have depth increased
+ * Makes the oldest reserved ioblock available for use again, waking the producer if it is waiting for one
+ * @param ioqueue* ioq : Reference to the ioqueue struct to release an ioblock to
  * @param int : Zero on success and a negative value if an error occurred
  */
 int release_ioblock(ioqueue *ioq);
 
+/**
+ * Waits for all ioblocks of the given IOQueue, aside from those still held by the caller, to be released
+ * @param ioqueue* ioq : Reference to the ioqueue struct to wait on
+ * @param int held : Number of ioblocks currently reserved by the caller, which will not be released
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int ioqueue_wait_idle(ioqueue *ioq, int held);
+
+/**
+ * Get the number of ioblocks of the given IOQueue which are currently in use ( reserved, queued, or being consumed )
+ * @param ioqueue* ioq : Reference to the ioqueue struct to check
+ * @return int : Count of in use ioblocks, or a negative value if an error occurred
+ */
+int ioqueue_outstanding(ioqueue *ioq);
+
+/* ------------------------------   LOCATION SCOREBOARD   ------------------------------ */
+
+// Health history of a single DAL location
+typedef struct location_score_struct
+{
+   DAL_location loc;               // location ( pod / block / cap / scatter ) these values describe
+   double read_latency;            // moving average of DAL read call latency, in microseconds
+   double write_latency;           // moving average of DAL write call latency, in microseconds
+   double error_rate;              // moving average of the fraction of DAL operations which failed
+   unsigned long long reads;       // total number of DAL read calls recorded
+   unsigned long long writes;      // total number of DAL write calls recorded
+   unsigned long long errors;      // total number of DAL operation failures recorded
+   time_t last_update;             // time of the most recent record ( zero if never recorded )
+   time_t last_failure;            // time of the most recent failure ( zero if none )
+} location_score;
+
+// Hash table of location_score entries, shared by many block threads
+typedef struct scoreboard_struct
+{
+   pthread_mutex_t lock;           // lock for all entries
+   size_t count;                   // number of tracked locations
+   struct score_entry_struct **buckets; // hash chains of entries
+} scoreboard;
+
+/**
+ * Creates a new, empty location scoreboard
+ * @return scoreboard* : Reference to the new scoreboard, or NULL on failure
+ */
+scoreboard *create_scoreboard(void);
+
+/**
+ * Destroys an existing location scoreboard
+ * @param scoreboard* sb : Reference to the scoreboard to be destroyed
+ */
+void destroy_scoreboard(scoreboard *sb);
+
+/**
+ * Record the outcome of a single DAL operation against the given location
+ * @param scoreboard* sb : Reference to the scoreboard to update ( NULL for a no-op )
+ * @param DAL_location loc : Location targeted by the operation
+ * @param char write : Non-zero for a write, zero for a read ( or for an operation without meaningful latency,
+ *                     if usec is negative )
+ * @param double usec : Latency of the operation in microseconds ( negative to record only success / failure )
+ * @param char error : Non-zero if the operation failed
+ */
+void scoreboard_record(scoreboard *sb, DAL_location loc, char write, double usec, char error);
+
+/**
+ * Retrieve the current health history of the given location
+ * @param scoreboard* sb : Reference to the scoreboard to check
+ * @param DAL_location loc : Location to retrieve the history of
+ * @param location_score* score : Reference to be populated with the history of that location
+ * @return int : Zero on success, or -1 if no history exists ( errno will be set to ENOENT )
+ */
+int scoreboard_lookup(scoreboard *sb, DAL_location loc, location_score *score);
+
+/**
+ * Export the health history of all tracked locations
+ * @param scoreboard* sb : Reference to the scoreboard to export
+ * @param location_score* scores : Array to be populated with location histories ( may be NULL if max is zero )
+ * @param size_t max : Maximum number of entries to populate
+ * @return size_t : Total number of tracked locations ( may exceed 'max' )
+ */
+size_t scoreboard_export(scoreboard *sb, location_score *scores, size_t max);
+
 /* ------------------------------   THREAD BEHAVIOR   ------------------------------ */
 
 // This struct contains all info read threads should need
@@ -205,7 +369,11 @@ typedef struct global_state_struct
    char meta_error;
    char data_error;
    ioqueue *ioq;
-   pthread_mutex_t* erasurelock;
+   scoreboard *sboard; // location health history to be updated ( NULL if none )
+   int numa_node;      // NUMA node to which the block thread binds itself ( negative for none )
+   // Compressed block data ( see minfo.compsz and the DAL 'compress' value )
+   uint64_t *uindex;   // stored offset of each IO unit, followed by the end of the stored data
+   size_t ucount;      // number of IO units listed in uindex
 } gthread_state;
 
 // Write thread internal state struct
@@ -217,6 +385,18 @@ typedef struct thread_state_struct
    ioblock *iob;
    uint64_t crcsumchk;
    char continuous;
+   // Vectored IO ( see the DAL putv() / getv() functions )
+   struct iovec iov[IO_VECTOR_MAX];             // combined buffer references for the next DAL call
+   int iovcnt;                                  // number of populated iov entries
+   ioblock *pending[IOBLOCK_BATCH_MAX];         // consumed ioblocks awaiting a batched write
+   int pending_cnt;                             // number of pending ioblocks
+   uint32_t crcs[IO_VECTOR_MAX / 2];            // CRC targets for vectored reads
+   // Compression ( only allocated for compressed blocks )
+   void *cbuff;                                 // compressed IO unit buffer
+   void *lvlbuf;                                // igzip level buffer
+   size_t lvlbufsz;                             // size of the igzip level buffer
+   int clevel;                                  // igzip compression level
+   char bound;                                  // indicates that this ( pooled ) thread is bound to a NUMA node
 } thread_state;
 
 /**
@@ -292,6 +472,74 @@ void write_term(void **state, void **prev_work, TQ_Control_Flags flg);
  */
 void read_term(void **state, void **prev_work, TQ_Control_Flags flg);
 
+/**
+ * Read and verify a single IO unit of a block, independent of any block thread ( for sparse reads )
+ * @param gthread_state* gstate : Global state of the block ( its dal, location, minfo, uindex, and sboard
+ *                                values are referenced )
+ * @param BLOCK_CTXT handle : Open DAL read handle for the block
+ * @param off_t unit : Index of the IO unit to be read ( each spans minfo.versz bytes of the block, including CRC )
+ * @param void* buffer : Buffer of at least minfo.versz bytes, to be populated with the data of the unit
+ * @return ssize_t : Number of verified data bytes read ( excluding the CRC ), or -1 on failure
+ */
+ssize_t read_unit(gthread_state *gstate, BLOCK_CTXT handle, off_t unit, void *buffer);
+
+/* ------------------------------   SHARED THREAD POOL   ------------------------------ */
+
+/**
+ * Retrieve the process-wide IO thread pool, for use with tq_init_pooled()
+ *  Threads are reused across ThreadQueues, so opening and closing a handle no longer creates and
+ *  joins a thread per block.  Each running queue thread occupies a pool thread ( block IO behavior
+ *  blocks on IOQueue flow control ), so the number of running threads is bounded by admission :
+ *  callers reserve slots for all of a handle's queues via iothread_pool_reserve() before launching
+ *  any of them, waiting while the pool limit is reached.  Up to IOTHREAD_POOL_MAX_IDLE threads are
+ *  parked for reuse once collected, with any beyond that terminated.
+ * @return TQ_Thread_Pool* : Reference to the shared pool ( never NULL )
+ */
+TQ_Thread_Pool *iothread_pool(void);
+
+/**
+ * Reserve slots of the process-wide IO thread pool, prior to launching that many pooled threads
+ *  NOTE -- A waiting caller is admitted once its slots fit within the pool limit, or once no other
+ *          slots are reserved at all.  Callers which already hold a reservation are never made to
+ *          wait, as they may be blocking the release of the very slots being waited upon.  For the
+ *          same reason, a thread must not wait for admission while its progress is required by a
+ *          handle opened elsewhere.
+ * @param unsigned int count : Number of slots to reserve
+ * @param char wait : If zero, the slots are taken immediately, even beyond the pool limit
+ *                    ( for extending work which has already been admitted )
+ */
+void iothread_pool_reserve(unsigned int count, char wait);
+
+/**
+ * Reserve up to the given number of IO thread pool slots, without waiting
+ * @param unsigned int count : Maximum number of slots to reserve
+ * @return unsigned int : Number of slots actually reserved ( possibly zero )
+ */
+unsigned int iothread_pool_tryreserve(unsigned int count);
+
+/**
+ * Release slots previously reserved from the process-wide IO thread pool, admitting any waiters
+ *  NOTE -- all pooled threads launched under the reservation must already have been collected
+ * @param unsigned int count : Number of slots to release
+ */
+void iothread_pool_release(unsigned int count);
+
+/**
+ * Set the limit on reserved slots of the process-wide IO thread pool ( IOTHREAD_POOL_MAX_ACTIVE, by default )
+ * @param unsigned int limit : New slot limit
+ * @return int : Zero on success, or -1 on failure ( a zero limit )
+ */
+int iothread_pool_set_limit(unsigned int limit);
+
+/**
+ * Report the current thread counts of the process-wide IO thread pool
+ * @param unsigned int* active : Reference to be populated with the number of threads running queue behavior
+ * @param unsigned int* idle : Reference to be populated with the number of parked threads
+ * @param unsigned int* reserved : Reference to be populated with the number of reserved slots
+ * @param unsigned int* waiting : Reference to be populated with the number of callers awaiting admission
+ */
+void iothread_pool_counts(unsigned int *active, unsigned int *idle, unsigned int *reserved, unsigned int *waiting);
+
 #ifdef __cplusplus
 }
 #endif
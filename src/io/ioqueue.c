@@ -116,6 +116,13 @@ underlying skt_etc() functions.
 #include "logging/logging.h"
 
 #include "io/io.h"
+#include "general_include/crc.c"
+
+#include <isa-l.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -126,8 +133,198 @@ underlying skt_etc() functions.
 #include <unistd.h>
 #include <errno.h>
 #include <pthread.h>
+#include <time.h>
+#include <sys/syscall.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#endif
+
+
+
+
+/* ------------------------------   IOBLOCK BUFFER POOL   ------------------------------ */
+
+// header overlaying the start of each idle buffer
+typedef struct iobuffer_struct
+{
+   size_t size;
+   int node; // NUMA node the buffer is bound to, or on which its pages were found ( -1 if unknown )
+   struct iobuffer_struct *next;
+} iobuffer;
+
+// process-wide cache of idle ioblock buffers
+//  NOTE -- Buffers bound to a node are tagged with that node when allocated, and are only ever reused by
+//          queues placed on that same node.  Unbound buffers land wherever they were first touched, so are
+//          kept separately, tagged by the node their pages were found to reside on when returned.
+static struct
+{
+   pthread_mutex_t lock;
+   size_t cached;     // total bytes of all idle buffers
+   iobuffer *bound;   // idle buffers bound to a specific NUMA node
+   iobuffer *unbound; // idle buffers placed by first touch
+} iobpool = { PTHREAD_MUTEX_INITIALIZER, 0, NULL, NULL };
+
+// identify the NUMA node of the calling thread ( -1 if unknown )
+static int iobuffer_local_node( void ) {
+#ifdef SYS_getcpu
+   unsigned int cpu = 0;
+   unsigned int node = 0;
+   if ( syscall( SYS_getcpu, &cpu, &node, NULL ) == 0 ) {
+      return (int)node;
+   }
+#endif
+   return -1;
+}
+
+// identify the NUMA node on which the ( first page of the ) given buffer resides ( -1 if unknown )
+static int iobuffer_resident_node( void* buff ) {
+#ifdef HAVE_LIBNUMA
+   int node = -1;
+   if ( get_mempolicy( &node, NULL, 0, buff, MPOL_F_NODE | MPOL_F_ADDR ) == 0 ) {
+      return node;
+   }
+#endif
+   return -1;
+}
+
+// retrieve an aligned buffer of exactly 'size' bytes, reusing an idle one if possible
+//  ( buffers are bound to the given NUMA node, or placed by first touch if negative )
+static void* iobuffer_get( size_t size, int numa_node ) {
+   if ( size >= sizeof( struct iobuffer_struct ) ) {
+      // an unbound buffer may come from anywhere, but preferably from our own node
+      int want = ( numa_node < 0 ) ? iobuffer_local_node() : numa_node;
+      pthread_mutex_lock( &iobpool.lock );
+      iobuffer** prev = ( numa_node < 0 ) ? &(iobpool.unbound) : &(iobpool.bound);
+      iobuffer** found = NULL;
+      iobuffer** tailprev = NULL;
+      while ( *prev != NULL ) {
+         iobuffer* iob = *prev;
+         if ( iob->size == size ) {
+            if ( iob->node == want ) { found = prev; break; }
+            if ( numa_node < 0  &&  found == NULL ) { found = prev; }
+         }
+         tailprev = prev;
+         prev = &(iob->next);
+      }
+      if ( found != NULL ) {
+         iobuffer* iob = *found;
+         *found = iob->next;
+         iobpool.cached -= size;
+         pthread_mutex_unlock( &iobpool.lock );
+         return (void*)iob;
+      }
+      // on a miss, drop the oldest idle buffer of this list if we are at capacity
+      //  ( prevents buffers of a no-longer-used size from pinning the pool )
+      if ( tailprev != NULL  &&  iobpool.cached + size > IOBUFFER_POOL_MAX_BYTES ) {
+         iobuffer* iob = *tailprev;
+         *tailprev = NULL;
+         iobpool.cached -= iob->size;
+         pthread_mutex_unlock( &iobpool.lock );
+         free( iob );
+      }
+      else {
+         pthread_mutex_unlock( &iobpool.lock );
+      }
+   }
+   void* buff = NULL;
+   int allocres = posix_memalign( &buff, 4096, size );
+   if ( allocres ) {
+      errno = allocres; // posix_memalign() does not set errno for us
+      return NULL;
+   }
+#ifdef HAVE_LIBNUMA
+   // bind pages before their first touch, which would otherwise place them local to the toucher
+   if ( numa_node >= 0 ) {
+      numa_tonode_memory( buff, size, numa_node );
+   }
+#endif
+   return buff;
+}
+
+// return a buffer, retrieved with the same 'numa_node' value, to the pool, or free it if the pool is full
+static void iobuffer_put( void* buff, size_t size, int numa_node ) {
+   if ( buff == NULL ) { return; }
+   if ( size >= sizeof( struct iobuffer_struct ) ) {
+      int node = ( numa_node < 0 ) ? iobuffer_resident_node( buff ) : numa_node;
+      pthread_mutex_lock( &iobpool.lock );
+      if ( iobpool.cached + size <= IOBUFFER_POOL_MAX_BYTES ) {
+         iobuffer** list = ( numa_node < 0 ) ? &(iobpool.unbound) : &(iobpool.bound);
+         iobuffer* iob = (iobuffer*)buff;
+         iob->size = size;
+         iob->node = node;
+         iob->next = *list;
+         *list = iob;
+         iobpool.cached += size;
+         pthread_mutex_unlock( &iobpool.lock );
+         return;
+      }
+      pthread_mutex_unlock( &iobpool.lock );
+   }
+   free( buff );
+}
+
+
+/* ------------------------------   IOQUEUE WAITING   ------------------------------ */
+
+// briefly yield the CPU to any sibling hyperthread, while polling
+static inline void ioqueue_cpu_relax( void ) {
+#if defined(__x86_64__) || defined(__i386__)
+   __builtin_ia32_pause();
+#elif defined(__aarch64__)
+   __asm__ __volatile__( "yield" );
+#endif
+}
 
+// sleep so long as the given word retains the given value ( spurious wakeups are possible )
+static void ioqueue_futex_wait( uint32_t* word, uint32_t value ) {
+#if defined(SYS_futex) && defined(FUTEX_WAIT_PRIVATE)
+   syscall( SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0 );
+#else
+   // no futex support, so simply poll at a reduced rate
+   struct timespec delay = { .tv_sec = 0, .tv_nsec = 50000 };
+   if ( __atomic_load_n( word, __ATOMIC_ACQUIRE ) == value ) { nanosleep( &delay, NULL ); }
+#endif
+}
 
+// wake all threads sleeping on the given word
+static void ioqueue_futex_wake( uint32_t* word ) {
+#if defined(SYS_futex) && defined(FUTEX_WAKE_PRIVATE)
+   syscall( SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 );
+#endif
+}
+
+/**
+ * (INTERNAL HELPER FUNC)
+ * Wait for no more than the given number of ioblocks to be outstanding, polling before sleeping
+ * @param ioqueue* ioq : Reference to the ioqueue struct to wait on
+ * @param uint32_t maxout : Maximum number of outstanding ioblocks
+ * @param int spin : Number of times to poll before sleeping
+ * @return int : Zero if the condition was met immediately, one if it was met while polling,
+ *               and two if it was met only after sleeping
+ */
+static int ioqueue_await( ioqueue* ioq, uint32_t maxout, int spin ) {
+   uint32_t reserved = __atomic_load_n( &(ioq->reserved), __ATOMIC_ACQUIRE );
+   int poll;
+   for ( poll = 0; poll <= spin; poll++ ) {
+      // NOTE -- free-running counts remain correct across wraparound, as unsigned differences
+      if ( reserved - __atomic_load_n( &(ioq->released), __ATOMIC_ACQUIRE ) <= maxout ) {
+         return ( poll ) ? 1 : 0;
+      }
+      ioqueue_cpu_relax();
+   }
+   while ( 1 ) {
+      // announce ourself before the final check, so that a releaser either sees us or we see its release
+      __atomic_fetch_add( &(ioq->waiters), 1, __ATOMIC_SEQ_CST );
+      uint32_t released = __atomic_load_n( &(ioq->released), __ATOMIC_SEQ_CST );
+      if ( reserved - released <= maxout ) {
+         __atomic_fetch_sub( &(ioq->waiters), 1, __ATOMIC_SEQ_CST );
+         return 2;
+      }
+      LOG( LOG_INFO, "Waiting for %u outstanding ioblocks\n", ( reserved - released ) - maxout );
+      ioqueue_futex_wait( &(ioq->released), released );
+      __atomic_fetch_sub( &(ioq->waiters), 1, __ATOMIC_SEQ_CST );
+   }
+}
 
 
 /* ------------------------------   IO QUEUE/BLOCK INTERACTION   ------------------------------ */
@@ -135,17 +332,28 @@ underlying skt_etc() functions.
 
 /**
  * Creates a new IOQueue
+ *  Ioblock buffers are drawn from a process-wide pool, and returned there by destroy_ioqueue()
  * @param size_t iosz : Byte size of each IO to be performed
  * @param size_t partsz : Byte size of each erasure part
+ * @param DAL_MODE mode : Mode of the IO to be performed
+ * @param int depth : Number of ioblocks in the queue ( zero for SUPER_BLOCK_CNT, at least 2 otherwise )
+ * @param int numa_node : NUMA node on which to place ioblock buffers ( negative for that of the calling thread )
  * @return ioqueue* : Reference to the newly created IOQueue
  */
-ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
-   LOG( LOG_INFO, "Creating IOQueue with IOSZ=%zu, PARTSZ=%zu, MODE=%s\n", iosz, partsz, ( mode == DAL_READ ) ? "read" : "write" );
+ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode, int depth, int numa_node ) {
+   if ( depth == 0 ) { depth = SUPER_BLOCK_CNT; }
+   LOG( LOG_INFO, "Creating IOQueue with IOSZ=%zu, PARTSZ=%zu, MODE=%s, DEPTH=%d\n", iosz, partsz, ( mode == DAL_READ ) ? "read" : "write", depth );
    // sanity check that our IO Size is sufficient to at least do something
    if ( iosz <= CRC_BYTES ) {
       LOG( LOG_ERR, "IO Size of %zu is too small for CRC size of %d!\n", iosz, CRC_BYTES );
       return NULL;
    }
+   // one block is always held by the producer, so we need at least one more to be able to push data
+   if ( depth < 2  ||  depth > IOQUEUE_MAX_DEPTH ) {
+      LOG( LOG_ERR, "IOQueue depth of %d is outside the allowable range of 2 to %d!\n", depth, IOQUEUE_MAX_DEPTH );
+      errno = EINVAL;
+      return NULL;
+   }
    size_t subsz = (mode == DAL_READ) ? (iosz - CRC_BYTES) : partsz;
    int    partcnt = (int) ( (iosz - CRC_BYTES) / partsz); // number of complete parts per IO
    if ( partsz > (iosz - CRC_BYTES) ) {
@@ -158,16 +366,9 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
       LOG( LOG_ERR, "failed to allocate memory for an ioqueue_struct!\n" );
       return NULL;
    }
-   // intialize all ioqueue values
-   if ( pthread_mutex_init( &(ioq->qlock), NULL ) ) {
-      LOG( LOG_ERR, "failed to initialize the ioqueue lock!\n" );
-      free( ioq );
-      return NULL;
-   }
-   // initialize the condition var
-   if ( pthread_cond_init( &(ioq->avail_block), NULL ) ) {
-      LOG( LOG_ERR, "failed to initialize the ioqueue avail_block conditional var!\n" );
-      pthread_mutex_destroy( &(ioq->qlock) );
+   ioq->block_list = calloc( depth, sizeof( struct ioblock_struct ) );
+   if ( ioq->block_list == NULL ) {
+      LOG( LOG_ERR, "failed to allocate memory for a list of %d ioblocks!\n", depth );
       free( ioq );
       return NULL;
    }
@@ -180,8 +381,15 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
    ioq->partsz = partsz;
    ioq->iosz = iosz;
    ioq->partcnt = partcnt;
+   // intialize all ioqueue values
+   ioq->reserved = 0;
+   ioq->released = 0;
+   ioq->waiters = 0;
    ioq->head = 0;
-   ioq->depth = SUPER_BLOCK_CNT;
+   ioq->spin = IOQUEUE_SPIN_MIN;
+   ioq->block_cnt = depth;
+   ioq->csum = CSUM_CRC32;
+   ioq->numa_node = numa_node;
    // calculate the blocksz we must allocate to allways fit written data
    // NOTE -- assuming perfect IOSZ and PARTSZ alignment, we will need space for a full buffer plus
    //         room for trailing CRC bytes.
@@ -201,24 +409,45 @@ ioqueue* create_ioqueue( size_t iosz, size_t partsz, DAL_MODE mode ) {
    //   overflow = 1;
    //}
    LOG( LOG_INFO, "Using ioblock size of %zu\n", ioq->blocksz );
+   // when writing, each ioblock may reference up to a full IO of external parts, plus a split part at either end
+   int ext_max = ( mode == DAL_READ ) ? 0 : (int)( ioq->split_threshold / partsz ) + 2;
    int i;
-   for ( i = 0; i < SUPER_BLOCK_CNT; i++ ) {
+   for ( i = 0; i < depth; i++ ) {
       // initialize state and struct for each ioblock
-      int allocres = posix_memalign( &(ioq->block_list[i].buff), 4096, sizeof( char ) * ioq->blocksz );
-      if ( allocres  ||  ioq->block_list[i].buff == NULL ) {
+      ioq->block_list[i].buff = iobuffer_get( sizeof( char ) * ioq->blocksz, ioq->numa_node );
+      if ( ioq->block_list[i].buff == NULL ) {
          // we've messed up, time to try to clean everything up
          LOG( LOG_ERR, "failed to allocate space for ioblock %d!\n", i );
+         int olderr = errno;
          for ( i -= 1; i >= 0; i-- ) {
-            free( ioq->block_list[i].buff );
+            free( ioq->block_list[i].iov );
+            iobuffer_put( ioq->block_list[i].buff, ioq->blocksz, ioq->numa_node );
          }
-         pthread_cond_destroy( &(ioq->avail_block) );
-         pthread_mutex_destroy( &(ioq->qlock) );
+         free( ioq->block_list );
          free( ioq );
-         errno = allocres; // posix_memalign() does not set errno for us
+         errno = olderr;
          return NULL;
       }
+      ioq->block_list[i].iov = NULL;
+      if ( ext_max ) {
+         ioq->block_list[i].iov = calloc( ext_max + 2, sizeof( struct iovec ) );
+         if ( ioq->block_list[i].iov == NULL ) {
+            LOG( LOG_ERR, "failed to allocate space for external references of ioblock %d!\n", i );
+            iobuffer_put( ioq->block_list[i].buff, ioq->blocksz, ioq->numa_node );
+            for ( i -= 1; i >= 0; i-- ) {
+               free( ioq->block_list[i].iov );
+               iobuffer_put( ioq->block_list[i].buff, ioq->blocksz, ioq->numa_node );
+            }
+            free( ioq->block_list );
+            free( ioq );
+            return NULL;
+         }
+      }
       ioq->block_list[i].data_size   = 0;
       ioq->block_list[i].error_end   = 0;
+      ioq->block_list[i].ext_offset  = 0;
+      ioq->block_list[i].ext_cnt     = 0;
+      ioq->block_list[i].ext_max     = ext_max;
    }
    return ioq;
 }
@@ -234,22 +463,16 @@ int destroy_ioqueue( ioqueue* ioq ) {
       LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
       return -1;
    }
-   if ( pthread_mutex_lock(&ioq->qlock) ) { // aquire the queue lock
-      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
-      return -1;
-   }
-   if ( ioq->depth != SUPER_BLOCK_CNT ) {
+   if ( __atomic_load_n( &(ioq->reserved), __ATOMIC_ACQUIRE ) != __atomic_load_n( &(ioq->released), __ATOMIC_ACQUIRE ) ) {
       LOG( LOG_ERR, "Cannot destroy ioqueue struct while ioblocks are in use!\n" );
-      pthread_mutex_unlock(&ioq->qlock);
       return -1;
    }
    int i;
-   for ( i = 0; i < SUPER_BLOCK_CNT; i++ ) {
-      free( ioq->block_list[i].buff );
+   for ( i = 0; i < ioq->block_cnt; i++ ) {
+      free( ioq->block_list[i].iov );
+      iobuffer_put( ioq->block_list[i].buff, ioq->blocksz, ioq->numa_node );
    }
-   pthread_cond_destroy( &(ioq->avail_block) );
-   pthread_mutex_unlock(&ioq->qlock);
-   pthread_mutex_destroy( &(ioq->qlock) );
+   free( ioq->block_list );
    free( ioq );
    LOG( LOG_INFO, "IOQueue successfully destroyed\n" );
    return 0;
@@ -266,7 +489,7 @@ ssize_t ioqueue_maxdata( ioqueue* ioq ) {
       LOG( LOG_ERR, "Received NULL ioqueue reference!\n" );
       return -1;
    }
-   return ( SUPER_BLOCK_CNT * ioq->split_threshold );
+   return ( ioq->block_cnt * ioq->split_threshold );
 }
 
 
@@ -304,6 +527,36 @@ int align_ioblock( ioblock* cur_block, size_t trim, ioqueue* ioq ) {
 }
 
 
+/**
+ * Transfer all external references of one ioblock, beyond the given split offset, to a new ioblock
+ * @param ioblock* prev_block : Reference to the ioblock to be split
+ * @param ioblock* new_block : Reference to the ( empty ) ioblock to receive the excess references
+ * @param size_t split : Offset at which to split, which must fall within the external data of prev_block
+ */
+static void split_external( ioblock* prev_block, ioblock* new_block, size_t split ) {
+   // locate the first reference extending beyond the split
+   size_t pos = prev_block->ext_offset;
+   int i;
+   for ( i = 1; i <= prev_block->ext_cnt; i++ ) {
+      if ( pos + prev_block->iov[i].iov_len > split ) { break; }
+      pos += prev_block->iov[i].iov_len;
+   }
+   int last = i - 1; // final reference which remains entirely in prev_block
+   size_t keep = split - pos;
+   // pass over the remainder of that reference, along with all that follow
+   for ( ; i <= prev_block->ext_cnt; i++ ) {
+      ioblock_add_external( new_block, prev_block->iov[i].iov_base + keep, prev_block->iov[i].iov_len - keep );
+      if ( keep ) {
+         // trim the split reference down to just the portion prior to the split
+         prev_block->iov[i].iov_len = keep;
+         last = i;
+         keep = 0;
+      }
+   }
+   prev_block->ext_cnt = last;
+}
+
+
 /**
  * Determines if a new ioblock is necessary to store additional data and, if so, reserves it.  Also, as ioblocks are filled, 
  * populates the 'push_block' reference with the ioblock that should be passed for read/write use.
@@ -340,7 +593,13 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
       }
       // otherwise, we may need to copy data over to the new ioblock
       if ( prev_block->data_size > ioq->split_threshold ) {
-         datacpy = prev_block->buff + ioq->split_threshold;
+         // external references can be handed over directly, so long as the split falls among them
+         if ( prev_block->ext_cnt  &&  prev_block->ext_offset > ioq->split_threshold ) {
+            ioblock_copy_external( prev_block );
+         }
+         if ( prev_block->ext_cnt == 0 ) {
+            datacpy = prev_block->buff + ioq->split_threshold;
+         }
          cpysz = prev_block->data_size - ioq->split_threshold;
          // sanity check
          if ( prev_block->data_size > ioq->blocksz ) {
@@ -353,26 +612,42 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
    }
 
    // if the previous block was NULL or did not have sufficient space, we need to reserve a new block
-   if ( pthread_mutex_lock(&ioq->qlock) ) { // aquire the queue lock
-      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
-      return -1;
-   }
-   // wait for a block to be available for use
-   while ( ioq->depth == 0 ) {
-      LOG( LOG_INFO, "Waiting for ioblock to become available\n" );
-      pthread_cond_wait( &ioq->avail_block, &ioq->qlock );
-   }
+   // wait for a block to be available for use, adapting our polling to how long releases tend to take
+   int waited = ioqueue_await( ioq, ioq->block_cnt - 1, ioq->spin );
+   if ( waited == 1  &&  ioq->spin < IOQUEUE_SPIN_MAX ) { ioq->spin *= 2; }
+   else if ( waited == 2  &&  ioq->spin > IOQUEUE_SPIN_MIN ) { ioq->spin /= 2; }
    // update the current block to the new reference
    (*cur_block) = &(ioq->block_list[ioq->head]);
    // update queue values to reflect the block being in use
-   ioq->depth--;
    ioq->head += 1;
-   if ( ioq->head == SUPER_BLOCK_CNT ) { ioq->head = 0; }
-   pthread_mutex_unlock(&ioq->qlock);
+   if ( ioq->head == ioq->block_cnt ) { ioq->head = 0; }
+   __atomic_store_n( &(ioq->reserved), ioq->reserved + 1, __ATOMIC_RELEASE );
 
    // clear any old values in this newly reserved block
    (*cur_block)->data_size   = 0;
    (*cur_block)->error_end   = 0;
+   (*cur_block)->ext_cnt     = 0;
+   (*cur_block)->ext_offset  = 0;
+   (*cur_block)->crc_len     = 0;
+   (*cur_block)->crc         = CRC_SEED;
+   (*cur_block)->spill_len   = 0;
+   (*cur_block)->spill_crc   = CRC_SEED;
+   // hand over any external references beyond the split
+   if ( cpysz  &&  datacpy == NULL ) {
+      LOG( LOG_INFO, "Passing %zu bytes of external references to next ioblock\n", cpysz );
+      split_external( prev_block, (*cur_block), ioq->split_threshold );
+      prev_block->data_size = ioq->split_threshold; // update prev block to exclude passed data
+   }
+   // pass along any CRC coverage of the data beyond the split
+   if ( cpysz  &&  prev_block->spill_len == cpysz ) {
+      (*cur_block)->crc_len = cpysz;
+      (*cur_block)->crc     = prev_block->spill_crc;
+   }
+   // coverage inherited in this way may itself extend beyond the split, and is useless once trimmed
+   if ( prev_block != NULL  &&  prev_block->crc_len > ioq->split_threshold ) {
+      prev_block->crc_len = 0;
+      prev_block->crc     = CRC_SEED;
+   }
 
    // we have the new block; check if we need to copy data over to it
    if ( datacpy != NULL ) {
@@ -399,10 +674,53 @@ int reserve_ioblock( ioblock** cur_block, ioblock** push_block, ioqueue* ioq ) {
  * @return void* : Buffer reference to write to
  */
 void* ioblock_write_target( ioblock* block ) {
+   if ( block->ext_cnt ) {
+      ioblock_copy_external( block );
+   }
    return block->buff + block->data_size;
 }
 
 
+/**
+ * Record a reference to external data as the next contents of the given ioblock, rather than copying that data
+ * NOTE -- the referenced memory must remain unaltered until the ioblock has either been released by its consumer
+ *         or had its external data copied in via ioblock_copy_external().
+ *         If the ioblock cannot track additional references, the data will simply be copied instead.
+ * @param ioblock* block : Reference to the ioblock to update
+ * @param const void* data : External data to be referenced
+ * @param size_t bytes : Size of the external data
+ */
+void ioblock_add_external( ioblock* block, const void* data, size_t bytes ) {
+   if ( block->ext_cnt == block->ext_max ) {
+      memcpy( ioblock_write_target( block ), data, bytes );
+      block->data_size += bytes;
+      return;
+   }
+   if ( block->ext_cnt == 0 ) {
+      block->ext_offset = block->data_size;
+   }
+   block->ext_cnt++;
+   block->iov[block->ext_cnt].iov_base = (void*)data;
+   block->iov[block->ext_cnt].iov_len = bytes;
+   block->data_size += bytes;
+}
+
+
+/**
+ * Copy all external data referenced by the given ioblock into its own buffer, dropping those references
+ * @param ioblock* block : Reference to the ioblock to update
+ */
+void ioblock_copy_external( ioblock* block ) {
+   void* tgt = block->buff + block->ext_offset;
+   int i;
+   for ( i = 1; i <= block->ext_cnt; i++ ) {
+      memcpy( tgt, block->iov[i].iov_base, block->iov[i].iov_len );
+      tgt += block->iov[i].iov_len;
+   }
+   block->ext_cnt = 0;
+}
+
+
 /**
  * Retrieve a buffer target reference for reading data from the given ioblock
  * @param ioblock* block : Reference to the ioblock to retrieve a target for
@@ -449,6 +767,95 @@ void ioblock_overwrite_fill( ioblock* block, size_t bytes, off_t error_end ) {
 }
 
 
+/**
+ * Checksum the given data via the given algorithm
+ * @param int alg : Checksum algorithm to use ( CSUM_* value )
+ * @param uint32_t crc : Seed value, or the running checksum of all preceding data
+ * @param const void* data : Reference to the data
+ * @param size_t bytes : Size of the data
+ * @return uint32_t : Checksum of all data, including that preceding this call
+ */
+uint32_t block_csum( int alg, uint32_t crc, const void* data, size_t bytes ) {
+   if ( alg == CSUM_CRC32C ) {
+      // crc32_iscsi() accepts only an int length
+      while ( bytes > INT_MAX ) {
+         crc = crc32_iscsi( (unsigned char*)data, INT_MAX, crc );
+         data  += INT_MAX;
+         bytes -= INT_MAX;
+      }
+      return crc32_iscsi( (unsigned char*)data, (int)bytes, crc );
+   }
+   return crc32_ieee( crc, (unsigned char*)data, bytes );
+}
+
+
+/**
+ * Fold data, just written to the given ioblock, into the CRC maintained for that ioblock
+ * NOTE -- this allows the producer to checksum data while it is still cache-resident.  Data is only
+ *         included if it directly follows that which has already been covered; any remainder will
+ *         simply be checksummed by ioblock_get_crc().
+ * @param ioblock* block : Reference to the ioblock to update
+ * @param size_t offset : Offset of the data within the ioblock
+ * @param const void* data : Reference to the data
+ * @param size_t bytes : Size of the data
+ * @param ioqueue* ioq : Reference to the ioqueue struct from which the ioblock was gathered
+ */
+void ioblock_update_crc( ioblock* block, size_t offset, const void* data, size_t bytes, ioqueue* ioq ) {
+   // data prior to the split threshold will be written out with this ioblock
+   if ( offset < ioq->split_threshold ) {
+      size_t cover = ioq->split_threshold - offset;
+      if ( cover > bytes ) { cover = bytes; }
+      if ( offset == block->crc_len ) {
+         block->crc = block_csum( ioq->csum, block->crc, data, cover );
+         block->crc_len += cover;
+      }
+      offset += cover;
+      data   += cover;
+      bytes  -= cover;
+   }
+   // data beyond the split threshold will be passed to the next ioblock
+   if ( bytes  &&  offset == ioq->split_threshold + block->spill_len ) {
+      block->spill_crc = block_csum( ioq->csum, block->spill_crc, data, bytes );
+      block->spill_len += bytes;
+   }
+}
+
+
+/**
+ * Get the CRC of all data contained in the given ioblock
+ * @param ioblock* block : Reference to the ioblock to checksum
+ * @param ioqueue* ioq : Reference to the ioqueue struct from which the ioblock was gathered
+ * @return uint32_t : CRC of the ioblock data
+ */
+uint32_t ioblock_get_crc( ioblock* block, ioqueue* ioq ) {
+   uint32_t crc = block->crc;
+   size_t skip = block->crc_len;
+   if ( skip >= block->data_size ) {
+      return crc;
+   }
+   // checksum any buffered data which has yet to be covered
+   size_t buffered = ( block->ext_cnt ) ? block->ext_offset : block->data_size;
+   if ( skip < buffered ) {
+      crc = block_csum( ioq->csum, crc, block->buff + skip, buffered - skip );
+      skip = 0;
+   }
+   else {
+      skip -= buffered;
+   }
+   // checksum any external data which has yet to be covered
+   int i;
+   for ( i = 1; i <= block->ext_cnt; i++ ) {
+      if ( skip >= block->iov[i].iov_len ) {
+         skip -= block->iov[i].iov_len;
+         continue;
+      }
+      crc = block_csum( ioq->csum, crc, block->iov[i].iov_base + skip, block->iov[i].iov_len - skip );
+      skip = 0;
+   }
+   return crc;
+}
+
+
 /**
  * Get the current data size written to the ioblock
  * @param ioblock* block : Reference to the ioblock to update
@@ -460,26 +867,49 @@ size_t ioblock_get_fill( ioblock* block ) {
 
 
 /**
- * Simply makes an ioblock available for use again by increasing ioqueue depth (works due to single producer & consumer assumption)
- * @param ioqueue* ioq : Reference to the ioqueue struct to have depth increased
+ * Makes the oldest reserved ioblock available for use again, waking the producer if it is waiting for one
+ * @param ioqueue* ioq : Reference to the ioqueue struct to release an ioblock to
  * @param int : Zero on success and a negative value if an error occurred
  */
 int release_ioblock( ioqueue* ioq ) {
-   if ( pthread_mutex_lock(&ioq->qlock) ) { // aquire the queue lock
-      LOG( LOG_ERR, "Failed to aquire ioqueue lock!\n" );
-      return -1;
+   // NOTE -- a producer may release its own ioblocks while the consumer does the same, so update via CAS
+   uint32_t released = __atomic_load_n( &(ioq->released), __ATOMIC_ACQUIRE );
+   do {
+      if ( released == __atomic_load_n( &(ioq->reserved), __ATOMIC_ACQUIRE ) ) {
+         LOG( LOG_ERR, "No outstanding ioblocks to be released!\n" );
+         return -1;
+      }
+   } while ( !__atomic_compare_exchange_n( &(ioq->released), &released, released + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE ) );
+   LOG( LOG_INFO, "%u out of %d ioblocks outstanding\n", __atomic_load_n( &(ioq->reserved), __ATOMIC_RELAXED ) - ( released + 1 ), ioq->block_cnt );
+   if ( __atomic_load_n( &(ioq->waiters), __ATOMIC_SEQ_CST ) ) {
+      ioqueue_futex_wake( &(ioq->released) );
    }
-   if ( ioq->depth == SUPER_BLOCK_CNT ) {
-      LOG( LOG_ERR, "No outstanding ioblocks to be released!\n" );
-      pthread_mutex_unlock(&ioq->qlock);
+   return 0;
+}
+
+
+/**
+ * Waits for all ioblocks of the given IOQueue, aside from those still held by the caller, to be released
+ * @param ioqueue* ioq : Reference to the ioqueue struct to wait on
+ * @param int held : Number of ioblocks currently reserved by the caller, which will not be released
+ * @return int : Zero on success and a negative value if an error occurred
+ */
+int ioqueue_wait_idle( ioqueue* ioq, int held ) {
+   if ( held < 0 ) {
+      LOG( LOG_ERR, "Received a negative held ioblock count!\n" );
       return -1;
    }
-   ioq->depth++;
-   LOG( LOG_INFO, "%d out of %d ioblocks available\n", ioq->depth, SUPER_BLOCK_CNT );
-   pthread_cond_signal(&ioq->avail_block);
-   pthread_mutex_unlock(&ioq->qlock);
+   ioqueue_await( ioq, (uint32_t)held, IOQUEUE_SPIN_MIN );
    return 0;
 }
 
 
-
+/**
+ * Get the number of ioblocks of the given IOQueue which are currently in use ( reserved, queued, or being consumed )
+ * @param ioqueue* ioq : Reference to the ioqueue struct to check
+ * @return int : Count of in use ioblocks, or a negative value if an error occurred
+ */
+int ioqueue_outstanding( ioqueue* ioq ) {
+   uint32_t released = __atomic_load_n( &(ioq->released), __ATOMIC_ACQUIRE );
+   return (int)( __atomic_load_n( &(ioq->reserved), __ATOMIC_ACQUIRE ) - released );
+}
@@ -115,6 +115,9 @@ underlying skt_etc() functions.
 #include "general_include/crc.c"
 
 #include <isa-l.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
@@ -127,10 +130,306 @@ underlying skt_etc() functions.
 #include <assert.h>
 #include <pthread.h>
 #include <stdlib.h>
+#include <time.h>
 
 
 /* ------------------------------   THREAD BEHAVIOR FUNCTIONS   ------------------------------ */
 
+/**
+ * Calculate the time elapsed since the given start time
+ * @param struct timespec* start : Start time ( CLOCK_MONOTONIC )
+ * @return double : Elapsed time in microseconds
+ */
+static double elapsed_usec(struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return ((now.tv_sec - start->tv_sec) * 1000000.0) + ((now.tv_nsec - start->tv_nsec) / 1000.0);
+}
+
+/* ------------------------------   NUMA PLACEMENT   ------------------------------ */
+
+/**
+ * Bind the calling thread, and any memory it allocates, to the NUMA node of its block ( if any )
+ * @param thread_state* tstate : Thread state reference
+ */
+static void bind_thread(thread_state* tstate) {
+   tstate->bound = 0;
+#ifdef HAVE_LIBNUMA
+   gthread_state* gstate = (gthread_state*)(tstate->gstate);
+   if (gstate->numa_node >= 0) {
+      if (numa_run_on_node(gstate->numa_node)) {
+         LOG(LOG_WARNING, "Block %d failed to bind its thread to NUMA node %d\n", gstate->location.block, gstate->numa_node);
+         return;
+      }
+      numa_set_preferred(gstate->numa_node);
+      tstate->bound = 1;
+   }
+#endif
+}
+
+/**
+ * Release any NUMA binding of the calling thread, as it may next serve another block
+ * @param thread_state* tstate : Thread state reference
+ */
+static void unbind_thread(thread_state* tstate) {
+#ifdef HAVE_LIBNUMA
+   if (tstate->bound) {
+      numa_run_on_node(-1);
+      numa_set_localalloc();
+      tstate->bound = 0;
+   }
+#endif
+}
+
+/* ------------------------------   BLOCK COMPRESSION   ------------------------------ */
+
+// Compressed blocks store each IO unit ( data and CRC ) as an independent deflate stream, unless that
+// would not reduce its size, in which case the unit is stored as is.  The stored units are followed by
+// an index of their offsets, terminated by the total stored size ( minfo.compsz ).  All other block
+// values ( minfo.blocksz, offsets, CRCs ) continue to refer to the uncompressed data.
+
+/**
+ * Allocate compression buffers for a write thread, if our DAL calls for compression
+ * @param thread_state* tstate : Thread state reference
+ * @return int : Zero on success, -1 on failure
+ */
+static int init_compression(thread_state* tstate) {
+   gthread_state* gstate = (gthread_state*)(tstate->gstate);
+   gstate->minfo.compsz = 0;
+   if (gstate->dal->compress < 0) {
+      return 0;
+   }
+#ifdef HAVE_IGZIP
+   tstate->clevel = gstate->dal->compress;
+   if (tstate->clevel > ISAL_DEF_MAX_LEVEL) {
+      LOG(LOG_WARNING, "Reducing unsupported compression level %d to %d\n", tstate->clevel, ISAL_DEF_MAX_LEVEL);
+      tstate->clevel = ISAL_DEF_MAX_LEVEL;
+   }
+   switch (tstate->clevel) {
+      case 1:
+         tstate->lvlbufsz = ISAL_DEF_LVL1_DEFAULT;
+         break;
+#ifdef ISAL_DEF_LVL2_DEFAULT
+      case 2:
+         tstate->lvlbufsz = ISAL_DEF_LVL2_DEFAULT;
+         break;
+#endif
+#ifdef ISAL_DEF_LVL3_DEFAULT
+      case 3:
+         tstate->lvlbufsz = ISAL_DEF_LVL3_DEFAULT;
+         break;
+#endif
+      default:
+         tstate->lvlbufsz = 0;
+   }
+   if (tstate->lvlbufsz) {
+      tstate->lvlbuf = malloc(tstate->lvlbufsz);
+      if (tstate->lvlbuf == NULL) {
+         LOG(LOG_ERR, "Block %d failed to allocate a compression level buffer!\n", gstate->location.block);
+         return -1;
+      }
+   }
+   tstate->cbuff = malloc(gstate->minfo.versz);
+   if (tstate->cbuff == NULL) {
+      LOG(LOG_ERR, "Block %d failed to allocate a compression buffer!\n", gstate->location.block);
+      free(tstate->lvlbuf);
+      tstate->lvlbuf = NULL;
+      return -1;
+   }
+   return 0;
+#else
+   LOG(LOG_ERR, "Block compression was requested, but is unsupported by this build!\n");
+   errno = ENOTSUP;
+   return -1;
+#endif
+}
+
+/**
+ * Compress a single IO unit into the compression buffer of the given thread
+ * @param thread_state* tstate : Thread state reference
+ * @param void* src : IO unit to be compressed ( data and CRC )
+ * @param size_t len : Size of the IO unit
+ * @return size_t : Size of the compressed IO unit, or zero if compression would not reduce its size
+ */
+static size_t compress_unit(thread_state* tstate, void* src, size_t len) {
+#ifdef HAVE_IGZIP
+   struct isal_zstream stream;
+   isal_deflate_stateless_init(&stream);
+   stream.level = tstate->clevel;
+   stream.level_buf = tstate->lvlbuf;
+   stream.level_buf_size = tstate->lvlbufsz;
+   stream.end_of_stream = 1;
+   stream.flush = NO_FLUSH;
+   stream.next_in = src;
+   stream.avail_in = len;
+   stream.next_out = tstate->cbuff;
+   stream.avail_out = len - 1; // anything larger is better left uncompressed
+   if (isal_deflate_stateless(&stream) != COMP_OK) {
+      return 0;
+   }
+   return stream.total_out;
+#else
+   return 0;
+#endif
+}
+
+/**
+ * Note the stored offset of the next IO unit of a compressed block
+ * @param gthread_state* gstate : Global state of the block
+ * @return int : Zero on success, -1 on failure
+ */
+static int index_unit(gthread_state* gstate) {
+   if ((gstate->ucount % UNIT_INDEX_GROWTH) == 0) {
+      // always leave room for the trailing end of data
+      uint64_t* newindex = realloc(gstate->uindex, (gstate->ucount + UNIT_INDEX_GROWTH + 1) * sizeof(uint64_t));
+      if (newindex == NULL) {
+         LOG(LOG_ERR, "Block %d failed to expand its IO unit index!\n", gstate->location.block);
+         return -1;
+      }
+      gstate->uindex = newindex;
+   }
+   gstate->uindex[gstate->ucount] = gstate->minfo.compsz;
+   gstate->ucount++;
+   return 0;
+}
+
+/**
+ * Read in and validate the IO unit index of a compressed block
+ * @param thread_state* tstate : Thread state reference
+ * @return int : Zero on success, -1 on failure
+ */
+static int load_unit_index(thread_state* tstate) {
+   gthread_state* gstate = (gthread_state*)(tstate->gstate);
+   free(gstate->uindex);
+   gstate->uindex = NULL;
+   gstate->ucount = 0;
+   if (gstate->minfo.compsz <= 0) {
+      return 0;
+   }
+   if (gstate->minfo.versz <= CRC_BYTES || gstate->minfo.blocksz <= 0) {
+      LOG(LOG_ERR, "Block %d has compressed data, but invalid versz/blocksz values!\n", gstate->location.block);
+      return -1;
+   }
+   size_t units = (gstate->minfo.blocksz + gstate->minfo.versz - 1) / gstate->minfo.versz;
+   size_t indexsz = (units + 1) * sizeof(uint64_t);
+   uint64_t* index = malloc(indexsz);
+   if (index == NULL) {
+      LOG(LOG_ERR, "Block %d failed to allocate space for an IO unit index!\n", gstate->location.block);
+      return -1;
+   }
+   if (gstate->dal->get(tstate->handle, index, indexsz, gstate->minfo.compsz) != indexsz) {
+      LOG(LOG_ERR, "Failed to read the IO unit index of block %d\n", gstate->location.block);
+      free(index);
+      return -1;
+   }
+   // every stored unit must lie in sequence, and be no larger than the unit itself
+   size_t unit;
+   for (unit = 0; unit < units; unit++) {
+      size_t unitsz = gstate->minfo.blocksz - (unit * gstate->minfo.versz);
+      if (unitsz > gstate->minfo.versz) {
+         unitsz = gstate->minfo.versz;
+      }
+      if (index[unit] >= index[unit + 1] || (index[unit + 1] - index[unit]) > unitsz) {
+         break;
+      }
+   }
+   if (index[0] != 0 || unit != units || index[units] != gstate->minfo.compsz) {
+      LOG(LOG_ERR, "IO unit index of block %d is invalid\n", gstate->location.block);
+      free(index);
+      return -1;
+   }
+   tstate->cbuff = malloc(gstate->minfo.versz);
+   if (tstate->cbuff == NULL) {
+      LOG(LOG_ERR, "Block %d failed to allocate a compression buffer!\n", gstate->location.block);
+      free(index);
+      return -1;
+   }
+   gstate->uindex = index;
+   gstate->ucount = units;
+   return 0;
+}
+
+/**
+ * Retrieve a single IO unit of a block, decompressing it if necessary
+ * @param gthread_state* gstate : Global state of the block
+ * @param BLOCK_CTXT handle : Open DAL read handle for the block
+ * @param void* buffer : Buffer to be populated with the IO unit
+ * @param size_t size : Size of the IO unit ( including CRC )
+ * @param off_t offset : Offset of the IO unit within the ( uncompressed ) block
+ * @param void* cbuff : Buffer of at least 'size' bytes for compressed data ( NULL to allocate one as needed )
+ * @return ssize_t : Size of the IO unit retrieved, or -1 on failure
+ */
+static ssize_t get_unit(gthread_state* gstate, BLOCK_CTXT handle, void* buffer, size_t size, off_t offset, void* cbuff) {
+   if (gstate->minfo.compsz <= 0) {
+      return gstate->dal->get(handle, buffer, size, offset);
+   }
+   size_t unit = offset / gstate->minfo.versz;
+   if (gstate->uindex == NULL || unit >= gstate->ucount) {
+      LOG(LOG_ERR, "Compressed block %d lacks an index entry for IO unit %zu\n", gstate->location.block, unit);
+      errno = EIO;
+      return -1;
+   }
+   size_t storedsz = gstate->uindex[unit + 1] - gstate->uindex[unit];
+   if (storedsz == size) {
+      // this unit was stored uncompressed
+      return gstate->dal->get(handle, buffer, size, gstate->uindex[unit]);
+   }
+#ifdef HAVE_IGZIP
+   void* stored = cbuff;
+   if (stored == NULL && (stored = malloc(storedsz)) == NULL) {
+      LOG(LOG_ERR, "Failed to allocate space for a compressed IO unit\n");
+      return -1;
+   }
+   ssize_t retval = -1;
+   if (gstate->dal->get(handle, stored, storedsz, gstate->uindex[unit]) == storedsz) {
+      struct inflate_state state;
+      isal_inflate_init(&state);
+      state.next_in = stored;
+      state.avail_in = storedsz;
+      state.next_out = buffer;
+      state.avail_out = size;
+      if (isal_inflate_stateless(&state) == ISAL_DECOMP_OK && state.total_out == size) {
+         retval = size;
+      }
+      else {
+         LOG(LOG_ERR, "Failed to decompress IO unit %zu of block %d\n", unit, gstate->location.block);
+         errno = EIO;
+      }
+   }
+   if (stored != cbuff) {
+      free(stored);
+   }
+   return retval;
+#else
+   LOG(LOG_ERR, "Block %d is compressed, but compression is unsupported by this build!\n", gstate->location.block);
+   errno = ENOTSUP;
+   return -1;
+#endif
+}
+
+/**
+ * Write out the IO unit index of a compressed block, and release all compression state
+ * @param thread_state* tstate : Thread state reference
+ * @param char discard : If non-zero, the index will be released without being written
+ */
+static void finish_compression(thread_state* tstate, char discard) {
+   gthread_state* gstate = (gthread_state*)(tstate->gstate);
+   if (!(discard) && gstate->data_error == 0 && gstate->ucount) {
+      gstate->uindex[gstate->ucount] = gstate->minfo.compsz;
+      if (gstate->dal->put(tstate->handle, gstate->uindex, (gstate->ucount + 1) * sizeof(uint64_t))) {
+         LOG(LOG_ERR, "Failed to write the IO unit index of block %d!\n", gstate->location.block);
+         gstate->data_error = 1;
+      }
+   }
+   free(gstate->uindex);
+   gstate->uindex = NULL;
+   gstate->ucount = 0;
+   free(tstate->cbuff);
+   tstate->cbuff = NULL;
+   free(tstate->lvlbuf);
+   tstate->lvlbuf = NULL;
+}
+
 /**
  * Initialize the write thread state and create a DAL BLOCK_CTXT
  * @param unsigned int tID : The ID of this thread
@@ -167,12 +466,29 @@ int write_init(unsigned int tID, void* global_state, void** state) {
    tstate->iob = NULL;
    tstate->crcsumchk = 0;
    tstate->continuous = 1;
+   tstate->iovcnt = 0;
+   tstate->pending_cnt = 0;
+   tstate->cbuff = NULL;
+   tstate->lvlbuf = NULL;
+   tstate->lvlbufsz = 0;
+   tstate->clevel = 0;
+   gstate->uindex = NULL;
+   gstate->ucount = 0;
+   gstate->minfo.csum = dal->checksum; // our producer is handed this same algorithm via our ioqueue
+   bind_thread(tstate);
+   if (init_compression(tstate)) {
+      unbind_thread(tstate);
+      free(tstate);
+      *state = NULL;
+      return -1;
+   }
 
    // open a handle for this block
    tstate->handle = dal->open(dal->ctxt, gstate->dmode, gstate->location, gstate->objID);
    if (tstate->handle == NULL) {
       LOG(LOG_ERR, "failed to open handle for block %d!\n", gstate->location.block);
       gstate->data_error = 1;
+      scoreboard_record(gstate->sboard, gstate->location, 1, -1, 1);
    }
 
    return 0;
@@ -212,15 +528,26 @@ int read_init(unsigned int tID, void* global_state, void** state) {
    tstate->iob = NULL;
    tstate->crcsumchk = 0;
    tstate->continuous = 1;
+   tstate->iovcnt = 0;
+   tstate->pending_cnt = 0;
+   tstate->cbuff = NULL;
+   tstate->lvlbuf = NULL;
+   tstate->lvlbufsz = 0;
+   tstate->clevel = 0;
    if (tstate->offset) {
       tstate->continuous = 0;
    }
+   bind_thread(tstate);
 
    // open a handle for this block
    tstate->handle = dal->open(dal->ctxt, gstate->dmode, gstate->location, gstate->objID);
    if (tstate->handle == NULL) {
       LOG(LOG_WARNING, "failed to open handle for block %d, attempting meta only access\n", gstate->location.block);
       gstate->data_error = 1;
+      // a missing object says nothing about the health of its location
+      if (errno != ENOENT) {
+         scoreboard_record(gstate->sboard, gstate->location, 0, -1, 1);
+      }
       tstate->handle = dal->open(dal->ctxt, DAL_METAREAD, gstate->location, gstate->objID);
       if (tstate->handle == NULL) {
          LOG(LOG_ERR, "failed to open meta handle for block %d!\n");
@@ -237,9 +564,54 @@ int read_init(unsigned int tID, void* global_state, void** state) {
       }
    }
 
+   // compressed data can only be located via its IO unit index
+   if (gstate->data_error == 0 && load_unit_index(tstate)) {
+      gstate->data_error = 1;
+      scoreboard_record(gstate->sboard, gstate->location, 0, -1, 1);
+   }
+
    return 0;
 }
 
+/**
+ * Write out all pending ioblocks via a single vectored DAL put, then release them
+ * @param thread_state* tstate : Thread state reference
+ * @param char discard : If non-zero, pending ioblocks will be released without being written
+ * @return int : Zero on success, -1 on failure
+ */
+static int flush_pending_writes(thread_state* tstate, char discard) {
+   gthread_state* gstate = (gthread_state*)(tstate->gstate);
+   if (tstate->pending_cnt == 0) {
+      return 0;
+   }
+   // write data out via the DAL, but only if we have not yet encoutered a write error
+   if (!(discard) && (gstate->data_error == 0)) {
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      if (gstate->dal->putv(tstate->handle, tstate->iov, tstate->iovcnt)) {
+         LOG(LOG_ERR, "Failed to write %d ioblocks to block %d!\n", tstate->pending_cnt, gstate->location.block);
+         gstate->data_error = 1;
+         // don't bother to abort yet, we'll do that on close
+      }
+      scoreboard_record(gstate->sboard, gstate->location, 1, elapsed_usec(&start), gstate->data_error);
+   }
+   LOG(LOG_INFO, "Block %d flushed %d ioblocks via %d buffer references\n", gstate->location.block, tstate->pending_cnt, tstate->iovcnt);
+   int retval = 0;
+   int i;
+   for (i = 0; i < tstate->pending_cnt; i++) {
+      tstate->pending[i]->ext_cnt = 0;
+      // regardless of success, we need to free up our ioblocks
+      if (release_ioblock(gstate->ioq)) {
+         LOG(LOG_ERR, "Block %d failed to release ioblock!\n", gstate->location.block);
+         gstate->data_error = 1;
+         retval = -1;
+      }
+   }
+   tstate->pending_cnt = 0;
+   tstate->iovcnt = 0;
+   return retval;
+}
+
 /**
  * Consume data buffers, generate CRCs for them, and write blocks out to their targets
  * @param void** state : Thread state reference
@@ -272,33 +644,103 @@ int write_consume(void** state, void** work_todo) {
       return -1;
    }
 
-   if (datasz > 0) {
-      // critical section : we are now going to call some inlined assembly erasure funcs
-      if ( pthread_mutex_lock( gstate->erasurelock ) ) {
-         LOG(LOG_ERR, "Block %d failed to acquire erasurelock\n", gstate->location.block);
-         gstate->data_error = 1;
-         release_ioblock(gstate->ioq);
-         return -1;
-      }
-      // calculate a CRC for this data and append it to the buffer
-      *(uint32_t*)(datasrc + datasz) = crc32_ieee(CRC_SEED, datasrc, datasz);
-      // exiting critical section
-      if ( pthread_mutex_unlock( gstate->erasurelock ) ) {
-         LOG(LOG_ERR, "Block %d failed to release erasurelock\n", gstate->location.block);
-         gstate->data_error = 1;
-         release_ioblock(gstate->ioq);
-         return -1;
-      }
+   // external data can only be written directly if our DAL supports vectored puts ( and we aren't compressing )
+   if (iob->ext_cnt  &&  (gstate->dal->putv == NULL  ||  tstate->cbuff)) {
+      ioblock_copy_external(iob);
+   }
+
+   // determine the list of buffers which make up this ioblock, including its CRC
+   struct iovec single;
+   struct iovec* iov = NULL;
+   int iovcnt = 0;
+   if (iob->ext_cnt) {
+      // zero-copy write : buffered data, followed by external data references, followed by our CRC
+      uint32_t crc = ioblock_get_crc(iob, gstate->ioq);
+      // the buffer space following our buffered data is otherwise unused, so store the CRC there
+      *(uint32_t*)(datasrc + iob->ext_offset) = crc;
+      iob->iov[0].iov_base = datasrc;
+      iob->iov[0].iov_len = iob->ext_offset;
+      iob->iov[iob->ext_cnt + 1].iov_base = datasrc + iob->ext_offset;
+      iob->iov[iob->ext_cnt + 1].iov_len = CRC_BYTES;
+      iov = iob->iov;
+      iovcnt = iob->ext_cnt + 2;
+      if (iob->ext_offset == 0) { iov++; iovcnt--; } // skip the empty buffered data reference
+      gstate->minfo.crcsum += crc;
+   }
+   else if (datasz > 0) {
+      // append the CRC of this data ( possibly already generated by our producer ) to the buffer
+      *(uint32_t*)(datasrc + datasz) = ioblock_get_crc(iob, gstate->ioq);
       gstate->minfo.crcsum += *((uint32_t*)(datasrc + datasz));
+      single.iov_base = datasrc;
+      single.iov_len = datasz + CRC_BYTES;
+      iov = &single;
+      iovcnt = 1;
+   }
+   if (iovcnt) {
       datasz += CRC_BYTES;
       // increment our block size
       gstate->minfo.blocksz += datasz;
+   }
 
+   if (iovcnt  &&  gstate->dal->putv  &&  tstate->cbuff == NULL) {
+      // combine this ioblock with any others which are already pending
+      if (tstate->pending_cnt == IOBLOCK_BATCH_MAX  ||  (tstate->iovcnt + iovcnt) > IO_VECTOR_MAX) {
+         if (flush_pending_writes(tstate, 0)) {
+            release_ioblock(gstate->ioq);
+            return -1;
+         }
+      }
+      if (iovcnt <= IO_VECTOR_MAX) {
+         memcpy(tstate->iov + tstate->iovcnt, iov, iovcnt * sizeof(struct iovec));
+         tstate->iovcnt += iovcnt;
+         tstate->pending[tstate->pending_cnt] = iob;
+         tstate->pending_cnt++;
+         // only continue to hold ioblocks if more are already queued for us ( the producer holds one more )
+         // NOTE -- waiting on any further data could deadlock a producer waiting on our ioblocks
+         int outstanding = ioqueue_outstanding(gstate->ioq);
+         if (outstanding < 0  ||  (outstanding - tstate->pending_cnt) <= 1) {
+            return flush_pending_writes(tstate, 0);
+         }
+         return 0;
+      }
+      // too many references to batch, so just write this ioblock on its own
+      if (gstate->data_error == 0) {
+         struct timespec start;
+         clock_gettime(CLOCK_MONOTONIC, &start);
+         if (gstate->dal->putv(tstate->handle, iov, iovcnt)) {
+            LOG(LOG_ERR, "Failed to write %zu bytes to block %d!\n", datasz, gstate->location.block);
+            gstate->data_error = 1;
+            // don't bother to abort yet, we'll do that on close
+         }
+         scoreboard_record(gstate->sboard, gstate->location, 1, elapsed_usec(&start), gstate->data_error);
+      }
+      iob->ext_cnt = 0;
+   }
+   else if (iovcnt) {
+      void* putsrc = datasrc;
+      size_t putsz = datasz;
+      if (tstate->cbuff) {
+         // compress this IO unit, noting where it will be stored
+         size_t compsz = compress_unit(tstate, datasrc, datasz);
+         if (compsz) {
+            putsrc = tstate->cbuff;
+            putsz = compsz;
+         }
+         if (index_unit(gstate)) {
+            gstate->data_error = 1;
+         }
+         gstate->minfo.compsz += putsz;
+      }
       // write data out via the DAL, but only if we have not yet encoutered a write error
-      if ((gstate->data_error == 0) && gstate->dal->put(tstate->handle, datasrc, datasz)) {
-         LOG(LOG_ERR, "Failed to write %zu bytes to block %d!\n", datasz, gstate->location.block);
-         gstate->data_error = 1;
-         // don't bother to abort yet, we'll do that on close
+      if (gstate->data_error == 0) {
+         struct timespec start;
+         clock_gettime(CLOCK_MONOTONIC, &start);
+         if (gstate->dal->put(tstate->handle, putsrc, putsz)) {
+            LOG(LOG_ERR, "Failed to write %zu bytes to block %d!\n", datasz, gstate->location.block);
+            gstate->data_error = 1;
+            // don't bother to abort yet, we'll do that on close
+         }
+         scoreboard_record(gstate->sboard, gstate->location, 1, elapsed_usec(&start), gstate->data_error);
       }
    }
 
@@ -380,10 +822,72 @@ int read_produce(void** state, void** work_tofill) {
          return -1; // force an abort
       }
       void* store_tgt = ioblock_write_target(tstate->iob);
+      if (gstate->dal->getv  &&  gstate->minfo.compsz <= 0) {
+         // gather as many IOs as will fit into this ioblock, scattering data into the ioblock and CRCs aside
+         size_t fill = ioblock_get_fill(tstate->iob);
+         size_t datapos = 0;
+         off_t endoff = tstate->offset;
+         int iocnt = 0;
+         while (iocnt < (IO_VECTOR_MAX / 2)) {
+            size_t iosz = (gstate->minfo.versz > (gstate->minfo.blocksz - endoff)) ? (gstate->minfo.blocksz - endoff) : gstate->minfo.versz;
+            if (iosz <= CRC_BYTES) { break; } // leave any end of block condition to the next pass
+            tstate->iov[(iocnt * 2)].iov_base = store_tgt + datapos;
+            tstate->iov[(iocnt * 2)].iov_len = iosz - CRC_BYTES;
+            tstate->iov[(iocnt * 2) + 1].iov_base = &(tstate->crcs[iocnt]);
+            tstate->iov[(iocnt * 2) + 1].iov_len = CRC_BYTES;
+            datapos += iosz - CRC_BYTES;
+            endoff += iosz;
+            iocnt++;
+            if ((fill + datapos) >= gstate->ioq->split_threshold) { break; } // ioblock is now full
+         }
+         LOG(LOG_INFO, "Reading %zd bytes ( %d IOs ) from offset %zu of block %d\n", (ssize_t)(endoff - tstate->offset), iocnt, tstate->offset, gstate->location.block);
+         struct timespec start;
+         clock_gettime(CLOCK_MONOTONIC, &start);
+         read_data = gstate->dal->getv(tstate->handle, tstate->iov, iocnt * 2, tstate->offset);
+         double latency = elapsed_usec(&start);
+         char call_err = 0;
+         if (read_data < (endoff - tstate->offset)) {
+            LOG(LOG_ERR, "Expected read return value of %zd for block %d, but recieved: %zd\n",
+               (ssize_t)(endoff - tstate->offset), gstate->location.block, read_data);
+            gstate->data_error = 1;
+            call_err = 1;
+         }
+         // check the crc of each IO
+         int i;
+         for (i = 0; i < iocnt; i++) {
+            to_read = tstate->iov[(i * 2)].iov_len;
+            char data_err = 0;
+            if (read_data < (ssize_t)(to_read + CRC_BYTES)) {
+               data_err = 1;
+               read_data = 0;
+            }
+            else {
+               read_data -= (to_read + CRC_BYTES);
+               uint32_t scrc = tstate->crcs[i];
+               tstate->crcsumchk += scrc; // track our global crc, for reference
+               uint32_t crc = block_csum(gstate->minfo.csum, CRC_SEED, tstate->iov[(i * 2)].iov_base, to_read);
+               if (crc != scrc) {
+                  LOG(LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc);
+                  gstate->data_error = 1;
+                  data_err = 1;
+                  call_err = 1;
+               }
+            }
+            // note how much REAL data (no CRC) we've stored to the ioblock
+            ioblock_update_fill(tstate->iob, to_read, data_err);
+            // note our increased offset within the data (MUST include the CRC!)
+            tstate->offset += (to_read + CRC_BYTES);
+         }
+         scoreboard_record(gstate->sboard, gstate->location, 0, latency, call_err);
+         continue;
+      }
       char data_err = 0;
       LOG(LOG_INFO, "Reading %zd bytes from offset %zu of block %d\n", to_read, tstate->offset, gstate->location.block);
-      if ((read_data = gstate->dal->get(tstate->handle, store_tgt, to_read, tstate->offset)) <
-         to_read) {
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      read_data = get_unit(gstate, tstate->handle, store_tgt, to_read, tstate->offset, tstate->cbuff);
+      double latency = elapsed_usec(&start);
+      if (read_data < to_read) {
          LOG(LOG_ERR, "Expected read return value of %zd for block %d, but recieved: %zd\n",
             to_read, gstate->location.block, read_data);
          gstate->data_error = 1;
@@ -395,27 +899,14 @@ int read_produce(void** state, void** work_tofill) {
          uint32_t crc = 0;
          uint32_t scrc = *((uint32_t*)(store_tgt + to_read));
          tstate->crcsumchk += scrc; // track our global crc, for reference
-         // critical section : we are now going to call some inlined assembly erasure funcs
-         if ( pthread_mutex_lock( gstate->erasurelock ) ) {
-            LOG(LOG_ERR, "Block %d failed to acquire erasurelock\n", gstate->location.block);
+         crc = block_csum(gstate->minfo.csum, CRC_SEED, store_tgt, to_read);
+         if (crc != scrc) {
+            LOG(LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc);
             gstate->data_error = 1;
             data_err = 1;
          }
-         else {
-            crc = crc32_ieee(CRC_SEED, store_tgt, to_read);
-            // exiting critical section
-            if ( pthread_mutex_unlock( gstate->erasurelock ) ) {
-               LOG(LOG_ERR, "Block %d failed to release erasurelock\n", gstate->location.block);
-               gstate->data_error = 1;
-               return -1; // force an abort
-            }
-            if (crc != scrc) {
-               LOG(LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc);
-               gstate->data_error = 1;
-               data_err = 1;
-            }
-         }
       }
+      scoreboard_record(gstate->sboard, gstate->location, 0, latency, data_err);
       // note how much REAL data (no CRC) we've stored to the ioblock
       ioblock_update_fill(tstate->iob, to_read, data_err);
       // note our increased offset within the data (MUST include the CRC!)
@@ -428,10 +919,62 @@ int read_produce(void** state, void** work_tofill) {
 }
 
 /**
- * No-op function, just to fill out the TQ struct
+ * Read and verify a single IO unit of a block, independent of any block thread ( for sparse reads )
+ * @param gthread_state* gstate : Global state of the block ( its dal, location, minfo, uindex, and sboard
+ *                                values are referenced )
+ * @param BLOCK_CTXT handle : Open DAL read handle for the block
+ * @param off_t unit : Index of the IO unit to be read ( each spans minfo.versz bytes of the block, including CRC )
+ * @param void* buffer : Buffer of at least minfo.versz bytes, to be populated with the data of the unit
+ * @return ssize_t : Number of verified data bytes read ( excluding the CRC ), or -1 on failure
+ */
+ssize_t read_unit(gthread_state* gstate, BLOCK_CTXT handle, off_t unit, void* buffer) {
+   off_t offset = unit * gstate->minfo.versz;
+   if (offset >= gstate->minfo.blocksz) {
+      LOG(LOG_ERR, "IO unit %zd lies beyond the end of block %d\n", unit, gstate->location.block);
+      errno = EINVAL;
+      return -1;
+   }
+   ssize_t to_read = (gstate->minfo.versz > (gstate->minfo.blocksz - offset)) ? (gstate->minfo.blocksz - offset) : gstate->minfo.versz;
+   if (to_read <= CRC_BYTES) {
+      LOG(LOG_ERR, "Remaining data at offset %zu of block %d ( %zd ) is <= CRC_BYTES!\n", offset, gstate->location.block, to_read);
+      errno = EBADF;
+      return -1;
+   }
+   LOG(LOG_INFO, "Reading %zd bytes from offset %zu of block %d\n", to_read, offset, gstate->location.block);
+   struct timespec start;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   ssize_t read_data = get_unit(gstate, handle, buffer, to_read, offset, NULL);
+   double latency = elapsed_usec(&start);
+   if (read_data < to_read) {
+      LOG(LOG_ERR, "Expected read return value of %zd for block %d, but recieved: %zd\n",
+         to_read, gstate->location.block, read_data);
+      scoreboard_record(gstate->sboard, gstate->location, 0, latency, 1);
+      errno = EIO;
+      return -1;
+   }
+   to_read -= CRC_BYTES;
+   uint32_t scrc = 0;
+   memcpy(&scrc, buffer + to_read, CRC_BYTES);
+   uint32_t crc = block_csum(gstate->minfo.csum, CRC_SEED, buffer, to_read);
+   if (crc != scrc) {
+      LOG(LOG_ERR, "Calculated CRC of data (%u) does not match stored CRC: %u\n", crc, scrc);
+      scoreboard_record(gstate->sboard, gstate->location, 0, latency, 1);
+      errno = EIO;
+      return -1;
+   }
+   scoreboard_record(gstate->sboard, gstate->location, 0, latency, 0);
+   return to_read;
+}
+
+/**
+ * Write out any pending ioblocks prior to pausing
+ * @param void** state : Thread state reference
+ * @param void** prev_work : Reference to any previously consumed buffer
+ * @return int : Integer return code ( -1 on error, 0 on success )
  */
 int write_pause(void** state, void** prev_work) {
-   return 0; // noop, probably permanently
+   // don't hold onto any ioblocks while paused
+   return flush_pending_writes((thread_state*)(*state), 0);
 }
 
 /**
@@ -464,7 +1007,7 @@ int read_resume(void** state, void** prev_work) {
    // check for a NULL ioq and create one if so (TODO: unnecessary?)
    if (gstate->ioq == NULL) {
       LOG(LOG_INFO, "Creating own ioqueue for block %d\n", gstate->location.block);
-      gstate->ioq = create_ioqueue(gstate->minfo.versz, gstate->minfo.partsz, gstate->dmode);
+      gstate->ioq = create_ioqueue(gstate->minfo.versz, gstate->minfo.partsz, gstate->dmode, 0, gstate->numa_node);
       if (gstate->ioq == NULL) {
          LOG(LOG_ERR, "Failed to create ioqueue!\n");
          return -1;
@@ -566,6 +1109,12 @@ void write_term(void** state, void** prev_work, TQ_Control_Flags flg) {
    // get a reference to the global state for this block
    gthread_state* gstate = (gthread_state*)(tstate->gstate);
 
+   // write out ( or, if aborting, simply release ) any ioblocks still awaiting a batched write
+   if (flush_pending_writes(tstate, (flg & TQ_ABORT) ? 1 : 0)) {
+      LOG(LOG_ERR, "Failed to flush pending IOBlocks!\n");
+      // not much to do besides complain
+   }
+
    // if we never used an IOBlock reference, we need to release it
    if (*(prev_work) != NULL && release_ioblock(gstate->ioq)) {
       LOG(LOG_ERR, "Failed to release previous IOBlock!\n");
@@ -573,10 +1122,14 @@ void write_term(void** state, void** prev_work, TQ_Control_Flags flg) {
       // not much to do besides complain
    }
 
+   // append the IO unit index of any compressed data
+   finish_compression(tstate, (flg & TQ_ABORT) ? 1 : 0);
+
    // attempt to write out meta info
    if (gstate->dal->set_meta(tstate->handle, &(gstate->minfo))) {
       LOG(LOG_ERR, "Failed to set meta value for block %d!\n", gstate->location.block);
       gstate->meta_error = 1;
+      scoreboard_record(gstate->sboard, gstate->location, 1, -1, 1);
    }
 
    // don't leave potentially bad data behind
@@ -597,6 +1150,7 @@ void write_term(void** state, void** prev_work, TQ_Control_Flags flg) {
       if ( gstate->dal->close(tstate->handle) ) {
          LOG(LOG_ERR, "Failed to close block %d!\n", gstate->location.block);
          gstate->data_error = 1;
+         scoreboard_record(gstate->sboard, gstate->location, 1, -1, 1);
          if (gstate->dal->abort(tstate->handle)) {
             LOG(LOG_ERR, "Abort of block %d failed!\n", gstate->location.block);
             // not really much to do besides complain
@@ -607,6 +1161,9 @@ void write_term(void** state, void** prev_work, TQ_Control_Flags flg) {
 
 
 
+   // this thread may go on to serve other blocks
+   unbind_thread(tstate);
+
    // just free and NULL our state, there isn't any useful info in there
    free(tstate);
    *state = NULL;
@@ -642,6 +1199,11 @@ void read_term(void** state, void** prev_work, TQ_Control_Flags flg) {
       }
    }
 
+   free(tstate->cbuff);
+   free(gstate->uindex);
+   gstate->uindex = NULL;
+   gstate->ucount = 0;
+
    // close our DAL handle
    if (gstate->dal->close(tstate->handle)) {
       // pessimistically call this a data erorr ( may not be necessary )
@@ -650,6 +1212,9 @@ void read_term(void** state, void** prev_work, TQ_Control_Flags flg) {
       // can only really complain, nothing else to be done
    }
 
+   // this thread may go on to serve other blocks
+   unbind_thread(tstate);
+
    // just free and NULL our state, there isn't any useful info in there
    free(tstate);
    *state = NULL;
@@ -657,3 +1222,285 @@ void read_term(void** state, void** prev_work, TQ_Control_Flags flg) {
    // NOTE -- it is up to the master / consumer proc to destroy our IOQueue
 }
 
+
+
+/* ------------------------------   SHARED THREAD POOL   ------------------------------ */
+
+typedef enum
+{
+   IOPOOL_IDLE, // parked on the idle list, awaiting a launch
+   IOPOOL_BUSY, // running a thread behavior
+   IOPOOL_DONE, // behavior has returned, awaiting collection
+   IOPOOL_EXIT  // instructed to terminate
+} iopool_state;
+
+typedef struct iopool_worker_struct
+{
+   pthread_cond_t wake; // signals any state change of this worker ( only the worker and one collector wait here )
+   iopool_state state;
+   void *(*start)(void *);
+   void *arg;
+   void *retval;
+   struct iopool_worker_struct *next; // next idle worker
+} iopool_worker;
+
+static struct
+{
+   pthread_mutex_t lock;
+   pthread_cond_t admit; // signals the release of reserved slots
+   iopool_worker *idle;  // list of parked workers
+   unsigned int idlecnt; // length of the idle list
+   unsigned int active;  // workers currently assigned to a ThreadQueue
+   unsigned int reserved; // slots reserved for ThreadQueues, whether or not yet launched
+   unsigned int waiting;  // callers blocked awaiting admission
+   unsigned int limit;    // maximum number of reserved slots, beyond which callers must wait
+} iopool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0, 0, 0, 0, IOTHREAD_POOL_MAX_ACTIVE};
+
+// slots reserved by the current thread, which may then never wait on admission
+static __thread unsigned int iopool_held = 0;
+
+// body of every pooled thread : run each assigned behavior, then park until reused or dismissed
+static void *iopool_thread(void *arg)
+{
+   iopool_worker *worker = (iopool_worker *)arg;
+   pthread_mutex_lock(&iopool.lock);
+   while (1)
+   {
+      while (worker->state == IOPOOL_IDLE || worker->state == IOPOOL_DONE)
+      {
+         pthread_cond_wait(&worker->wake, &iopool.lock);
+      }
+      if (worker->state == IOPOOL_EXIT)
+      {
+         break;
+      }
+      pthread_mutex_unlock(&iopool.lock);
+      void *retval = worker->start(worker->arg);
+      pthread_mutex_lock(&iopool.lock);
+      worker->retval = retval;
+      worker->state = IOPOOL_DONE;
+      pthread_cond_signal(&worker->wake);
+   }
+   pthread_mutex_unlock(&iopool.lock);
+   pthread_cond_destroy(&worker->wake);
+   free(worker);
+   return NULL;
+}
+
+// TQ_Thread_Pool launch function : hand the behavior to an idle worker, or spawn a new one
+static int iopool_launch(void *pool, void *(*start)(void *), void *arg, void **thread)
+{
+   pthread_mutex_lock(&iopool.lock);
+   iopool_worker *worker = iopool.idle;
+   if (worker != NULL)
+   {
+      iopool.idle = worker->next;
+      iopool.idlecnt--;
+      worker->next = NULL;
+      worker->start = start;
+      worker->arg = arg;
+      worker->retval = NULL;
+      worker->state = IOPOOL_BUSY;
+      pthread_cond_signal(&worker->wake);
+   }
+   else
+   {
+      worker = calloc(1, sizeof(struct iopool_worker_struct));
+      if (worker == NULL)
+      {
+         LOG(LOG_ERR, "Failed to allocate a new pool worker\n");
+         pthread_mutex_unlock(&iopool.lock);
+         return -1;
+      }
+      if (pthread_cond_init(&worker->wake, NULL))
+      {
+         LOG(LOG_ERR, "Failed to initialize pool worker condition\n");
+         free(worker);
+         pthread_mutex_unlock(&iopool.lock);
+         return -1;
+      }
+      worker->start = start;
+      worker->arg = arg;
+      worker->state = IOPOOL_BUSY;
+      pthread_attr_t attr;
+      pthread_t thread_id;
+      int ret = pthread_attr_init(&attr);
+      if (ret == 0)
+      {
+         pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+         ret = pthread_create(&thread_id, &attr, iopool_thread, worker);
+         pthread_attr_destroy(&attr);
+      }
+      if (ret)
+      {
+         LOG(LOG_ERR, "Failed to create a new pool worker thread\n");
+         pthread_cond_destroy(&worker->wake);
+         free(worker);
+         pthread_mutex_unlock(&iopool.lock);
+         errno = ret;
+         return -1;
+      }
+   }
+   iopool.active++;
+   pthread_mutex_unlock(&iopool.lock);
+   *thread = worker;
+   return 0;
+}
+
+// TQ_Thread_Pool collect function : wait for the behavior to return, then park or dismiss the worker
+static int iopool_collect(void *pool, void *thread, void **retval)
+{
+   iopool_worker *worker = (iopool_worker *)thread;
+   pthread_mutex_lock(&iopool.lock);
+   while (worker->state == IOPOOL_BUSY)
+   {
+      pthread_cond_wait(&worker->wake, &iopool.lock);
+   }
+   if (retval != NULL)
+   {
+      *retval = worker->retval;
+   }
+   iopool.active--;
+   if (iopool.idlecnt < IOTHREAD_POOL_MAX_IDLE)
+   {
+      worker->state = IOPOOL_IDLE;
+      worker->start = NULL;
+      worker->arg = NULL;
+      worker->next = iopool.idle;
+      iopool.idle = worker;
+      iopool.idlecnt++;
+   }
+   else
+   {
+      worker->state = IOPOOL_EXIT;
+      pthread_cond_signal(&worker->wake);
+   }
+   pthread_mutex_unlock(&iopool.lock);
+   return 0;
+}
+
+static TQ_Thread_Pool iopool_ref = {NULL, iopool_launch, iopool_collect};
+
+/**
+ * Retrieve the process-wide IO thread pool, for use with tq_init_pooled()
+ * @return TQ_Thread_Pool* : Reference to the shared pool ( never NULL )
+ */
+TQ_Thread_Pool *iothread_pool(void)
+{
+   return &iopool_ref;
+}
+
+/**
+ * Reserve slots of the process-wide IO thread pool, prior to launching that many pooled threads
+ * @param unsigned int count : Number of slots to reserve
+ * @param char wait : If zero, the slots are taken immediately, even beyond the pool limit
+ */
+void iothread_pool_reserve(unsigned int count, char wait)
+{
+   pthread_mutex_lock(&iopool.lock);
+   // a thread already holding slots may be what the current holders are waiting on, so never block it
+   if (wait && iopool_held == 0)
+   {
+      iopool.waiting++;
+      while (iopool.reserved && iopool.reserved + count > iopool.limit)
+      {
+         pthread_cond_wait(&iopool.admit, &iopool.lock);
+      }
+      iopool.waiting--;
+   }
+   iopool.reserved += count;
+   iopool_held += count;
+   pthread_mutex_unlock(&iopool.lock);
+}
+
+/**
+ * Reserve up to the given number of IO thread pool slots, without waiting
+ * @param unsigned int count : Maximum number of slots to reserve
+ * @return unsigned int : Number of slots actually reserved ( possibly zero )
+ */
+unsigned int iothread_pool_tryreserve(unsigned int count)
+{
+   pthread_mutex_lock(&iopool.lock);
+   unsigned int avail = (iopool.reserved < iopool.limit) ? iopool.limit - iopool.reserved : 0;
+   if (count > avail)
+   {
+      count = avail;
+   }
+   iopool.reserved += count;
+   iopool_held += count;
+   pthread_mutex_unlock(&iopool.lock);
+   return count;
+}
+
+/**
+ * Release slots previously reserved from the process-wide IO thread pool, admitting any waiters
+ * @param unsigned int count : Number of slots to release
+ */
+void iothread_pool_release(unsigned int count)
+{
+   if (count == 0)
+   {
+      return;
+   }
+   pthread_mutex_lock(&iopool.lock);
+   iopool.reserved -= (count < iopool.reserved) ? count : iopool.reserved;
+   // handles may be closed by a thread other than the one which opened them
+   iopool_held -= (count < iopool_held) ? count : iopool_held;
+   if (iopool.waiting)
+   {
+      pthread_cond_broadcast(&iopool.admit);
+   }
+   pthread_mutex_unlock(&iopool.lock);
+}
+
+/**
+ * Set the limit on reserved slots of the process-wide IO thread pool
+ * @param unsigned int limit : New slot limit
+ * @return int : Zero on success, or -1 on failure ( a zero limit )
+ */
+int iothread_pool_set_limit(unsigned int limit)
+{
+   if (limit == 0)
+   {
+      LOG(LOG_ERR, "Received a zero IO thread pool limit\n");
+      errno = EINVAL;
+      return -1;
+   }
+   pthread_mutex_lock(&iopool.lock);
+   iopool.limit = limit;
+   if (iopool.waiting)
+   {
+      pthread_cond_broadcast(&iopool.admit);
+   }
+   pthread_mutex_unlock(&iopool.lock);
+   return 0;
+}
+
+/**
+ * Report the current thread counts of the process-wide IO thread pool
+ * @param unsigned int* active : Reference to be populated with the number of threads running queue behavior
+ * @param unsigned int* idle : Reference to be populated with the number of parked threads
+ * @param unsigned int* reserved : Reference to be populated with the number of reserved slots
+ * @param unsigned int* waiting : Reference to be populated with the number of callers awaiting admission
+ */
+void iothread_pool_counts(unsigned int *active, unsigned int *idle, unsigned int *reserved, unsigned int *waiting)
+{
+   pthread_mutex_lock(&iopool.lock);
+   if (active)
+   {
+      *active = iopool.active;
+   }
+   if (idle)
+   {
+      *idle = iopool.idlecnt;
+   }
+   if (reserved)
+   {
+      *reserved = iopool.reserved;
+   }
+   if (waiting)
+   {
+      *waiting = iopool.waiting;
+   }
+   pthread_mutex_unlock(&iopool.lock);
+}
@@ -0,0 +1,285 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+#include "marfs_auto_config.h"
+#ifdef DEBUG_IO
+#define DEBUG DEBUG_IO
+#elif (defined DEBUG_ALL)
+#define DEBUG DEBUG_ALL
+#endif
+#define LOG_PREFIX "scoreboard"
+#include "logging/logging.h"
+
+#include "io/io.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+// A single hash chain entry
+typedef struct score_entry_struct
+{
+   location_score score;
+   struct score_entry_struct *next;
+} score_entry;
+
+/**
+ * Hash a DAL location to a scoreboard bucket
+ * @param DAL_location loc : Location to hash
+ * @return size_t : Bucket index
+ */
+static size_t hash_location(DAL_location loc)
+{
+   size_t hash = (size_t)loc.pod;
+   hash = (hash * 31) + (size_t)loc.cap;
+   hash = (hash * 31) + (size_t)loc.scatter;
+   hash = (hash * 31) + (size_t)loc.block;
+   return hash % SCOREBOARD_BUCKETS;
+}
+
+/**
+ * Locate the entry of the given location ( caller must hold the scoreboard lock )
+ * @param scoreboard* sb : Reference to the scoreboard to search
+ * @param DAL_location loc : Location to search for
+ * @return score_entry* : Reference to the matching entry, or NULL if none exists
+ */
+static score_entry *find_entry(scoreboard *sb, DAL_location loc)
+{
+   score_entry *entry = sb->buckets[hash_location(loc)];
+   for (; entry; entry = entry->next)
+   {
+      if (entry->score.loc.pod == loc.pod && entry->score.loc.block == loc.block &&
+          entry->score.loc.cap == loc.cap && entry->score.loc.scatter == loc.scatter)
+      {
+         return entry;
+      }
+   }
+   return NULL;
+}
+
+/**
+ * Creates a new, empty location scoreboard
+ * @return scoreboard* : Reference to the new scoreboard, or NULL on failure
+ */
+scoreboard *create_scoreboard(void)
+{
+   scoreboard *sb = malloc(sizeof(struct scoreboard_struct));
+   if (sb == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate a new scoreboard\n");
+      return NULL;
+   }
+   sb->buckets = calloc(SCOREBOARD_BUCKETS, sizeof(score_entry *));
+   if (sb->buckets == NULL)
+   {
+      LOG(LOG_ERR, "Failed to allocate scoreboard buckets\n");
+      free(sb);
+      return NULL;
+   }
+   if (pthread_mutex_init(&sb->lock, NULL))
+   {
+      LOG(LOG_ERR, "Failed to initialize scoreboard lock\n");
+      free(sb->buckets);
+      free(sb);
+      return NULL;
+   }
+   sb->count = 0;
+   return sb;
+}
+
+/**
+ * Destroys an existing location scoreboard
+ * @param scoreboard* sb : Reference to the scoreboard to be destroyed
+ */
+void destroy_scoreboard(scoreboard *sb)
+{
+   if (sb == NULL)
+   {
+      return;
+   }
+   size_t bucket;
+   for (bucket = 0; bucket < SCOREBOARD_BUCKETS; bucket++)
+   {
+      score_entry *entry = sb->buckets[bucket];
+      while (entry)
+      {
+         score_entry *next = entry->next;
+         free(entry);
+         entry = next;
+      }
+   }
+   pthread_mutex_destroy(&sb->lock);
+   free(sb->buckets);
+   free(sb);
+}
+
+/**
+ * Record the outcome of a single DAL operation against the given location
+ * @param scoreboard* sb : Reference to the scoreboard to update ( NULL for a no-op )
+ * @param DAL_location loc : Location targeted by the operation
+ * @param char write : Non-zero for a write, zero for a read ( or for an operation without meaningful latency,
+ *                     if usec is negative )
+ * @param double usec : Latency of the operation in microseconds ( negative to record only success / failure )
+ * @param char error : Non-zero if the operation failed
+ */
+void scoreboard_record(scoreboard *sb, DAL_location loc, char write, double usec, char error)
+{
+   if (sb == NULL)
+   {
+      return;
+   }
+   time_t now = time(NULL);
+   pthread_mutex_lock(&sb->lock);
+   score_entry *entry = find_entry(sb, loc);
+   if (entry == NULL)
+   {
+      entry = calloc(1, sizeof(struct score_entry_struct));
+      if (entry == NULL)
+      {
+         LOG(LOG_WARNING, "Failed to allocate a scoreboard entry ( history will not be recorded )\n");
+         pthread_mutex_unlock(&sb->lock);
+         return;
+      }
+      entry->score.loc = loc;
+      size_t bucket = hash_location(loc);
+      entry->next = sb->buckets[bucket];
+      sb->buckets[bucket] = entry;
+      sb->count++;
+   }
+   location_score *score = &(entry->score);
+   // the first sample simply seeds each moving average
+   if (usec >= 0)
+   {
+      double *latency = (write) ? &(score->write_latency) : &(score->read_latency);
+      unsigned long long *calls = (write) ? &(score->writes) : &(score->reads);
+      *latency = (*calls) ? (*latency + (SCOREBOARD_WEIGHT * (usec - *latency))) : usec;
+      (*calls)++;
+   }
+   double sample = (error) ? 1.0 : 0.0;
+   score->error_rate = (score->last_update) ? (score->error_rate + (SCOREBOARD_WEIGHT * (sample - score->error_rate))) : sample;
+   if (error)
+   {
+      score->errors++;
+      score->last_failure = now;
+   }
+   score->last_update = now;
+   pthread_mutex_unlock(&sb->lock);
+}
+
+/**
+ * Retrieve the current health history of the given location
+ * @param scoreboard* sb : Reference to the scoreboard to check
+ * @param DAL_location loc : Location to retrieve the history of
+ * @param location_score* score : Reference to be populated with the history of that location
+ * @return int : Zero on success, or -1 if no history exists ( errno will be set to ENOENT )
+ */
+int scoreboard_lookup(scoreboard *sb, DAL_location loc, location_score *score)
+{
+   if (sb == NULL)
+   {
+      errno = ENOENT;
+      return -1;
+   }
+   pthread_mutex_lock(&sb->lock);
+   score_entry *entry = find_entry(sb, loc);
+   if (entry)
+   {
+      *score = entry->score;
+   }
+   pthread_mutex_unlock(&sb->lock);
+   if (entry == NULL)
+   {
+      errno = ENOENT;
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Export the health history of all tracked locations
+ * @param scoreboard* sb : Reference to the scoreboard to export
+ * @param location_score* scores : Array to be populated with location histories ( may be NULL if max is zero )
+ * @param size_t max : Maximum number of entries to populate
+ * @return size_t : Total number of tracked locations ( may exceed 'max' )
+ */
+size_t scoreboard_export(scoreboard *sb, location_score *scores, size_t max)
+{
+   if (sb == NULL)
+   {
+      return 0;
+   }
+   pthread_mutex_lock(&sb->lock);
+   size_t filled = 0;
+   size_t bucket;
+   for (bucket = 0; bucket < SCOREBOARD_BUCKETS && filled < max; bucket++)
+   {
+      score_entry *entry = sb->buckets[bucket];
+      for (; entry && filled < max; entry = entry->next)
+      {
+         scores[filled] = entry->score;
+         filled++;
+      }
+   }
+   size_t count = sb->count;
+   pthread_mutex_unlock(&sb->lock);
+   return count;
+}
@@ -59,10 +59,15 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 */
 
 
+#include "marfs_auto_config.h"
 #include "io/io.h"
 #include "dal/dal.h"
 #include <unistd.h>
 #include <stdio.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
 
 
 // sentinel values to ensure good data transfer
@@ -230,16 +235,22 @@ size_t verify_data( size_t prev_ver, size_t partsz, size_t buffsz, void* buffer,
 
 
 
-int test_values( size_t iosz, size_t partsz, DAL_MODE mode ) {
-   printf( "\nTesting queue with iosz=%zu / partsz=%zu / mode=%s\n", iosz, partsz, (mode == DAL_READ) ? "read" : "write" );
+int test_values( size_t iosz, size_t partsz, DAL_MODE mode, int depth, int numa_node ) {
+   printf( "\nTesting queue with iosz=%zu / partsz=%zu / mode=%s / depth=%d / node=%d\n", iosz, partsz, (mode == DAL_READ) ? "read" : "write", depth, numa_node );
    // create a new ioqueue
-   ioqueue* ioq = create_ioqueue( iosz, partsz, mode );
+   ioqueue* ioq = create_ioqueue( iosz, partsz, mode, depth, numa_node );
    if ( ioq == NULL ) {
       printf( "ERROR: Failed to create new ioqueue with iosz=%zu and partsz=%zu\n", iosz, partsz );
       return -1;
    }
 
    printf( "IOQueue created with ssize=%zu, bsize=%zu\n", ioq->split_threshold, ioq->blocksz );
+   int expdepth = ( depth ) ? depth : SUPER_BLOCK_CNT;
+   if ( ioq->block_cnt != expdepth  ||  ioqueue_maxdata( ioq ) != ( expdepth * ioq->split_threshold ) ) {
+      printf( "ERROR: IOQueue has %d ioblocks, rather than the expected %d\n", ioq->block_cnt, expdepth );
+      destroy_ioqueue( ioq );
+      return -1;
+   }
 
    // reserver our first block
    ioblock* cur_block = NULL;
@@ -254,7 +265,7 @@ int test_values( size_t iosz, size_t partsz, DAL_MODE mode ) {
    size_t written_data = 0;
    size_t verified_data = 0;
    int ver_blocks = 0;
-   while ( ver_blocks < ( SUPER_BLOCK_CNT + 1 ) ) {
+   while ( ver_blocks < ( expdepth + 1 ) ) {
       size_t written = fill_buffer( written_data, iosz, partsz, ioblock_write_target( cur_block ), mode );
       if ( written == 0 ) {
          destroy_ioqueue( ioq );
@@ -348,39 +359,121 @@ int test_values( size_t iosz, size_t partsz, DAL_MODE mode ) {
 
 
 
+// check that every ioblock buffer of the given queue is ( or is not ) among a list of buffers
+int check_buffers( ioqueue* ioq, void** buffs, int cnt, char expect ) {
+   int i;
+   for ( i = 0; i < ioq->block_cnt; i++ ) {
+      char found = 0;
+      int j;
+      for ( j = 0; j < cnt; j++ ) {
+         if ( ioq->block_list[i].buff == buffs[j] ) { found = 1; }
+      }
+      if ( found != expect ) {
+         printf( "ERROR: ioblock %d buffer was %sexpected to be reused from a previous queue\n", i, ( expect ) ? "" : "not " );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+// touch every ioblock buffer of the given queue, and check that each resides on the given NUMA node
+int check_placement( ioqueue* ioq, int numa_node ) {
+   int i;
+   for ( i = 0; i < ioq->block_cnt; i++ ) {
+      memset( ioq->block_list[i].buff, 0, ioq->blocksz );
+#ifdef HAVE_LIBNUMA
+      int node = -1;
+      if ( numa_node >= 0  &&  get_mempolicy( &node, NULL, 0, ioq->block_list[i].buff, MPOL_F_NODE | MPOL_F_ADDR ) == 0  &&  node != numa_node ) {
+         printf( "ERROR: ioblock %d buffer resides on NUMA node %d, rather than %d\n", i, node, numa_node );
+         return -1;
+      }
+#endif
+   }
+   return 0;
+}
+
+// check that pooled buffers are only reused by queues of the same placement, and remain on the expected node
+int test_placement( size_t iosz, size_t partsz, int depth ) {
+   printf( "\nTesting buffer placement across reuse with iosz=%zu / partsz=%zu / depth=%d\n", iosz, partsz, depth );
+   void* unbound[IOQUEUE_MAX_DEPTH];
+   void* bound[IOQUEUE_MAX_DEPTH];
+   int i;
+   // buffers of an unbound queue return to the pool as unbound
+   ioqueue* ioq = create_ioqueue( iosz, partsz, DAL_WRITE, depth, -1 );
+   if ( ioq == NULL  ||  check_placement( ioq, -1 ) ) { return -1; }
+   for ( i = 0; i < depth; i++ ) { unbound[i] = ioq->block_list[i].buff; }
+   if ( destroy_ioqueue( ioq ) ) { return -1; }
+   // a queue bound to a node must never receive them
+   ioq = create_ioqueue( iosz, partsz, DAL_WRITE, depth, 0 );
+   if ( ioq == NULL  ||  check_buffers( ioq, unbound, depth, 0 )  ||  check_placement( ioq, 0 ) ) { return -1; }
+   for ( i = 0; i < depth; i++ ) { bound[i] = ioq->block_list[i].buff; }
+   if ( destroy_ioqueue( ioq ) ) { return -1; }
+   // a later queue bound to the same node should reuse the bound buffers, still residing on that node
+   ioq = create_ioqueue( iosz, partsz, DAL_WRITE, depth, 0 );
+   if ( ioq == NULL  ||  check_buffers( ioq, bound, depth, 1 )  ||  check_placement( ioq, 0 ) ) { return -1; }
+   if ( destroy_ioqueue( ioq ) ) { return -1; }
+   // while a later unbound queue should reuse only the unbound buffers
+   ioq = create_ioqueue( iosz, partsz, DAL_WRITE, depth, -1 );
+   if ( ioq == NULL  ||  check_buffers( ioq, unbound, depth, 1 ) ) { return -1; }
+   if ( destroy_ioqueue( ioq ) ) { return -1; }
+   return 0;
+}
+
+
 int main( int argc, char** argv ) {
    // Test read IOQueue with a small partsz and larger, aligned iosz
    size_t iosz = 8196;
    size_t partsz = 4096;
    DAL_MODE mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
    // Test write IOQueue with a small partsz and larger, aligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
 
    // Test a read IOQueue with small partsz and larger, unaligned iosz
    iosz = 8197;
    mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
    // Test a write IOQueue with small partsz and larger, unaligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
 
    // Test a read IOQueue with large partsz and smaller, aligned iosz
    iosz = 2052;
    mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
    // Test a write IOQueue with large partsz and smaller, aligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
 
    // Test a read IOQueue with a small partsz and very large, unaligned iosz
    iosz = 1048567;
    mode = DAL_READ;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
    // Test a write IOQueue with a small partsz and very large, unaligned iosz
    mode = DAL_WRITE;
-   if ( test_values( iosz, partsz, mode ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 0, -1 ) ) { return -1; }
+
+   // Test minimal and deep IOQueues ( buffers of the previous queues should now be reused )
+   if ( test_values( iosz, partsz, mode, 2, -1 ) ) { return -1; }
+   if ( test_values( iosz, partsz, mode, 16, -1 ) ) { return -1; }
+   mode = DAL_READ;
+   if ( test_values( iosz, partsz, mode, 16, -1 ) ) { return -1; }
+
+   // Test IOQueues with buffers placed on a specific NUMA node
+   if ( test_values( iosz, partsz, mode, 0, 0 ) ) { return -1; }
+   mode = DAL_WRITE;
+   if ( test_values( iosz, partsz, mode, 0, 0 ) ) { return -1; }
+
+   // Test that pooled buffers are only reused by queues with matching placement ( using a size unique to this test )
+   if ( test_placement( 65536, partsz, 4 ) ) { return -1; }
+
+   // Test that unusable depth values are rejected
+   if ( create_ioqueue( iosz, partsz, mode, 1, -1 ) != NULL  ||
+        create_ioqueue( iosz, partsz, mode, IOQUEUE_MAX_DEPTH + 1, -1 ) != NULL ) {
+      printf( "ERROR: created an IOQueue with an invalid depth value\n" );
+      return -1;
+   }
 
    return 0;
 }
@@ -114,12 +114,6 @@ int main( int argc, char** argv ) {
    
    // create a global state struct
    gthread_state gstate;
-   pthread_mutex_t erasurelock;
-   gstate.erasurelock = &erasurelock;
-   if ( pthread_mutex_init( gstate.erasurelock, NULL ) ) {
-      printf( "failed to initialize erasurelock\n" );
-      return -1;
-   }
    gstate.objID = "";
    gstate.location = maxloc;
    gstate.dmode = DAL_WRITE;
@@ -135,9 +129,15 @@ int main( int argc, char** argv ) {
    gstate.minfo.totsz = 0;
    gstate.meta_error = 0;
    gstate.data_error = 0;
+   gstate.numa_node = -1;
+   gstate.sboard = create_scoreboard();
+   if ( gstate.sboard == NULL ) {
+      printf( "Failed to create a location scoreboard!\n" );
+      return -1;
+   }
 
    // create an ioqueue for our data blocks
-   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode );
+   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode, 0, -1 );
    if ( gstate.ioq == NULL ) {
       printf( "Failed to create IOQueue for write thread!\n" );
       return -1;
@@ -247,7 +247,7 @@ int main( int argc, char** argv ) {
    printf( "done\n" );
 
    // create our ioqueue (based on minfo values gathered by the read thread)
-   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode );
+   gstate.ioq = create_ioqueue( gstate.minfo.versz, gstate.minfo.partsz, gstate.dmode, 0, -1 );
    if ( gstate.ioq == NULL ) {
       printf( "Failed to create ioqueue for read!\n" );
       return -1;
@@ -294,6 +294,21 @@ int main( int argc, char** argv ) {
    }
    printf( "all reads complete\n" );
 
+   // check that the thread recorded the health history of our block
+   location_score score;
+   if ( scoreboard_lookup( gstate.sboard, maxloc, &score ) ) {
+      printf( "Failed to locate the scoreboard history of our block!\n" );
+      return -1;
+   }
+   if ( score.writes == 0  ||  score.reads == 0  ||  score.errors ) {
+      printf( "Unexpected scoreboard history: %llu writes, %llu reads, %llu errors\n", score.writes, score.reads, score.errors );
+      return -1;
+   }
+   if ( scoreboard_export( gstate.sboard, NULL, 0 ) != 1 ) {
+      printf( "Scoreboard is tracking an unexpected number of locations!\n" );
+      return -1;
+   }
+
    // call our read term func
    printf( "Terminating read thread state..." );
    read_term( &tstate, (void**) &iob, 0 );
@@ -307,13 +322,11 @@ int main( int argc, char** argv ) {
       printf( "Failed to destroy read ioqueue!\n" );
       return -1;
    }
+   destroy_scoreboard( gstate.sboard );
 
    // Delete the block we created
    if ( dal->del( dal->ctxt, maxloc, "" ) ) { printf( "warning: del failed!\n" ); }
 
-   // destroy our erasurelock
-   pthread_mutex_destroy( gstate.erasurelock );
-
    // Free the DAL
    if ( dal->cleanup( dal ) ) { printf( "error: failed to cleanup DAL\n" ); return -1; }
 
@@ -0,0 +1,198 @@
+/*
+ * Compares erasure generation followed by a separate CRC pass ( the historical libne write path )
+ * against a fused, cache-blocked pass which checksums each chunk of every part immediately after
+ * encoding it ( see encode_stripe() in ne.c ).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <getopt.h>
+#include "isa-l.h"
+
+/* default values */
+#define K_DEFAULT 10
+#define P_DEFAULT 2
+#define PART_SIZE_DEFAULT (1024 * 1024)
+#define DATA_SIZE_DEFAULT (1024LL * 1024 * 1024)
+#define CACHE_BYTES_DEFAULT 262144
+
+#define MMAX 255
+#define KMAX 255
+
+#define CRC_SEED 57
+
+static long long parse_size(const char* str)
+{
+	char* end = NULL;
+	long long val = strtoll(str, &end, 10);
+	switch (*end) {
+		case 'g':
+		case 'G':
+			val *= 1024;
+			/* fall through */
+		case 'm':
+		case 'M':
+			val *= 1024;
+			/* fall through */
+		case 'k':
+		case 'K':
+			val *= 1024;
+	}
+	return val;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+int usage(void)
+{
+	fprintf(stderr,
+		"Usage: fused_crc_benchmark [options]\n"
+		"  -h        Help\n"
+		"  -k <val>  Number of data parts\n"
+		"  -p <val>  Number of erasure parts\n"
+		"  -b <val>  Part size, eg 64K, 1M\n"
+		"  -d <val>  Total data size, eg 1G\n"
+		"  -c <val>  Cache budget per fused chunk ( across all parts ), eg 256K\n");
+	exit(0);
+}
+
+/* encode the full stripe, then checksum each part in a second pass */
+static void separate_pass(int k, int p, size_t partsz, unsigned char* tbls,
+			  unsigned char** buffs, uint32_t* crcs)
+{
+	int i;
+	ec_encode_data(partsz, k, p, tbls, buffs, &buffs[k]);
+	for (i = 0; i < k + p; i++)
+		crcs[i] = crc32_ieee(CRC_SEED, buffs[i], partsz);
+}
+
+/* encode and checksum one cache-sized chunk of every part at a time */
+static void fused_pass(int k, int p, size_t partsz, size_t chunksz, unsigned char* tbls,
+		       unsigned char** buffs, unsigned char** refs, uint32_t* crcs)
+{
+	int i;
+	size_t off;
+	for (i = 0; i < k + p; i++) {
+		refs[i] = buffs[i];
+		crcs[i] = CRC_SEED;
+	}
+	for (off = 0; off < partsz; off += chunksz) {
+		size_t len = partsz - off;
+		if (len > chunksz)
+			len = chunksz;
+		ec_encode_data(len, k, p, tbls, refs, &refs[k]);
+		for (i = 0; i < k + p; i++) {
+			crcs[i] = crc32_ieee(crcs[i], refs[i], len);
+			refs[i] += len;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int k = K_DEFAULT, p = P_DEFAULT;
+	size_t partsz = PART_SIZE_DEFAULT;
+	long long datasz = DATA_SIZE_DEFAULT;
+	size_t cachesz = CACHE_BYTES_DEFAULT;
+	int c, i;
+
+	while ((c = getopt(argc, argv, "k:p:b:d:c:h")) != -1) {
+		switch (c) {
+			case 'k':
+				k = atoi(optarg);
+				break;
+			case 'p':
+				p = atoi(optarg);
+				break;
+			case 'b':
+				partsz = parse_size(optarg);
+				break;
+			case 'd':
+				datasz = parse_size(optarg);
+				break;
+			case 'c':
+				cachesz = parse_size(optarg);
+				break;
+			case 'h':
+			default:
+				usage();
+		}
+	}
+	if (k <= 0 || k > KMAX || p <= 0 || p > MMAX || (k + p) > MMAX || partsz == 0 || datasz <= 0) {
+		fprintf(stderr, "Invalid arguments\n");
+		usage();
+	}
+	size_t chunksz = (cachesz / (k + p)) & ~((size_t)63);
+	if (chunksz < 4096)
+		chunksz = 4096;
+	long long stripes = datasz / (partsz * k);
+	if (stripes == 0)
+		stripes = 1;
+
+	unsigned char* matrix = malloc((k + p) * k);
+	unsigned char* tbls = malloc(k * p * 32);
+	unsigned char** buffs = calloc(k + p, sizeof(unsigned char*));
+	unsigned char** refs = calloc(k + p, sizeof(unsigned char*));
+	uint32_t* crcs = calloc(k + p, sizeof(uint32_t));
+	uint32_t* fcrcs = calloc(k + p, sizeof(uint32_t));
+	if (!matrix || !tbls || !buffs || !refs || !crcs || !fcrcs) {
+		fprintf(stderr, "Failed to allocate benchmark structures\n");
+		return -1;
+	}
+	for (i = 0; i < k + p; i++) {
+		if (posix_memalign((void**)&buffs[i], 64, partsz)) {
+			fprintf(stderr, "Failed to allocate part buffer\n");
+			return -1;
+		}
+		size_t j;
+		for (j = 0; j < partsz; j++)
+			buffs[i][j] = rand();
+	}
+	gf_gen_cauchy1_matrix(matrix, k + p, k);
+	ec_init_tables(k, p, &matrix[k * k], tbls);
+
+	printf("k=%d p=%d partsz=%zu chunksz=%zu stripes=%lld\n", k, p, partsz, chunksz, stripes);
+
+	// warm up, and verify that both methods agree
+	separate_pass(k, p, partsz, tbls, buffs, crcs);
+	fused_pass(k, p, partsz, chunksz, tbls, buffs, refs, fcrcs);
+	if (memcmp(crcs, fcrcs, (k + p) * sizeof(uint32_t))) {
+		fprintf(stderr, "Fused CRCs do not match separate CRCs!\n");
+		return -1;
+	}
+
+	long long s;
+	double start = now();
+	for (s = 0; s < stripes; s++)
+		separate_pass(k, p, partsz, tbls, buffs, crcs);
+	double septime = now() - start;
+
+	start = now();
+	for (s = 0; s < stripes; s++)
+		fused_pass(k, p, partsz, chunksz, tbls, buffs, refs, fcrcs);
+	double fusedtime = now() - start;
+
+	double mb = (double)stripes * partsz * k / (1024 * 1024);
+	printf("separate encode+crc : %f sec  %.2f MB/s\n", septime, mb / septime);
+	printf("fused encode+crc    : %f sec  %.2f MB/s\n", fusedtime, mb / fusedtime);
+
+	for (i = 0; i < k + p; i++)
+		free(buffs[i]);
+	free(buffs);
+	free(refs);
+	free(crcs);
+	free(fcrcs);
+	free(tbls);
+	free(matrix);
+	return 0;
+}
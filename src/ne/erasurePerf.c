@@ -75,9 +75,147 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <sys/time.h>
 #include <libgen.h>
 #include <string.h>
+#include <time.h>
+#include <isa-l.h>
 
 #include "ne.h"
 
+// encode benchmark parameters
+#define ENCODE_CACHE_BYTES 262144 // matches the fused encode+crc chunking of libne ( FUSED_CACHE_BYTES in ne.c )
+#define ENCODE_IOBLOCK_BYTES (1024 * 1024) // data buffered per part before libne encodes and pushes it
+#define ENCODE_DATA_BYTES (256LL * 1024 * 1024) // total data to encode at each part size
+#define CRC_SEED 57
+
+static const size_t encode_partsz[] = {1024, 4096, 16384, 65536, 262144, 1048576};
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+// encode and checksum 'len' bytes of every part, in cache-sized chunks
+static void encode_region(int N, int E, unsigned char *tbls, unsigned char **buffs, unsigned char **refs,
+                          uint32_t *crcs, size_t len, size_t chunksz)
+{
+  int i;
+  size_t off;
+  for (off = 0; off < len; off += chunksz)
+  {
+    size_t chunklen = len - off;
+    if (chunklen > chunksz)
+    {
+      chunklen = chunksz;
+    }
+    ec_encode_data(chunklen, N, E, tbls, refs, &refs[N]);
+    for (i = 0; i < N + E; i++)
+    {
+      crcs[i] = crc32_ieee(crcs[i], refs[i], chunklen);
+      refs[i] += chunklen;
+    }
+  }
+}
+
+/**
+ * Time encode+crc of a full ioblock worth of stripes, either one stripe at a time or with all stripes
+ * of the ioblock encoded at once, and report the single-threaded ( per core ) throughput of each
+ * @param int N : Data part count
+ * @param int E : Erasure part count
+ * @return int : Zero on success, -1 on failure
+ */
+static int encode_benchmark(int N, int E)
+{
+  size_t chunksz = (ENCODE_CACHE_BYTES / (N + E)) & ~((size_t)63);
+  if (chunksz < 4096)
+  {
+    chunksz = 4096;
+  }
+  unsigned char *matrix = malloc((N + E) * N);
+  unsigned char *tbls = malloc(N * E * 32);
+  unsigned char **buffs = calloc(N + E, sizeof(unsigned char *));
+  unsigned char **refs = calloc(N + E, sizeof(unsigned char *));
+  uint32_t *crcs = calloc(N + E, sizeof(uint32_t));
+  if (matrix == NULL || tbls == NULL || buffs == NULL || refs == NULL || crcs == NULL)
+  {
+    printf("ERROR: Failed to allocate encode benchmark structures!\n");
+    return -1;
+  }
+  int i;
+  for (i = 0; i < N + E; i++)
+  {
+    if (posix_memalign((void **)&buffs[i], 64, ENCODE_IOBLOCK_BYTES))
+    {
+      printf("ERROR: Failed to allocate encode benchmark buffers!\n");
+      return -1;
+    }
+    size_t j;
+    for (j = 0; j < ENCODE_IOBLOCK_BYTES; j++)
+    {
+      buffs[i][j] = (unsigned char)(j * 31 + i);
+    }
+  }
+  gf_gen_cauchy1_matrix(matrix, N + E, N);
+  ec_init_tables(N, E, &matrix[N * N], tbls);
+
+  printf("encode+crc throughput per core ( N=%d E=%d, %zu byte chunks )\n", N, E, chunksz);
+  printf("%10s %16s %16s\n", "partsz", "per-stripe GB/s", "batched GB/s");
+  size_t p;
+  for (p = 0; p < sizeof(encode_partsz) / sizeof(size_t); p++)
+  {
+    size_t partsz = encode_partsz[p];
+    size_t stripes = ENCODE_IOBLOCK_BYTES / partsz; // stripes buffered per ioblock
+    size_t region = stripes * partsz;
+    long long passes = ENCODE_DATA_BYTES / ((long long)region * N);
+    if (passes == 0)
+    {
+      passes = 1;
+    }
+    long long pass;
+    size_t s;
+    // one encode call sequence per stripe
+    double beg = now_sec();
+    for (pass = 0; pass < passes; pass++)
+    {
+      for (s = 0; s < stripes; s++)
+      {
+        for (i = 0; i < N + E; i++)
+        {
+          refs[i] = buffs[i] + (s * partsz);
+          crcs[i] = CRC_SEED;
+        }
+        encode_region(N, E, tbls, buffs, refs, crcs, partsz, chunksz);
+      }
+    }
+    double single = now_sec() - beg;
+    // every stripe of the ioblock at once
+    beg = now_sec();
+    for (pass = 0; pass < passes; pass++)
+    {
+      for (i = 0; i < N + E; i++)
+      {
+        refs[i] = buffs[i];
+        crcs[i] = CRC_SEED;
+      }
+      encode_region(N, E, tbls, buffs, refs, crcs, region, chunksz);
+    }
+    double batched = now_sec() - beg;
+    double gb = (double)passes * region * N / 1e9;
+    printf("%10zu %16.2f %16.2f\n", partsz, gb / single, gb / batched);
+  }
+
+  for (i = 0; i < N + E; i++)
+  {
+    free(buffs[i]);
+  }
+  free(buffs);
+  free(refs);
+  free(crcs);
+  free(tbls);
+  free(matrix);
+  return 0;
+}
+
 int main(int argc, const char **argv)
 {
   if (argc < 3 || argc > 5)
@@ -97,6 +235,12 @@ int main(int argc, const char **argv)
     epat.partsz = atoi(argv[4]);
   }
 
+  // Time erasure generation alone, across a range of part sizes
+  if (encode_benchmark(epat.N, epat.E))
+  {
+    return -1;
+  }
+
   // Form config file path
   printf("%s\n", argv[0]);
   char *d_name = dirname(strdup(argv[0]));
@@ -161,6 +305,12 @@ int main(int argc, const char **argv)
     printf("ERROR: Failed to open a write handle!\n");
     return -1;
   }
+  // iobuff is left untouched until the handle is closed, so complete stripes need not be copied
+  if (ne_set_zero_copy(handle, 1))
+  {
+    printf("ERROR: Failed to enable zero-copy writes!\n");
+    return -1;
+  }
   if (ne_write(handle, iobuff, iosz) != iosz)
   {
     printf("ERROR: Unexpected return value from ne_write!\n");
@@ -173,7 +323,7 @@ int main(int argc, const char **argv)
   }
   struct timeval end;
   gettimeofday(&end, NULL);
-  double wr_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6;
+  double wr_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec - beg.tv_usec) * 1e-6;
 
   // Time a read operation
   gettimeofday(&beg, NULL);
@@ -194,7 +344,7 @@ int main(int argc, const char **argv)
     return -1;
   }
   gettimeofday(&end, NULL);
-  double rd_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6;
+  double rd_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec - beg.tv_usec) * 1e-6;
 
   ne_state *sref = calloc(1, sizeof(ne_state));
 
@@ -217,7 +367,7 @@ int main(int argc, const char **argv)
     return -1;
   }
   gettimeofday(&end, NULL);
-  double ver_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6;
+  double ver_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec - beg.tv_usec) * 1e-6;
 
   // Time a rebuild operation
   gettimeofday(&beg, NULL);
@@ -243,7 +393,7 @@ int main(int argc, const char **argv)
     return -1;
   }
   gettimeofday(&end, NULL);
-  double reb_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec + beg.tv_usec) * 1e-6;
+  double reb_time = (end.tv_sec - beg.tv_sec) + (end.tv_usec - beg.tv_usec) * 1e-6;
 
   // Output results
   printf("write time: %.6f, read time: %.6f, verify time: %.6f, rebuild time: %.6f\n", wr_time, rd_time, ver_time, reb_time);
@@ -115,6 +115,9 @@ underlying skt_etc() functions.
 #include "thread_queue/thread_queue.h"
 
 #include <isa-l.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
 
 #include <stdio.h>
 #include <string.h>
@@ -127,21 +130,77 @@ underlying skt_etc() functions.
 #include <errno.h>
 #include <assert.h>
 #include <pthread.h>
+#include <time.h>
 
 // Some configurable values
-#define QDEPTH SUPER_BLOCK_CNT + 1
+#define QDEPTH(HANDLE) ((HANDLE)->ctxt->iodepth + 1)
+#define STAT_PROBE_THREADS 16 // maximum number of concurrent metadata probes issued by ne_stat()
+#define DELETE_BATCH_THREADS 32 // default number of concurrent block deletions issued by ne_delete_batch()
+#define DECODE_CACHE_SIZE 32 // number of decode tables ( one per erasure / error pattern ) retained by each ne_ctxt
+#define FUSED_CACHE_BYTES 262144 // bytes of stripe data ( across all N+E parts ) to encode and checksum at once
+#define HEDGE_DELAY_USEC 2000 // default time NE_RDHEDGE handles await data blocks once a stripe could be reconstructed without them
+#define HEDGE_POLL_USEC 200 // interval at which NE_RDHEDGE handles recheck all block queues while awaiting ioblocks
+#define SCORE_ERROR_THRESHOLD 0.25 // recent error rate beyond which read handles avoid a block location
+#define SCORE_SLOW_FACTOR 4.0 // multiple of the median stripe read latency beyond which read handles avoid a block location
+#define SCORE_MIN_READS 4 // number of recorded reads required before a block location may be considered slow
+#define SCORE_MEMORY_SEC 300 // age beyond which block location history no longer influences read handles
+
+// Cached decode tables for a specific error pattern
+typedef struct decode_table_struct {
+   int N;
+   int E;
+   unsigned char* in_err;       // error pattern of N+E blocks ( the cache key, along with N and E )
+   unsigned char* decode_index; // blocks to regenerate from
+   unsigned char* g_tbls;       // isa-l tables for regeneration of the erred blocks
+   size_t tblsz;                // size of g_tbls
+   struct decode_table_struct* prev; // more recently used entry
+   struct decode_table_struct* next; // less recently used entry
+} decode_table;
+
+// LRU cache of decode tables
+typedef struct decode_cache_struct {
+   pthread_mutex_t lock;
+   int count;
+   decode_table* head; // most recently used entry
+   decode_table* tail; // least recently used entry
+} decode_cache;
 
 // NE context
 typedef struct ne_ctxt_struct {
    // Max Block value
    int max_block;
+   // Number of ioblocks per block IOQueue
+   int iodepth;
+   // Microseconds which NE_RDHEDGE handles will wait on slow data blocks
+   unsigned int hedge_delay;
+   // Decode tables of recently encountered error patterns
+   decode_cache dcache;
+   // Health history of all block locations accessed via this context
+   scoreboard* sboard;
+   // NUMA node on which block IO threads and buffers are placed ( negative for no placement )
+   int numa_node;
    // DAL definitions
    DAL dal;
-   // Synchronization
-   pthread_mutex_t locallock;
-   pthread_mutex_t* erasurelock;
 } *ne_ctxt;
 
+// State of a hedged ( NE_RDHEDGE ) read handle, or of any read handle which avoids suspect blocks
+typedef struct hedge_state_struct {
+   int* lag;     // number of stale ioblocks, skipped by previous stripes, still to be discarded from each block queue
+   char* dead;   // indicates that a block queue will produce no further ioblocks
+   char* skip;   // indicates that a block is being avoided, due to its scoreboard history or excessive lag ( its thread remains halted )
+   char* insub;  // indicates that the handle ioblock of a block is a substitute
+   ioblock* sub; // substitute ioblocks, standing in for those which have not yet arrived
+} hedge_state;
+
+// State of a sparse ( NE_RDSPARSE ) read handle
+typedef struct sparse_state_struct {
+   BLOCK_CTXT* bctxt; // DAL read handles of each data block ( opened on first use )
+   void** buff;       // data of the most recently read IO unit of each data block ( allocated on first use )
+   off_t* unit;       // index of the buffered IO unit of each data block ( -1 if none )
+   size_t* unit_data; // verified data bytes of each buffered IO unit
+   off_t offset;      // current data offset of the handle
+} sparse_state;
+
 typedef struct ne_handle_struct {
    /* Reference back to our global context */
    ne_ctxt ctxt;
@@ -162,11 +221,16 @@ typedef struct ne_handle_struct {
    off_t iob_datasz;
    off_t iob_offset;
    ssize_t sub_offset;
+   hedge_state* hedge;
+   sparse_state* sparse;
+   int pend_stripes; // complete stripes, at the tail of every current ioblock, which have yet to be encoded
+   char zcopy;       // caller buffers may be referenced until close, allowing complete stripes to be written without copying
 
    /* Threading fields */
    ThreadQueue* thread_queues;
    gthread_state* thread_states;
    unsigned int ethreads_running;
+   unsigned int poolslots; // IO thread pool slots reserved for this handle's queues
 
    /* Erasure Manipulation Structures */
    unsigned char e_ready;
@@ -178,8 +242,45 @@ typedef struct ne_handle_struct {
    unsigned char* g_tbls;
    unsigned char* decode_index;
 
+   /* Latency breakdown of the ne_stat() call which produced this handle */
+   ne_stat_timing stat_timing;
+
 } *ne_handle;
 
+// shared state of the concurrent metadata probes issued by ne_stat()
+typedef struct stat_probe_struct {
+   ne_ctxt ctxt;
+   const char* objID;
+   ne_location loc;
+   pthread_mutex_t lock;
+   pthread_cond_t progress; // signaled whenever a probe completes
+   int nextblock;         // next block to be probed
+   int maxblock;          // probe limit ( widened while consensus is lacking, then set to N+E once it is reached )
+   int inflight;          // number of probes currently in progress
+   int probed;            // number of completed probes
+   int final;             // flag indicating that sufficient consensus has been reached
+   int valid_meta;        // number of populated minfo_refs
+   int match_count;       // agreement of the current consensus
+   meta_info consensus;
+   meta_info* minfo_list; // meta info of each block
+   meta_info** minfo_refs; // valid meta info, in order of arrival
+   char* meta_errs;
+   char* data_errs;
+   ne_stat_timing* timing;
+} stat_probe;
+
+// shared state of the concurrent block deletions issued by ne_delete_batch()
+typedef struct delete_batch_struct {
+   ne_ctxt ctxt;
+   ne_delete_target* targets;
+   size_t count;
+   pthread_mutex_t lock;
+   size_t nextdel;        // next ( target * max_block + block ) deletion to be issued
+} delete_batch;
+
+static pthread_once_t erasure_init_once = PTHREAD_ONCE_INIT;
+static int erasure_init_result = 0;
+
 static int gf_gen_decode_matrix_simple(unsigned char* encode_matrix,
    unsigned char* decode_matrix,
    unsigned char* invert_matrix,
@@ -189,6 +290,245 @@ static int gf_gen_decode_matrix_simple(unsigned char* encode_matrix,
 
 // ---------------------- INTERNAL HELPER FUNCTIONS ----------------------
 
+/**
+ * Report which SIMD erasure kernels are available to isa-l on this host
+ * NOTE -- isa-l dispatches ec_encode_data() to the widest supported kernel ( AVX512 + GFNI, AVX512, AVX2, ... )
+ *         at runtime, so this is purely informational, but aids in explaining encode throughput.
+ */
+static void log_erasure_kernels(void) {
+#if (DEBUG)  // these values are only consumed by LOG(), which is a no-op otherwise
+#if defined(__x86_64__) && defined(__GNUC__)
+   __builtin_cpu_init();
+   int avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+   int avx512 = (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) ? 1 : 0;
+   int gfni = __builtin_cpu_supports("gfni") ? 1 : 0;
+   LOG(LOG_INFO, "Erasure kernel support: AVX2=%s AVX512=%s GFNI=%s ( expected encode kernel: %s )\n",
+      (avx2) ? "yes" : "no", (avx512) ? "yes" : "no", (gfni) ? "yes" : "no",
+      (avx512 && gfni) ? "avx512_gfni" : (avx512) ? "avx512" : (avx2 && gfni) ? "avx2_gfni" : (avx2) ? "avx2" : "base/sse");
+#else
+   LOG(LOG_INFO, "Erasure kernel support is not reported for this architecture\n");
+#endif
+#endif
+}
+
+/**
+ * One-time initialization of isa-l erasure/crc routines ( run via pthread_once() )
+ * NOTE -- isa-l selects its SIMD implementations on the first call to each multibinary function.
+ *         Forcing that selection here, exactly once per process, means that all later calls are
+ *         free of shared state and may proceed in parallel without any external lock.
+ */
+static void erasure_lib_init(void) {
+   int N = 2;
+   int E = 1;
+   size_t len = 64;
+   unsigned char matrix[(2 + 1) * 2];
+   unsigned char tbls[2 * 1 * 32];
+   unsigned char* buffs = calloc(N + E, len);
+   if (buffs == NULL) {
+      LOG(LOG_ERR, "Failed to allocate space for erasure init buffers!\n");
+      erasure_init_result = -1;
+      return;
+   }
+   unsigned char* refs[3] = { buffs, buffs + len, buffs + (2 * len) };
+   gf_gen_cauchy1_matrix(matrix, N + E, N);
+   ec_init_tables(N, E, &(matrix[N * N]), tbls);
+   ec_encode_data(len, N, E, tbls, refs, &(refs[N]));
+   (void)crc32_ieee(0, buffs, len);
+   free(buffs);
+   LOG(LOG_INFO, "Initialized isa-l erasure routines\n");
+   log_erasure_kernels();
+}
+
+/**
+ * Ensure that isa-l erasure routines have been initialized for this process
+ * @return int : Zero on success, -1 on failure
+ */
+static int erasure_init(void) {
+   if (pthread_once(&erasure_init_once, erasure_lib_init)) {
+      LOG(LOG_ERR, "Failed to run one-time erasure initialization\n");
+      return -1;
+   }
+   if (erasure_init_result) {
+      errno = ENOMEM;
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Populate the encode matrix and g_tbls of the given handle for erasure generation
+ * NOTE -- these structures are private to the handle, so no locking is required
+ * @param ne_handle handle : Handle for which to initialize erasure structures
+ */
+static void init_encode_tables(ne_handle handle) {
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   // Generate an encoding matrix
+   // NOTE: The matrix generated by gf_gen_rs_matrix is not always invertable for N>=6 and E>=5!
+   gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
+   // Generate g_tbls from encode matrix
+   ec_init_tables(N, E, &(handle->encode_matrix[N * N]), handle->g_tbls);
+   handle->e_ready = 1;
+}
+
+/**
+ * Determine the size of the per-part chunks in which stripes are encoded and checksummed
+ * @param int N : Data part count
+ * @param int E : Erasure part count
+ * @return size_t : Chunk size, such that a chunk of every part will fit in cache at once
+ */
+static size_t encode_chunksz(int N, int E) {
+   size_t chunksz = (FUSED_CACHE_BYTES / (N + E)) & ~((size_t)63);
+   if (chunksz < 4096) {
+      chunksz = 4096;
+   }
+   return chunksz;
+}
+
+/**
+ * Generate erasure parts for one or more complete stripes, checksumming every part as it is encoded
+ * NOTE -- the stripes are processed in chunks small enough to remain cache-resident, such that the CRC of
+ *         each data/erasure part is generated while that data is still hot, rather than in a separate pass
+ *         by our iothreads.  Every part of the stripes is expected to be the most recent data of its ioblock.
+ *         As encoding is bytewise, consecutive stripes, contiguous within each ioblock, may be encoded as if
+ *         they were a single stripe of larger partsz.  This allows small parts to be encoded in full chunks.
+ * @param ne_handle handle : Handle on which the stripes are being written
+ * @param void** tgt_refs : Array of N+E part references ( these will be advanced beyond the end of each part )
+ * @param size_t len : Length of data to be encoded from each part ( a multiple of partsz )
+ */
+static void encode_stripes(ne_handle handle, void** tgt_refs, size_t len) {
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t chunksz = encode_chunksz(N, E);
+   size_t offset;
+   for (offset = 0; offset < len; offset += chunksz) {
+      size_t chunklen = len - offset;
+      if (chunklen > chunksz) {
+         chunklen = chunksz;
+      }
+      // g_tbls are private to this handle, so no locking is required
+      ec_encode_data(chunklen, N, E, handle->g_tbls, (unsigned char**)tgt_refs, (unsigned char**)&(tgt_refs[N]));
+      int block;
+      for (block = 0; block < N + E; block++) {
+         ioblock* iob = handle->iob[block];
+         ioblock_update_crc(iob, (ioblock_get_fill(iob) - len) + offset, tgt_refs[block], chunklen, handle->thread_states[block].ioq);
+         tgt_refs[block] += chunklen;
+      }
+   }
+}
+
+/**
+ * Generate erasure parts for all complete stripes which have been buffered, but not yet encoded
+ * NOTE -- this must be called at a stripe boundary, prior to pushing any ioblock of the handle
+ * @param ne_handle handle : Handle on which the stripes are being written
+ * @param void** tgt_refs : Array of N+E references, to be used for erasure generation
+ */
+static void encode_pending_stripes(ne_handle handle, void** tgt_refs) {
+   if (handle->pend_stripes == 0) {
+      return;
+   }
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t len = handle->pend_stripes * handle->epat.partsz;
+   LOG(LOG_INFO, "Generating erasure parts for %d buffered stripes\n", handle->pend_stripes);
+   int block;
+   for (block = 0; block < N + E; block++) {
+      // pending stripes are always the most recent data of each ioblock
+      tgt_refs[block] = ioblock_write_target(handle->iob[block]) - len;
+   }
+   encode_stripes(handle, tgt_refs, len);
+   handle->pend_stripes = 0;
+}
+
+/**
+ * Push any full ioblocks of the given block to its iothread, leaving a usable ioblock reserved
+ * @param ne_handle handle : Handle on which to push ioblocks
+ * @param int block : Index of the block to push for
+ * @return int : Zero on success, -1 on failure
+ */
+static int push_full_ioblocks(ne_handle handle, int block) {
+   ioblock* push_block = NULL;
+   int reserved;
+   while ((reserved = reserve_ioblock(&(handle->iob[block]), &(push_block), handle->thread_states[block].ioq)) > 0) {
+      LOG(LOG_INFO, "Pushing full ioblock to thread %d\n", block);
+      if (tq_enqueue(handle->thread_queues[block], TQ_NONE, (void*)push_block)) {
+         LOG(LOG_ERR, "Failed to push ioblock to thread_queue %d\n", block);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   if (reserved < 0) {
+      LOG(LOG_ERR, "Failed to reserve ioblock for position %d!\n", block);
+      errno = EBADF;
+      return -1;
+   }
+   return 0;
+}
+
+/**
+ * Write a complete, stripe-aligned stripe of caller data without copying it
+ * Data parts are encoded directly from the caller buffer, and references to them are handed to our iothreads.
+ * NOTE -- the caller buffer must not be released until all ioblocks have been consumed ( see release_caller_buffers() )
+ * @param ne_handle handle : Handle to write to
+ * @param const void* buffer : Caller buffer, containing a complete stripe of data
+ * @param void** tgt_refs : Array of N+E references, to be used for erasure generation
+ * @return int : Zero on success, -1 on failure
+ */
+static int write_full_stripe(ne_handle handle, const void* buffer, void** tgt_refs) {
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t partsz = handle->epat.partsz;
+   // buffered stripes precede this one, and must be encoded before any ioblock is pushed
+   encode_pending_stripes(handle, tgt_refs);
+   int block;
+   for (block = 0; block < N + E; block++) {
+      // make sure we have room for another part
+      if (push_full_ioblocks(handle, block)) {
+         return -1;
+      }
+      if (block < N) {
+         tgt_refs[block] = (void*)(buffer + (block * partsz));
+         ioblock_add_external(handle->iob[block], tgt_refs[block], partsz);
+      }
+      else {
+         // assume we will successfully generate erasure
+         tgt_refs[block] = ioblock_write_target(handle->iob[block]);
+         ioblock_update_fill(handle->iob[block], partsz, 0);
+      }
+   }
+   // generate erasure parts
+   encode_stripes(handle, tgt_refs, partsz);
+   // immediately push any completed ioblocks, rather than waiting for the next write
+   for (block = 0; block < N + E; block++) {
+      if (push_full_ioblocks(handle, block)) {
+         return -1;
+      }
+   }
+   return 0;
+}
+
+/**
+ * Ensure that no ioblock of the given write handle still references any caller buffer
+ * Any references held by our current ioblocks are copied into them, and all ioblocks already handed to our
+ * iothreads are waited upon.
+ * @param ne_handle handle : Handle to release caller buffers of
+ * @return int : Zero on success, -1 on failure
+ */
+static int release_caller_buffers(ne_handle handle) {
+   int block;
+   for (block = 0; block < handle->epat.N; block++) {
+      if (handle->iob[block]) {
+         ioblock_copy_external(handle->iob[block]);
+      }
+      if (ioqueue_wait_idle(handle->thread_states[block].ioq, (handle->iob[block]) ? 1 : 0)) {
+         LOG(LOG_ERR, "Failed to wait for outstanding ioblocks of block %d\n", block);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   return 0;
+}
+
 /**
  * Clear/zero out existing ne_state information
  * @param ne_state* state : Reference to the state structure to clear
@@ -424,10 +764,12 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       return NULL;
    }
 
+   // pre-initialize our erasure structs, so encoding never requires shared state
+   init_encode_tables(handle);
+
    int i;
    for (i = 0; i < num_blocks; i++) {
       // assign values to thread states
-      handle->thread_states[i].erasurelock = handle->ctxt->erasurelock;
       // object attributes
       handle->thread_states[i].objID = handle->objID;
       handle->thread_states[i].location.pod = loc.pod;
@@ -435,6 +777,8 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       handle->thread_states[i].location.cap = loc.cap;
       handle->thread_states[i].location.scatter = loc.scatter;
       handle->thread_states[i].dal = ctxt->dal;
+      handle->thread_states[i].sboard = ctxt->sboard;
+      handle->thread_states[i].numa_node = ctxt->numa_node;
       handle->thread_states[i].offset = 0;
       // meta info values
       handle->thread_states[i].minfo.N = consensus->N;
@@ -445,6 +789,8 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
       handle->thread_states[i].minfo.blocksz = consensus->blocksz;
       handle->thread_states[i].minfo.crcsum = 0;
       handle->thread_states[i].minfo.totsz = consensus->totsz;
+      handle->thread_states[i].minfo.compsz = 0;
+      handle->thread_states[i].minfo.csum = consensus->csum;
       handle->thread_states[i].meta_error = 0;
       handle->thread_states[i].data_error = 0;
       //      size_t iosz = consensus->versz;
@@ -471,11 +817,139 @@ ne_handle allocate_handle(ne_ctxt ctxt, const char* objID, ne_location loc, meta
    return handle;
 }
 
+/**
+ * Allocate the state of a hedged read handle
+ * @param int blocks : Total number of blocks ( N + E )
+ * @return hedge_state* : Newly allocated hedge state, or NULL on failure
+ */
+static hedge_state* allocate_hedge_state(int blocks) {
+   hedge_state* hedge = calloc(1, sizeof(struct hedge_state_struct));
+   if (hedge == NULL) {
+      LOG(LOG_ERR, "Failed to allocate a hedge_state struct!\n");
+      return NULL;
+   }
+   hedge->lag = calloc(blocks, sizeof(int));
+   hedge->dead = calloc(blocks, sizeof(char));
+   hedge->skip = calloc(blocks, sizeof(char));
+   hedge->insub = calloc(blocks, sizeof(char));
+   hedge->sub = calloc(blocks, sizeof(ioblock));
+   if (hedge->lag == NULL || hedge->dead == NULL || hedge->skip == NULL || hedge->insub == NULL || hedge->sub == NULL) {
+      LOG(LOG_ERR, "Failed to allocate hedge_state arrays!\n");
+      free(hedge->sub);
+      free(hedge->insub);
+      free(hedge->skip);
+      free(hedge->dead);
+      free(hedge->lag);
+      free(hedge);
+      return NULL;
+   }
+   return hedge;
+}
+
+/**
+ * Free the state of a hedged read handle
+ * @param hedge_state* hedge : Hedge state to be freed ( may be NULL )
+ * @param int blocks : Total number of blocks ( N + E )
+ */
+static void free_hedge_state(hedge_state* hedge, int blocks) {
+   if (hedge == NULL) {
+      return;
+   }
+   int i;
+   for (i = 0; i < blocks; i++) {
+      free(hedge->sub[i].buff);
+   }
+   free(hedge->sub);
+   free(hedge->insub);
+   free(hedge->skip);
+   free(hedge->dead);
+   free(hedge->lag);
+   free(hedge);
+}
+
+/**
+ * Drop the handle reference to a block ioblock, releasing it unless it is a hedge substitute
+ * @param ne_handle handle : Handle to update
+ * @param int block : Index of the block
+ * @return int : Zero on success, and -1 on failure
+ */
+static int drop_handle_ioblock(ne_handle handle, int block) {
+   if (handle->iob[block] == NULL) {
+      return 0;
+   }
+   if (handle->hedge && handle->hedge->insub[block]) {
+      handle->hedge->insub[block] = 0;
+   }
+   else if (release_ioblock(handle->thread_states[block].ioq)) {
+      return -1;
+   }
+   handle->iob[block] = NULL;
+   return 0;
+}
+
+/**
+ * Allocate the state of a sparse read handle
+ * @param int blocks : Number of data blocks of the handle
+ * @return sparse_state* : Newly allocated sparse state, or NULL on failure
+ */
+static sparse_state* allocate_sparse_state(int blocks) {
+   sparse_state* sparse = calloc(1, sizeof(struct sparse_state_struct));
+   if (sparse == NULL) {
+      LOG(LOG_ERR, "Failed to allocate a sparse_state struct!\n");
+      return NULL;
+   }
+   sparse->bctxt = calloc(blocks, sizeof(BLOCK_CTXT));
+   sparse->buff = calloc(blocks, sizeof(void*));
+   sparse->unit = calloc(blocks, sizeof(off_t));
+   sparse->unit_data = calloc(blocks, sizeof(size_t));
+   if (sparse->bctxt == NULL || sparse->buff == NULL || sparse->unit == NULL || sparse->unit_data == NULL) {
+      LOG(LOG_ERR, "Failed to allocate sparse_state arrays!\n");
+      free(sparse->unit_data);
+      free(sparse->unit);
+      free(sparse->buff);
+      free(sparse->bctxt);
+      free(sparse);
+      return NULL;
+   }
+   int i;
+   for (i = 0; i < blocks; i++) {
+      sparse->unit[i] = -1;
+   }
+   return sparse;
+}
+
+/**
+ * Close all block references of, and free, the sparse state of a handle
+ * @param ne_handle handle : Handle to free the sparse state of ( may lack one )
+ */
+static void free_sparse_state(ne_handle handle) {
+   sparse_state* sparse = handle->sparse;
+   if (sparse == NULL) {
+      return;
+   }
+   int i;
+   for (i = 0; i < handle->epat.N; i++) {
+      if (sparse->bctxt[i] && handle->ctxt->dal->close(sparse->bctxt[i])) {
+         LOG(LOG_WARNING, "Failed to close sparse read handle for block %d\n", i);
+      }
+      free(sparse->buff[i]);
+   }
+   free(sparse->unit_data);
+   free(sparse->unit);
+   free(sparse->buff);
+   free(sparse->bctxt);
+   free(sparse);
+   handle->sparse = NULL;
+}
+
 /**
  * Free an allocated ne_handle structure
  * @param ne_handle handle : Handle to free
  */
 void free_handle(ne_handle handle) {
+   iothread_pool_release(handle->poolslots);
+   free_hedge_state(handle->hedge, handle->epat.N + handle->epat.E);
+   free_sparse_state(handle);
    //   int i;
    //   for ( i = 0; i < handle->epat.N + handle->epat.E; i++ ) {
    //      destroy_ioqueue( handle->thread_states[i].ioq );
@@ -512,6 +986,8 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
    ret_buf->versz = -1;
    ret_buf->blocksz = -1;
    ret_buf->totsz = -1;
+   ret_buf->compsz = 0;
+   ret_buf->csum = CSUM_CRC32;
    // bounds checking
    if ( num_blocks < 1 ) {
       LOG( LOG_ERR, "Called with zero blocks, nothing to check\n" );
@@ -638,6 +1114,351 @@ int check_matches(meta_info** minfo_structs, int num_blocks, int max_blocks, met
    return retval;
 }
 
+/**
+ * Populate the decode tables of the given handle from the context cache, if a matching entry exists
+ * @param ne_handle handle : Handle to populate the decode_index and g_tbls of
+ * @param unsigned char* in_err : Error pattern of all N+E blocks
+ * @return int : One if the tables were populated, and zero if no entry was found
+ */
+static int decode_cache_lookup(ne_handle handle, const unsigned char* in_err) {
+   decode_cache* dcache = &(handle->ctxt->dcache);
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   pthread_mutex_lock(&dcache->lock);
+   decode_table* entry = dcache->head;
+   for (; entry != NULL; entry = entry->next) {
+      if (entry->N == N && entry->E == E && memcmp(entry->in_err, in_err, N + E) == 0) {
+         break;
+      }
+   }
+   if (entry == NULL) {
+      pthread_mutex_unlock(&dcache->lock);
+      return 0;
+   }
+   // move this entry to the head of the list
+   if (entry != dcache->head) {
+      entry->prev->next = entry->next;
+      if (entry->next) {
+         entry->next->prev = entry->prev;
+      }
+      else {
+         dcache->tail = entry->prev;
+      }
+      entry->prev = NULL;
+      entry->next = dcache->head;
+      dcache->head->prev = entry;
+      dcache->head = entry;
+   }
+   memcpy(handle->decode_index, entry->decode_index, N + E);
+   memcpy(handle->g_tbls, entry->g_tbls, entry->tblsz);
+   pthread_mutex_unlock(&dcache->lock);
+   return 1;
+}
+
+/**
+ * Insert the current decode tables of the given handle into the context cache, evicting the least recently used
+ * entry if necessary
+ * @param ne_handle handle : Handle with freshly generated decode_index and g_tbls
+ * @param unsigned char* in_err : Error pattern of all N+E blocks
+ * @param int nerrs : Number of erred blocks
+ */
+static void decode_cache_insert(ne_handle handle, const unsigned char* in_err, int nerrs) {
+   decode_cache* dcache = &(handle->ctxt->dcache);
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   size_t tblsz = (size_t)N * nerrs * 32;
+   // allocate the entry and all of its arrays at once
+   decode_table* entry = malloc(sizeof(struct decode_table_struct) + (2 * (N + E)) + tblsz);
+   if (entry == NULL) {
+      LOG(LOG_WARNING, "Failed to allocate a decode cache entry ( tables will not be cached )\n");
+      return;
+   }
+   entry->N = N;
+   entry->E = E;
+   entry->in_err = (unsigned char*)(entry + 1);
+   entry->decode_index = entry->in_err + (N + E);
+   entry->g_tbls = entry->decode_index + (N + E);
+   entry->tblsz = tblsz;
+   memcpy(entry->in_err, in_err, N + E);
+   memcpy(entry->decode_index, handle->decode_index, N + E);
+   memcpy(entry->g_tbls, handle->g_tbls, tblsz);
+   entry->prev = NULL;
+   pthread_mutex_lock(&dcache->lock);
+   entry->next = dcache->head;
+   if (dcache->head) {
+      dcache->head->prev = entry;
+   }
+   else {
+      dcache->tail = entry;
+   }
+   dcache->head = entry;
+   dcache->count++;
+   decode_table* evicted = NULL;
+   if (dcache->count > DECODE_CACHE_SIZE) {
+      evicted = dcache->tail;
+      dcache->tail = evicted->prev;
+      dcache->tail->next = NULL;
+      dcache->count--;
+   }
+   pthread_mutex_unlock(&dcache->lock);
+   free(evicted);
+}
+
+/**
+ * Retrieve the next ioblock of a block queue for a hedged read, discarding any stale ioblocks which
+ * earlier stripes were reconstructed without
+ * @param ne_handle handle : Handle to retrieve the ioblock for
+ * @param int block : Index of the block
+ * @param const struct timespec* abstime : Time at which to stop waiting for the ioblock
+ *                                         ( NULL to only retrieve an ioblock which is already queued )
+ * @return int : One if handle->iob[block] was populated, zero if no ioblock is yet available, and -1 on failure
+ */
+static int hedge_take_ioblock(ne_handle handle, int block, const struct timespec* abstime) {
+   hedge_state* hedge = handle->hedge;
+   ThreadQueue tq = handle->thread_queues[block];
+   while (1) {
+      ioblock* iob = NULL;
+      int depth;
+      errno = 0;
+      if (abstime) {
+         depth = tq_dequeue_timed(tq, TQ_HALT, (void**)&iob, abstime);
+      }
+      else if ((depth = tq_depth(tq)) > 0) {
+         depth = tq_dequeue(tq, TQ_HALT, (void**)&iob);
+      }
+      if (depth < 0) {
+         LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", block);
+         errno = EBADF;
+         return -1;
+      }
+      if (iob == NULL) {
+         if (abstime && errno != ETIMEDOUT) {
+            LOG(LOG_WARNING, "Queue of block %d has finished, and will produce no further ioblocks\n", block);
+            hedge->dead[block] = 1;
+         }
+         return 0;
+      }
+      if (hedge->lag[block] == 0) {
+         handle->iob[block] = iob;
+         return 1;
+      }
+      // this ioblock belongs to a stripe we have already moved beyond
+      LOG(LOG_INFO, "Discarding stale ioblock of block %d ( %d remain )\n", block, hedge->lag[block] - 1);
+      if (release_ioblock(handle->thread_states[block].ioq)) {
+         LOG(LOG_ERR, "Failed to release stale ioblock of block %d!\n", block);
+         errno = EBADF;
+         return -1;
+      }
+      hedge->lag[block]--;
+   }
+}
+
+/**
+ * Resume reading from a block which was previously avoided, due to its scoreboard history or excessive lag
+ * @param ne_handle handle : Handle to resume the block of
+ * @param int block : Index of the block
+ * @return int : Zero on success, and -1 on failure
+ */
+static int revive_skipped_block(ne_handle handle, int block) {
+   LOG(LOG_WARNING, "Resuming reads of avoided block %d, to cope with additional errors\n", block);
+   ThreadQueue tq = handle->thread_queues[block];
+   ioblock* iob = NULL;
+   // a block halted for lagging may still be stuck waiting for ioqueue elements
+   if (tq_dequeue(tq, TQ_HALT, (void**)&iob) > 0 && iob != NULL) {
+      release_ioblock(handle->thread_states[block].ioq);
+   }
+   if (tq_wait_for_pause(tq)) {
+      LOG(LOG_ERR, "Failed to verify that thread %d paused, prior to restarting\n", block);
+      errno = EBADF;
+      return -1;
+   }
+   // discard any stale ioblocks it produced before halting
+   int depth = tq_depth(tq);
+   while (depth > 0) {
+      iob = NULL;
+      if ((depth = tq_dequeue(tq, TQ_HALT, (void**)&iob)) < 0) {
+         LOG(LOG_ERR, "Failed to dequeue from HALTED thread_queue %d!\n", block);
+         errno = EBADF;
+         return -1;
+      }
+      if (iob != NULL) {
+         release_ioblock(handle->thread_states[block].ioq);
+      }
+      depth--; // decrement, as dequeue depth includes the returned element
+   }
+   handle->thread_states[block].offset = handle->iob_offset;
+   if (tq_unset_flags(handle->thread_queues[block], TQ_HALT)) {
+      LOG(LOG_ERR, "Failed to clear PAUSE state for block %d!\n", block);
+      errno = EBADF;
+      return -1;
+   }
+   handle->hedge->skip[block] = 0;
+   handle->hedge->dead[block] = 0;
+   handle->hedge->lag[block] = 0;
+   return 0;
+}
+
+/**
+ * Populate the ioblocks of all N+E blocks for a hedged ( NE_RDHEDGE ) read, or for a read which avoids suspect
+ *  blocks.  This returns as soon as every data block has arrived intact, or once the stripes could be
+ *  reconstructed and missing data blocks have failed to arrive within the hedge delay ( only NE_RDHEDGE handles
+ *  proceed without every live block ).  Any block which has not yet arrived is stood in for by a substitute
+ *  ioblock, marked as entirely erroneous, and its late ioblock is discarded by a later call.  Avoided blocks are
+ *  resumed only if the stripes could not otherwise be reconstructed.
+ * @param ne_handle handle : Handle to populate ioblocks for
+ * @return int : Number of erroneous ioblocks, or -1 on failure
+ */
+static int hedge_gather_ioblocks(ne_handle handle) {
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   hedge_state* hedge = handle->hedge;
+   char deadline_set = 0;
+   struct timespec deadline;
+   int cur_block;
+   while (1) {
+      // collect any ioblocks which have already arrived
+      int arrived = 0;
+      int erred = 0;
+      int lost = 0;
+      int data_ready = 0;
+      for (cur_block = 0; cur_block < N + E; cur_block++) {
+         if (handle->iob[cur_block] == NULL && !(hedge->dead[cur_block]) &&
+             hedge_take_ioblock(handle, cur_block, NULL) < 0) {
+            return -1;
+         }
+         if (handle->iob[cur_block] == NULL) {
+            if (hedge->dead[cur_block]) {
+               lost++;
+            }
+            continue;
+         }
+         arrived++;
+         if (handle->iob[cur_block]->error_end > 0) {
+            erred++;
+         }
+         else if (cur_block < N) {
+            data_ready++;
+         }
+      }
+      // errors include erroneous ioblocks, as well as any ioblocks we still lack
+      int nerrs = (N + E) - arrived + erred;
+      if (data_ready == N) {
+         break; // all data is intact
+      }
+      if (erred + lost > E) {
+         // we certainly cannot reconstruct, unless we resume reading an avoided block
+         for (cur_block = 0; cur_block < N + E && !(hedge->skip[cur_block]); cur_block++) {}
+         if (cur_block < N + E) {
+            if (revive_skipped_block(handle, cur_block)) {
+               return -1;
+            }
+            continue;
+         }
+      }
+      struct timespec now;
+      clock_gettime(CLOCK_REALTIME, &now);
+      if (nerrs <= E && handle->mode == NE_RDHEDGE) {
+         // we could reconstruct now, but prefer to await data blocks for a short while
+         if (!(deadline_set)) {
+            deadline = now;
+            deadline.tv_nsec += (long)(handle->ctxt->hedge_delay % 1000000) * 1000;
+            deadline.tv_sec += (handle->ctxt->hedge_delay / 1000000) + (deadline.tv_nsec / 1000000000);
+            deadline.tv_nsec %= 1000000000;
+            deadline_set = 1;
+         }
+         if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec)) {
+            LOG(LOG_INFO, "Proceeding with %d of %d data blocks, after hedge delay\n", data_ready, N);
+            break;
+         }
+      }
+      // select a block to wait on, preferring data blocks
+      int wait_block = -1;
+      for (cur_block = 0; cur_block < N + E; cur_block++) {
+         if (handle->iob[cur_block] == NULL && !(hedge->dead[cur_block])) {
+            wait_block = cur_block;
+            break;
+         }
+      }
+      if (wait_block < 0) {
+         break; // no further ioblocks will ever arrive
+      }
+      // wait for that block, but recheck all others periodically
+      struct timespec abstime = now;
+      abstime.tv_nsec += HEDGE_POLL_USEC * 1000;
+      abstime.tv_sec += abstime.tv_nsec / 1000000000;
+      abstime.tv_nsec %= 1000000000;
+      if (deadline_set && (deadline.tv_sec < abstime.tv_sec ||
+          (deadline.tv_sec == abstime.tv_sec && deadline.tv_nsec < abstime.tv_nsec))) {
+         abstime = deadline;
+      }
+      if (hedge_take_ioblock(handle, wait_block, &abstime) < 0) {
+         return -1;
+      }
+   }
+
+   // make sure our ioblock sizes are consistent
+   for (cur_block = 0; cur_block < N + E; cur_block++) {
+      ioblock* cur_iob = handle->iob[cur_block];
+      if (cur_iob == NULL) {
+         continue;
+      }
+      if (handle->iob_datasz == 0) {
+         handle->iob_datasz = cur_iob->data_size;
+      }
+      else if (cur_iob->data_size != handle->iob_datasz) {
+         LOG(LOG_ERR, "Detected a ioblock of size %zd from block %d which conflicts with expected value of %zd!\n",
+            cur_iob->data_size, cur_block, handle->iob_datasz);
+         errno = EBADF;
+         return -1;
+      }
+   }
+   if (handle->iob_datasz == 0) {
+      LOG(LOG_ERR, "Failed to retrieve any ioblocks!\n");
+      errno = ENODATA;
+      return -1;
+   }
+
+   // stand in for any blocks we are missing
+   int nerrs = 0;
+   for (cur_block = 0; cur_block < N + E; cur_block++) {
+      if (handle->iob[cur_block] == NULL) {
+         ioblock* sub = &(hedge->sub[cur_block]);
+         if (sub->buff == NULL) {
+            sub->buff = malloc(handle->thread_states[cur_block].ioq->blocksz);
+            if (sub->buff == NULL) {
+               LOG(LOG_ERR, "Failed to allocate a substitute ioblock buffer for block %d!\n", cur_block);
+               return -1;
+            }
+         }
+         sub->data_size = handle->iob_datasz;
+         sub->error_end = handle->iob_datasz;
+         handle->iob[cur_block] = sub;
+         hedge->insub[cur_block] = 1;
+         if (!(hedge->dead[cur_block])) {
+            hedge->lag[cur_block]++;
+         }
+         LOG(LOG_INFO, "Reconstructing without block %d ( lag = %d )\n", cur_block, hedge->lag[cur_block]);
+         // a block lagging by more than its ioqueue can hold will never catch up, so stop reading it
+         //  ( it may still be resumed, if the stripes could not otherwise be reconstructed )
+         if (hedge->lag[cur_block] > handle->ctxt->iodepth) {
+            LOG(LOG_WARNING, "Halting block %d, which lags by %d ioblocks\n", cur_block, hedge->lag[cur_block]);
+            if (tq_set_flags(handle->thread_queues[cur_block], TQ_HALT)) {
+               LOG(LOG_ERR, "Failed to set HALT state for block %d!\n", cur_block);
+               errno = EBADF;
+               return -1;
+            }
+            hedge->skip[cur_block] = 1;
+            hedge->dead[cur_block] = 1;
+            hedge->lag[cur_block] = 0;
+         }
+      }
+      if (handle->iob[cur_block]->error_end > 0) {
+         nerrs++;
+      }
+   }
+   return nerrs;
+}
+
 /**
  *
  *
@@ -667,13 +1488,16 @@ int read_stripes(ne_handle handle) {
    handle->iob_datasz = 0;
 
    // if we have previous block references, we'll need to release them
+   // NOTE -- a reseek drops only the references of running threads, so those of halted erasure threads may remain
    int i;
-   for (i = 0; i < handle->epat.N + handle->epat.E && handle->iob[i] != NULL; i++) {
-      if (release_ioblock(handle->thread_states[i].ioq)) {
+   for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
+      if (handle->iob[i] == NULL) {
+         continue;
+      }
+      if (drop_handle_ioblock(handle, i)) {
          LOG(LOG_ERR, "Failed to release ioblock reference for block %d!\n", i);
          return -1;
       }
-      handle->iob[i] = NULL; // NULL out this outdated reference
    }
 
    // ---------------------- VERIFY INTEGRITY OF ALL BLOCKS IN STRIPE ----------------------
@@ -690,70 +1514,86 @@ int read_stripes(ne_handle handle) {
    int cur_block;
    int stripecnt = 0;
    int nstripe_errors = 0;
-   for (cur_block = 0; (cur_block < (N + nstripe_errors) || cur_block < (N + handle->ethreads_running)) && cur_block < (N + E); cur_block++) {
-      // if this thread isn't running, we need to start it
-      if (cur_block >= N + handle->ethreads_running) {
-         LOG(LOG_INFO, "Starting up thread %d to cope with errors beyond stripe %d\n", cur_block, start_stripe);
-         // first, make sure to empty any ioblocks still on the queue
-         while (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void**)&(handle->iob[cur_block])) > 0) {
-            LOG(LOG_INFO, "Releasing ioblock from queue %d, prior to reseek\n", cur_block);
-            if (release_ioblock(handle->thread_states[cur_block].ioq)) {
-               LOG(LOG_ERR, "Failed to release ioblock from queue %d\n", cur_block);
-               errno = EBADF;
-               return -1;
-            }
-         }
-         if ( tq_wait_for_pause( handle->thread_queues[cur_block] ) ) {
-            LOG( LOG_ERR, "Failed to verify that thread %d paused, prior to restarting\n", cur_block );
-            errno = EBADF;
-            return -1;
-         }
-         handle->thread_states[cur_block].offset = handle->iob_offset; // set offset for this read thread
-         if (tq_unset_flags(handle->thread_queues[cur_block], TQ_HALT)) {
-            LOG(LOG_ERR, "Failed to clear PAUSE state for block %d!\n", cur_block);
-            errno = EBADF;
-            return -1;
-         }
-         handle->ethreads_running++;
-      }
-      // retrieve a new ioblock from this thread
-      if (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void**)&(handle->iob[cur_block])) < 0) {
-         LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", cur_block);
-         errno = EBADF;
+   if (handle->hedge) {
+      // reconstruct from whichever blocks arrive first, or without any avoided blocks
+      nstripe_errors = hedge_gather_ioblocks(handle);
+      if (nstripe_errors < 0) {
          return -1;
       }
-      LOG(LOG_INFO, "Dequeued ioblock at position %d\n", cur_block);
-      // check if this new ioblock will require a rebuild
-      ioblock* cur_iob = handle->iob[cur_block];
-      if (cur_iob->error_end > 0) {
-         LOG(LOG_ERR, "Detected an error at offset %zu of ioblock %d\n", cur_iob->error_end, cur_block);
-         nstripe_errors++;
-      }
-      // check if we can even handle however many errors we've hit so far
       if (nstripe_errors > E) {
          LOG(LOG_ERR, "Data beyond stripe %d has too many errors (%d) to be recovered\n", start_stripe, nstripe_errors);
          errno = ENODATA;
          return -1;
       }
-      // make sure our ioblock sizes are consistent
-      if (handle->iob_datasz) {
-         if (cur_iob->data_size != handle->iob_datasz) {
-            LOG(LOG_ERR, "Detected a ioblock of size %zd from block %d which conflicts with expected value of %zd!\n",
-               cur_iob->data_size, cur_block, handle->iob_datasz);
+      stripecnt = (handle->iob_datasz / partsz);
+      cur_block = N + E;
+   }
+   else {
+      for (cur_block = 0; (cur_block < (N + nstripe_errors) || cur_block < (N + handle->ethreads_running)) && cur_block < (N + E); cur_block++) {
+         // if this thread isn't running, we need to start it
+         if (cur_block >= N + handle->ethreads_running) {
+            LOG(LOG_INFO, "Starting up thread %d to cope with errors beyond stripe %d\n", cur_block, start_stripe);
+            // first, make sure to empty any ioblocks still on the queue
+            while (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void**)&(handle->iob[cur_block])) > 0) {
+               LOG(LOG_INFO, "Releasing ioblock from queue %d, prior to reseek\n", cur_block);
+               if (release_ioblock(handle->thread_states[cur_block].ioq)) {
+                  LOG(LOG_ERR, "Failed to release ioblock from queue %d\n", cur_block);
+                  errno = EBADF;
+                  return -1;
+               }
+            }
+            if ( tq_wait_for_pause( handle->thread_queues[cur_block] ) ) {
+               LOG( LOG_ERR, "Failed to verify that thread %d paused, prior to restarting\n", cur_block );
+               errno = EBADF;
+               return -1;
+            }
+            handle->thread_states[cur_block].offset = handle->iob_offset; // set offset for this read thread
+            if (tq_unset_flags(handle->thread_queues[cur_block], TQ_HALT)) {
+               LOG(LOG_ERR, "Failed to clear PAUSE state for block %d!\n", cur_block);
+               errno = EBADF;
+               return -1;
+            }
+            handle->ethreads_running++;
+         }
+         // retrieve a new ioblock from this thread
+         if (tq_dequeue(handle->thread_queues[cur_block], TQ_HALT, (void**)&(handle->iob[cur_block])) < 0) {
+            LOG(LOG_ERR, "Failed to retrieve new buffer for block %d!\n", cur_block);
             errno = EBADF;
             return -1;
          }
+         LOG(LOG_INFO, "Dequeued ioblock at position %d\n", cur_block);
+         // check if this new ioblock will require a rebuild
+         ioblock* cur_iob = handle->iob[cur_block];
+         if (cur_iob->error_end > 0) {
+            LOG(LOG_ERR, "Detected an error at offset %zu of ioblock %d\n", cur_iob->error_end, cur_block);
+            nstripe_errors++;
+         }
+         // check if we can even handle however many errors we've hit so far
+         if (nstripe_errors > E) {
+            LOG(LOG_ERR, "Data beyond stripe %d has too many errors (%d) to be recovered\n", start_stripe, nstripe_errors);
+            errno = ENODATA;
+            return -1;
+         }
+         // make sure our ioblock sizes are consistent
+         if (handle->iob_datasz) {
+            if (cur_iob->data_size != handle->iob_datasz) {
+               LOG(LOG_ERR, "Detected a ioblock of size %zd from block %d which conflicts with expected value of %zd!\n",
+                  cur_iob->data_size, cur_block, handle->iob_datasz);
+               errno = EBADF;
+               return -1;
+            }
+         }
+         else {
+            stripecnt = (cur_iob->data_size / partsz);
+            handle->iob_datasz = cur_iob->data_size;
+         } // or set it, if we haven't yet
       }
-      else {
-         stripecnt = (cur_iob->data_size / partsz);
-         handle->iob_datasz = cur_iob->data_size;
-      } // or set it, if we haven't yet
    }
 
    int block_cnt = cur_block;
 
    // if we'er trying to avoid unnecessary reads, halt excess erasure threads
-   if (handle->mode == NE_RDONLY) {
+   if (handle->mode == NE_RDONLY && handle->hedge == NULL) {
       // keep the greater of how many erasure threads we've needed in the last couple of stripes...
       if (nstripe_errors > handle->prev_err_cnt)
          handle->prev_err_cnt = nstripe_errors;
@@ -817,6 +1657,12 @@ int read_stripes(ne_handle handle) {
          }
 
 
+         // reuse the decode tables of any previous encounter with this error pattern
+         if (!(handle->e_ready) && decode_cache_lookup(handle, stripe_in_err)) {
+            LOG(LOG_INFO, "Reusing cached erasure tables ( nstripe_errors = %d )\n", nstripe_errors);
+            handle->e_ready = 1;
+         }
+
          if (!(handle->e_ready)) {
 
             LOG(LOG_INFO, "Initializing erasure structs...\n");
@@ -829,15 +1675,7 @@ int read_stripes(ne_handle handle) {
                return -1;
             }
 
-            // critical section : we are now going to call some inlined assembly erasure funcs
-            if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to acquire erasurelock prior to table generation for stripe %d\n", cur_stripe + start_stripe );
-               free(tmpmatrix);
-               free( stripe_err_list );
-               free( stripe_in_err );
-               return -1;
-            }
-
+            // NOTE -- all erasure structs are private to this handle, so no locking is required
             // Generate an encoding matrix
             gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
 
@@ -850,7 +1688,6 @@ int read_stripes(ne_handle handle) {
             if (ret_code != 0) {
                // this is the only error for which we will at least attempt to continue
                LOG(LOG_ERR, "Failure to generate decode matrix, errors may exceed erasure limits (%d)!\n", nstripe_errors);
-               pthread_mutex_unlock( handle->ctxt->erasurelock );
                free(tmpmatrix);
                free(stripe_in_err);
                free(stripe_err_list);
@@ -861,16 +1698,8 @@ int read_stripes(ne_handle handle) {
 
             LOG(LOG_INFO, "Initializing erasure tables ( nstripe_errors = %d )\n", nstripe_errors);
             ec_init_tables(N, nstripe_errors, handle->decode_matrix, handle->g_tbls);
-
-            // exiting critical section
-            if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to relinquish erasurelock after table generation for stripe %d\n", cur_stripe + start_stripe );
-               free(tmpmatrix);
-               free( stripe_err_list );
-               free( stripe_in_err );
-               return -1;
-            }
             free(tmpmatrix);
+            decode_cache_insert(handle, stripe_in_err, nstripe_errors);
 
             handle->e_ready = 1; //indicate that rebuild structures are initialized
          }
@@ -913,23 +1742,7 @@ int read_stripes(ne_handle handle) {
          }
 
          LOG(LOG_INFO, "Performing regeneration of stripe %d from erasure\n", cur_stripe + start_stripe);
-         // critical section : we are now going to call some inlined assembly erasure funcs
-         if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-            LOG( LOG_ERR, "Failed to acquire erasurelock prior to regeneration of stripe %d\n", cur_stripe + start_stripe );
-            free(recov);
-            free( stripe_err_list );
-            free( stripe_in_err );
-            return -1;
-         }
          ec_encode_data(partsz, N, nstripe_errors, handle->g_tbls, recov, &temp_buffs[0]);
-         // exiting critical section
-         if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-            LOG( LOG_ERR, "Failed to relinquish erasurelock after regeneration of stripe %d\n", cur_stripe + start_stripe );
-            free(recov);
-            free( stripe_err_list );
-            free( stripe_in_err );
-            return -1;
-         }
 
          free(recov);
          free(temp_buffs);
@@ -951,17 +1764,19 @@ int read_stripes(ne_handle handle) {
  * This fucntion is intended primarily for use with test utilities and commandline tools.
  * @param const char* path : The complete path template for the erasure stripe
  * @param ne_location max_loc : The maximum pod/cap/scatter values for this context
- * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
- *                                       If NULL, libne will create such a lock internally.  In such a case,
- *                                       the internal lock will continue to protect multi-threaded programs
- *                                       ONLY if they exclusively use a single ne_ctxt at a time.
- *                                       Multi-threaded programs using multiple ne_ctxt references in parallel
- *                                       MUST create + initialize their own pthread_mutex and pass it into
- *                                       ALL ne_init*() calls.
+ * @param pthread_mutex_t* erasurelock : Ignored; retained only for interface compatibility.
+ *                                       isa-l routines are initialized exactly once per process and all
+ *                                       erasure structures are private to each ne_handle, so concurrent
+ *                                       handles ( from one or many ne_ctxt references ) encode in parallel.
  * @return ne_ctxt : The initialized ne_ctxt or NULL if an error occurred
  */
 ne_ctxt ne_path_init(const char* path, ne_location max_loc, int max_block, pthread_mutex_t* erasurelock) {
+   // perform any one-time erasure initialization
+   if (erasure_init()) {
+      LOG(LOG_ERR, "Failed to initialize erasure routines\n");
+      return NULL;
+   }
+
    // create a stand-in XML config
    char* configtemplate = "<DAL type=\"posix\"><dir_template>%s</dir_template><sec_root></sec_root></DAL>";
    int len = strlen(path) + strlen(configtemplate);
@@ -1014,19 +1829,23 @@ ne_ctxt ne_path_init(const char* path, ne_location max_loc, int max_block, pthre
 
    // fill in context elements
    ctxt->max_block = max_block;
+   ctxt->iodepth = SUPER_BLOCK_CNT;
+   ctxt->hedge_delay = HEDGE_DELAY_USEC;
+   ctxt->numa_node = dal->numa_node;
    ctxt->dal = dal;
-   // verify or create our erasurelock
-   if ( erasurelock ) {
-      ctxt->erasurelock = erasurelock;
+   if (pthread_mutex_init(&(ctxt->dcache.lock), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize decode cache lock\n");
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      free(ctxt);
+      return NULL;
    }
-   else {
-      if ( pthread_mutex_init( &(ctxt->locallock), NULL ) ) {
-         LOG( LOG_ERR, "failed to intialize internal erasurelock\n" );
-         free( ctxt );
-         dal->cleanup(dal); // cleanup our DAL context, ignoring errors
-         return NULL;
-      }
-      ctxt->erasurelock = &(ctxt->locallock);
+   ctxt->sboard = create_scoreboard();
+   if (ctxt->sboard == NULL) {
+      LOG(LOG_ERR, "Failed to create a location scoreboard\n");
+      pthread_mutex_destroy(&(ctxt->dcache.lock));
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      free(ctxt);
+      return NULL;
    }
 
    // return the new ne_ctxt
@@ -1039,17 +1858,19 @@ ne_ctxt ne_path_init(const char* path, ne_location max_loc, int max_block, pthre
  * @param ne_location max_loc : ne_location struct containing maximum allowable pod/cap/scatter
  *                              values for this context
  * @param int max_block : Integer maximum block value ( N + E ) for this context
- * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
- *                                       If NULL, libne will create such a lock internally.  In such a case,
- *                                       the internal lock will continue to protect multi-threaded programs
- *                                       ONLY if they exclusively use a single ne_ctxt at a time.
- *                                       Multi-threaded programs using multiple ne_ctxt references in parallel
- *                                       MUST create + initialize their own pthread_mutex and pass it into
- *                                       ALL ne_init*() calls.
+ * @param pthread_mutex_t* erasurelock : Ignored; retained only for interface compatibility.
+ *                                       isa-l routines are initialized exactly once per process and all
+ *                                       erasure structures are private to each ne_handle, so concurrent
+ *                                       handles ( from one or many ne_ctxt references ) encode in parallel.
  * @return ne_ctxt : New ne_ctxt or NULL if an error was encountered
  */
 ne_ctxt ne_init(xmlNode* dal_root, ne_location max_loc, int max_block, pthread_mutex_t* erasurelock) {
+   // perform any one-time erasure initialization
+   if (erasure_init()) {
+      LOG(LOG_ERR, "Failed to initialize erasure routines\n");
+      return NULL;
+   }
+
    // Initialize a DAL instance
    DAL_location maxdal = { .pod = max_loc.pod, .block = max_block - 1, .cap = max_loc.cap, .scatter = max_loc.scatter };
    DAL dal = init_dal(dal_root, maxdal);
@@ -1058,32 +1879,67 @@ ne_ctxt ne_init(xmlNode* dal_root, ne_location max_loc, int max_block, pthread_m
       LOG(LOG_ERR, "DAL instance failed to properly initialize!\n");
       return NULL;
    }
-
-   // allocate a new context struct
-   ne_ctxt ctxt = calloc( 1, sizeof(struct ne_ctxt_struct) );
-   if (ctxt == NULL) {
-      LOG(LOG_ERR, "failed to allocate memory for a new ne_ctxt struct!\n");
+   // Verify that any requested IO depth is usable
+   if (dal->io_depth != 0 && (dal->io_depth < 2 || dal->io_depth > IOQUEUE_MAX_DEPTH)) {
+      LOG(LOG_ERR, "DAL iodepth of %d is outside the allowable range of 2 to %d\n", dal->io_depth, IOQUEUE_MAX_DEPTH);
       dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      errno = EINVAL;
       return NULL;
    }
-
-   // verify or create our erasurelock
-   if ( erasurelock ) {
-      ctxt->erasurelock = erasurelock;
+#ifndef HAVE_IGZIP
+   // Verify that any requested compression is usable
+   if (dal->compress >= 0) {
+      LOG(LOG_ERR, "DAL requests block compression, but libne was built without isa-l igzip support\n");
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      errno = ENOTSUP;
+      return NULL;
    }
-   else {
-      if ( pthread_mutex_init( &(ctxt->locallock), NULL ) ) {
-         LOG( LOG_ERR, "failed to intialize internal erasurelock\n" );
-         free( ctxt );
+#endif
+   // Verify that any requested NUMA placement is usable
+   if (dal->numa_node >= 0) {
+#ifdef HAVE_LIBNUMA
+      if (numa_available() < 0 || dal->numa_node > numa_max_node()) {
+         LOG(LOG_ERR, "DAL requests placement on NUMA node %d, which is not available\n", dal->numa_node);
          dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+         errno = EINVAL;
          return NULL;
       }
-      ctxt->erasurelock = &(ctxt->locallock);
+#else
+      LOG(LOG_ERR, "DAL requests NUMA placement, but libne was built without libnuma support\n");
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      errno = ENOTSUP;
+      return NULL;
+#endif
+   }
+
+   // allocate a new context struct
+   ne_ctxt ctxt = calloc( 1, sizeof(struct ne_ctxt_struct) );
+   if (ctxt == NULL) {
+      LOG(LOG_ERR, "failed to allocate memory for a new ne_ctxt struct!\n");
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      return NULL;
    }
 
    // fill in context values and return
    ctxt->max_block = max_block;
+   ctxt->iodepth = (dal->io_depth) ? dal->io_depth : SUPER_BLOCK_CNT;
+   ctxt->hedge_delay = HEDGE_DELAY_USEC;
+   ctxt->numa_node = dal->numa_node;
    ctxt->dal = dal;
+   if (pthread_mutex_init(&(ctxt->dcache.lock), NULL)) {
+      LOG(LOG_ERR, "Failed to initialize decode cache lock\n");
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      free(ctxt);
+      return NULL;
+   }
+   ctxt->sboard = create_scoreboard();
+   if (ctxt->sboard == NULL) {
+      LOG(LOG_ERR, "Failed to create a location scoreboard\n");
+      pthread_mutex_destroy(&(ctxt->dcache.lock));
+      dal->cleanup(dal); // cleanup our DAL context, ignoring errors
+      free(ctxt);
+      return NULL;
+   }
 
    return ctxt;
 }
@@ -1099,6 +1955,69 @@ int ne_verify(ne_ctxt ctxt, char fix) {
    return ctxt->dal->verify(ctxt->dal->ctxt, fix);
 }
 
+/**
+ * Set the time for which NE_RDHEDGE handles of the given ne_ctxt will wait on data blocks, once the
+ * stripe could instead be reconstructed from the blocks which have already arrived
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param unsigned int usec : Delay in microseconds ( zero to always reconstruct from the first blocks to arrive )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_hedge_delay(ne_ctxt ctxt, unsigned int usec) {
+   if (ctxt == NULL) {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   ctxt->hedge_delay = usec;
+   return 0;
+}
+
+/**
+ * Export the health history of all block locations accessed via the given ne_ctxt
+ * NOTE -- read handles of the ne_ctxt will avoid block locations which this history indicates are
+ *         failing or unusually slow, reconstructing their data from erasure instead
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to export the history of
+ * @param ne_location_score* scores : Array to be populated with location histories ( may be NULL if max is zero )
+ * @param size_t max : Maximum number of entries to populate
+ * @return size_t : Total number of tracked locations ( may exceed 'max' )
+ */
+size_t ne_get_scoreboard(ne_ctxt ctxt, ne_location_score* scores, size_t max) {
+   if (ctxt == NULL) {
+      LOG(LOG_ERR, "Received a NULL ne_ctxt argument!\n");
+      errno = EINVAL;
+      return 0;
+   }
+   location_score* lscores = NULL;
+   if (max && scores) {
+      lscores = malloc(sizeof(location_score) * max);
+      if (lscores == NULL) {
+         LOG(LOG_ERR, "Failed to allocate space for %zu location scores\n", max);
+         return 0;
+      }
+   }
+   else {
+      max = 0;
+   }
+   size_t count = scoreboard_export(ctxt->sboard, lscores, max);
+   size_t i;
+   for (i = 0; i < count && i < max; i++) {
+      scores[i].loc.pod = lscores[i].loc.pod;
+      scores[i].loc.cap = lscores[i].loc.cap;
+      scores[i].loc.scatter = lscores[i].loc.scatter;
+      scores[i].block = lscores[i].loc.block;
+      scores[i].read_latency = lscores[i].read_latency;
+      scores[i].write_latency = lscores[i].write_latency;
+      scores[i].error_rate = lscores[i].error_rate;
+      scores[i].reads = lscores[i].reads;
+      scores[i].writes = lscores[i].writes;
+      scores[i].errors = lscores[i].errors;
+      scores[i].last_update = lscores[i].last_update;
+      scores[i].last_failure = lscores[i].last_failure;
+   }
+   free(lscores);
+   return count;
+}
+
 /**
  * Destroys an existing ne_ctxt
  * @param ne_ctxt ctxt : Reference to the ne_ctxt to be destroyed
@@ -1110,16 +2029,50 @@ int ne_term(ne_ctxt ctxt) {
       LOG(LOG_ERR, "failed to cleanup DAL context!\n");
       return -1;
    }
-   // potentially cleanup our local lock
-   if ( ctxt->erasurelock == &(ctxt->locallock) ) {
-      pthread_mutex_destroy( ctxt->erasurelock );
+   // free all cached decode tables
+   decode_table* entry = ctxt->dcache.head;
+   while (entry != NULL) {
+      decode_table* next = entry->next;
+      free(entry);
+      entry = next;
    }
+   pthread_mutex_destroy(&(ctxt->dcache.lock));
+   destroy_scoreboard(ctxt->sboard);
    free(ctxt);
    return 0;
 }
 
 // ---------------------- PER-OBJECT FUNCTIONS ----------------------
 
+// repeatedly claim and issue the next outstanding block deletion, until none remain
+static void* delete_batch_thread(void* arg) {
+   delete_batch* batch = (delete_batch*)arg;
+   ne_ctxt ctxt = batch->ctxt;
+   size_t total = batch->count * ctxt->max_block;
+   pthread_mutex_lock(&batch->lock);
+   while (batch->nextdel < total) {
+      size_t curdel = batch->nextdel;
+      batch->nextdel++;
+      pthread_mutex_unlock(&batch->lock);
+
+      ne_delete_target* tgt = batch->targets + (curdel / ctxt->max_block);
+      DAL_location dalloc = { .pod = tgt->loc.pod, .block = (int)(curdel % ctxt->max_block), .cap = tgt->loc.cap, .scatter = tgt->loc.scatter };
+      int delerr = 0;
+      if (ctxt->dal->del(ctxt->dal->ctxt, dalloc, tgt->objID)) {
+         LOG(LOG_ERR, "Failed to delete block %d of object \"%s\"!\n", dalloc.block, tgt->objID);
+         delerr = (errno) ? errno : EIO;
+      }
+
+      pthread_mutex_lock(&batch->lock);
+      // any error other than ENOENT takes precedence
+      if (delerr && (tgt->status == 0 || tgt->status == ENOENT)) {
+         tgt->status = delerr;
+      }
+   }
+   pthread_mutex_unlock(&batch->lock);
+   return NULL;
+}
+
 /**
  * Delete a given object
  * @param ne_ctxt ctxt : The ne_ctxt used to access this data stripe
@@ -1128,31 +2081,201 @@ int ne_term(ne_ctxt ctxt) {
  * @return int : Zero on success and -1 on failure
  */
 int ne_delete(ne_ctxt ctxt, const char* objID, ne_location loc) {
+   LOG(LOG_INFO, "Deleting object %s (%d blocks)\n", objID, (ctxt) ? ctxt->max_block : 0);
+   ne_delete_target tgt = { .objID = objID, .loc = loc, .status = 0 };
+   int retval = ne_delete_batch(ctxt, &tgt, 1, 0);
+   if (retval > 0) {
+      errno = tgt.status;
+      return -1;
+   }
+   return retval;
+}
+
+/**
+ * Delete a list of objects, issuing block deletions for all of them concurrently
+ * @param ne_ctxt ctxt : The ne_ctxt used to access these data stripes
+ * @param ne_delete_target* targets : List of objects to be deleted ( the 'status' of each will be populated )
+ * @param size_t count : Number of elements in the targets list
+ * @param int max_parallel : Maximum number of concurrent block deletions ( zero for the libne default )
+ * @return int : Number of targets which failed to be deleted ( see their 'status' values ), or -1 on failure
+ */
+int ne_delete_batch(ne_ctxt ctxt, ne_delete_target* targets, size_t count, int max_parallel) {
    // check for NULL context
    if (ctxt == NULL) {
       LOG(LOG_ERR, "Received NULL context!\n");
       errno = EINVAL;
       return -1;
    }
-   int retval = 0;
-   DAL_location dalloc = { .pod = loc.pod, .cap = loc.cap, .scatter = loc.scatter };
-   LOG(LOG_INFO, "Deleting object %s (%d blocks)\n", objID, ctxt->max_block);
+   if (targets == NULL && count) {
+      LOG(LOG_ERR, "Received NULL targets list!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (max_parallel < 0) {
+      LOG(LOG_ERR, "Received a negative max_parallel value!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (max_parallel == 0) {
+      max_parallel = DELETE_BATCH_THREADS;
+   }
+   size_t i;
+   for (i = 0; i < count; i++) {
+      targets[i].status = 0;
+   }
+   LOG(LOG_INFO, "Deleting %zu objects (%d blocks each) with up to %d threads\n", count, ctxt->max_block, max_parallel);
 
-   // loop through and delete all blocks
-   int i;
-   for (i = 0; i < ctxt->max_block; i++) {
-      dalloc.block = i;
-      if (ctxt->dal->del(ctxt->dal->ctxt, dalloc, objID)) {
-         LOG(LOG_ERR, "Failed to delete block %d of object \"%s\"!\n", i, objID);
-         retval = -1;
+   delete_batch batch = { .ctxt = ctxt, .targets = targets, .count = count, .nextdel = 0 };
+   if (pthread_mutex_init(&batch.lock, NULL)) {
+      LOG(LOG_ERR, "Failed to initialize delete batch lock!\n");
+      return -1;
+   }
+   // the calling thread deletes as well, so only launch helpers for the remaining width
+   size_t total = count * ctxt->max_block;
+   size_t helpers = (total < (size_t)max_parallel) ? total : (size_t)max_parallel;
+   if (helpers) {
+      helpers--;
+   }
+   void** thrds = NULL;
+   if (helpers) {
+      thrds = malloc(sizeof(void*) * helpers);
+      if (thrds == NULL) {
+         LOG(LOG_WARNING, "Failed to allocate thread references ( deleting serially )\n");
+         helpers = 0;
       }
    }
+   // helpers only take spare pool slots, never waiting on those of open handles
+   helpers = iothread_pool_tryreserve((unsigned int)helpers);
+   TQ_Thread_Pool* tpool = iothread_pool();
+   size_t thrdcnt = 0;
+   for (; thrdcnt < helpers; thrdcnt++) {
+      if (tpool->launch(tpool->pool, delete_batch_thread, &batch, &(thrds[thrdcnt]))) {
+         LOG(LOG_WARNING, "Failed to launch delete thread %zu ( continuing with fewer )\n", thrdcnt);
+         break;
+      }
+   }
+   delete_batch_thread(&batch);
+   for (i = 0; i < thrdcnt; i++) {
+      tpool->collect(tpool->pool, thrds[i], NULL);
+   }
+   iothread_pool_release(helpers);
+   free(thrds);
+   pthread_mutex_destroy(&batch.lock);
 
-   return retval;
+   int failures = 0;
+   for (i = 0; i < count; i++) {
+      if (targets[i].status) {
+         failures++;
+      }
+   }
+   return failures;
 }
 
 // ---------------------- HANDLE CREATION FUNCTIONS ----------------------
 
+// return the microseconds elapsed since 'start', then reset 'start' to the current time
+static double lap_usec(struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   double elapsed = ((now.tv_sec - start->tv_sec) * 1000000.0) + ((now.tv_nsec - start->tv_nsec) / 1000.0);
+   *start = now;
+   return elapsed;
+}
+
+// repeatedly claim and probe the next unprobed block, until the probe limit is reached and no
+//  outstanding probe could widen it further
+static void* stat_probe_thread(void* arg) {
+   stat_probe* probe = (stat_probe*)arg;
+   ne_ctxt ctxt = probe->ctxt;
+   pthread_mutex_lock(&probe->lock);
+   while (probe->nextblock < probe->maxblock || probe->inflight) {
+      if (probe->nextblock >= probe->maxblock) {
+         pthread_cond_wait(&probe->progress, &probe->lock);
+         continue;
+      }
+      int curblock = probe->nextblock;
+      probe->nextblock++;
+      probe->inflight++;
+      pthread_mutex_unlock(&probe->lock);
+
+      DAL_location dloc = { .pod = probe->loc.pod, .block = curblock, .cap = probe->loc.cap, .scatter = probe->loc.scatter };
+      double opentime = 0, metatime = 0, closetime = 0, stattime = 0;
+      char meta_err = 0;
+      char data_err = 0;
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+
+      // first, we need to get a block reference
+      BLOCK_CTXT dblock = ctxt->dal->open(ctxt->dal->ctxt, DAL_METAREAD, dloc, probe->objID);
+      opentime = lap_usec(&start);
+      if (dblock == NULL) {
+         LOG(LOG_ERR, "Failed to open a DAL reference for block %d!\n", dloc.block);
+         meta_err = 1;
+      }
+      else {
+         // attempt to retrive meta info
+         if (ctxt->dal->get_meta(dblock, &(probe->minfo_list[curblock]))) {
+            LOG(LOG_WARNING, "Detected a meta error for block %d\n", curblock);
+            meta_err = 1;
+         }
+         metatime = lap_usec(&start);
+         // close our block reference
+         ctxt->dal->close(dblock);
+         closetime = lap_usec(&start);
+      }
+
+      // verify that data exists for this block
+      if (ctxt->dal->stat(ctxt->dal->ctxt, dloc, probe->objID)) {
+         data_err = 1;
+      }
+      stattime = lap_usec(&start);
+
+      pthread_mutex_lock(&probe->lock);
+      probe->inflight--;
+      probe->probed++;
+      probe->meta_errs[curblock] = meta_err;
+      probe->data_errs[curblock] = data_err;
+      ne_stat_timing* timing = probe->timing;
+      timing->probes++;
+#define STAT_PHASE(PHASE, VAL) \
+      timing->PHASE##_sum += VAL; \
+      if (VAL > timing->PHASE##_max) { timing->PHASE##_max = VAL; }
+      STAT_PHASE(open, opentime)
+      STAT_PHASE(meta, metatime)
+      STAT_PHASE(close, closetime)
+      STAT_PHASE(stat, stattime)
+#undef STAT_PHASE
+      if (!meta_err) {
+         // set a reference to the retrieved meta info
+         probe->minfo_refs[probe->valid_meta] = &(probe->minfo_list[curblock]);
+         probe->valid_meta++;
+         // get new consensus values, including this info
+         probe->match_count = check_matches(probe->minfo_refs, probe->valid_meta, ctxt->max_block, &(probe->consensus));
+         // if we have sufficient agreement, stop probing beyond the stripe width to save us some time
+         if (probe->match_count > MIN_MD_CONSENSUS) {
+            probe->final = 1;
+            probe->maxblock = probe->consensus.N + probe->consensus.E;
+            if (probe->maxblock > ctxt->max_block) {
+               probe->maxblock = ctxt->max_block;
+            }
+         }
+      }
+      // otherwise, probe one additional block for every probe which has failed to agree
+      if (!(probe->final)) {
+         int limit = MIN_MD_CONSENSUS + 1 + (probe->probed - probe->match_count);
+         if (limit > ctxt->max_block) {
+            limit = ctxt->max_block;
+         }
+         if (limit > probe->maxblock) {
+            probe->maxblock = limit;
+         }
+      }
+      pthread_cond_broadcast(&probe->progress);
+   }
+   pthread_mutex_unlock(&probe->lock);
+   return NULL;
+}
+
 /**
  * Determine the erasure structure of a given object and (optionally) produce a generic handle for it
  * @param ne_ctxt ctxt : The ne_ctxt used to access this data stripe
@@ -1161,6 +2284,10 @@ int ne_delete(ne_ctxt ctxt, const char* objID, ne_location loc) {
  * @return ne_handle : Newly created ne_handle, or NULL if an error occured
  */
 ne_handle ne_stat(ne_ctxt ctxt, const char* objID, ne_location loc) {
+   ne_stat_timing timing = {0};
+   struct timespec start;
+   clock_gettime(CLOCK_MONOTONIC, &start);
+
    // allocate space for temporary error arrays
    char* tmp_meta_errs = calloc(ctxt->max_block * 2, sizeof(char));
    if (tmp_meta_errs == NULL) {
@@ -1185,47 +2312,77 @@ ne_handle ne_stat(ne_ctxt ctxt, const char* objID, ne_location loc) {
       return NULL;
    }
 
-   // loop through all blocks, getting meta_info for each
-   int curblock = 0;
-   int valid_meta = 0;
-   int maxblock = ctxt->max_block;
-   int match_count = 0;
-   for (; curblock < maxblock; curblock++) {
-
-      DAL_location dloc = { .pod = loc.pod, .block = curblock, .cap = loc.cap, .scatter = loc.scatter };
-
-      // first, we need to get a block reference
-      BLOCK_CTXT dblock = ctxt->dal->open(ctxt->dal->ctxt, DAL_METAREAD, dloc, objID);
-      if (dblock == NULL) {
-         LOG(LOG_ERR, "Failed to open a DAL reference for block %d!\n", dloc.block);
-         tmp_meta_errs[curblock] = 1;
-      }
-      else {
-         // attempt to retrive meta info
-         if (ctxt->dal->get_meta(dblock, &(minfo_list[curblock]))) {
-            LOG(LOG_WARNING, "Detected a meta error for block %d\n", curblock);
-            tmp_meta_errs[curblock] = 1;
-         }
-         else {
-            // set a reference to the retrieved meta info
-            minfo_refs[valid_meta] = &(minfo_list[curblock]);
-            valid_meta++;
-            // get new consensus values, including this info
-            match_count = check_matches(minfo_refs, valid_meta, ctxt->max_block, &consensus);
-            // if we have sufficient agreement, update our maxblock value and save us some time
-            if (match_count > MIN_MD_CONSENSUS) {
-               maxblock = consensus.N + consensus.E;
-            }
-         }
-         // close our block reference
-         ctxt->dal->close(dblock);
+   // probe blocks concurrently, getting meta_info for each
+   //  only enough blocks to reach consensus are probed at first, as the stripe width is not yet known
+   stat_probe probe = {
+      .ctxt = ctxt,
+      .objID = objID,
+      .loc = loc,
+      .nextblock = 0,
+      .maxblock = (ctxt->max_block < MIN_MD_CONSENSUS + 1) ? ctxt->max_block : MIN_MD_CONSENSUS + 1,
+      .inflight = 0,
+      .probed = 0,
+      .final = 0,
+      .valid_meta = 0,
+      .match_count = 0,
+      .minfo_list = minfo_list,
+      .minfo_refs = minfo_refs,
+      .meta_errs = tmp_meta_errs,
+      .data_errs = tmp_data_errs,
+      .timing = &timing
+   };
+   if (pthread_mutex_init(&probe.lock, NULL)) {
+      LOG(LOG_ERR, "Failed to initialize metadata probe lock!\n");
+      free(tmp_meta_errs);
+      free(minfo_list);
+      free(minfo_refs);
+      return NULL;
+   }
+   if (pthread_cond_init(&probe.progress, NULL)) {
+      LOG(LOG_ERR, "Failed to initialize metadata probe condition!\n");
+      pthread_mutex_destroy(&probe.lock);
+      free(tmp_meta_errs);
+      free(minfo_list);
+      free(minfo_refs);
+      return NULL;
+   }
+   // the calling thread probes as well, so only launch helpers for the remaining width ( and spare pool slots )
+   int helpers = (ctxt->max_block < STAT_PROBE_THREADS) ? ctxt->max_block - 1 : STAT_PROBE_THREADS - 1;
+   helpers = (helpers > 0) ? (int)iothread_pool_tryreserve(helpers) : 0;
+   TQ_Thread_Pool* tpool = iothread_pool();
+   void* probe_thrds[STAT_PROBE_THREADS];
+   int thrdcnt = 0;
+   for (; thrdcnt < helpers; thrdcnt++) {
+      if (tpool->launch(tpool->pool, stat_probe_thread, &probe, &(probe_thrds[thrdcnt]))) {
+         LOG(LOG_WARNING, "Failed to launch metadata probe thread %d ( continuing with fewer )\n", thrdcnt);
+         break;
       }
+   }
+   timing.threads = thrdcnt + 1;
+   stat_probe_thread(&probe);
+   int i;
+   for (i = 0; i < thrdcnt; i++) {
+      tpool->collect(tpool->pool, probe_thrds[i], NULL);
+   }
+   iothread_pool_release(helpers);
+   pthread_cond_destroy(&probe.progress);
+   pthread_mutex_destroy(&probe.lock);
+   timing.probe = lap_usec(&start);
 
-      // verify that data exists for this block
-      if (ctxt->dal->stat(ctxt->dal->ctxt, dloc, objID)) {
-         tmp_data_errs[curblock] = 1;
+   // disregard any blocks probed beyond the final limit, then settle on a consensus
+   //  considering blocks in order ( as check_matches() prefers values of lower blocks )
+   int curblock = probe.maxblock;
+   int valid_meta = 0;
+   int match_count = 0;
+   for (i = 0; i < curblock; i++) {
+      if (tmp_meta_errs[i] == 0) {
+         minfo_refs[valid_meta] = &(minfo_list[i]);
+         valid_meta++;
       }
    }
+   if (valid_meta) {
+      match_count = check_matches(minfo_refs, valid_meta, ctxt->max_block, &consensus);
+   }
 
    // we're done with our minfo_refs
    free(minfo_refs);
@@ -1239,7 +2396,7 @@ ne_handle ne_stat(ne_ctxt ctxt, const char* objID, ne_location loc) {
       if (valid_meta == 0) {
          errno = ENOENT;
       }
-      LOG(LOG_ERR, "Failed to achieve sufficient meta info consensus across %d blocks (%s)\n", maxblock, strerror(errno));
+      LOG(LOG_ERR, "Failed to achieve sufficient meta info consensus across %d blocks (%s)\n", curblock, strerror(errno));
       fprintf(stderr, "Vmeta=%d, Match=%d, Con.N=%d, Con.E=%d\n", valid_meta, match_count, consensus.N, consensus.E);
       return NULL;
    }
@@ -1266,7 +2423,6 @@ ne_handle ne_stat(ne_ctxt ctxt, const char* objID, ne_location loc) {
       modeval = NE_ERR;
    }
    // at this point, if we have all valid N/E/O values, we need to rearange our errors based on offset
-   int i;
    if (modeval == NE_STAT) {
       for (i = 0; i < curblock; i++) {
          int translation = (i + consensus.O) % (consensus.N + consensus.E);
@@ -1301,6 +2457,8 @@ ne_handle ne_stat(ne_ctxt ctxt, const char* objID, ne_location loc) {
       for (i = 0; i < curblock; i++) {
          if (handle->thread_states[i].meta_error == 0) {
             handle->thread_states[i].minfo.crcsum = minfo_list[(i + consensus.O) % (consensus.N + consensus.E)].crcsum;
+            handle->thread_states[i].minfo.compsz = minfo_list[(i + consensus.O) % (consensus.N + consensus.E)].compsz;
+            handle->thread_states[i].minfo.csum = minfo_list[(i + consensus.O) % (consensus.N + consensus.E)].csum;
          }
       }
    }
@@ -1309,13 +2467,130 @@ ne_handle ne_stat(ne_ctxt ctxt, const char* objID, ne_location loc) {
    handle->mode = modeval;
    free(minfo_list);
 
+   // record our latency breakdown
+   timing.consensus = lap_usec(&start);
+   timing.total = timing.probe + timing.consensus;
+   handle->stat_timing = timing;
+   LOG(LOG_INFO, "Stat of \"%s\" took %.0fus ( probe %.0fus via %d threads / consensus %.0fus )\n",
+      objID, timing.total, timing.probe, timing.threads, timing.consensus);
+   LOG(LOG_INFO, "Per-block probe latency of %d blocks ( avg/max ): open %.0f/%.0fus, meta %.0f/%.0fus, close %.0f/%.0fus, stat %.0f/%.0fus\n",
+      timing.probes, timing.open_sum / timing.probes, timing.open_max, timing.meta_sum / timing.probes, timing.meta_max,
+      timing.close_sum / timing.probes, timing.close_max, timing.stat_sum / timing.probes, timing.stat_max);
+
    return handle;
 }
 
+/**
+ * Identify blocks of a read handle which the scoreboard of its ne_ctxt indicates are failing or unusually slow,
+ *  and mark up to E of them to be avoided ( their data will be reconstructed from erasure instead )
+ * @param ne_handle handle : Handle to be checked ( threads must not yet be running )
+ * @param ne_mode mode : Read mode the handle is being converted to
+ * @return int : Number of blocks to be avoided
+ */
+static int skip_suspect_blocks(ne_handle handle, ne_mode mode) {
+   int N = handle->epat.N;
+   int E = handle->epat.E;
+   if (E == 0 || handle->ctxt->sboard == NULL) {
+      return 0;
+   }
+   double* errscore = calloc(N + E, sizeof(double));
+   double* slowscore = calloc(N + E, sizeof(double));
+   double* latencies = calloc(N + E, sizeof(double));
+   if (errscore == NULL || slowscore == NULL || latencies == NULL) {
+      LOG(LOG_WARNING, "Failed to allocate scoreboard arrays ( no blocks will be avoided )\n");
+      free(latencies);
+      free(slowscore);
+      free(errscore);
+      return 0;
+   }
+   // gather the recent history of each block
+   time_t now = time(NULL);
+   int timed = 0;
+   int i;
+   for (i = 0; i < N + E; i++) {
+      location_score score;
+      if (scoreboard_lookup(handle->ctxt->sboard, handle->thread_states[i].location, &score)) {
+         continue;
+      }
+      if (score.last_failure && (now - score.last_failure) < SCORE_MEMORY_SEC &&
+          score.error_rate >= SCORE_ERROR_THRESHOLD) {
+         errscore[i] = score.error_rate;
+      }
+      if (score.reads >= SCORE_MIN_READS && (now - score.last_update) < SCORE_MEMORY_SEC) {
+         slowscore[i] = score.read_latency;
+         // insert into our sorted list of latencies
+         int pos = timed;
+         for (; pos > 0 && latencies[pos - 1] > score.read_latency; pos--) {
+            latencies[pos] = latencies[pos - 1];
+         }
+         latencies[pos] = score.read_latency;
+         timed++;
+      }
+   }
+   // blocks are only slow relative to several of their peers
+   double median = (timed >= 3) ? latencies[timed / 2] : 0.0;
+   char data_suspect = 0;
+   for (i = 0; i < N + E; i++) {
+      if (median > 0.0 && slowscore[i] > (SCORE_SLOW_FACTOR * median)) {
+         slowscore[i] /= median;
+      }
+      else {
+         slowscore[i] = 0.0;
+      }
+      if (i < N && (errscore[i] > 0.0 || slowscore[i] > 0.0)) {
+         data_suspect = 1;
+      }
+   }
+   free(latencies);
+   // NE_RDONLY handles only read erasure to cope with data errors
+   if (mode == NE_RDONLY && !(data_suspect)) {
+      free(slowscore);
+      free(errscore);
+      return 0;
+   }
+   // avoid the worst blocks, preferring those which are failing over those which are slow
+   int skipped = 0;
+   while (skipped < E) {
+      int worst = -1;
+      for (i = 0; i < N + E; i++) {
+         if (errscore[i] > 0.0 && (worst < 0 || errscore[i] > errscore[worst])) {
+            worst = i;
+         }
+      }
+      if (worst < 0) {
+         for (i = 0; i < N + E; i++) {
+            if (slowscore[i] > 0.0 && (worst < 0 || slowscore[i] > slowscore[worst])) {
+               worst = i;
+            }
+         }
+      }
+      if (worst < 0) {
+         break;
+      }
+      if (handle->hedge == NULL) {
+         handle->hedge = allocate_hedge_state(N + E);
+         if (handle->hedge == NULL) {
+            LOG(LOG_WARNING, "Failed to allocate hedge state ( no blocks will be avoided )\n");
+            break;
+         }
+      }
+      LOG(LOG_WARNING, "Avoiding block %d, due to its history ( error rate = %.3f, relative latency = %.1f )\n",
+         worst, errscore[worst], slowscore[worst]);
+      handle->hedge->skip[worst] = 1;
+      handle->hedge->dead[worst] = 1;
+      errscore[worst] = 0.0;
+      slowscore[worst] = 0.0;
+      skipped++;
+   }
+   free(slowscore);
+   free(errscore);
+   return skipped;
+}
+
 /**
  * Converts a generic handle (produced by ne_stat()) into a handle for a specific operation
  * @param ne_handle handle : Reference to a generic handle (produced by ne_stat())
- * @param ne_mode mode : Mode to be set for handle (NE_RDONLY || NE_RDALL || NE_WRONLY || NE_WRALL || NE_REBUILD)
+ * @param ne_mode mode : Mode to be set for handle (NE_RDONLY || NE_RDALL || NE_RDHEDGE || NE_RDSPARSE || NE_WRONLY || NE_WRALL || NE_REBUILD)
  * @return ne_handle : Reference to the modified handle, or NULL if an error occured
  */
 ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
@@ -1333,6 +2608,28 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       return NULL;
    }
 
+   // hedged and sparse reads require some additional state
+   if (mode == NE_RDHEDGE && handle->hedge == NULL) {
+      handle->hedge = allocate_hedge_state(handle->epat.N + handle->epat.E);
+      if (handle->hedge == NULL) {
+         return NULL;
+      }
+   }
+   if (mode == NE_RDSPARSE && handle->sparse == NULL) {
+      handle->sparse = allocate_sparse_state(handle->epat.N);
+      if (handle->sparse == NULL) {
+         return NULL;
+      }
+   }
+
+   // wait for pool admission of every queue before launching any, so that no handle holds some threads
+   // while blocking on the rest ( a rebuild may additionally launch an output queue per block )
+   unsigned int slots = (handle->epat.N + handle->epat.E) * ((mode == NE_REBUILD) ? 2 : 1);
+   if (handle->poolslots < slots) {
+      iothread_pool_reserve(slots - handle->poolslots, (handle->poolslots == 0));
+      handle->poolslots = slots;
+   }
+
    // we need to startup some threads
    TQ_Init_Opts tqopts = {0};
    char* lprefstr = malloc(sizeof(char) * (6 + (handle->ctxt->max_block / 10)));
@@ -1350,7 +2647,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       preffmt = "WQ%d";
    }
    tqopts.init_flags = TQ_HALT; // initialize the threads in a HALTED state (essential for reads, doesn't hurt writes)
-   tqopts.max_qdepth = QDEPTH;
+   tqopts.max_qdepth = QDEPTH(handle);
    tqopts.num_threads = 1;
    tqopts.num_prod_threads = (mode == NE_WRONLY || mode == NE_WRALL) ? 0 : 1;
    DAL_MODE dmode = DAL_READ;
@@ -1378,7 +2675,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       tqopts.global_state = &(handle->thread_states[i]);
       // set a log_prefix value for this queue
       snprintf(lprefstr, 6 + (handle->ctxt->max_block/10), preffmt, i);
-      handle->thread_queues[i] = tq_init(&tqopts);
+      handle->thread_queues[i] = tq_init_pooled(&tqopts, iothread_pool());
       if (handle->thread_queues[i] == NULL) {
          LOG(LOG_ERR, "Failed to create thread_queue for block %d!\n", i);
          // if we failed to initialize any thread_queue, attempt to abort everything else
@@ -1497,9 +2794,14 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       }
    }
 
-   // start with zero erasure threads running only for NE_RDONLY
+   // start with zero erasure threads running only for NE_RDONLY ( and NE_RDSPARSE )
    handle->ethreads_running = 0;
-   if (mode != NE_RDONLY) {
+   if (mode != NE_RDONLY && mode != NE_RDSPARSE) {
+      handle->ethreads_running = handle->epat.E;
+   }
+
+   // avoid any blocks with a poor history, reconstructing their data instead
+   if ((mode == NE_RDONLY || mode == NE_RDHEDGE) && skip_suspect_blocks(handle, mode) > 0) {
       handle->ethreads_running = handle->epat.E;
    }
 
@@ -1512,13 +2814,15 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
       } // if we already have a versz, use that instead
 
       // initialize ioqueues
-      handle->thread_states[i].ioq = create_ioqueue(iosz, handle->epat.partsz, dmode);
+      handle->thread_states[i].ioq = create_ioqueue(iosz, handle->epat.partsz, dmode, handle->ctxt->iodepth, handle->ctxt->numa_node);
       if (handle->thread_states[i].ioq == NULL) {
          LOG(LOG_ERR, "Failed to create ioqueue for thread %d!\n", i);
          break;
       }
-      // remove the PAUSE flag, allowing thread to begin processing
-      if (i < handle->epat.N + handle->ethreads_running) {
+      // written data must be checksummed via the algorithm our writer will record
+      handle->thread_states[i].ioq->csum = handle->thread_states[i].minfo.csum;
+      // remove the PAUSE flag, allowing thread to begin processing ( sparse handles only do so after an error )
+      if (i < handle->epat.N + handle->ethreads_running && !(handle->hedge && handle->hedge->skip[i]) && mode != NE_RDSPARSE) {
          if (tq_unset_flags(handle->thread_queues[i], TQ_HALT)) {
             LOG(LOG_ERR, "Failed to unset PAUSE flag for block %d\n", i);
             break;
@@ -1552,7 +2856,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode) {
  * @param const char* objID : ID of the object to be rebuilt
  * @param ne_location loc : Location of the object to be rebuilt
  * @param ne_erasure epat : Erasure pattern of the object to be rebuilt
- * @param ne_mode mode : Handle mode (NE_RDONLY || NE_RDALL || NE_WRONLY || NE_WRALL || NE_REBUILD)
+ * @param ne_mode mode : Handle mode (NE_RDONLY || NE_RDALL || NE_RDHEDGE || NE_RDSPARSE || NE_WRONLY || NE_WRALL || NE_REBUILD)
  * @return ne_handle : Newly created ne_handle, or NULL if an error occured
  */
 ne_handle ne_open(ne_ctxt ctxt, const char* objID, ne_location loc, ne_erasure epat, ne_mode mode) {
@@ -1564,7 +2868,7 @@ ne_handle ne_open(ne_ctxt ctxt, const char* objID, ne_location loc, ne_erasure e
    }
 
    // verify that our mode argument makes sense
-   if (mode != NE_RDONLY && mode != NE_RDALL && mode != NE_WRONLY && mode != NE_WRALL && mode != NE_REBUILD) {
+   if (mode != NE_RDONLY && mode != NE_RDALL && mode != NE_RDHEDGE && mode != NE_RDSPARSE && mode != NE_WRONLY && mode != NE_WRALL && mode != NE_REBUILD) {
       LOG(LOG_ERR, "Recieved an inappropriate mode argument!\n");
       errno = EINVAL;
       return NULL;
@@ -1580,6 +2884,8 @@ ne_handle ne_open(ne_ctxt ctxt, const char* objID, ne_location loc, ne_erasure e
    minfo.blocksz = 0;
    minfo.crcsum = 0;
    minfo.totsz = 0;
+   minfo.compsz = 0;
+   minfo.csum = ctxt->dal->checksum;
 
    // allocate our handle structure
    ne_handle handle = allocate_handle(ctxt, objID, loc, &minfo);
@@ -1642,6 +2948,16 @@ int ne_close(ne_handle handle, ne_erasure* epat, ne_state* sref) {
          handle->totsz -= (stripesz - partstripe);
          free(zerobuff);
       }
+      // generate erasure for any stripes still buffered in our ioblocks
+      if (handle->pend_stripes) {
+         void** tgt_refs = calloc(handle->epat.N + handle->epat.E, sizeof(char*));
+         if (tgt_refs == NULL) {
+            LOG(LOG_ERR, "Failed to allocate space for a target buffer array!\n");
+            return -1;
+         }
+         encode_pending_stripes(handle, tgt_refs);
+         free(tgt_refs);
+      }
    }
 
    int ret_val = 0;
@@ -1691,6 +3007,11 @@ int ne_close(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       // set a FINISHED state for all threads
       for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
          LOG(LOG_INFO, "Terminating thread %d\n", i);
+         if (handle->hedge && handle->hedge->insub[i]) {
+            // substitute ioblocks are not ours to release
+            handle->hedge->insub[i] = 0;
+            handle->iob[i] = NULL;
+         }
          if (terminate_thread(&(handle->iob[i]), handle->thread_queues[i], &(handle->thread_states[i]), handle->mode)) {
             ret_val = -1;
          }
@@ -1698,7 +3019,7 @@ int ne_close(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       // verify thread termination and close all queues
       for (i = 0; i < handle->epat.N + handle->epat.E; i++) {
          LOG(LOG_INFO, "Terminating queue %d\n", i);
-         if (handle->mode == NE_RDONLY || handle->mode == NE_RDALL) {
+         if (handle->mode == NE_RDONLY || handle->mode == NE_RDALL || handle->mode == NE_RDHEDGE || handle->mode == NE_RDSPARSE) {
             // wait for thread termination
             int waitres = 0;
             while ( (waitres = tq_wait_for_completion( handle->thread_queues[i] )) ) {
@@ -1868,6 +3189,24 @@ int ne_get_info(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    return 0;
 }
 
+/**
+ * Retrieve the latency breakdown of the ne_stat() call which produced the given handle
+ * @param ne_handle handle : Handle to retrieve timing info for
+ * @param ne_stat_timing* timing : Address of an ne_stat_timing struct to be populated
+ *                                 ( all zero, if the handle was not produced via ne_stat() )
+ * @return int : Zero on success, and -1 on a failure
+ */
+int ne_get_stat_timing(ne_handle handle, ne_stat_timing* timing) {
+   // sanity checks
+   if (handle == NULL || timing == NULL) {
+      LOG(LOG_ERR, "Received a NULL ne_handle or ne_stat_timing reference!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   *timing = handle->stat_timing;
+   return 0;
+}
+
 /**
  * Seed error patterns into a given handle (may useful for speeding up ne_rebuild())
  * @param ne_handle handle : Handle for which to set an error pattern
@@ -1987,7 +3326,6 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    // assign values to thread states
    int i;
    for (i = 0; i < N + E; i++) {
-      outstates[i].erasurelock = handle->ctxt->erasurelock;
       // object attributes
       outstates[i].objID = handle->objID;
       outstates[i].location.pod = handle->loc.pod;
@@ -1995,6 +3333,8 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       outstates[i].location.cap = handle->loc.cap;
       outstates[i].location.scatter = handle->loc.scatter;
       outstates[i].dal = handle->ctxt->dal;
+      outstates[i].sboard = handle->ctxt->sboard;
+      outstates[i].numa_node = handle->ctxt->numa_node;
       outstates[i].offset = 0;
       // meta info values
       outstates[i].minfo.N = N;
@@ -2005,6 +3345,8 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       outstates[i].minfo.blocksz = handle->blocksz;
       outstates[i].minfo.crcsum = 0;
       outstates[i].minfo.totsz = 0;
+      outstates[i].minfo.compsz = 0;
+      outstates[i].minfo.csum = handle->ctxt->dal->checksum;
       outstates[i].meta_error = 0;
       outstates[i].data_error = 0;
    }
@@ -2018,7 +3360,7 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    tqopts.log_prefix = lprefstr;
    // create a format string for each thread queue
    tqopts.init_flags = TQ_HALT; // initialize the threads in a HALTED state (essential for reads, doesn't hurt writes)
-   tqopts.max_qdepth = QDEPTH;
+   tqopts.max_qdepth = QDEPTH(handle);
    tqopts.num_threads = 1;
    tqopts.num_prod_threads = 0;
    tqopts.thread_init_func = write_init;
@@ -2036,7 +3378,7 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
          LOG(LOG_INFO, "Starting up output thread %d\n", i);
          // set a log_prefix value for this queue
          snprintf(lprefstr, 6 + (handle->ctxt->max_block/10), "RWQ%d", i);
-         OutTQs[i] = tq_init(&tqopts);
+         OutTQs[i] = tq_init_pooled(&tqopts, iothread_pool());
          if (OutTQs[i] == NULL) {
             LOG(LOG_ERR, "Failed to create output thread_queue for block %d!\n", i);
             // if we failed to initialize any thread_queue, attempt to abort everything else
@@ -2083,11 +3425,12 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
       if (OutTQs[i] != NULL) {
          LOG(LOG_INFO, "Prepping block %d for output\n", i);
          // initialize ioqueues
-         outstates[i].ioq = create_ioqueue(handle->versz, handle->epat.partsz, DAL_REBUILD);
+         outstates[i].ioq = create_ioqueue(handle->versz, handle->epat.partsz, DAL_REBUILD, handle->ctxt->iodepth, handle->ctxt->numa_node);
          if (outstates[i].ioq == NULL) {
             LOG(LOG_ERR, "Failed to create ioqueue for thread %d!\n", i);
             break;
          }
+         outstates[i].ioq->csum = outstates[i].minfo.csum;
          // remove the PAUSE flag, allowing thread to begin processing
          if (tq_unset_flags(OutTQs[i], TQ_HALT)) {
             LOG(LOG_ERR, "Failed to unset PAUSE flag for block %d\n", i);
@@ -2306,7 +3649,7 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
             // if we've been successful so far, restart this thread
             if (handle->mode != NE_ERR) {
                LOG(LOG_INFO, "Restarting thread %d\n", i);
-               handle->thread_queues[i] = tq_init(&opts);
+               handle->thread_queues[i] = tq_init_pooled(&opts, iothread_pool());
                if (handle->thread_queues[i] == NULL) {
                   LOG(LOG_ERR, "Failed to initialize new thread queue at position %d!\n", i);
                   numerrs++;
@@ -2343,6 +3686,120 @@ int ne_rebuild(ne_handle handle, ne_erasure* epat, ne_state* sref) {
    return newerrs;
 }
 
+/**
+ * Satisfy a read from a sparse handle by reading only the IO units of those data blocks which cover the request
+ * @param ne_handle handle : Handle to read from ( must be in NE_RDSPARSE mode )
+ * @param void* buffer : Reference to a buffer to be filled with read data ( may be NULL, to discard data )
+ * @param size_t bytes : Number of bytes to be read ( must not extend beyond EOF )
+ * @return ssize_t : The number of bytes read, or -1 if any block could not provide verified data
+ *                   ( the handle offset is unchanged, in that case )
+ */
+static ssize_t sparse_read(ne_handle handle, void* buffer, size_t bytes) {
+   sparse_state* sparse = handle->sparse;
+   int N = handle->epat.N;
+   size_t partsz = handle->epat.partsz;
+   size_t stripesz = partsz * N;
+   off_t offset = sparse->offset;
+   size_t bytes_read = 0;
+   while (bytes_read < bytes) {
+      int block = (int)((offset % stripesz) / partsz);
+      gthread_state* gstate = &(handle->thread_states[block]);
+      size_t unitdata = gstate->minfo.versz - CRC_BYTES;
+      // data offset within the block
+      off_t block_off = ((offset / stripesz) * partsz) + (offset % partsz);
+      off_t unit = block_off / unitdata;
+      // read the covering IO unit, unless we already hold it
+      if (sparse->unit[block] != unit) {
+         sparse->unit[block] = -1;
+         if (gstate->data_error || gstate->meta_error) {
+            LOG(LOG_ERR, "Block %d is known to be erroneous\n", block);
+            return -1;
+         }
+         if (sparse->bctxt[block] == NULL) {
+            sparse->bctxt[block] = gstate->dal->open(gstate->dal->ctxt, DAL_READ, gstate->location, gstate->objID);
+            if (sparse->bctxt[block] == NULL) {
+               LOG(LOG_ERR, "Failed to open sparse read handle for block %d\n", block);
+               return -1;
+            }
+         }
+         if (sparse->buff[block] == NULL) {
+            sparse->buff[block] = malloc(gstate->minfo.versz);
+            if (sparse->buff[block] == NULL) {
+               LOG(LOG_ERR, "Failed to allocate a %zu byte sparse read buffer!\n", gstate->minfo.versz);
+               return -1;
+            }
+         }
+         ssize_t unit_data = read_unit(gstate, sparse->bctxt[block], unit, sparse->buff[block]);
+         if (unit_data < 0) {
+            LOG(LOG_ERR, "Failed to read IO unit %zd of block %d\n", unit, block);
+            return -1;
+         }
+         sparse->unit[block] = unit;
+         sparse->unit_data[block] = unit_data;
+      }
+      // copy out the remainder of this part, the unit, or the request ( whichever is smallest )
+      off_t unit_off = block_off - (unit * unitdata);
+      if (unit_off >= sparse->unit_data[block]) {
+         LOG(LOG_ERR, "IO unit %zd of block %d is subsized (%zu)!\n", unit, block, sparse->unit_data[block]);
+         sparse->unit[block] = -1;
+         return -1;
+      }
+      size_t to_copy = partsz - (offset % partsz);
+      if (to_copy > (bytes - bytes_read)) {
+         to_copy = bytes - bytes_read;
+      }
+      if (to_copy > (sparse->unit_data[block] - unit_off)) {
+         to_copy = sparse->unit_data[block] - unit_off;
+      }
+      if (buffer) {
+         memcpy(buffer + bytes_read, sparse->buff[block] + unit_off, to_copy);
+      }
+      bytes_read += to_copy;
+      offset += to_copy;
+   }
+   sparse->offset = offset;
+   return bytes_read;
+}
+
+/**
+ * Convert a sparse handle to NE_RDONLY behavior ( so that erasure may be used to reconstruct data ), starting
+ *  the data block threads at the current handle offset
+ * @param ne_handle handle : Handle to be converted ( must be in NE_RDSPARSE mode )
+ * @return int : Zero on success, and -1 on failure
+ */
+static int escalate_sparse_handle(ne_handle handle) {
+   int N = handle->epat.N;
+   ssize_t partsz = handle->epat.partsz;
+   size_t stripesz = partsz * N;
+   off_t offset = handle->sparse->offset;
+   LOG(LOG_WARNING, "Falling back to full stripe reads at offset %zd\n", offset);
+   free_sparse_state(handle);
+   handle->mode = NE_RDONLY;
+   // start up all data threads at our target stripe
+   off_t tgt_stripe = offset / stripesz;
+   int i;
+   for (i = 0; i < N; i++) {
+      if (tq_wait_for_pause(handle->thread_queues[i])) {
+         LOG(LOG_ERR, "Failed to verify that thread %d paused, prior to starting\n", i);
+         return -1;
+      }
+      handle->thread_states[i].offset = (tgt_stripe * partsz);
+      if (tq_unset_flags(handle->thread_queues[i], TQ_HALT)) {
+         LOG(LOG_ERR, "Failed to clear PAUSE state for block %d!\n", i);
+         return -1;
+      }
+   }
+   handle->sub_offset = 0;
+   handle->iob_datasz = 0;
+   handle->iob_offset = (tgt_stripe * partsz);
+   if (read_stripes(handle)) {
+      LOG(LOG_ERR, "Failed to read initial stripes!\n");
+      return -1;
+   }
+   handle->sub_offset = offset - (handle->iob_offset * N);
+   return 0;
+}
+
 /**
  * Seek to a new offset on a read ne_handle
  * @param ne_handle handle : Handle on which to seek (must be open for read)
@@ -2357,7 +3814,7 @@ off_t ne_seek(ne_handle handle, off_t offset) {
       return -1;
    }
 
-   if (handle->mode != NE_RDONLY && handle->mode != NE_RDALL && (handle->mode == NE_REBUILD && offset != 0)) {
+   if (handle->mode != NE_RDONLY && handle->mode != NE_RDALL && handle->mode != NE_RDHEDGE && handle->mode != NE_RDSPARSE && (handle->mode == NE_REBUILD && offset != 0)) {
       LOG(LOG_ERR, "Handle is in improper mode for seeking!\n");
       errno = EPERM;
       return -1;
@@ -2368,6 +3825,12 @@ off_t ne_seek(ne_handle handle, off_t offset) {
       LOG(LOG_WARNING, "Seek offset extends beyond EOF, resizing read request to %zu\n", offset);
    }
 
+   // sparse handles only read what each request covers, so just note the new offset
+   if (handle->mode == NE_RDSPARSE) {
+      handle->sparse->offset = offset;
+      return offset;
+   }
+
    int N = handle->epat.N;
    ssize_t partsz = handle->epat.partsz;
    size_t stripesz = partsz * N;
@@ -2395,12 +3858,13 @@ off_t ne_seek(ne_handle handle, off_t offset) {
             break;
          }
          // next, release any unneeded ioblock reference
-         if (handle->iob[i] != NULL) {
-            if (release_ioblock(handle->thread_states[i].ioq)) {
-               LOG(LOG_ERR, "Failed to release ioblock ref for block %d!\n", i);
-               break;
-            }
-            handle->iob[i] = NULL;
+         if (drop_handle_ioblock(handle, i)) {
+            LOG(LOG_ERR, "Failed to release ioblock ref for block %d!\n", i);
+            break;
+         }
+         // avoided blocks remain halted
+         if (handle->hedge && handle->hedge->skip[i]) {
+            continue;
          }
          // make sure that the thread isn't stuck waiting for ioqueue elements
          if (tq_dequeue(handle->thread_queues[i], TQ_HALT, (void**)&(handle->iob[i])) > 0) {
@@ -2433,6 +3897,11 @@ off_t ne_seek(ne_handle handle, off_t offset) {
          } // catch any previous error
          // set the thread to our target offset
          handle->thread_states[i].offset = (tgt_stripe * partsz);
+         if (handle->hedge) {
+            // no stale ioblocks remain
+            handle->hedge->lag[i] = 0;
+            handle->hedge->dead[i] = 0;
+         }
          // unpause the thread
          if (tq_unset_flags(handle->thread_queues[i], TQ_HALT)) {
             LOG(LOG_ERR, "Failed to unset HALT state for block %d!\n", i);
@@ -2525,7 +3994,7 @@ off_t ne_seek(ne_handle handle, off_t offset) {
 }
 
 /**
- * Read from a given NE_RDONLY or NE_RDALL handle
+ * Read from a given NE_RDONLY, NE_RDALL, NE_RDHEDGE, or NE_RDSPARSE handle
  * @param ne_handle handle : The ne_handle reference to read from
  * @param off_t offset : Offset at which to read
  * @param void* buffer : Reference to a buffer to be filled with read data
@@ -2544,12 +4013,15 @@ ssize_t ne_read(ne_handle handle, void* buffer, size_t bytes) {
       errno = EFBIG; /* sort of */
       return -1;
    }
-   if (handle->mode != NE_RDONLY && handle->mode != NE_RDALL) {
+   if (handle->mode != NE_RDONLY && handle->mode != NE_RDALL && handle->mode != NE_RDHEDGE && handle->mode != NE_RDSPARSE) {
       LOG(LOG_ERR, "Handle is in improper mode for reading!\n");
       errno = EPERM;
       return -1;
    }
    size_t offset = (handle->iob_offset * handle->epat.N) + handle->sub_offset;
+   if (handle->mode == NE_RDSPARSE) {
+      offset = handle->sparse->offset;
+   }
    LOG(LOG_INFO, "Called to retrieve %zu bytes at offset %zu\n", bytes, offset);
    if ((offset + bytes) > handle->totsz) {
       if (offset >= handle->totsz) {
@@ -2560,6 +4032,20 @@ ssize_t ne_read(ne_handle handle, void* buffer, size_t bytes) {
       LOG(LOG_WARNING, "Read would extend beyond EOF, resizing read request to %zu\n", bytes);
    }
 
+   // sparse handles read only the data parts covering the request, unless they encounter an error
+   if (handle->mode == NE_RDSPARSE) {
+      ssize_t sparse_bytes = sparse_read(handle, buffer, bytes);
+      if (sparse_bytes >= 0) {
+         return sparse_bytes;
+      }
+      if (escalate_sparse_handle(handle)) {
+         LOG(LOG_ERR, "Failed to fall back to full stripe reads at offset %zu!\n", offset);
+         handle->mode = NE_ERR; // make sure that no one tries to reuse this broken handle!
+         errno = EBADF;
+         return -1;
+      }
+   }
+
    // get some useful reference values
    int N = handle->epat.N;
    ssize_t partsz = handle->epat.partsz;
@@ -2636,6 +4122,33 @@ ssize_t ne_read(ne_handle handle, void* buffer, size_t bytes) {
    return bytes_read;
 }
 
+/**
+ * Allow complete stripes written to the given NE_WRONLY / NE_WRALL handle to be taken directly from caller
+ * buffers, rather than copied
+ * NOTE -- While enabled, the caller must not modify or release any buffer passed to ne_write() until the handle
+ *         has been closed or aborted, or until this behavior has been disabled again.
+ * @param ne_handle handle : Handle to be updated
+ * @param char enable : Non-zero to enable zero-copy writes, or zero to disable them ( releasing all caller buffers )
+ * @return int : Zero on success, and -1 on failure
+ */
+int ne_set_zero_copy(ne_handle handle, char enable) {
+   if (handle == NULL) {
+      LOG(LOG_ERR, "Received a NULL handle!\n");
+      errno = EINVAL;
+      return -1;
+   }
+   if (handle->mode != NE_WRONLY && handle->mode != NE_WRALL) {
+      LOG(LOG_ERR, "Handle is in improper mode for writing! %d\n", handle->mode);
+      errno = EINVAL;
+      return -1;
+   }
+   if (handle->zcopy && !(enable) && release_caller_buffers(handle)) {
+      return -1;
+   }
+   handle->zcopy = (enable) ? 1 : 0;
+   return 0;
+}
+
 /**
  * Write to a given NE_WRONLY or NE_WRALL handle
  * @param ne_handle handle : The ne_handle reference to write to
@@ -2676,22 +4189,7 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
    // initialize erasure structs (these never change for writes, so we can just check here)
    if (handle->e_ready == 0) {
       LOG(LOG_INFO, "Initializing erasure matricies...\n");
-      // critical section : we are now going to call some inlined assembly erasure funcs
-      if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-         LOG( LOG_ERR, "Failed to acquire erasurelock prior to encoding prep of stripe %d\n", stripenum );
-         return -1;
-      }
-      // Generate an encoding matrix
-      // NOTE: The matrix generated by gf_gen_rs_matrix is not always invertable for N>=6 and E>=5!
-      gf_gen_cauchy1_matrix(handle->encode_matrix, N + E, N);
-      // Generate g_tbls from encode matrix
-      ec_init_tables(N, E, &(handle->encode_matrix[N * N]), handle->g_tbls);
-      // exiting critical section
-      if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-         LOG( LOG_ERR, "Failed to relinquish erasurelock after encoding prep of stripe %d\n", stripenum );
-         return -1;
-      }
-      handle->e_ready = 1;
+      init_encode_tables(handle);
    }
 
    // allocate space for our buffer references
@@ -2708,10 +4206,28 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
    LOG(LOG_INFO, "   Init write block = %d\n", outblock);
    LOG(LOG_INFO, "   Init write size = %zu\n", to_write);
 
+   // complete stripes may be written without copying, if our caller permits it and our DAL supports vectored puts
+   // NOTE -- parts smaller than an encoding chunk are better off copied, as buffered stripes may then
+   //         be encoded together ( see encode_pending_stripes() )
+   char zcopy = (handle->zcopy && handle->ctxt->dal->putv != NULL && partsz >= encode_chunksz(N, E));
+
    // write out data from the buffer until we have all of it
    // NOTE - the (outblock >= N) check is meant to ensure we don't quit before outputing erasure parts
    ssize_t written = 0;
    while (written < bytes || outblock >= N) {
+      // check for a complete, aligned stripe of caller data
+      if (zcopy && outblock == 0 && to_write == partsz && (bytes - written) >= stripesz) {
+         LOG(LOG_INFO, "Writing stripe %u without copying\n", stripenum);
+         if (write_full_stripe(handle, buffer + written, tgt_refs)) {
+            LOG(LOG_ERR, "Failed to write complete stripe\n");
+            free(tgt_refs);
+            return -1;
+         }
+         written += stripesz;
+         handle->sub_offset += stripesz;
+         handle->totsz += stripesz;
+         continue;
+      }
       ioblock* push_block = NULL;
       int reserved;
       // check that the current ioblock has room for our data
@@ -2748,25 +4264,14 @@ ssize_t ne_write(ne_handle handle, const void* buffer, size_t bytes) {
 
          // check if we have completed a stripe
          if (outblock == (N + E)) {
-            LOG(LOG_INFO, "Generating erasure parts for stripe %u\n", stripenum);
-            // build an array of data/erasure references while reseting outblock to zero
-            for (outblock -= 1; outblock >= 0; outblock--) {
-               // previously written data will be one partsz behind
-               tgt_refs[outblock] = ioblock_write_target(handle->iob[outblock]) - partsz;
-            }
-            // critical section : we are now going to call some inlined assembly erasure funcs
-            if ( pthread_mutex_lock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to acquire erasurelock prior to encoding of stripe %d\n", stripenum );
-               free( tgt_refs );
-               return -1;
-            }
-            // generate erasure parts
-            ec_encode_data(partsz, N, E, handle->g_tbls, (unsigned char**)tgt_refs, (unsigned char**)&(tgt_refs[N]));
-            // exiting critical section
-            if ( pthread_mutex_unlock( handle->ctxt->erasurelock ) ) {
-               LOG( LOG_ERR, "Failed to relinquish erasurelock after encoding of stripe %d\n", stripenum );
-               free( tgt_refs );
-               return -1;
+            LOG(LOG_INFO, "Completed stripe %u\n", stripenum);
+            handle->pend_stripes++;
+            // defer erasure generation until our ioblocks are full, so that every buffered stripe
+            // may be encoded at once
+            // NOTE -- all ioblocks hold the same fill at a stripe boundary, and none can be pushed
+            //         until that fill reaches the split threshold
+            if (ioblock_get_fill(handle->iob[0]) >= handle->thread_states[0].ioq->split_threshold) {
+               encode_pending_stripes(handle, tgt_refs);
             }
             // reset outblock
             outblock = 0;
@@ -73,6 +73,7 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #include <stdint.h>
 #include <sys/types.h>
 #include <pthread.h>
+#include <time.h>
 #include <libxml/tree.h>
 
 #ifndef LIBXML_TREE_ENABLED
@@ -121,7 +122,10 @@ typedef enum
  NE_RDALL,             //3  -- read data and all erasure, regardless of data state
  NE_WRONLY,            //4  -- write data and erasure to new stripe
  NE_WRALL = NE_WRONLY, //   -- same as above, defined just to avoid confusion
- NE_REBUILD            //5  -- rebuild an existing object
+ NE_REBUILD,           //5  -- rebuild an existing object
+ NE_RDHEDGE,           //6  -- read data and all erasure, reconstructing from whichever blocks arrive first
+ NE_RDSPARSE           //7  -- read only the data parts covering each request ( for small random reads ),
+                       //      switching to NE_RDONLY behavior once any error is encountered
 } ne_mode;
 
 typedef struct ne_erasure_struct
@@ -147,6 +151,25 @@ typedef struct ne_state_struct
  u64 *csum; // user allocated region, must be at least ( sizeof(u64) * max_block ) bytes; ignored if NULL
 } ne_state;
 
+typedef struct ne_stat_timing_struct
+{
+ // all times are in microseconds
+ double total;     // complete ne_stat() call
+ double probe;     // concurrent metadata probing of all blocks ( wall time )
+ double consensus; // final consensus, handle allocation, and error translation
+ // per-phase latency of individual block probes ( sum and max across all probed blocks )
+ double open_sum;
+ double open_max;
+ double meta_sum;
+ double meta_max;
+ double close_sum;
+ double close_max;
+ double stat_sum;
+ double stat_max;
+ int probes;  // number of blocks probed ( including any beyond the final stripe width )
+ int threads; // number of threads which issued probes
+} ne_stat_timing;
+
 // location struct
 typedef struct ne_location_struct
 {
@@ -155,6 +178,29 @@ typedef struct ne_location_struct
  int scatter;
 } ne_location;
 
+typedef struct ne_delete_target_struct
+{
+ const char *objID;
+ ne_location loc;
+ int status; // populated by ne_delete_batch() : zero on success, otherwise an errno value
+             //  ( ENOENT indicates that every failing block was already absent )
+} ne_delete_target;
+
+// health history of a single block location, as observed by all handles of a ne_ctxt
+typedef struct ne_location_score_struct
+{
+ ne_location loc;
+ int block;
+ double read_latency;  // moving average of block read latency, in microseconds
+ double write_latency; // moving average of block write latency, in microseconds
+ double error_rate;    // moving average of the fraction of block operations which failed
+ unsigned long long reads;
+ unsigned long long writes;
+ unsigned long long errors;
+ time_t last_update;   // time of the most recent operation ( zero if never accessed )
+ time_t last_failure;  // time of the most recent failure ( zero if none )
+} ne_location_score;
+
 /*
  ---  Initialization/Termination functions, to produce and destroy a ne_ctxt  ---
 */
@@ -168,14 +214,10 @@ typedef struct ne_ctxt_struct *ne_ctxt; // forward decl.
  * @param ne_location max_loc : ne_location struct containing maximum allowable pod/cap/scatter
  *                              values for this context
  * @param int max_block : Integer maximum block value ( N + E ) for this context
- * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
- *                                       If NULL, libne will create such a lock internally.  In such a case,
- *                                       the internal lock will continue to protect multi-threaded programs
- *                                       ONLY if they exclusively use a single ne_ctxt at a time.
- *                                       Multi-threaded programs using multiple ne_ctxt references in parallel
- *                                       MUST create + initialize their own pthread_mutex and pass it into
- *                                       ALL ne_init*() calls.
+ * @param pthread_mutex_t* erasurelock : Ignored; retained only for interface compatibility.
+ *                                       isa-l routines are initialized exactly once per process and all
+ *                                       erasure structures are private to each ne_handle, so concurrent
+ *                                       handles ( from one or many ne_ctxt references ) encode in parallel.
  * @return ne_ctxt : New ne_ctxt or NULL if an error was encountered
  */
 ne_ctxt ne_init(xmlNode *dal_root, ne_location max_loc, int max_block, pthread_mutex_t* erasurelock);
@@ -185,14 +227,10 @@ ne_ctxt ne_init(xmlNode *dal_root, ne_location max_loc, int max_block, pthread_m
  * This fucntion is intended primarily for use with test utilities and commandline tools.
  * @param const char* path : The complete path template for the erasure stripe
  * @param ne_location max_loc : The maximum pod/cap/scatter values for this context
- * @param pthread_mutex_t* erasurelock : Reference to a pthread_mutex lock, to be used for synchronizing access
- *                                       to isa-l erasure generation functions in multi-threaded programs.
- *                                       If NULL, libne will create such a lock internally.  In such a case,
- *                                       the internal lock will continue to protect multi-threaded programs
- *                                       ONLY if they exclusively use a single ne_ctxt at a time.
- *                                       Multi-threaded programs using multiple ne_ctxt references in parallel
- *                                       MUST create + initialize their own pthread_mutex and pass it into
- *                                       ALL ne_init*() calls.
+ * @param pthread_mutex_t* erasurelock : Ignored; retained only for interface compatibility.
+ *                                       isa-l routines are initialized exactly once per process and all
+ *                                       erasure structures are private to each ne_handle, so concurrent
+ *                                       handles ( from one or many ne_ctxt references ) encode in parallel.
  * @return ne_ctxt : The initialized ne_ctxt or NULL if an error occurred
  */
 ne_ctxt ne_path_init(const char *path, ne_location max_loc, int max_block, pthread_mutex_t* erasurelock);
@@ -205,6 +243,26 @@ ne_ctxt ne_path_init(const char *path, ne_location max_loc, int max_block, pthre
  */
 int ne_verify(ne_ctxt ctxt, char fix);
 
+/**
+ * Set the time for which NE_RDHEDGE handles of the given ne_ctxt will wait on data blocks, once the
+ * stripe could instead be reconstructed from the blocks which have already arrived
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to be updated
+ * @param unsigned int usec : Delay in microseconds ( zero to always reconstruct from the first blocks to arrive )
+ * @return int : Zero on a success, and -1 on a failure
+ */
+int ne_set_hedge_delay(ne_ctxt ctxt, unsigned int usec);
+
+/**
+ * Export the health history of all block locations accessed via the given ne_ctxt
+ * NOTE -- read handles of the ne_ctxt will avoid block locations which this history indicates are
+ *         failing or unusually slow, reconstructing their data from erasure instead
+ * @param ne_ctxt ctxt : Reference to the ne_ctxt to export the history of
+ * @param ne_location_score* scores : Array to be populated with location histories ( may be NULL if max is zero )
+ * @param size_t max : Maximum number of entries to populate
+ * @return size_t : Total number of tracked locations ( may exceed 'max' )
+ */
+size_t ne_get_scoreboard(ne_ctxt ctxt, ne_location_score* scores, size_t max);
+
 /**
  * Destroys an existing ne_ctxt
  * @param ne_ctxt ctxt : Reference to the ne_ctxt to be destroyed
@@ -225,6 +283,16 @@ int ne_term(ne_ctxt ctxt);
  */
 int ne_delete(ne_ctxt ctxt, const char *objID, ne_location loc);
 
+/**
+ * Delete a list of objects, issuing block deletions for all of them concurrently
+ * @param ne_ctxt ctxt : The ne_ctxt used to access these data stripes
+ * @param ne_delete_target* targets : List of objects to be deleted ( the 'status' of each will be populated )
+ * @param size_t count : Number of elements in the targets list
+ * @param int max_parallel : Maximum number of concurrent block deletions ( zero for the libne default )
+ * @return int : Number of targets which failed to be deleted ( see their 'status' values ), or -1 on failure
+ */
+int ne_delete_batch(ne_ctxt ctxt, ne_delete_target *targets, size_t count, int max_parallel);
+
 /*
  ---  Per-Object Handle Creation/Destruction  ---
 */
@@ -244,7 +312,7 @@ ne_handle ne_stat(ne_ctxt ctxt, const char *objID, ne_location loc);
 /**
  * Converts a generic handle (produced by ne_stat()) into a handle for a specific operation
  * @param ne_handle handle : Reference to a generic handle (produced by ne_stat())
- * @param ne_mode mode : Mode to be set for handle (NE_RDONLY || NE_RDALL || NE_WRONLY || NE_WRALL || NE_REBUILD)
+ * @param ne_mode mode : Mode to be set for handle (NE_RDONLY || NE_RDALL || NE_RDHEDGE || NE_RDSPARSE || NE_WRONLY || NE_WRALL || NE_REBUILD)
  * @return ne_handle : Reference to the modified handle, or NULL if an error occured
  */
 ne_handle ne_convert_handle(ne_handle handle, ne_mode mode);
@@ -255,7 +323,7 @@ ne_handle ne_convert_handle(ne_handle handle, ne_mode mode);
  * @param const char* objID : ID of the object to be rebuilt
  * @param ne_location loc : Location of the object to be rebuilt
  * @param ne_erasure epat : Erasure pattern of the object to be rebuilt
- * @param ne_mode mode : Handle mode (NE_RDONLY || NE_RDALL || NE_WRONLY || NE_WRALL || NE_REBUILD)
+ * @param ne_mode mode : Handle mode (NE_RDONLY || NE_RDALL || NE_RDHEDGE || NE_RDSPARSE || NE_WRONLY || NE_WRALL || NE_REBUILD)
  * @return ne_handle : Newly created ne_handle, or NULL if an error occured
  */
 ne_handle ne_open(ne_ctxt ctxt, const char *objID, ne_location loc, ne_erasure epat, ne_mode mode);
@@ -292,6 +360,15 @@ int ne_abort(ne_handle handle);
  */
 int ne_get_info(ne_handle handle, ne_erasure *epat, ne_state *sref);
 
+/**
+ * Retrieve the latency breakdown of the ne_stat() call which produced the given handle
+ * @param ne_handle handle : Handle to retrieve timing info for
+ * @param ne_stat_timing* timing : Address of an ne_stat_timing struct to be populated
+ *                                 ( all zero, if the handle was not produced via ne_stat() )
+ * @return int : Zero on success, and -1 on a failure
+ */
+int ne_get_stat_timing(ne_handle handle, ne_stat_timing *timing);
+
 /**
  * Seed error patterns into a given handle (may useful for speeding up ne_rebuild())
  * @param ne_handle handle : Handle for which to set an error pattern
@@ -323,7 +400,7 @@ int ne_rebuild(ne_handle handle, ne_erasure *epat, ne_state *sref);
 off_t ne_seek(ne_handle handle, off_t offset);
 
 /**
- * Read from a given NE_RDONLY or NE_RDALL handle
+ * Read from a given NE_RDONLY, NE_RDALL, NE_RDHEDGE, or NE_RDSPARSE handle
  * @param ne_handle handle : The ne_handle reference to read from
  * @param void* buffer : Reference to a buffer to be filled with read data
  * @param size_t bytes : Number of bytes to be read
@@ -340,6 +417,17 @@ ssize_t ne_read(ne_handle handle, void *buffer, size_t bytes);
  */
 ssize_t ne_write(ne_handle handle, const void *buffer, size_t nbytes);
 
+/**
+ * Allow complete stripes written to the given NE_WRONLY / NE_WRALL handle to be taken directly from caller
+ * buffers, rather than copied
+ * NOTE -- While enabled, the caller must not modify or release any buffer passed to ne_write() until the handle
+ *         has been closed or aborted, or until this behavior has been disabled again.
+ * @param ne_handle handle : Handle to be updated
+ * @param char enable : Non-zero to enable zero-copy writes, or zero to disable them ( releasing all caller buffers )
+ * @return int : Zero on success, and -1 on failure
+ */
+int ne_set_zero_copy(ne_handle handle, char enable);
+
 #ifdef __cplusplus
 }
 #endif
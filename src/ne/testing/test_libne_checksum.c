@@ -0,0 +1,251 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+
+// Block checksum test
+//  Writes one object with crc32c checksums and one with the original crc32 checksums, then verifies
+//  that each is readable ( and that corruption is still detected ) regardless of the 'checksum'
+//  attribute of the reading context.
+
+#define CONFIG_FILE "./testing/checksum_config.xml"
+#define BLOCK_FMT "./CSUM_stripefile.%d.%s"
+
+unsigned char data_byte( size_t offset ) {
+   return (unsigned char)( ( offset * 7 ) + ( offset >> 11 ) );
+}
+
+int write_object( ne_ctxt ctxt, const char* objID, ne_erasure* epat, size_t totsz ) {
+   unsigned char* iobuff = malloc( totsz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+   size_t i;
+   for ( i = 0; i < totsz; i++ ) {
+      iobuff[i] = data_byte( i );
+   }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_handle handle = ne_open( ctxt, objID, loc, *epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle for \"%s\"!\n", objID );
+      free( iobuff );
+      return -1;
+   }
+   if ( ne_write( handle, iobuff, totsz ) != totsz ) {
+      printf( "ERROR: Unexpected return value from ne_write!\n" );
+      ne_abort( handle );
+      free( iobuff );
+      return -1;
+   }
+   free( iobuff );
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+// returns the number of erroneous blocks encountered, or -1 on failure
+int read_object( ne_ctxt ctxt, const char* objID, ne_erasure* epat, ne_mode mode, size_t totsz ) {
+   unsigned char* iobuff = malloc( totsz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_handle handle = ne_open( ctxt, objID, loc, *epat, mode );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a read handle for \"%s\"!\n", objID );
+      free( iobuff );
+      return -1;
+   }
+   if ( ne_read( handle, iobuff, totsz ) != totsz ) {
+      printf( "ERROR: Unexpected return value from ne_read!\n" );
+      ne_close( handle, NULL, NULL );
+      free( iobuff );
+      return -1;
+   }
+   size_t i;
+   for ( i = 0; i < totsz; i++ ) {
+      if ( iobuff[i] != data_byte( i ) ) {
+         printf( "ERROR: Data mismatch at offset %zu of \"%s\"!\n", i, objID );
+         ne_close( handle, NULL, NULL );
+         free( iobuff );
+         return -1;
+      }
+   }
+   free( iobuff );
+   int errcnt = ne_close( handle, NULL, NULL );
+   if ( errcnt < 0 ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+   }
+   return errcnt;
+}
+
+int main( int argc, char** argv ) {
+   xmlDoc* doc = NULL;
+   xmlNode* root_element = NULL;
+
+   LIBXML_TEST_VERSION
+
+   /*parse the file and get the DOM */
+   doc = xmlReadFile( CONFIG_FILE, NULL, XML_PARSE_NOBLANKS );
+   if ( doc == NULL ) {
+      printf( "error: could not parse file %s\n", CONFIG_FILE );
+      return -1;
+   }
+   root_element = xmlDocGetRootElement( doc );
+
+   ne_erasure epat = { .N = 4, .E = 1, .O = 2, .partsz = 8192 };
+   ne_location max_loc = { .pod = 1, .cap = 1, .scatter = 1 };
+   ne_ctxt cctxt = ne_init( root_element, max_loc, epat.N + epat.E, NULL );
+   if ( cctxt == NULL ) {
+      printf( "ERROR: Failed to initialize crc32c ne_ctxt!\n" );
+      return -1;
+   }
+   // a context lacking any 'checksum' attribute should continue to use crc32
+   xmlUnsetProp( root_element, (xmlChar*)"checksum" );
+   ne_ctxt lctxt = ne_init( root_element, max_loc, epat.N + epat.E, NULL );
+   if ( lctxt == NULL ) {
+      printf( "ERROR: Failed to initialize crc32 ne_ctxt!\n" );
+      return -1;
+   }
+   // unknown algorithms should be rejected
+   xmlSetProp( root_element, (xmlChar*)"checksum", (xmlChar*)"md5" );
+   ne_ctxt bctxt = ne_init( root_element, max_loc, epat.N + epat.E, NULL );
+   if ( bctxt != NULL ) {
+      printf( "ERROR: Unexpected success of ne_init with an unknown checksum!\n" );
+      return -1;
+   }
+   /* Free the xml Doc */
+   xmlFreeDoc( doc );
+   xmlCleanupParser();
+
+   size_t totsz = ( 3 * 1024 * 1024 ) + 777;
+   if ( write_object( cctxt, "crc32c", &epat, totsz ) ) { return -1; }
+   if ( write_object( lctxt, "crc32", &epat, totsz ) ) { return -1; }
+
+   // every object should be readable from either context
+   ne_ctxt ctxts[2] = { cctxt, lctxt };
+   const char* objIDs[2] = { "crc32c", "crc32" };
+   int c, o;
+   for ( c = 0; c < 2; c++ ) {
+      for ( o = 0; o < 2; o++ ) {
+         if ( read_object( ctxts[c], objIDs[o], &epat, NE_RDALL, totsz ) ) {
+            printf( "ERROR: Failed to cleanly read \"%s\" via context %d!\n", objIDs[o], c );
+            return -1;
+         }
+      }
+   }
+
+   // the meta info of the crc32c object should record its non-default algorithm
+   char path[128];
+   snprintf( path, sizeof(path), BLOCK_FMT ".meta", epat.O, objIDs[0] );
+   char metastr[256] = {0};
+   int fd = open( path, O_RDONLY );
+   if ( fd < 0  ||  read( fd, metastr, sizeof(metastr) - 1 ) <= 0 ) {
+      printf( "ERROR: Failed to read meta file \"%s\"!\n", path );
+      return -1;
+   }
+   close( fd );
+   if ( strncmp( metastr, "v3 ", 3 )  ||  strstr( metastr, " 1\n" ) == NULL ) {
+      printf( "ERROR: Unexpected meta info for crc32c block: \"%s\"\n", metastr );
+      return -1;
+   }
+
+   // corrupt a data block of each object, and make certain that corruption is detected
+   for ( o = 0; o < 2; o++ ) {
+      snprintf( path, sizeof(path), BLOCK_FMT, ( epat.O + 1 ) % ( epat.N + epat.E ), objIDs[o] );
+      fd = open( path, O_WRONLY );
+      if ( fd < 0  ||  pwrite( fd, "XXXX", 4, 100 ) != 4 ) {
+         printf( "ERROR: Failed to corrupt block file \"%s\"!\n", path );
+         return -1;
+      }
+      close( fd );
+      for ( c = 0; c < 2; c++ ) {
+         if ( read_object( ctxts[c], objIDs[o], &epat, NE_RDALL, totsz ) != 1 ) {
+            printf( "ERROR: Corruption of \"%s\" went undetected via context %d!\n", objIDs[o], c );
+            return -1;
+         }
+      }
+   }
+
+   // delete our test objects
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   for ( o = 0; o < 2; o++ ) {
+      if ( ne_delete( cctxt, objIDs[o], loc ) ) {
+         printf( "ERROR: Failed to delete object \"%s\"!\n", objIDs[o] );
+         return -1;
+      }
+   }
+   if ( ne_term( cctxt )  ||  ne_term( lctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+
+   return 0;
+}
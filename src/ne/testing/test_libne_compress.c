@@ -0,0 +1,299 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+
+#include "marfs_auto_config.h"
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// Block compression test
+//  Writes an object through a posix DAL configured with compress="1", then verifies that the
+//  stored blocks shrank and that the data survives sequential, seek, sparse, and degraded reads,
+//  as well as a rebuild of a missing block.
+
+#define CONFIG_FILE "./testing/compress_config.xml"
+#define BLOCK_FMT "./COMPRESS_stripefile.%d"
+
+// mostly compressible data, with one incompressible region in every four
+unsigned char data_byte( size_t offset ) {
+   if ( ( offset / 65536 ) % 4 == 3 ) {
+      uint64_t hash = offset * 0x9E3779B97F4A7C15ULL;
+      hash ^= hash >> 29;
+      hash *= 0xBF58476D1CE4E5B9ULL;
+      return (unsigned char)( hash >> 32 );
+   }
+   return (unsigned char)( 'a' + ( ( offset / 64 ) % 26 ) );
+}
+
+int verify_data( size_t offset, const unsigned char* buffer, size_t len ) {
+   size_t i;
+   for ( i = 0; i < len; i++ ) {
+      if ( buffer[i] != data_byte( offset + i ) ) {
+         printf( "ERROR: Data mismatch at offset %zu!\n", offset + i );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+int read_all( ne_ctxt ctxt, ne_location loc, ne_erasure* epat, ne_mode mode, size_t totsz, unsigned char* iobuff, size_t iosz ) {
+   ne_handle handle = ne_open( ctxt, "", loc, *epat, mode );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a read handle!\n" );
+      return -1;
+   }
+   size_t offset = 0;
+   while ( offset < totsz ) {
+      size_t toread = ( totsz - offset < iosz ) ? totsz - offset : iosz;
+      if ( ne_read( handle, iobuff, toread ) != toread ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         ne_close( handle, NULL, NULL );
+         return -1;
+      }
+      if ( verify_data( offset, iobuff, toread ) ) {
+         ne_close( handle, NULL, NULL );
+         return -1;
+      }
+      offset += toread;
+   }
+   int errcnt = ne_close( handle, NULL, NULL );
+   if ( errcnt < 0 ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   return errcnt;
+}
+
+int read_scattered( ne_ctxt ctxt, ne_location loc, ne_erasure* epat, ne_mode mode, size_t totsz, unsigned char* iobuff ) {
+   ne_handle handle = ne_open( ctxt, "", loc, *epat, mode );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a read handle!\n" );
+      return -1;
+   }
+   size_t offset = totsz / 3;
+   int i;
+   for ( i = 0; i < 64; i++ ) {
+      size_t toread = 100 + ( i * 37 );
+      offset = ( offset * 7 + 4093 ) % ( totsz - toread );
+      if ( ne_seek( handle, offset ) != offset ) {
+         printf( "ERROR: Failed to seek to offset %zu!\n", offset );
+         ne_close( handle, NULL, NULL );
+         return -1;
+      }
+      if ( ne_read( handle, iobuff, toread ) != toread ) {
+         printf( "ERROR: Unexpected return value from ne_read at offset %zu!\n", offset );
+         ne_close( handle, NULL, NULL );
+         return -1;
+      }
+      if ( verify_data( offset, iobuff, toread ) ) {
+         ne_close( handle, NULL, NULL );
+         return -1;
+      }
+   }
+   if ( ne_close( handle, NULL, NULL ) < 0 ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   return 0;
+}
+
+int main( int argc, char** argv ) {
+   xmlDoc* doc = NULL;
+   xmlNode* root_element = NULL;
+
+   LIBXML_TEST_VERSION
+
+   /*parse the file and get the DOM */
+   doc = xmlReadFile( CONFIG_FILE, NULL, XML_PARSE_NOBLANKS );
+   if ( doc == NULL ) {
+      printf( "error: could not parse file %s\n", CONFIG_FILE );
+      return -1;
+   }
+   root_element = xmlDocGetRootElement( doc );
+
+   ne_erasure epat = { .N = 10, .E = 2, .O = 3, .partsz = 4096 };
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_location max_loc = { .pod = 1, .cap = 1, .scatter = 1 };
+   ne_ctxt ctxt = ne_init( root_element, max_loc, epat.N + epat.E, NULL );
+   /* Free the xml Doc */
+   xmlFreeDoc( doc );
+   xmlCleanupParser();
+#ifndef HAVE_IGZIP
+   // compression is expected to be refused without isa-l igzip support
+   if ( ctxt != NULL ) {
+      printf( "ERROR: Compression was accepted without isa-l igzip support!\n" );
+      ne_term( ctxt );
+      return -1;
+   }
+   printf( "Skipping compression test, as isa-l igzip is unavailable\n" );
+   return 0;
+#else
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   size_t totsz = ( 5 * 1024 * 1024 ) + 12345;
+   size_t iosz = 100000;
+   unsigned char* iobuff = malloc( iosz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+
+   // write out our object
+   ne_handle handle = ne_open( ctxt, "", loc, epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   size_t offset = 0;
+   while ( offset < totsz ) {
+      size_t towrite = ( totsz - offset < iosz ) ? totsz - offset : iosz;
+      size_t i;
+      for ( i = 0; i < towrite; i++ ) {
+         iobuff[i] = data_byte( offset + i );
+      }
+      if ( ne_write( handle, iobuff, towrite ) != towrite ) {
+         printf( "ERROR: Unexpected return value from ne_write!\n" );
+         ne_abort( handle );
+         return -1;
+      }
+      offset += towrite;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // the stored blocks should be notably smaller than the data they hold
+   size_t stored = 0;
+   int block;
+   for ( block = 0; block < epat.N + epat.E; block++ ) {
+      char path[64];
+      struct stat st;
+      snprintf( path, sizeof(path), BLOCK_FMT, block );
+      if ( stat( path, &st ) ) {
+         printf( "ERROR: Failed to stat block file \"%s\"!\n", path );
+         return -1;
+      }
+      stored += st.st_size;
+   }
+   printf( "Stored %zu bytes for %zu bytes of data\n", stored, totsz );
+   if ( stored >= totsz ) {
+      printf( "ERROR: Compressed blocks are no smaller than the original data!\n" );
+      return -1;
+   }
+
+   // read back our data in every mode
+   if ( read_all( ctxt, loc, &epat, NE_RDONLY, totsz, iobuff, iosz ) ) { return -1; }
+   if ( read_all( ctxt, loc, &epat, NE_RDALL, totsz, iobuff, 7777 ) ) { return -1; }
+   if ( read_scattered( ctxt, loc, &epat, NE_RDONLY, totsz, iobuff ) ) { return -1; }
+   if ( read_scattered( ctxt, loc, &epat, NE_RDSPARSE, totsz, iobuff ) ) { return -1; }
+
+   // remove a data block, and make certain we can still read and rebuild it
+   char path[64];
+   snprintf( path, sizeof(path), BLOCK_FMT, ( epat.O + 1 ) % ( epat.N + epat.E ) );
+   if ( unlink( path ) ) {
+      printf( "ERROR: Failed to remove block file \"%s\"!\n", path );
+      return -1;
+   }
+   if ( read_all( ctxt, loc, &epat, NE_RDONLY, totsz, iobuff, iosz ) != 1 ) {
+      printf( "ERROR: Expected a single erroneous block when reading a damaged object!\n" );
+      return -1;
+   }
+   if ( read_scattered( ctxt, loc, &epat, NE_RDSPARSE, totsz, iobuff ) ) { return -1; }
+   handle = ne_open( ctxt, "", loc, epat, NE_REBUILD );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a rebuild handle!\n" );
+      return -1;
+   }
+   if ( ne_rebuild( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failed to rebuild the damaged object!\n" );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) < 0 ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   if ( read_all( ctxt, loc, &epat, NE_RDONLY, totsz, iobuff, iosz ) ) {
+      printf( "ERROR: Rebuilt object still contains errors!\n" );
+      return -1;
+   }
+
+   // delete our test object
+   if ( ne_delete( ctxt, "", loc ) ) {
+      printf( "ERROR: Failed to delete written object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+
+   return 0;
+#endif
+}
+
@@ -0,0 +1,262 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+
+#include "ne/ne.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+// Encode scaling benchmark
+//  Each thread writes through its own ne_handle ( all sharing a single ne_ctxt ) to a noop DAL,
+//  so runtime is dominated by erasure/crc generation.  Encode throughput should scale with the
+//  number of writer threads, up to the number of available cores.
+//  NOTE -- the noop DAL discards all data, so this verifies nothing and is not run as a 'make check' test.
+
+typedef struct bench_arg_struct
+{
+  ne_ctxt ctxt;
+  ne_erasure epat;
+  ne_location loc;
+  size_t iosz;
+  size_t iocnt;
+  int result;
+} bench_arg;
+
+void *write_thread(void *arg)
+{
+  bench_arg *barg = (bench_arg *)arg;
+  barg->result = -1;
+  void *iobuff = malloc(barg->iosz);
+  if (iobuff == NULL)
+  {
+    printf("ERROR: Failed to allocate space for an iobuffer!\n");
+    return NULL;
+  }
+  // non-zero data, to avoid any shortcuts on trivial input
+  size_t i;
+  for (i = 0; i < barg->iosz; i++)
+  {
+    ((unsigned char *)iobuff)[i] = (unsigned char)(i * 31 + 7);
+  }
+  ne_handle handle = ne_open(barg->ctxt, "", barg->loc, barg->epat, NE_WRALL);
+  if (handle == NULL)
+  {
+    printf("ERROR: Failed to open a write handle!\n");
+    free(iobuff);
+    return NULL;
+  }
+  for (i = 0; i < barg->iocnt; i++)
+  {
+    if (ne_write(handle, iobuff, barg->iosz) != barg->iosz)
+    {
+      printf("ERROR: Unexpected return value from ne_write!\n");
+      ne_abort(handle);
+      free(iobuff);
+      return NULL;
+    }
+  }
+  if (ne_close(handle, NULL, NULL) < 0)
+  {
+    printf("ERROR: Failure of ne_close!\n");
+    free(iobuff);
+    return NULL;
+  }
+  free(iobuff);
+  barg->result = 0;
+  return NULL;
+}
+
+int run_bench(ne_ctxt ctxt, ne_erasure epat, int tcnt, size_t iosz, size_t iocnt, double *gbps)
+{
+  pthread_t *threads = calloc(tcnt, sizeof(pthread_t));
+  bench_arg *args = calloc(tcnt, sizeof(bench_arg));
+  if (threads == NULL || args == NULL)
+  {
+    printf("ERROR: Failed to allocate thread structures!\n");
+    free(threads);
+    free(args);
+    return -1;
+  }
+  struct timeval beg;
+  struct timeval end;
+  gettimeofday(&beg, NULL);
+  int i;
+  int retval = 0;
+  for (i = 0; i < tcnt; i++)
+  {
+    args[i].ctxt = ctxt;
+    args[i].epat = epat;
+    args[i].loc.pod = 0;
+    args[i].loc.cap = 0;
+    args[i].loc.scatter = i;
+    args[i].iosz = iosz;
+    args[i].iocnt = iocnt;
+    if (pthread_create(&(threads[i]), NULL, write_thread, &(args[i])))
+    {
+      printf("ERROR: Failed to create writer thread %d!\n", i);
+      tcnt = i;
+      retval = -1;
+      break;
+    }
+  }
+  for (i = 0; i < tcnt; i++)
+  {
+    pthread_join(threads[i], NULL);
+    if (args[i].result)
+    {
+      retval = -1;
+    }
+  }
+  gettimeofday(&end, NULL);
+  double elapsed = (end.tv_sec - beg.tv_sec) + (end.tv_usec - beg.tv_usec) * 1e-6;
+  double bytes = (double)tcnt * iosz * iocnt;
+  *gbps = (elapsed > 0) ? (bytes / elapsed) / (1024.0 * 1024.0 * 1024.0) : 0.0;
+  free(threads);
+  free(args);
+  return retval;
+}
+
+int main(int argc, char **argv)
+{
+  // optional args : max thread count, MiB written per thread
+  int maxthreads = 4;
+  size_t mibpt = 64;
+  if (argc > 1)
+  {
+    maxthreads = atoi(argv[1]);
+  }
+  if (argc > 2)
+  {
+    mibpt = strtoul(argv[2], NULL, 10);
+  }
+  if (maxthreads < 1 || mibpt < 1)
+  {
+    printf("usage: %s [max_threads] [MiB_per_thread]\n", argv[0]);
+    return -1;
+  }
+
+  xmlDoc *doc = NULL;
+  xmlNode *root_element = NULL;
+
+  LIBXML_TEST_VERSION
+
+  /*parse the file and get the DOM */
+  doc = xmlReadFile("./testing/noop_config.xml", NULL, XML_PARSE_NOBLANKS);
+
+  if (doc == NULL)
+  {
+    printf("error: could not parse file %s\n", "./testing/noop_config.xml");
+    return -1;
+  }
+
+  /*Get the root element node */
+  root_element = xmlDocGetRootElement(doc);
+
+  ne_erasure epat = {.N = 10, .E = 2, .O = 0, .partsz = 1048572};
+  ne_location max_loc = {.pod = 1, .cap = 1, .scatter = maxthreads};
+  ne_ctxt ctxt = ne_init(root_element, max_loc, epat.N + epat.E, NULL);
+  if (ctxt == NULL)
+  {
+    printf("ERROR: Failed to initialize ne_ctxt!\n");
+    return -1;
+  }
+
+  // write full stripes, so that every iteration generates erasure
+  size_t iosz = epat.N * epat.partsz;
+  size_t iocnt = ((mibpt * 1024 * 1024) + iosz - 1) / iosz;
+
+  printf("Encode scaling ( N=%d E=%d partsz=%zu, %zu bytes per thread )\n", epat.N, epat.E, epat.partsz, iosz * iocnt);
+  double base = 0.0;
+  int tcnt;
+  for (tcnt = 1; tcnt <= maxthreads; tcnt *= 2)
+  {
+    double gbps = 0.0;
+    if (run_bench(ctxt, epat, tcnt, iosz, iocnt, &gbps))
+    {
+      printf("ERROR: Benchmark failed with %d threads!\n", tcnt);
+      return -1;
+    }
+    if (tcnt == 1)
+    {
+      base = gbps;
+    }
+    printf("   threads: %3d   encode rate: %8.3f GB/s   speedup: %6.2fx\n", tcnt, gbps, (base > 0) ? gbps / base : 0.0);
+  }
+
+  if (ne_term(ctxt))
+  {
+    printf("ERROR: Failure of ne_term!\n");
+    return -1;
+  }
+
+  /* Free the xml Doc */
+  xmlFreeDoc(doc);
+  /*
+   *Free the global variables that may
+   *have been allocated by the parser.
+   */
+  xmlCleanupParser();
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+
+#include "ne/ne.h"
+#include "dal/dal.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+
+// stripe layout of the test object ( reads of block 1, a data block, are stalled by hedge_config.xml )
+#define SLOW_BLOCK 1
+#define TEST_N 6
+#define TEST_E 2
+#define TEST_PARTSZ 4096
+#define TEST_IOCNT 128 // number of 16K reads of each block
+#define TEST_SIZE ( TEST_N * 16 * 1024 * TEST_IOCNT )
+#define TEST_HEDGE_USEC 1000
+
+
+// populate a buffer with a pattern unique to each byte offset of an object
+void fill_pattern( unsigned char* buffer, size_t size ) {
+   size_t i;
+   for ( i = 0; i < size; i++ ) {
+      buffer[i] = (unsigned char)( ( i * 7 ) + ( i / 4093 ) );
+   }
+}
+
+// look up the recorded read count of the slow block
+int slow_reads( ne_ctxt ctxt, unsigned long long* reads ) {
+   ne_location_score scores[TEST_N + TEST_E];
+   size_t count = ne_get_scoreboard( ctxt, scores, TEST_N + TEST_E );
+   if ( count > TEST_N + TEST_E ) { count = TEST_N + TEST_E; }
+   size_t i;
+   for ( i = 0; i < count; i++ ) {
+      if ( scores[i].block == SLOW_BLOCK ) {
+         *reads = scores[i].reads;
+         return 0;
+      }
+   }
+   printf( "ERROR: Scoreboard has no history for the slow block!\n" );
+   return -1;
+}
+
+
+int main( int argc, char** argv ) {
+   LIBXML_TEST_VERSION
+
+   unsigned char* data = malloc( TEST_SIZE );
+   unsigned char* readbuf = calloc( 1, TEST_SIZE );
+   if ( data == NULL  ||  readbuf == NULL ) {
+      printf( "ERROR: Failed to allocate data buffers!\n" );
+      return -1;
+   }
+   fill_pattern( data, TEST_SIZE );
+
+   xmlDoc* doc = xmlReadFile( "./testing/hedge_config.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( doc == NULL ) {
+      printf( "ERROR: Could not parse file ./testing/hedge_config.xml\n" );
+      return -1;
+   }
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( doc ), loc, TEST_N + TEST_E, NULL );
+   xmlFreeDoc( doc );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   // write out our test object
+   printf( "Writing out data stripe...\n" );
+   ne_erasure epat = { .N = TEST_N, .E = TEST_E, .O = 0, .partsz = TEST_PARTSZ };
+   ne_handle handle = ne_open( ctxt, "", loc, epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle!\n" );
+      return -1;
+   }
+   if ( ne_write( handle, data, TEST_SIZE ) != TEST_SIZE ) {
+      printf( "ERROR: Unexpected return value from ne_write!\n" );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // read half of it back via a hedged handle, which must reconstruct every stripe without the stalled block
+   printf( "Reading with a stalled data block and a %dus hedge delay...\n", TEST_HEDGE_USEC );
+   if ( ne_set_hedge_delay( ctxt, TEST_HEDGE_USEC ) ) {
+      printf( "ERROR: Failed to set hedge delay!\n" );
+      return -1;
+   }
+   handle = ne_open( ctxt, "", loc, epat, NE_RDHEDGE );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a hedged read handle!\n" );
+      return -1;
+   }
+   if ( ne_read( handle, readbuf, TEST_SIZE / 2 ) != TEST_SIZE / 2 ) {
+      printf( "ERROR: Unexpected return value from ne_read of the first half!\n" );
+      return -1;
+   }
+   unsigned long long reads = 0;
+   if ( slow_reads( ctxt, &reads ) ) { return -1; }
+   if ( reads ) {
+      printf( "ERROR: Stalled block completed %llu reads!\n", reads );
+      return -1;
+   }
+
+   // once released, the stalled block should remain halted, as it lags further behind than its ioqueue
+   //  could hold, rather than reading ( and discarding ) the remainder of its data
+   printf( "Releasing the stalled block...\n" );
+   sim_dal_release();
+   if ( ne_read( handle, readbuf + ( TEST_SIZE / 2 ), TEST_SIZE / 2 ) != TEST_SIZE / 2 ) {
+      printf( "ERROR: Unexpected return value from ne_read of the second half!\n" );
+      return -1;
+   }
+   if ( memcmp( readbuf, data, TEST_SIZE ) ) {
+      printf( "ERROR: Data mismatch on hedged read!\n" );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) < 0 ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+   if ( slow_reads( ctxt, &reads ) ) { return -1; }
+   printf( "   stalled block performed %llu of %d reads\n", reads, TEST_IOCNT );
+   if ( reads >= TEST_IOCNT / 4 ) {
+      printf( "ERROR: Lagging block was not halted!\n" );
+      return -1;
+   }
+
+   // cleanup
+   if ( ne_delete( ctxt, "", loc ) ) {
+      printf( "ERROR: Failed to delete test object!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( readbuf );
+   free( data );
+   xmlCleanupParser();
+   return 0;
+}
@@ -60,9 +60,12 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 
 
 #include "ne/ne.h"
+#include "io/io.h"
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <pthread.h>
 
 
 // sentinel values to ensure good data transfer
@@ -202,18 +205,21 @@ size_t verify_data( size_t prev_ver, size_t partsz, size_t buffsz, void* buffer
 
 
 
-int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
-   printf( "\nTesting basic libne capabilities with iosz=%zu / partsz=%zu\n", iosz, partsz );
+int test_values( ne_erasure* epat, size_t iosz, size_t partsz, char zcopy ) {
+   printf( "\nTesting basic libne capabilities with iosz=%zu / partsz=%zu%s\n", iosz, partsz, ( zcopy ) ? " ( zero-copy writes )" : "" );
 
+   int iocnt = 10;
    void* iobuff = malloc( iosz );
-   if ( iobuff == NULL ) {
+   // zero-copy writes require that every written buffer remain intact, so give each write its own
+   void* zcbuff = ( zcopy ) ? malloc( iosz * iocnt ) : NULL;
+   if ( iobuff == NULL  ||  ( zcopy  &&  zcbuff == NULL ) ) {
       printf( "ERROR: FFailed to allocate space for an iobuffer!\n" );
       return -1;
    }
 
-   // create a new libne ctxt
+   // create a new libne ctxt, allowing for more blocks than we write ( so ne_stat() must find the stripe width )
    ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
-   ne_ctxt ctxt = ne_path_init ( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E , NULL);
+   ne_ctxt ctxt = ne_path_init ( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E + 4, NULL);
    if ( ctxt == NULL ) {
       printf( "ERROR: Failed to initialize ne_ctxt!\n" );
       return -1;
@@ -226,17 +232,29 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
       printf( "ERROR: Failed to open a write handle!\n" );
       return -1;
    }
+   if ( zcopy  &&  ne_set_zero_copy( write_handle, 1 ) ) {
+      printf( "ERROR: Failed to enable zero-copy writes!\n" );
+      return -1;
+   }
    // write out data
-   int iocnt = 10;
    int i;
    for ( i = 0; i < iocnt; i++ ) {
+      void* wbuff = ( zcopy ) ? zcbuff + ( iosz * i ) : iobuff;
+      // once zero-copy is disabled, no previously written buffer may still be referenced
+      if ( zcopy  &&  i == iocnt - 1 ) {
+         if ( ne_set_zero_copy( write_handle, 0 ) ) {
+            printf( "ERROR: Failed to disable zero-copy writes!\n" );
+            return -1;
+         }
+         memset( zcbuff, 0, iosz * i );
+      }
       // populate our data buffer
-      if ( iosz != fill_buffer( iosz * i, iosz, partsz, iobuff ) ) {
+      if ( iosz != fill_buffer( iosz * i, iosz, partsz, wbuff ) ) {
          printf( "ERROR: Failed to populate data buffer!\n" );
          return -1;
       }
       // write our data buffer
-      if ( iosz != ne_write( write_handle, iobuff, iosz ) ) {
+      if ( iosz != ne_write( write_handle, wbuff, iosz ) ) {
          printf( "ERROR: Unexpected return value from ne_write!\n" );
          return -1;
       }
@@ -324,6 +342,94 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
       return -1;
    }
 
+   // open a hedged read handle, which never waits on slow data blocks, to verify our data
+   printf( "...Verifying written data (RDHEDGE)...\n" );
+   if ( ne_set_hedge_delay( ctxt, 0 ) ) {
+      printf( "ERROR: Failed to set hedge delay!\n" );
+      return -1;
+   }
+   read_handle = ne_open( ctxt, "", cur_loc, *epat, NE_RDHEDGE );
+   if ( read_handle == NULL ) {
+      printf( "ERROR: Failed to open a hedged read handle!\n" );
+      return -1;
+   }
+   // read out data
+   for ( i = 0; i < iocnt; i++ ) {
+      // read our into our data buffer
+      if ( iosz != ne_read( read_handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      // populate our data buffer
+      if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+         printf( "ERROR: Failed to populate data buffer!\n" );
+         return -1;
+      }
+   }
+   // reseek, and verify our data once again
+   if ( ne_seek( read_handle, 0 ) != 0 ) {
+      printf( "ERROR: Failed to reseek hedged read handle!\n" );
+      return -1;
+   }
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != ne_read( read_handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+         printf( "ERROR: Failed to populate data buffer!\n" );
+         return -1;
+      }
+   }
+   // close our handle
+   if ( ne_close( read_handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
+   // open a sparse read handle, and verify small reads scattered throughout our data
+   printf( "...Verifying written data (RDSPARSE)...\n" );
+   read_handle = ne_open( ctxt, "", cur_loc, *epat, NE_RDSPARSE );
+   if ( read_handle == NULL ) {
+      printf( "ERROR: Failed to open a sparse read handle!\n" );
+      return -1;
+   }
+   size_t sparsesz = 1000;
+   for ( i = 0; i < 32; i++ ) {
+      off_t sparseoff = (off_t)( ( (size_t)i * 2654435761UL ) % ( (iosz * iocnt) - sparsesz ) );
+      if ( ne_seek( read_handle, sparseoff ) != sparseoff ) {
+         printf( "ERROR: Failed to seek sparse read handle to offset %zd!\n", sparseoff );
+         return -1;
+      }
+      if ( sparsesz != ne_read( read_handle, iobuff, sparsesz ) ) {
+         printf( "ERROR: Unexpected return value from sparse ne_read!\n" );
+         return -1;
+      }
+      if ( sparsesz != verify_data( sparseoff, partsz, sparsesz, iobuff ) ) {
+         printf( "ERROR: Failed to verify sparse read at offset %zd!\n", sparseoff );
+         return -1;
+      }
+   }
+   // sequential reads should work just as well
+   if ( ne_seek( read_handle, 0 ) != 0 ) {
+      printf( "ERROR: Failed to reseek sparse read handle!\n" );
+      return -1;
+   }
+   for ( i = 0; i < iocnt; i++ ) {
+      if ( iosz != ne_read( read_handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_read!\n" );
+         return -1;
+      }
+      if ( iosz != verify_data( iosz * i, partsz, iosz, iobuff ) ) {
+         printf( "ERROR: Failed to populate data buffer!\n" );
+         return -1;
+      }
+   }
+   if ( ne_close( read_handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close!\n" );
+      return -1;
+   }
+
    // open a handle by stating (no epat struct)
    printf( "...Verifying written data (NE_STAT/RD_ONLY)...\n" );
    ne_handle stat_handle = ne_stat( ctxt, "", cur_loc );
@@ -331,6 +437,17 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
       printf( "ERROR: Failed to open a ne_stat handle!\n" );
       return -1;
    }
+   // check that exactly the blocks of our stripe were probed, and that a latency breakdown was recorded
+   ne_stat_timing stimes;
+   if ( ne_get_stat_timing( stat_handle, &stimes ) ) {
+      printf( "ERROR: Failed to retrieve ne_stat timing info!\n" );
+      return -1;
+   }
+   printf( "   stat took %.0fus ( probed %d blocks via %d threads in %.0fus )\n", stimes.total, stimes.probes, stimes.threads, stimes.probe );
+   if ( stimes.probes != epat->N + epat->E  ||  stimes.threads < 1  ||  stimes.total < stimes.probe ) {
+      printf( "ERROR: Unexpected ne_stat timing info!\n" );
+      return -1;
+   }
    // convert to a RD_ONLY handle
    read_handle = ne_convert_handle( stat_handle, NE_RDONLY );
    if ( read_handle == NULL ) {
@@ -356,6 +473,25 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
       return -1;
    }
 
+   // check that the health history of every block location was recorded
+   ne_location_score* scores = calloc( epat->N + epat->E, sizeof(ne_location_score) );
+   if ( scores == NULL ) {
+      printf( "ERROR: Failed to allocate scoreboard entries!\n" );
+      return -1;
+   }
+   if ( ne_get_scoreboard( ctxt, scores, epat->N + epat->E ) != (size_t)(epat->N + epat->E) ) {
+      printf( "ERROR: Scoreboard is tracking an unexpected number of block locations!\n" );
+      return -1;
+   }
+   for ( i = 0; i < epat->N + epat->E; i++ ) {
+      if ( scores[i].writes == 0  ||  scores[i].reads == 0  ||  scores[i].errors ) {
+         printf( "ERROR: Unexpected scoreboard history for block %d ( %llu writes, %llu reads, %llu errors )\n",
+                 scores[i].block, scores[i].writes, scores[i].reads, scores[i].errors );
+         return -1;
+      }
+   }
+   free( scores );
+
    // delete our test object
    if ( ne_delete( ctxt, "", cur_loc ) ) {
       printf( "ERROR: Failed to delete written object!\n" );
@@ -364,6 +500,107 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
 
 
    // close our ne_ctxt
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( iobuff );
+   free( zcbuff );
+
+   return 0;
+}
+
+int test_delete_batch( ne_erasure* epat ) {
+   printf( "\nTesting batched deletion of several objects\n" );
+
+   size_t iosz = epat->N * epat->partsz * 3;
+   void* iobuff = malloc( iosz );
+   if ( iobuff == NULL ) {
+      printf( "ERROR: Failed to allocate space for an iobuffer!\n" );
+      return -1;
+   }
+   if ( iosz != fill_buffer( 0, iosz, epat->partsz, iobuff ) ) {
+      printf( "ERROR: Failed to populate data buffer!\n" );
+      return -1;
+   }
+
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_path_init ( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E, NULL );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+
+   // write out several objects
+   const char* objIDs[3] = { "batch0", "batch1", "batch2" };
+   int i;
+   for ( i = 0; i < 3; i++ ) {
+      ne_handle write_handle = ne_open( ctxt, objIDs[i], cur_loc, *epat, NE_WRALL );
+      if ( write_handle == NULL ) {
+         printf( "ERROR: Failed to open a write handle for \"%s\"!\n", objIDs[i] );
+         return -1;
+      }
+      if ( iosz != ne_write( write_handle, iobuff, iosz ) ) {
+         printf( "ERROR: Unexpected return value from ne_write of \"%s\"!\n", objIDs[i] );
+         return -1;
+      }
+      if ( ne_close( write_handle, NULL, NULL ) ) {
+         printf( "ERROR: Failure of ne_close for \"%s\"!\n", objIDs[i] );
+         return -1;
+      }
+   }
+
+   // delete them in a single batch, along with an absent object and one beyond our context's bounds
+   ne_location bad_loc = { .pod = 1, .cap = 0, .scatter = 0 };
+   ne_delete_target targets[5] = {
+      { .objID = objIDs[0], .loc = cur_loc, .status = -1 },
+      { .objID = "absent", .loc = cur_loc, .status = -1 },
+      { .objID = objIDs[1], .loc = cur_loc, .status = -1 },
+      { .objID = objIDs[2], .loc = bad_loc, .status = -1 },
+      { .objID = objIDs[2], .loc = cur_loc, .status = -1 }
+   };
+   // use fewer threads than there are block deletions
+   int res = ne_delete_batch( ctxt, targets, 5, 2 );
+   if ( res != 1 ) {
+      printf( "ERROR: Unexpected ne_delete_batch result of %d ( expected a single failure )!\n", res );
+      return -1;
+   }
+   for ( i = 0; i < 5; i++ ) {
+      // missing blocks are not an error for the posix DAL, but locations beyond its limits are
+      int expected = ( i == 3 ) ? EDOM : 0;
+      if ( targets[i].status != expected ) {
+         printf( "ERROR: Unexpected status of delete target %d ( \"%s\" ) : %d ( expected %d )!\n",
+                 i, targets[i].objID, targets[i].status, expected );
+         return -1;
+      }
+   }
+   for ( i = 0; i < 3; i++ ) {
+      ne_handle stat_handle = ne_stat( ctxt, objIDs[i], cur_loc );
+      if ( stat_handle != NULL ) {
+         printf( "ERROR: Object \"%s\" survived batched deletion!\n", objIDs[i] );
+         return -1;
+      }
+   }
+
+   // a parallelism beyond the total number of block deletions is clamped, and repeated deletion succeeds
+   res = ne_delete_batch( ctxt, targets, 3, 1000 );
+   if ( res != 0  ||  targets[0].status  ||  targets[1].status  ||  targets[2].status ) {
+      printf( "ERROR: Unexpected result of repeated batched deletion ( %d )!\n", res );
+      return -1;
+   }
+
+   // invalid arguments are rejected outright
+   errno = 0;
+   if ( ne_delete_batch( ctxt, targets, 1, -1 ) != -1  ||  errno != EINVAL ) {
+      printf( "ERROR: ne_delete_batch accepted a negative max_parallel value!\n" );
+      return -1;
+   }
+   errno = 0;
+   if ( ne_delete_batch( ctxt, NULL, 1, 0 ) != -1  ||  errno != EINVAL ) {
+      printf( "ERROR: ne_delete_batch accepted a NULL targets list!\n" );
+      return -1;
+   }
+
    if ( ne_term( ctxt ) ) {
       printf( "ERROR: Failure of ne_term!\n" );
       return -1;
@@ -375,17 +612,146 @@ int test_values( ne_erasure* epat, size_t iosz, size_t partsz ) {
 
 
 
+typedef struct admit_args_struct {
+   ne_ctxt ctxt;
+   ne_erasure epat;
+   ne_handle handle;
+} admit_args;
+
+void* admit_thread( void* arg ) {
+   admit_args* args = (admit_args*)arg;
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   args->handle = ne_open( args->ctxt, "admit1", cur_loc, args->epat, NE_WRALL );
+   return NULL;
+}
+
+int test_admission( ne_erasure* epat ) {
+   printf( "\nTesting IO thread pool admission of handles\n" );
+
+   ne_location cur_loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_path_init ( "./test_libne_io.block{b}.pod{p}.cap{c}.scatter{s}", cur_loc, epat->N + epat->E, NULL );
+   if ( ctxt == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt!\n" );
+      return -1;
+   }
+   // only admit a single handle at a time
+   unsigned int width = epat->N + epat->E;
+   if ( iothread_pool_set_limit( width ) ) {
+      printf( "ERROR: Failed to limit the IO thread pool!\n" );
+      return -1;
+   }
+
+   ne_handle first = ne_open( ctxt, "admit0", cur_loc, *epat, NE_WRALL );
+   if ( first == NULL ) {
+      printf( "ERROR: Failed to open the first handle!\n" );
+      return -1;
+   }
+   // a thread which already holds a handle is admitted beyond the limit, rather than deadlocking itself
+   ne_handle nested = ne_open( ctxt, "admit1", cur_loc, *epat, NE_WRALL );
+   if ( nested == NULL ) {
+      printf( "ERROR: Failed to open a nested handle beyond the pool limit!\n" );
+      return -1;
+   }
+   if ( ne_abort( nested ) ) {
+      printf( "ERROR: Failed to abort the nested handle!\n" );
+      return -1;
+   }
+
+   // any other thread must wait for the first handle to release its slots
+   admit_args args = { .ctxt = ctxt, .epat = *epat, .handle = NULL };
+   pthread_t thread;
+   if ( pthread_create( &thread, NULL, admit_thread, &args ) ) {
+      printf( "ERROR: Failed to create the admission thread!\n" );
+      return -1;
+   }
+   unsigned int reserved = 0;
+   unsigned int waiting = 0;
+   while ( waiting == 0 ) {
+      usleep( 1000 );
+      iothread_pool_counts( NULL, NULL, &reserved, &waiting );
+   }
+   if ( reserved != width ) {
+      printf( "ERROR: Unexpected pool reservation while a handle is waiting ( %u reserved / %u expected )!\n", reserved, width );
+      return -1;
+   }
+   if ( ne_abort( first ) ) {
+      printf( "ERROR: Failed to abort the first handle!\n" );
+      return -1;
+   }
+   pthread_join( thread, NULL );
+   if ( args.handle == NULL ) {
+      printf( "ERROR: Failed to open a handle once admitted!\n" );
+      return -1;
+   }
+   if ( ne_abort( args.handle ) ) {
+      printf( "ERROR: Failed to abort the admitted handle!\n" );
+      return -1;
+   }
+
+   // helper threads only use spare slots, so a full pool serializes deletion rather than blocking it
+   iothread_pool_reserve( width, 0 );
+   ne_delete_target targets[2] = {
+      { .objID = "admit0", .loc = cur_loc, .status = -1 },
+      { .objID = "admit1", .loc = cur_loc, .status = -1 }
+   };
+   if ( ne_delete_batch( ctxt, targets, 2, 4 ) ) {
+      printf( "ERROR: Failure of ne_delete_batch with a full IO thread pool!\n" );
+      return -1;
+   }
+   iothread_pool_release( width );
+
+   if ( iothread_pool_set_limit( IOTHREAD_POOL_MAX_ACTIVE ) ) {
+      printf( "ERROR: Failed to restore the IO thread pool limit!\n" );
+      return -1;
+   }
+   if ( ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+
+   return 0;
+}
+
+
+
 int main( int argc, char** argv ) {
    // Test with a small partsz and larger, aligned iosz
    size_t iosz = 8196;
    size_t partsz = 4096;
    ne_erasure epat = { .N = 10, .E = 2, .O = 1, .partsz = 1024 };
-   if ( test_values( &epat, iosz, partsz ) ) { return -1; }
+   if ( test_values( &epat, iosz, partsz, 0 ) ) { return -1; }
    // Test with a larger partsz and much larger iosz
    partsz = 524288;
    iosz = 1048576;
    epat.partsz = partsz;
-   if ( test_values( &epat, iosz, partsz ) ) { return -1; }
+   if ( test_values( &epat, iosz, partsz, 0 ) ) { return -1; }
+   // Test with a small partsz and an unaligned iosz spanning many complete stripes, with and without zero-copy writes
+   partsz = 4096;
+   iosz = ( 10 * 64 * partsz ) + 1000;
+   epat.partsz = partsz;
+   if ( test_values( &epat, iosz, partsz, 0 ) ) { return -1; }
+   if ( test_values( &epat, iosz, partsz, 1 ) ) { return -1; }
+   // Test with a single partsz per IO and an iosz of exactly two complete stripes, with and without zero-copy writes
+   partsz = 1048572;
+   iosz = 2 * 10 * partsz;
+   epat.partsz = partsz;
+   if ( test_values( &epat, iosz, partsz, 0 ) ) { return -1; }
+   if ( test_values( &epat, iosz, partsz, 1 ) ) { return -1; }
+   // Test deletion of several objects at once
+   epat.partsz = 4096;
+   if ( test_delete_batch( &epat ) ) { return -1; }
+   // Test that handles beyond the IO thread pool limit wait for admission
+   if ( test_admission( &epat ) ) { return -1; }
+
+   // all handles are closed, so every IO thread should have been returned to the shared pool
+   unsigned int active = 0;
+   unsigned int idle = 0;
+   unsigned int reserved = 0;
+   iothread_pool_counts( &active, &idle, &reserved, NULL );
+   if ( active  ||  reserved  ||  idle == 0  ||  idle > IOTHREAD_POOL_MAX_IDLE ) {
+      printf( "error: unexpected IO thread pool state ( %u active / %u idle / %u reserved )\n", active, idle, reserved );
+      return -1;
+   }
 
    return 0;
 }
@@ -0,0 +1,286 @@
+/*
+Copyright (c) 2015, Los Alamos National Security, LLC
+All rights reserved.
+
+Copyright 2015.  Los Alamos National Security, LLC. This software was produced
+under U.S. Government contract DE-AC52-06NA25396 for Los Alamos National
+Laboratory (LANL), which is operated by Los Alamos National Security, LLC for
+the U.S. Department of Energy. The U.S. Government has rights to use, reproduce,
+and distribute this software.  NEITHER THE GOVERNMENT NOR LOS ALAMOS NATIONAL
+SECURITY, LLC MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY LIABILITY
+FOR THE USE OF THIS SOFTWARE.  If software is modified to produce derivative
+works, such modified software should be clearly marked, so as not to confuse it
+with the version available from LANL.
+ 
+Additionally, redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+3. Neither the name of Los Alamos National Security, LLC, Los Alamos National
+Laboratory, LANL, the U.S. Government, nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY LOS ALAMOS NATIONAL SECURITY, LLC AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL LOS ALAMOS NATIONAL SECURITY, LLC OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+-----
+NOTE:
+-----
+Although these files reside in a seperate repository, they fall under the MarFS copyright and license.
+
+MarFS is released under the BSD license.
+
+MarFS was reviewed and released by LANL under Los Alamos Computer Code identifier:
+LA-CC-15-039.
+
+These erasure utilites make use of the Intel Intelligent Storage
+Acceleration Library (Intel ISA-L), which can be found at
+https://github.com/01org/isa-l and is under its own license.
+
+MarFS uses libaws4c for Amazon S3 object communication. The original version
+is at https://aws.amazon.com/code/Amazon-S3/2601 and under the LGPL license.
+LANL added functionality to the original work. The original work plus
+LANL contributions is found at https://github.com/jti-lanl/aws4c.
+
+GNU licenses can be found at http://www.gnu.org/licenses/.
+*/
+
+
+#include "ne/ne.h"
+#include "dal/dal.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+
+// stripe layout of all test objects ( block 1, a data block, is corrupted in one of them )
+#define BAD_BLOCK 1
+#define TEST_N 6
+#define TEST_E 2
+#define TEST_PARTSZ 4096
+#define TEST_SIZE ( TEST_N * 64 * 1024 * 8 ) // eight 64K reads of each block
+#define TEST_MAX_PASSES 16 // reads of the corrupted object allowed before its bad block must be avoided
+
+
+// populate a buffer with a pattern unique to each byte offset of an object
+void fill_pattern( unsigned char* buffer, size_t size ) {
+   size_t i;
+   for ( i = 0; i < size; i++ ) {
+      buffer[i] = (unsigned char)( ( i * 7 ) + ( i / 4093 ) );
+   }
+}
+
+// look up the recorded read and error counts of the given block location
+int block_history( ne_ctxt ctxt, int block, unsigned long long* reads, unsigned long long* errors ) {
+   ne_location_score scores[TEST_N + TEST_E];
+   size_t count = ne_get_scoreboard( ctxt, scores, TEST_N + TEST_E );
+   if ( count > TEST_N + TEST_E ) { count = TEST_N + TEST_E; }
+   size_t i;
+   for ( i = 0; i < count; i++ ) {
+      if ( scores[i].block == block ) {
+         *reads = scores[i].reads;
+         if ( errors ) { *errors = scores[i].errors; }
+         return 0;
+      }
+   }
+   printf( "ERROR: Scoreboard has no history for block %d!\n", block );
+   return -1;
+}
+
+// write out a complete test object
+int write_object( ne_ctxt ctxt, const char* objID, ne_location loc, unsigned char* data ) {
+   ne_erasure epat = { .N = TEST_N, .E = TEST_E, .O = 0, .partsz = TEST_PARTSZ };
+   ne_handle handle = ne_open( ctxt, objID, loc, epat, NE_WRALL );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open a write handle for \"%s\"!\n", objID );
+      return -1;
+   }
+   if ( ne_write( handle, data, TEST_SIZE ) != TEST_SIZE ) {
+      printf( "ERROR: Unexpected return value from ne_write of \"%s\"!\n", objID );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) ) {
+      printf( "ERROR: Failure of ne_close for \"%s\"!\n", objID );
+      return -1;
+   }
+   return 0;
+}
+
+// read back and verify a complete test object, via a NE_RDONLY handle
+int verify_object( ne_ctxt ctxt, const char* objID, ne_location loc, unsigned char* data, unsigned char* readbuf ) {
+   ne_handle handle = ne_stat( ctxt, objID, loc );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to stat \"%s\"!\n", objID );
+      return -1;
+   }
+   handle = ne_convert_handle( handle, NE_RDONLY );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to convert \"%s\" to a read handle!\n", objID );
+      return -1;
+   }
+   memset( readbuf, 0, TEST_SIZE );
+   if ( ne_read( handle, readbuf, TEST_SIZE ) != TEST_SIZE ) {
+      printf( "ERROR: Unexpected return value from ne_read of \"%s\"!\n", objID );
+      return -1;
+   }
+   if ( memcmp( readbuf, data, TEST_SIZE ) ) {
+      printf( "ERROR: Data mismatch on read of \"%s\"!\n", objID );
+      return -1;
+   }
+   if ( ne_close( handle, NULL, NULL ) < 0 ) {
+      printf( "ERROR: Failure of ne_close for \"%s\"!\n", objID );
+      return -1;
+   }
+   return 0;
+}
+
+// remove the given blocks of an object, directly via a DAL
+int lose_blocks( DAL dal, const char* objID, ne_location loc, int first, int count ) {
+   int block;
+   for ( block = first; block < first + count; block++ ) {
+      DAL_location dloc = { .pod = loc.pod, .cap = loc.cap, .block = block, .scatter = loc.scatter };
+      if ( dal->del( dal->ctxt, dloc, objID ) ) {
+         printf( "ERROR: Failed to delete block %d of \"%s\"!\n", block, objID );
+         return -1;
+      }
+   }
+   return 0;
+}
+
+// corrupt every byte of the data of a single block, leaving its meta info intact
+int corrupt_block( DAL dal, const char* objID, ne_location loc, int block, unsigned char* buffer ) {
+   DAL_location dloc = { .pod = loc.pod, .cap = loc.cap, .block = block, .scatter = loc.scatter };
+   BLOCK_CTXT handle = dal->open( dal->ctxt, DAL_READ, dloc, objID );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open block %d of \"%s\" for read!\n", block, objID );
+      return -1;
+   }
+   meta_info minfo;
+   ssize_t size = -1;
+   if ( dal->get_meta( handle, &minfo ) == 0 ) { size = dal->get( handle, buffer, TEST_SIZE, 0 ); }
+   if ( dal->close( handle )  ||  size <= 0 ) {
+      printf( "ERROR: Failed to read back block %d of \"%s\"!\n", block, objID );
+      return -1;
+   }
+   ssize_t i;
+   for ( i = 0; i < size; i++ ) { buffer[i] = ~(buffer[i]); }
+   handle = dal->open( dal->ctxt, DAL_WRITE, dloc, objID );
+   if ( handle == NULL ) {
+      printf( "ERROR: Failed to open block %d of \"%s\" for write!\n", block, objID );
+      return -1;
+   }
+   if ( dal->put( handle, buffer, size )  ||  dal->set_meta( handle, &minfo )  ||  dal->close( handle ) ) {
+      printf( "ERROR: Failed to replace block %d of \"%s\"!\n", block, objID );
+      return -1;
+   }
+   return 0;
+}
+
+
+int main( int argc, char** argv ) {
+   LIBXML_TEST_VERSION
+
+   unsigned char* data = malloc( TEST_SIZE );
+   unsigned char* readbuf = malloc( TEST_SIZE );
+   if ( data == NULL  ||  readbuf == NULL ) {
+      printf( "ERROR: Failed to allocate data buffers!\n" );
+      return -1;
+   }
+   fill_pattern( data, TEST_SIZE );
+
+   xmlDoc* doc = xmlReadFile( "./testing/scoreboard_config.xml", NULL, XML_PARSE_NOBLANKS );
+   if ( doc == NULL ) {
+      printf( "ERROR: Could not parse file ./testing/scoreboard_config.xml\n" );
+      return -1;
+   }
+   // the Sim DAL object store is shared by all DAL instances, so our extra DAL may damage objects of our ne_ctxt
+   ne_location loc = { .pod = 0, .cap = 0, .scatter = 0 };
+   ne_ctxt ctxt = ne_init( xmlDocGetRootElement( doc ), loc, TEST_N + TEST_E, NULL );
+   DAL_location maxloc = { .pod = 0, .cap = 0, .block = TEST_N + TEST_E - 1, .scatter = 0 };
+   DAL dal = init_dal( xmlDocGetRootElement( doc ), maxloc );
+   xmlFreeDoc( doc );
+   if ( ctxt == NULL  ||  dal == NULL ) {
+      printf( "ERROR: Failed to initialize ne_ctxt / DAL!\n" );
+      return -1;
+   }
+
+   // write out all objects first, as successful writes to the bad location would dilute its error history
+   if ( write_object( ctxt, "bad", loc, data )  ||  write_object( ctxt, "skip", loc, data )  ||
+        write_object( ctxt, "revive", loc, data ) ) { return -1; }
+   if ( corrupt_block( dal, "bad", loc, BAD_BLOCK, readbuf ) ) { return -1; }
+   if ( lose_blocks( dal, "revive", loc, BAD_BLOCK + 1, TEST_E ) ) { return -1; }
+
+   // every read of the bad block now fails verification, until its location is avoided entirely
+   printf( "Reading with a corrupted data block...\n" );
+   unsigned long long badreads = 0;
+   unsigned long long baderrs = 0;
+   unsigned long long reads = 0;
+   unsigned long long errors = 0;
+   int pass;
+   for ( pass = 0; pass < TEST_MAX_PASSES; pass++ ) {
+      if ( verify_object( ctxt, "bad", loc, data, readbuf ) ) { return -1; }
+      if ( block_history( ctxt, BAD_BLOCK, &reads, &errors ) ) { return -1; }
+      if ( pass  &&  reads == badreads ) { break; }
+      if ( errors <= baderrs ) {
+         printf( "ERROR: Read of the corrupted block was not recorded as an error!\n" );
+         return -1;
+      }
+      badreads = reads;
+      baderrs = errors;
+   }
+   if ( pass == TEST_MAX_PASSES ) {
+      printf( "ERROR: Corrupted block was never avoided ( %llu errors recorded )!\n", baderrs );
+      return -1;
+   }
+
+   // the history belongs to the location, so intact objects should avoid the block as well
+   printf( "Reading an intact object with the failing block avoided...\n" );
+   unsigned long long ereads = 0;
+   if ( block_history( ctxt, TEST_N, &ereads, NULL ) ) { return -1; }
+   if ( verify_object( ctxt, "skip", loc, data, readbuf ) ) { return -1; }
+   if ( block_history( ctxt, BAD_BLOCK, &reads, NULL ) ) { return -1; }
+   if ( reads != badreads ) {
+      printf( "ERROR: Failing block was read while it should have been avoided ( %llu reads, previously %llu )!\n", reads, badreads );
+      return -1;
+   }
+   if ( block_history( ctxt, TEST_N, &reads, NULL ) ) { return -1; }
+   if ( reads <= ereads ) {
+      printf( "ERROR: Erasure was not read in place of the avoided block!\n" );
+      return -1;
+   }
+
+   // with E other blocks lost, the avoided block must be read after all
+   printf( "Reading with the failing block avoided and %d other blocks lost...\n", TEST_E );
+   if ( verify_object( ctxt, "revive", loc, data, readbuf ) ) { return -1; }
+   if ( block_history( ctxt, BAD_BLOCK, &reads, NULL ) ) { return -1; }
+   if ( reads <= badreads ) {
+      printf( "ERROR: Avoided block was not revived to cope with additional errors!\n" );
+      return -1;
+   }
+
+   // cleanup
+   if ( ne_delete( ctxt, "bad", loc )  ||  ne_delete( ctxt, "skip", loc )  ||  ne_delete( ctxt, "revive", loc ) ) {
+      printf( "ERROR: Failed to delete test objects!\n" );
+      return -1;
+   }
+   if ( dal->cleanup( dal )  ||  ne_term( ctxt ) ) {
+      printf( "ERROR: Failure of ne_term!\n" );
+      return -1;
+   }
+   free( readbuf );
+   free( data );
+   xmlCleanupParser();
+   return 0;
+}
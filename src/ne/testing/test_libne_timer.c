@@ -481,37 +481,43 @@ int main(int argc, char **argv)
    */
   LIBXML_TEST_VERSION
 
-  /*parse the file and get the DOM */
-  doc = xmlReadFile("./testing/timer_config.xml", NULL, XML_PARSE_NOBLANKS);
-
-  if (doc == NULL)
+  // Test with the default ioqueue depth, then with a deeper queue inherited through the timer DAL
+  const char *configs[2] = {"./testing/timer_config.xml", "./testing/timer_iodepth_config.xml"};
+  int cfg;
+  for (cfg = 0; cfg < 2; cfg++)
   {
-    printf("error: could not parse file %s\n", "./dal/testing/timer_config.xml");
-    return -1;
-  }
+    /*parse the file and get the DOM */
+    doc = xmlReadFile(configs[cfg], NULL, XML_PARSE_NOBLANKS);
 
-  /*Get the root element node */
-  root_element = xmlDocGetRootElement(doc);
+    if (doc == NULL)
+    {
+      printf("error: could not parse file %s\n", configs[cfg]);
+      return -1;
+    }
 
-  // Test with a small partsz and larger, aligned iosz
-  size_t iosz = 8196;
-  size_t partsz = 4096;
-  ne_erasure epat = {.N = 10, .E = 4, .O = 1, .partsz = 1024};
-  if (test_values(root_element, &epat, iosz, partsz))
-  {
-    return -1;
-  }
-  // Test with a larger partsz and much larger iosz
-  partsz = 524288;
-  iosz = 1048576;
-  epat.partsz = partsz;
-  if (test_values(root_element, &epat, iosz, partsz))
-  {
-    return -1;
-  }
+    /*Get the root element node */
+    root_element = xmlDocGetRootElement(doc);
+
+    // Test with a small partsz and larger, aligned iosz
+    size_t iosz = 8196;
+    size_t partsz = 4096;
+    ne_erasure epat = {.N = 10, .E = 4, .O = 1, .partsz = 1024};
+    if (test_values(root_element, &epat, iosz, partsz))
+    {
+      return -1;
+    }
+    // Test with a larger partsz and much larger iosz
+    partsz = 524288;
+    iosz = 1048576;
+    epat.partsz = partsz;
+    if (test_values(root_element, &epat, iosz, partsz))
+    {
+      return -1;
+    }
 
-  /* Free the xml Doc */
-  xmlFreeDoc(doc);
+    /* Free the xml Doc */
+    xmlFreeDoc(doc);
+  }
   /*
    *Free the global variables that may
    *have been allocated by the parser.
@@ -82,6 +82,9 @@ GNU licenses can be found at http://www.gnu.org/licenses/.
 #define ENOATTR ENODATA
 #endif
 
+// maximum number of objects to be deleted via a single ne_delete_batch() call
+#define DELOBJ_BATCH 512
+
 typedef struct repackstreamer_struct {
    // synchronization and access control
    pthread_mutex_t lock;
@@ -352,9 +355,41 @@ int repackstreamer_abort( REPACKSTREAMER repackst ) {
 //   -------------   INTERNAL FUNCTIONS    -------------
 
 
+// issue a batch of object deletions, noting any failures on the associated ops
+static void flush_deleteobj( marfs_ds* ds, ne_delete_target* tgts, opinfo** tgtops, size_t* tgtnos, size_t count ) {
+   if ( count == 0 ) { return; }
+   size_t index;
+   if ( ne_delete_batch( ds->nectxt, tgts, count, 0 ) < 0 ) {
+      LOG( LOG_ERR, "Failed to issue a batch of %zu object deletions\n", count );
+      int errval = (errno) ? errno : ENOTRECOVERABLE;
+      for ( index = 0; index < count; index++ ) {
+         if ( tgtops[index]->errval == 0 ) { tgtops[index]->errval = errval; }
+      }
+   }
+   else {
+      for ( index = 0; index < count; index++ ) {
+         if ( tgts[index].status == ENOENT ) {
+            LOG( LOG_INFO, "Object %zu of stream \"%s\" was already deleted\n", tgtnos[index], tgtops[index]->ftag.streamid );
+         }
+         else if ( tgts[index].status ) {
+            LOG( LOG_ERR, "Failed to delete object %zu of stream \"%s\"\n", tgtnos[index], tgtops[index]->ftag.streamid );
+            if ( tgtops[index]->errval == 0 ) { tgtops[index]->errval = tgts[index].status; }
+         }
+      }
+   }
+   for ( index = 0; index < count; index++ ) {
+      free( (char*)tgts[index].objID );
+   }
+}
+
 void process_deleteobj( marfs_position* pos, opinfo* op ) {
    marfs_ds* ds = &(pos->ns->prepo->datascheme);
-   while ( op ) {
+   // objects of all ops are gathered into batches, so block deletions can proceed in parallel
+   ne_delete_target tgts[DELOBJ_BATCH];
+   opinfo* tgtops[DELOBJ_BATCH];
+   size_t tgtnos[DELOBJ_BATCH];
+   size_t tgtcnt = 0;
+   for ( ; op; op = op->next ) {
       op->start = 0;
       size_t countval = 0;
       // check for extendedinfo
@@ -362,7 +397,8 @@ void process_deleteobj( marfs_position* pos, opinfo* op ) {
       if ( delobjinf != NULL ) {
          countval = delobjinf->offset; // skip ahead by some offset, if specified
       }
-      while ( countval < op->count + delobjinf->offset ) {
+      size_t endval = op->count + countval;
+      for ( ; countval < endval; countval++ ) {
          // identify the object target of the op
          FTAG tmptag = op->ftag;
          tmptag.objno += countval;
@@ -374,26 +410,20 @@ void process_deleteobj( marfs_position* pos, opinfo* op ) {
             op->errval = (errno) ? errno : ENOTRECOVERABLE;
             break;
          }
-         // delete the object
+         // queue up the object for deletion
          LOG( LOG_INFO, "Deleting object %zu of stream \"%s\"\n", tmptag.objno, tmptag.streamid );
-         int olderrno = errno;
-         if ( ne_delete( ds->nectxt, objname, location ) ) {
-            if ( errno == ENOENT ) {
-               LOG( LOG_INFO, "Object %zu of stream \"%s\" was already deleted\n", tmptag.objno, tmptag.streamid );
-            }
-            else {
-               LOG( LOG_ERR, "Failed to delete object %zu of stream \"%s\"\n", tmptag.objno, tmptag.streamid );
-               free( objname );
-               op->errval = (errno) ? errno : ENOTRECOVERABLE;
-               break;
-            }
+         tgts[tgtcnt].objID = objname;
+         tgts[tgtcnt].loc = location;
+         tgtops[tgtcnt] = op;
+         tgtnos[tgtcnt] = tmptag.objno;
+         tgtcnt++;
+         if ( tgtcnt == DELOBJ_BATCH ) {
+            flush_deleteobj( ds, tgts, tgtops, tgtnos, tgtcnt );
+            tgtcnt = 0;
          }
-         errno = olderrno;
-         free( objname );
-         countval++;
       }
-      op = op->next;
    }
+   flush_deleteobj( ds, tgts, tgtops, tgtnos, tgtcnt );
    return;
 }
 
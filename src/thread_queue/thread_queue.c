@@ -140,6 +140,8 @@ typedef struct thread_queue_struct
    // Thread Definitions
    unsigned int uncoll_thrds; /* number of threads that have initialized and not yet returned state info */
    pthread_t *threads;        /* thread instances */
+   TQ_Thread_Pool *tpool;     /* optional external source of threads ( NULL for dedicated pthreads ) */
+   void **pool_thrds;         /* pooled thread handles ( only allocated when tpool is set ) */
    TQWorkerPool prod_pool;    /* reference to producer thread pool */
    TQWorkerPool cons_pool;    /* reference to consumer thread pool */
 } * ThreadQueue;
@@ -202,12 +204,33 @@ void tq_free_all(ThreadQueue tq)
       free(tq->prod_pool);
    }
    free(tq->threads);
+   free(tq->pool_thrds);
    free(tq->state_flags);
    free(tq->log_prefix);
    free(tq->workpkg);
    free(tq);
 }
 
+// start the given thread behavior, either via the attached thread pool or as a dedicated pthread
+int tq_launch_thread(ThreadQueue tq, unsigned int tID, void *(*start)(void *), void *arg)
+{
+   if (tq->tpool != NULL)
+   {
+      return tq->tpool->launch(tq->tpool->pool, start, arg, &tq->pool_thrds[tID]);
+   }
+   return pthread_create(&tq->threads[tID], NULL, start, arg);
+}
+
+// wait for the given thread to exit, populating its return value ( if 'retval' is non-NULL )
+int tq_collect_thread(ThreadQueue tq, unsigned int tID, void **retval)
+{
+   if (tq->tpool != NULL)
+   {
+      return tq->tpool->collect(tq->tpool->pool, tq->pool_thrds[tID], retval);
+   }
+   return pthread_join(tq->threads[tID], retval);
+}
+
 // call the thread_init_func (if supplied), attempt first lock acquizition, and set a READY state
 int general_thread_init_behavior(ThreadQueue tq, TQWorkerPool wp, unsigned int tID, void *global_state, void **tstate)
 {
@@ -408,7 +431,7 @@ void *consumer_thread(void *arg)
    void *tstate = NULL;
    if (general_thread_init_behavior(tq, wp, tID, global_state, &tstate))
    { // non-zero return means failure to acquire lock or initialize
-      pthread_exit(tstate);
+      return tstate;
    }
 
    // begin main loop
@@ -480,13 +503,13 @@ void *consumer_thread(void *arg)
       // acquire lock and set queue flags based on work result
       if (general_thread_post_work_behavior(tq, wp, tID, &tstate, &cur_work, work_res))
       { // non-zero return means failure to acquire lock
-         pthread_exit(tstate);
+         return tstate;
       }
    }
    // end of main loop (still holding lock)
 
    general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
-   pthread_exit(tstate);
+   return tstate;
 }
 
 // defines behavior for all producer threads
@@ -504,7 +527,7 @@ void *producer_thread(void *arg)
    void *tstate = NULL;
    if (general_thread_init_behavior(tq, wp, tID, global_state, &tstate))
    { // non-zero return means failure to acquire lock or initialize
-      pthread_exit(tstate);
+      return tstate;
    }
 
    // define pointer for current work package
@@ -524,6 +547,13 @@ void *producer_thread(void *arg)
       } // hit standard abort logic
    }
 
+   // a queue which was aborted, or finished without ever being resumed, needs no work from us
+   if ((tq->con_flags & TQ_ABORT) || ((tq->con_flags & TQ_FINISHED) && (tq->con_flags & TQ_HALT)))
+   {
+      general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
+      return tstate;
+   }
+
    pthread_mutex_unlock(&tq->qlock); // release the lock
 
    // begin main loop
@@ -536,7 +566,7 @@ void *producer_thread(void *arg)
       // acquire lock and set queue flags based on work result
       if (general_thread_post_work_behavior(tq, wp, tID, &tstate, &cur_work, work_res))
       { // non-zero return means failure to acquire lock
-         pthread_exit(tstate);
+         return tstate;
       }
 
       // Wait while there is no space available OR while the queue is both halted and NOT FINISHED
@@ -607,7 +637,7 @@ void *producer_thread(void *arg)
    // end of main loop (still holding lock)
 
    general_thread_term_behavior(tq, wp, tID, &tstate, &cur_work);
-   pthread_exit(tstate);
+   return tstate;
 }
 
 /* -------------------------------------------------------  EXPOSED FUNCTIONS  ------------------------------------------------------- */
@@ -619,6 +649,24 @@ void *producer_thread(void *arg)
  */
 ThreadQueue tq_init(TQ_Init_Opts *opts)
 {
+   return tq_init_pooled(opts, NULL);
+}
+
+/**
+ * Initializes a new ThreadQueue, running all of its threads via the given TQ_Thread_Pool
+ * @param TQ_Init_Opts opts : options struct defining parameters for the created ThreadQueue
+ * @param TQ_Thread_Pool* tpool : Thread pool to launch threads from ( NULL for dedicated pthreads )
+ *                                NOTE -- the pool must persist until all thread states are collected
+ * @return ThreadQueue : pointer to the created ThreadQueue, or NULL if an error was encountered
+ */
+ThreadQueue tq_init_pooled(TQ_Init_Opts *opts, TQ_Thread_Pool *tpool)
+{
+   if (tpool != NULL && (tpool->launch == NULL || tpool->collect == NULL))
+   {
+      LOG(LOG_ERR, "received a TQ_Thread_Pool lacking launch/collect functions!\n");
+      errno = EINVAL;
+      return NULL;
+   }
    // allocate space for a new thread_queue_struct
    ThreadQueue tq = malloc(sizeof(struct thread_queue_struct));
    if (tq == NULL)
@@ -718,6 +766,9 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
    // initialize worker pools to NULL (simplifies cleanup logic)
    tq->prod_pool = NULL;
    tq->cons_pool = NULL;
+   // attach any thread pool
+   tq->tpool = tpool;
+   tq->pool_thrds = NULL;
    // initialize our count of uncollected threads
    tq->uncoll_thrds = 0;
    // initialize pthread control structures
@@ -785,6 +836,16 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
       FREE_TQP(tq);
       return NULL;
    }
+   if (tpool != NULL)
+   {
+      tq->pool_thrds = calloc(opts->num_threads, sizeof(void *));
+      if (tq->pool_thrds == NULL)
+      {
+         LOG(LOG_ERR, "%s failed to allocate space for pooled thread references!\n", tq->log_prefix);
+         tq_free_all(tq);
+         return NULL;
+      }
+   }
 
    // allocate space for thread arg structs
    ThreadArg** targs = malloc(sizeof(ThreadArg*) * opts->num_threads);
@@ -868,7 +929,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
       targ->tID = tID;
       targ->tq = tq;
       LOG(LOG_INFO, "%s Starting %s Thread %u\n", tq->log_prefix, tq->prod_pool->pname, targ->tID);
-      if (pthread_create(&tq->threads[tID], NULL, producer_thread, (void *)targ))
+      if (tq_launch_thread(tq, tID, producer_thread, (void *)targ))
       {
          LOG(LOG_ERR, "%s failed to create thread %d\n", tq->log_prefix, tID);
          break;
@@ -884,7 +945,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
       targ->tID = tID;
       targ->tq = tq;
       LOG(LOG_INFO, "%s Starting %s Thread %u\n", tq->log_prefix, tq->cons_pool->pname, targ->tID);
-      if (pthread_create(&tq->threads[tID], NULL, consumer_thread, (void *)targ))
+      if (tq_launch_thread(tq, tID, consumer_thread, (void *)targ))
       {
          LOG(LOG_ERR, "%s failed to create thread %d\n", tq->log_prefix, tID);
          for( i = tID; i < opts->num_threads; i++ ) { free( targs[i] ); }
@@ -915,7 +976,7 @@ ThreadQueue tq_init(TQ_Init_Opts *opts)
       } //if this wasn't a locking failure, unlock
       for (tID = 0; tID < tq->uncoll_thrds; tID++)
       {
-         pthread_join(tq->threads[tID], NULL); // just ignore thread status, we are already aborting
+         tq_collect_thread(tq, tID, NULL); // just ignore thread status, we are already aborting
          LOG(LOG_INFO, "%s joined with thread %u\n", tq->log_prefix, tID);
       }
       // free everything we allocated and terminate
@@ -1095,19 +1156,15 @@ int tq_enqueue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void *workbuff)
 }
 
 /**
- * Retrieve a new element of work from the ThreadQueue.
- *  Note that, if the Queue is empty but not FINISHED, this call will block.
- *  However, if the Queue is empty and FINISED, this call will return zero and
- *  populate workbuff with a NULL value.
+ * (INTERNAL HELPER FUNCTION)
+ * Retrieve a new element of work from the ThreadQueue, waiting no later than the given time
  * @param ThreadQueue tq : ThreadQueue from which to retrieve work
  * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
- *                                        (By default, only a TQ_FINISHED state will not result in a failure)
  * @param void** workbuff : Reference to be populated with the work element pointer
- * @return int : The depth of the queue (including the retrieved element) on success,
- *               Zero if the queue is both empty and has ANY control flags set (deadlock protection),
- *               and -1 on failure (such as, if the queue is HALTED or ABORTED, and those flags were not ignored)
+ * @param const struct timespec* abstime : Absolute CLOCK_REALTIME timeout ( NULL to wait indefinitely )
+ * @return int : See tq_dequeue() and tq_dequeue_timed()
  */
-int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff)
+static int dequeue_work(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff, const struct timespec *abstime)
 {
    if (pthread_mutex_lock(&tq->qlock))
    {
@@ -1120,7 +1177,22 @@ int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff)
    {
       LOG(LOG_INFO, "%s master proc is waiting for an element to dequeue\n", tq->log_prefix);
       pthread_cond_broadcast(&tq->producer_resume); // our queue is empty!  Make sure all producers are running
-      pthread_cond_wait(&tq->consumer_resume, &tq->qlock);
+      if (abstime == NULL)
+      {
+         pthread_cond_wait(&tq->consumer_resume, &tq->qlock);
+      }
+      else if (pthread_cond_timedwait(&tq->consumer_resume, &tq->qlock, abstime) == ETIMEDOUT)
+      {
+         if (tq->qdepth == 0 && !(tq->con_flags))
+         {
+            LOG(LOG_INFO, "%s master proc timed out waiting for an element to dequeue\n", tq->log_prefix);
+            pthread_mutex_unlock(&tq->qlock);
+            if (workbuff)
+               *workbuff = NULL;
+            errno = ETIMEDOUT;
+            return 0;
+         }
+      }
       LOG(LOG_INFO, "%s master proc has woken up\n", tq->log_prefix);
    }
    // check for any oddball conditions which should prevent this work
@@ -1177,6 +1249,43 @@ int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff)
    return depth;
 }
 
+/**
+ * Retrieve a new element of work from the ThreadQueue.
+ *  Note that, if the Queue is empty but not FINISHED, this call will block.
+ *  However, if the Queue is empty and FINISED, this call will return zero and
+ *  populate workbuff with a NULL value.
+ * @param ThreadQueue tq : ThreadQueue from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @return int : The depth of the queue (including the retrieved element) on success,
+ *               Zero if the queue is both empty and has ANY control flags set (deadlock protection),
+ *               and -1 on failure (such as, if the queue is HALTED or ABORTED, and those flags were not ignored)
+ */
+int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff)
+{
+   return dequeue_work(tq, ignore_flags, workbuff, NULL);
+}
+
+/**
+ * Retrieve a new element of work from the ThreadQueue, waiting no later than the given time.
+ *  Identical to tq_dequeue(), except that an empty Queue with no state flags set will only
+ *  block until 'abstime', after which this call will return zero, populate workbuff with a
+ *  NULL value, and set errno to ETIMEDOUT.
+ * @param ThreadQueue tq : ThreadQueue from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @param const struct timespec* abstime : Absolute CLOCK_REALTIME time at which to stop waiting
+ * @return int : The depth of the queue (including the retrieved element) on success,
+ *               Zero if the queue is both empty and has ANY control flags set or the timeout expired,
+ *               and -1 on failure (such as, if the queue is HALTED or ABORTED, and those flags were not ignored)
+ */
+int tq_dequeue_timed(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff, const struct timespec *abstime)
+{
+   return dequeue_work(tq, ignore_flags, workbuff, abstime);
+}
+
 /**
  * Determine the current depth (number of enqueued elements) of the given ThreadQueue
  * @param ThreadQueue tq : ThreadQueue for which to determine depth
@@ -1543,7 +1652,7 @@ int tq_next_thread_status(ThreadQueue tq, void **tstate)
          pthread_cond_wait(&tq->state_resume, &tq->qlock);
       }
       LOG(LOG_INFO, "%s master attempting to join thread %u\n", tq->log_prefix, tID);
-      int ret = pthread_join(tq->threads[tID], tstate);
+      int ret = tq_collect_thread(tq, tID, tstate);
       if (ret)
       { // indicate a failure if we couldn't join
          LOG(LOG_ERR, "%s master failed to join thread %u!\n", tq->log_prefix, tID);
@@ -72,6 +72,8 @@ IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
 OF SUCH DAMAGE.
 */
 
+#include <time.h>
+
 typedef enum
 {
    TQ_NONE = 0,             // filler value, used to indicate no flags at all
@@ -187,6 +189,33 @@ typedef struct queue_init_struct
 
 typedef struct thread_queue_struct *ThreadQueue; // forward decl.
 
+typedef struct thread_queue_pool_struct
+{
+   void *pool; /* reference to the pool implementation, passed as the first argument of both functions */
+
+   /*
+      function pointer defining how a queue thread is started
+      - Arguments
+         * The first argument is the 'pool' reference above
+         * The second and third arguments are the thread behavior and its argument ( as for pthread_create() )
+         * The fourth argument is a reference to be populated with a handle for the started thread
+      - Return Value
+         * Zero on success, non-zero if the thread could not be started
+   */
+   int (*launch)(void *pool, void *(*start)(void *), void *arg, void **thread);
+
+   /*
+      function pointer defining how a queue thread is collected ( called exactly once per launched thread )
+      - Arguments
+         * The first argument is the 'pool' reference above
+         * The second argument is the thread handle populated by launch()
+         * The third argument is a reference to be populated with the thread return value ( may be NULL )
+      - Return Value
+         * Zero on success, non-zero if the thread could not be collected
+   */
+   int (*collect)(void *pool, void *thread, void **retval);
+} TQ_Thread_Pool;
+
 /**
  * Initializes a new ThreadQueue according to the parameters of the passed options struct
  * @param TQ_Init_Opts opts : options struct defining parameters for the created ThreadQueue
@@ -194,6 +223,15 @@ typedef struct thread_queue_struct *ThreadQueue; // forward decl.
  */
 ThreadQueue tq_init(TQ_Init_Opts *opts);
 
+/**
+ * Initializes a new ThreadQueue, running all of its threads via the given TQ_Thread_Pool
+ * @param TQ_Init_Opts opts : options struct defining parameters for the created ThreadQueue
+ * @param TQ_Thread_Pool* tpool : Thread pool to launch threads from ( NULL for dedicated pthreads )
+ *                                NOTE -- the pool must persist until all thread states are collected
+ * @return ThreadQueue : pointer to the created ThreadQueue, or NULL if an error was encountered
+ */
+ThreadQueue tq_init_pooled(TQ_Init_Opts *opts, TQ_Thread_Pool *tpool);
+
 /**
  * Check for successful initialization of all threads of a ThreadQueue
  * @param ThreadQueue tq : ThreadQueue for which to check status
@@ -236,6 +274,22 @@ int tq_enqueue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void *workbuff);
  */
 int tq_dequeue(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff);
 
+/**
+ * Retrieve a new element of work from the ThreadQueue, waiting no later than the given time.
+ *  Identical to tq_dequeue(), except that an empty Queue with no state flags set will only
+ *  block until 'abstime', after which this call will return zero, populate workbuff with a
+ *  NULL value, and set errno to ETIMEDOUT.
+ * @param ThreadQueue tq : ThreadQueue from which to retrieve work
+ * @param TQ_Control_Flags ignore_flags : Indicates which queue states should be bypassed during this operation
+ *                                        (By default, only a TQ_FINISHED state will not result in a failure)
+ * @param void** workbuff : Reference to be populated with the work element pointer
+ * @param const struct timespec* abstime : Absolute CLOCK_REALTIME time at which to stop waiting
+ * @return int : The depth of the queue (including the retrieved element) on success,
+ *               Zero if the queue is both empty and has ANY control flags set or the timeout expired,
+ *               and -1 on failure (such as, if the queue is HALTED or ABORTED, and those flags were not ignored)
+ */
+int tq_dequeue_timed(ThreadQueue tq, TQ_Control_Flags ignore_flags, void **workbuff, const struct timespec *abstime);
+
 /**
  * Determine the current depth (number of enqueued elements) of the given ThreadQueue
  * @param ThreadQueue tq : ThreadQueue for which to determine depth